@@ -4,7 +4,7 @@
  *	@author 	Tilen MAJERLE
  *	@email		tilen@majerle.eu
  *	@website	http://stm32f4-discovery.net
- *	@version 	v1.0
+ *	@version 	v1.1
  *	@ide		Keil uVision 5
  *	@license	GNU GPL v3
  *	
@@ -27,10 +27,32 @@
  *
  * Different compilers uses different special keywords for functions/variables. etc.
  * For this purpose that file has been made. On one place to all possible attributes used in my libs.
+ *
+ * CCM RAM
+ *
+ * STM32F429 has 64kB of CCM RAM at 0x10000000. Only CPU can access it, without wait states and without
+ * waiting for DMA2D, LTDC or Ethernet DMA which use SRAM at the same time. DMA can't access it.
+ *
+ * CCM RAM is not used by default, TM_CCM_DATA and TM_CCM_BSS are empty and all variables stay in SRAM.
+ * Linker must know where CCM sections go, otherwise startup code does not initialize them. To enable CCM RAM:
+ *
+ *  - Use STM32F429_CCM.sct for Keil or STM32F429_CCM.ld for GCC from linker/ folder
+ *  - For GCC, call TM_CCM_Init() from TM CCM library at the end of SystemInit()
+ *  - Set TM_CCM_ENABLED to 1 in defines.h
+ *
+ * Then variables with TM_CCM_DATA (with initial value) or TM_CCM_BSS (zero at startup) are placed in CCM.
+ * Both linker files also put main stack to CCM, so local variables can't be used as DMA buffers.
+ *
+ * Version 1.1
+ *  - October 16, 2026
+ *  - Added CCM RAM placement macros
  */
 #ifndef TM_ATTRIBUTES_H
 #define TM_ATTRIBUTES_H
 
+#include "stdint.h"
+#include "defines.h"
+
 /* Check for GNUC */
 #if defined (__GNUC__)
 	#ifndef __weak		
@@ -41,4 +63,33 @@
 	#endif	/* Packed attribute */
 #endif
 
+/* CCM RAM is not used by default, it needs CCM linker file */
+#ifndef TM_CCM_ENABLED
+#define TM_CCM_ENABLED		0
+#endif
+
+/* CCM RAM location */
+#define TM_CCM_START		0x10000000
+#define TM_CCM_SIZE			0x00010000
+
+/* CCM RAM variables */
+#if TM_CCM_ENABLED == 1
+	#if defined (__CC_ARM)
+		#define TM_CCM_DATA		__attribute__((section(".ccmram")))
+		#define TM_CCM_BSS		__attribute__((section(".ccmbss"), zero_init))
+	#elif defined (__GNUC__)
+		#define TM_CCM_DATA		__attribute__((section(".ccmram")))
+		#define TM_CCM_BSS		__attribute__((section(".ccmbss")))
+	#else
+		#define TM_CCM_DATA
+		#define TM_CCM_BSS
+	#endif
+#else
+	#define TM_CCM_DATA
+	#define TM_CCM_BSS
+#endif
+
+/* Returns 1 if pointer is in CCM RAM, DMA can't use this memory */
+#define TM_IS_CCM(ptr)		((uintptr_t)(ptr) - TM_CCM_START < TM_CCM_SIZE)
+
 #endif
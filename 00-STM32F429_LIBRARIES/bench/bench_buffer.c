@@ -0,0 +1,80 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * USART receive ring buffer: write from interrupt side and read with Getc, Gets and FindCharacter
+ */
+#include "bench_suites.h"
+#include "tm_stm32f4_usart.h"
+
+/* Same buffer as GPS suite, it is cleared before each case */
+#define BUFFER_USART        USART1
+#define BUFFER_BYTES        256
+
+static char Line[BUFFER_BYTES + 1];
+
+static void
+Clear(void) {
+    TM_USART_ClearBuffer(BUFFER_USART);
+}
+
+static void
+Fill(void) {
+    uint16_t i;
+
+    /* Lines of 16 characters, like from terminal */
+    for (i = 0; i < BUFFER_BYTES; i++) {
+        TM_USART_InsertToBuffer(BUFFER_USART, (i & 0x0F) == 0x0F ? '\n' : 'a' + (i & 0x0F));
+    }
+}
+
+static void
+CaseInsertGetc(void) {
+    uint16_t i;
+    uint32_t sum = 0;
+
+    Fill();
+    for (i = 0; i < BUFFER_BYTES; i++) {
+        sum += TM_USART_Getc(BUFFER_USART);
+    }
+    TM_BENCH_Use(sum);
+}
+
+static void
+CaseGets(void) {
+    uint32_t sum = 0;
+
+    Fill();
+    while (!TM_USART_BufferEmpty(BUFFER_USART)) {
+        sum += TM_USART_Gets(BUFFER_USART, Line, sizeof(Line));
+    }
+    TM_BENCH_Use(sum);
+}
+
+static void
+CaseFind(void) {
+    Fill();
+    TM_BENCH_Use(TM_USART_FindCharacter(BUFFER_USART, 'z'));
+    TM_USART_ClearBuffer(BUFFER_USART);
+}
+
+static const TM_BENCH_Case_t Cases[] = {
+    TM_BENCH_CASE_SETUP("insert_getc_256", Clear, CaseInsertGetc, BUFFER_BYTES),
+    TM_BENCH_CASE_SETUP("insert_gets_16x16", Clear, CaseGets, BUFFER_BYTES),
+    TM_BENCH_CASE_SETUP("insert_find_miss_256", Clear, CaseFind, BUFFER_BYTES),
+};
+TM_BENCH_SUITE(BENCH_Buffer, "buffer", NULL, Cases);
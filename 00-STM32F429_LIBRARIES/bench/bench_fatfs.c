@@ -0,0 +1,97 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * FatFs on RAM disk in SDRAM, set FATFS_USE_SDRAM to 1 in defines.h
+ */
+#include "bench_suites.h"
+#include "tm_stm32f4_fatfs.h"
+
+#define FILE_BYTES          4096
+#define FILES               16
+
+static FATFS FS;
+static FIL File;
+static DIR Dir;
+static FILINFO Info;
+static uint8_t Data[FILE_BYTES];
+
+static uint8_t
+Init(void) {
+    char name[24];
+    UINT bw;
+    uint8_t i;
+
+    /* Mount and format RAM disk, SDRAM is initialized by disk driver */
+    if (f_mount(&FS, "SDRAM:", 0) != FR_OK || f_mkfs("SDRAM:", 0, 0) != FR_OK) {
+        return 0;
+    }
+
+    /* Files for read and directory cases */
+    for (i = 0; i < FILES; i++) {
+        sprintf(name, "SDRAM:file_%02d.bin", i);
+        if (f_open(&File, name, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+            return 0;
+        }
+        f_write(&File, Data, FILE_BYTES, &bw);
+        f_close(&File);
+    }
+    return 1;
+}
+
+static void
+CaseWrite(void) {
+    UINT bw = 0;
+
+    if (f_open(&File, "SDRAM:write.bin", FA_CREATE_ALWAYS | FA_WRITE) == FR_OK) {
+        f_write(&File, Data, FILE_BYTES, &bw);
+        f_close(&File);
+    }
+    TM_BENCH_Use(bw);
+}
+
+static void
+CaseRead(void) {
+    UINT br = 0;
+
+    if (f_open(&File, "SDRAM:file_07.bin", FA_READ) == FR_OK) {
+        f_read(&File, Data, FILE_BYTES, &br);
+        f_close(&File);
+    }
+    TM_BENCH_Use(br);
+}
+
+static void
+CaseList(void) {
+    uint32_t count = 0;
+
+    /* Go through all entries in root directory */
+    if (f_opendir(&Dir, "SDRAM:") == FR_OK) {
+        while (f_readdir(&Dir, &Info) == FR_OK && Info.fname[0]) {
+            count++;
+        }
+        f_closedir(&Dir);
+    }
+    TM_BENCH_Use(count);
+}
+
+static const TM_BENCH_Case_t Cases[] = {
+    TM_BENCH_CASE_BYTES("write_4k", CaseWrite, FILE_BYTES),
+    TM_BENCH_CASE_BYTES("read_4k", CaseRead, FILE_BYTES),
+    TM_BENCH_CASE("readdir_17", CaseList),
+};
+TM_BENCH_SUITE(BENCH_FatFs, "fatfs", Init, Cases);
@@ -0,0 +1,72 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * FFT library with CMSIS DSP complex FFT and magnitude
+ */
+#include "bench_suites.h"
+#include "tm_stm32f4_fft.h"
+
+#define FFT_MAX_SIZE        1024
+
+static TM_FFT_F32_t FFT;
+static float32_t Input[2 * FFT_MAX_SIZE];
+static float32_t Output[FFT_MAX_SIZE];
+static float32_t Samples[2 * FFT_MAX_SIZE];
+
+static void
+Prepare(uint16_t Size) {
+    uint16_t i;
+
+    TM_FFT_Init_F32(&FFT, Size, 0);
+    TM_FFT_SetBuffers_F32(&FFT, Input, Output);
+
+    /* Saw signal, copy is kept because FFT works in place */
+    for (i = 0; i < Size; i++) {
+        TM_FFT_AddToBuffer(&FFT, (float32_t)((i * 7) % 64) - 32.0f);
+    }
+    memcpy(Samples, Input, 2 * Size * sizeof(float32_t));
+}
+
+static void SetupFFT256(void) { Prepare(256); }
+static void SetupFFT1024(void) { Prepare(1024); }
+
+static void
+CaseProcess(void) {
+    /* Same input for each run, copy is small part of FFT time */
+    memcpy(Input, Samples, 2 * FFT.FFT_Size * sizeof(float32_t));
+    TM_FFT_Process_F32(&FFT);
+    TM_BENCH_Use(TM_FFT_GetMaxIndex(&FFT));
+}
+
+static void
+CaseAdd(void) {
+    uint16_t i;
+
+    /* Fill whole buffer sample by sample */
+    FFT.Count = 0;
+    for (i = 0; i < FFT.FFT_Size; i++) {
+        TM_FFT_AddToBuffer(&FFT, (float32_t)i);
+    }
+}
+
+static const TM_BENCH_Case_t Cases[] = {
+    TM_BENCH_CASE_SETUP("add_samples_1024", SetupFFT1024, CaseAdd, 0),
+    TM_BENCH_CASE_SETUP("f32_256", SetupFFT256, CaseProcess, 0),
+    TM_BENCH_CASE_SETUP("f32_1024", SetupFFT1024, CaseProcess, 0),
+};
+TM_BENCH_SUITE(BENCH_FFT, "fft", NULL, Cases);
@@ -0,0 +1,75 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * GPS NMEA parser, sentences are put to USART receive buffer like from GPS module
+ */
+#include "bench_suites.h"
+#include "tm_stm32f4_gps.h"
+
+/* Sentences without checksum */
+static const char* Sentences[] = {
+    "GPGGA,123519.00,4807.03812,N,01131.00012,E,1,08,0.9,545.4,M,46.9,M,,",
+    "GPRMC,123519.00,A,4807.03812,N,01131.00012,E,022.4,084.4,230394,003.1,W",
+    "GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1",
+    "GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45",
+    "GPGSV,2,2,08,15,12,060,36,18,54,126,48,21,33,295,42,24,65,172,47",
+};
+
+static TM_GPS_t GPS_Data;
+static char Block[512];
+static uint16_t BlockLength;
+
+static uint8_t
+Init(void) {
+    uint8_t i, sum;
+    const char* s;
+
+    /* USART is initialized, received data comes only from buffer */
+    TM_GPS_Init(&GPS_Data, 9600);
+
+    /* Block of sentences with checksums, like one second of GPS output */
+    BlockLength = 0;
+    for (i = 0; i < sizeof(Sentences) / sizeof(Sentences[0]); i++) {
+        for (sum = 0, s = Sentences[i]; *s; s++) {
+            sum ^= *s;
+        }
+        BlockLength += sprintf(&Block[BlockLength], "$%s*%02X\r\n", Sentences[i], sum);
+    }
+    return 1;
+}
+
+static void
+CaseUpdate(void) {
+    uint16_t i;
+
+    /* Put block to buffer and parse it */
+    for (i = 0; i < BlockLength; i++) {
+        TM_USART_InsertToBuffer(GPS_USART, Block[i]);
+    }
+    TM_BENCH_Use(TM_GPS_Update(&GPS_Data));
+}
+
+static void
+Clear(void) {
+    TM_USART_ClearBuffer(GPS_USART);
+}
+
+static const TM_BENCH_Case_t Cases[] = {
+    TM_BENCH_CASE_SETUP("update_5_sentences", Clear, CaseUpdate, 0),
+};
+TM_BENCH_SUITE(BENCH_GPS, "gps", Init, Cases);
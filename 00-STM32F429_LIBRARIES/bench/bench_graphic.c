@@ -0,0 +1,54 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * Graphic primitives on ILI9341 with LTDC and DMA2D GRAPHIC library on the same frame buffer
+ */
+#include "bench_suites.h"
+#include "tm_stm32f4_ili9341_ltdc.h"
+#include "tm_stm32f4_dma2d_graphic.h"
+#include "tm_stm32f4_fonts.h"
+
+static uint8_t
+Init(void) {
+    TM_ILI9341_Init();
+    TM_ILI9341_Rotate(TM_ILI9341_Orientation_Portrait_2);
+    TM_DMA2DGRAPHIC_Init();
+    TM_DMA2DGRAPHIC_SetOrientation(1);
+    return 1;
+}
+
+static void CaseFill(void) { TM_ILI9341_Fill(ILI9341_COLOR_BLUE); }
+static void CasePixel(void) { TM_ILI9341_DrawPixel(120, 160, ILI9341_COLOR_RED); }
+static void CaseLine(void) { TM_ILI9341_DrawLine(10, 20, 230, 300, ILI9341_COLOR_RED); }
+static void CaseCircle(void) { TM_ILI9341_DrawFilledCircle(120, 160, 50, ILI9341_COLOR_GREEN); }
+static void CasePuts(void) { TM_ILI9341_Puts(10, 100, "Benchmark", &TM_Font_11x18, ILI9341_COLOR_BLACK, ILI9341_COLOR_WHITE); }
+static void CaseRect(void) { TM_DMA2DGRAPHIC_DrawFilledRectangle(20, 20, 100, 100, 0xF800); }
+static void CaseRoundRect(void) { TM_DMA2DGRAPHIC_DrawFilledRoundedRectangle(20, 20, 100, 100, 10, 0x07E0); }
+static void CaseTriangle(void) { TM_DMA2DGRAPHIC_DrawFilledTriangle(10, 10, 230, 60, 80, 300, 0x001F); }
+
+static const TM_BENCH_Case_t Cases[] = {
+    TM_BENCH_CASE_BYTES("ili9341_fill", CaseFill, 240 * 320 * 2),
+    TM_BENCH_CASE("ili9341_pixel", CasePixel),
+    TM_BENCH_CASE("ili9341_line_diagonal", CaseLine),
+    TM_BENCH_CASE("ili9341_filled_circle_r50", CaseCircle),
+    TM_BENCH_CASE("ili9341_puts_9_chars", CasePuts),
+    TM_BENCH_CASE_BYTES("dma2d_filled_rect_100x100", CaseRect, 100 * 100 * 2),
+    TM_BENCH_CASE("dma2d_filled_round_rect_100x100", CaseRoundRect),
+    TM_BENCH_CASE("dma2d_filled_triangle", CaseTriangle),
+};
+TM_BENCH_SUITE(BENCH_Graphic, "graphic", Init, Cases);
@@ -0,0 +1,128 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * TM HEAP allocator against malloc from C library, with the same pattern of sizes,
+ * and TM POOL for objects of one size
+ */
+#include "bench_suites.h"
+#include "tm_stm32f4_heap.h"
+#include "tm_stm32f4_pool.h"
+#include "stdlib.h"
+
+#define HEAP_SIZE           (32 * 1024)
+#define BLOCKS              32
+
+static TM_HEAP_t Heap;
+static uint8_t Memory[HEAP_SIZE];
+static void* Blocks[BLOCKS];
+
+TM_POOL_DEFINE_SIZE(Pool, 64, BLOCKS);
+
+/* Sizes from 8 to 1024 bytes, like strings, timers and buffers */
+static const uint16_t Sizes[BLOCKS] = {
+    24, 100, 8, 512, 40, 16, 256, 64, 12, 1024, 32, 80, 20, 128, 48, 200,
+    16, 36, 300, 8, 72, 24, 640, 56, 28, 160, 44, 96, 400, 16, 60, 120,
+};
+
+static uint8_t
+Init(void) {
+    return TM_HEAP_Init(&Heap, Memory, sizeof(Memory));
+}
+
+static void
+CaseHeapPair(void) {
+    void* ptr = TM_HEAP_Malloc(&Heap, 64);
+    TM_BENCH_Use((uint32_t)(uintptr_t)ptr);
+    TM_HEAP_Free(ptr);
+}
+
+static void
+CaseLibcPair(void) {
+    /* Pointer is used, so compiler can't remove malloc and free */
+    void* ptr = malloc(64);
+    TM_BENCH_Use((uint32_t)(uintptr_t)ptr);
+    free(ptr);
+}
+
+static void
+CasePoolPair(void) {
+    void* ptr = TM_POOL_Alloc(&Pool);
+    TM_BENCH_Use((uint32_t)(uintptr_t)ptr);
+    TM_POOL_Free(&Pool, ptr);
+}
+
+static void
+CasePoolAll(void) {
+    uint8_t i;
+
+    /* Allocate all objects and free them in other order */
+    for (i = 0; i < BLOCKS; i++) {
+        Blocks[i] = TM_POOL_Alloc(&Pool);
+    }
+    for (i = 0; i < BLOCKS; i++) {
+        TM_POOL_Free(&Pool, Blocks[(i * 7) % BLOCKS]);
+    }
+}
+
+static void
+CaseHeapMixed(void) {
+    uint8_t i;
+
+    /* Allocate all, free every second and allocate them again, then free all */
+    for (i = 0; i < BLOCKS; i++) {
+        Blocks[i] = TM_HEAP_Malloc(&Heap, Sizes[i]);
+    }
+    for (i = 0; i < BLOCKS; i += 2) {
+        TM_HEAP_Free(Blocks[i]);
+    }
+    for (i = 0; i < BLOCKS; i += 2) {
+        Blocks[i] = TM_HEAP_Malloc(&Heap, Sizes[BLOCKS - 1 - i]);
+    }
+    for (i = 0; i < BLOCKS; i++) {
+        TM_HEAP_Free(Blocks[i]);
+    }
+}
+
+static void
+CaseLibcMixed(void) {
+    uint8_t i;
+
+    /* Same pattern as TM HEAP case */
+    for (i = 0; i < BLOCKS; i++) {
+        Blocks[i] = malloc(Sizes[i]);
+    }
+    for (i = 0; i < BLOCKS; i += 2) {
+        free(Blocks[i]);
+    }
+    for (i = 0; i < BLOCKS; i += 2) {
+        Blocks[i] = malloc(Sizes[BLOCKS - 1 - i]);
+    }
+    for (i = 0; i < BLOCKS; i++) {
+        free(Blocks[i]);
+    }
+}
+
+static const TM_BENCH_Case_t Cases[] = {
+    TM_BENCH_CASE("tm_heap_malloc_free_64", CaseHeapPair),
+    TM_BENCH_CASE("libc_malloc_free_64", CaseLibcPair),
+    TM_BENCH_CASE("tm_pool_alloc_free_64", CasePoolPair),
+    TM_BENCH_CASE("tm_pool_all_32", CasePoolAll),
+    TM_BENCH_CASE("tm_heap_mixed_32", CaseHeapMixed),
+    TM_BENCH_CASE("libc_mixed_32", CaseLibcMixed),
+};
+TM_BENCH_SUITE(BENCH_Heap, "heap", Init, Cases);
@@ -0,0 +1,184 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * String helpers: TM STRING table and hardware CRC unit
+ */
+#include "bench_suites.h"
+#include "tm_stm32f4_string.h"
+#include "tm_stm32f4_crc.h"
+
+#define STRING_COUNT        32
+#define STRING_LARGE        2048
+#define CRC_BYTES           1024
+
+static const char* Words[] = {"Temperature", "Humidity", "Pressure", "Altitude"};
+static TM_STRING_t* Table;
+static TM_STRING_t* Large;
+static char Names[STRING_LARGE][12];
+static uint32_t Data[CRC_BYTES / 4];
+
+static void
+CaseAddFree(void) {
+    TM_STRING_t* String;
+    uint16_t i;
+
+    /* Table starts small and grows with each string */
+    String = TM_STRING_Create(1);
+    for (i = 0; i < STRING_COUNT; i++) {
+        TM_STRING_AddString(String, (char *)Words[i & 3]);
+    }
+    TM_STRING_FreeAll(String);
+}
+
+static void
+SetupTable(void) {
+    uint16_t i;
+
+    /* Table used by replace and get cases */
+    if (Table == NULL) {
+        Table = TM_STRING_Create(STRING_COUNT);
+        for (i = 0; i < STRING_COUNT; i++) {
+            TM_STRING_AddString(Table, (char *)Words[i & 3]);
+        }
+    }
+}
+
+static void
+CaseReplace(void) {
+    uint16_t i;
+
+    /* Longer and shorter strings, so memory is allocated on each second call */
+    for (i = 0; i < STRING_COUNT; i++) {
+        TM_STRING_ReplaceString(Table, i, (char *)Words[(i + 1) & 3]);
+        TM_STRING_ReplaceString(Table, i, (char *)Words[i & 3]);
+    }
+}
+
+static void
+CaseGet(void) {
+    uint16_t i;
+    uint32_t sum = 0;
+
+    for (i = 0; i < STRING_COUNT; i++) {
+        sum += (uint8_t)TM_STRING_GetString(Table, i)[0];
+    }
+    TM_BENCH_Use(sum);
+}
+
+static void
+SetupNames(void) {
+    uint16_t i;
+
+    /* Different names, like variables in configuration file */
+    for (i = 0; i < STRING_LARGE; i++) {
+        sprintf(Names[i], "sensor_%u", i);
+    }
+}
+
+static void
+CaseAddLarge(void) {
+    TM_STRING_t* String;
+    uint16_t i;
+
+    /* Arena and arrays grow a few times only */
+    String = TM_STRING_Create(1);
+    for (i = 0; i < STRING_LARGE; i++) {
+        TM_STRING_AddString(String, Names[i]);
+    }
+    TM_STRING_FreeAll(String);
+}
+
+static void
+SetupLarge(void) {
+    uint16_t i;
+
+    /* Large table used by find and delete cases */
+    if (Large == NULL) {
+        SetupNames();
+        Large = TM_STRING_Create(STRING_LARGE);
+        for (i = 0; i < STRING_LARGE; i++) {
+            TM_STRING_AddString(Large, Names[i]);
+        }
+    }
+}
+
+static void
+CaseFind(void) {
+    uint16_t i;
+    uint32_t sum = 0;
+
+    /* Names from whole table, linear search takes longer for later names */
+    for (i = 0; i < STRING_COUNT; i++) {
+        sum += TM_STRING_Find(Large, Names[i * (STRING_LARGE / STRING_COUNT)]);
+    }
+    TM_BENCH_Use(sum);
+}
+
+static void
+CaseDeleteAdd(void) {
+    char name[12];
+
+    /* First string goes to the end, unused memory is compacted from time to time */
+    strcpy(name, TM_STRING_GetString(Large, 0));
+    TM_STRING_DeleteString(Large, 0);
+    TM_STRING_AddString(Large, name);
+}
+
+static const TM_BENCH_Case_t StringCases[] = {
+    TM_BENCH_CASE("add_grow_free_32", CaseAddFree),
+    TM_BENCH_CASE_SETUP("replace_2x32", SetupTable, CaseReplace, 0),
+    TM_BENCH_CASE_SETUP("get_32", SetupTable, CaseGet, 0),
+    TM_BENCH_CASE_SETUP("add_grow_free_2048", SetupNames, CaseAddLarge, 0),
+    TM_BENCH_CASE_SETUP("find_32_of_2048", SetupLarge, CaseFind, 0),
+    TM_BENCH_CASE_SETUP("delete_add_2048", SetupLarge, CaseDeleteAdd, 0),
+};
+TM_BENCH_SUITE(BENCH_String, "string", NULL, StringCases);
+
+static uint8_t
+InitCRC(void) {
+    uint16_t i;
+
+#if TM_BENCH_HOST
+    /* CRC is calculated by hardware unit, there is nothing to measure on PC */
+    return 0;
+#endif
+
+    /* Random data */
+    for (i = 0; i < CRC_BYTES / 4; i++) {
+        Data[i] = i * 2654435761UL;
+    }
+
+    TM_CRC_Init();
+    return 1;
+}
+
+static void
+CaseCRC8(void) {
+    TM_BENCH_Use(TM_CRC_Calculate8((uint8_t *)Data, CRC_BYTES, 1));
+}
+
+static void
+CaseCRC32(void) {
+    TM_BENCH_Use(TM_CRC_Calculate32(Data, CRC_BYTES / 4, 1));
+}
+
+static const TM_BENCH_Case_t CRCCases[] = {
+    TM_BENCH_CASE_BYTES("calculate8_1k", CaseCRC8, CRC_BYTES),
+    TM_BENCH_CASE_BYTES("calculate32_1k", CaseCRC32, CRC_BYTES),
+};
+TM_BENCH_SUITE(BENCH_CRC, "crc", InitCRC, CRCCases);
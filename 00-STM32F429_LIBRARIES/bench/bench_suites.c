@@ -0,0 +1,32 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "bench_suites.h"
+
+const TM_BENCH_Suite_t* const BENCH_Suites[] = {
+    &BENCH_Buffer,
+    &BENCH_String,
+    &BENCH_Heap,
+    &BENCH_CRC,
+    &BENCH_Graphic,
+    &BENCH_FFT,
+    &BENCH_GPS,
+    &BENCH_FatFs,
+};
+
+const uint16_t BENCH_SuitesCount = sizeof(BENCH_Suites) / sizeof(BENCH_Suites[0]);
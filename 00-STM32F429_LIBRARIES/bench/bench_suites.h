@@ -0,0 +1,43 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * Benchmark suites for TM libraries, used by 64-STM32F429_BENCHMARK on board and host/bench_main.c on PC
+ *
+ * Graphic suite uses SDRAM as LCD frame buffer and FatFs suite formats SDRAM as RAM disk,
+ * so FatFs suite is the last one in the list.
+ */
+#ifndef BENCH_SUITES_H
+#define BENCH_SUITES_H
+
+#include "tm_stm32f4_bench.h"
+
+/* Suites */
+extern const TM_BENCH_Suite_t BENCH_Buffer;
+extern const TM_BENCH_Suite_t BENCH_String;
+extern const TM_BENCH_Suite_t BENCH_Heap;
+extern const TM_BENCH_Suite_t BENCH_CRC;
+extern const TM_BENCH_Suite_t BENCH_Graphic;
+extern const TM_BENCH_Suite_t BENCH_FFT;
+extern const TM_BENCH_Suite_t BENCH_GPS;
+extern const TM_BENCH_Suite_t BENCH_FatFs;
+
+/* All suites in order they are run */
+extern const TM_BENCH_Suite_t* const BENCH_Suites[];
+extern const uint16_t BENCH_SuitesCount;
+
+#endif
@@ -66,6 +66,7 @@ can be set here.
 #include "GUI_Private.h"
 #include "GUIDRV_Lin.h"
 #include "global_includes.h"
+#include "tm_stm32f4_dma2d_graphic.h"
 
 /* External variable, declared in tm_stm32f4_emwin.c file */
 extern uint32_t EMWIN_LCD_DRIVER_CB_CALLED;
@@ -96,7 +97,11 @@ extern uint32_t EMWIN_LCD_DRIVER_CB_CALLED;
 //
 // Buffers / VScreens
 //
+#ifdef EMWIN_NUM_BUFFERS
+#define NUM_BUFFERS  EMWIN_NUM_BUFFERS // Number of multiple buffers, set in defines.h
+#else
 #define NUM_BUFFERS  1 // Number of multiple buffers to be used
+#endif
 #define NUM_VSCREENS 1 // Number of virtual screens to be used
 
 //
@@ -266,7 +271,7 @@ static void _Color2IndexBulk_##PFIX##_DMA2D(LCD_COLOR * pColor, void * pIndex, U
   _DMA_Color2IndexBulk(pColor, pIndex, NumItems, SizeOfIndex, PIXELFORMAT);                                    \
 }                                                                                                              \
 static void _Index2ColorBulk_##PFIX##_DMA2D(void * pIndex, LCD_COLOR * pColor, U32 NumItems, U8 SizeOfIndex) { \
-  _DMA_Index2ColorBulk(pColor, pIndex, NumItems, SizeOfIndex, PIXELFORMAT);                                    \
+  _DMA_Index2ColorBulk(pIndex, pColor, NumItems, SizeOfIndex, PIXELFORMAT);                                    \
 }
 /*********************************************************************
 *
@@ -301,6 +306,11 @@ DEFINE_DMA2D_COLORCONVERSION(M4444I, LTDC_Pixelformat_ARGB4444)
 static U32 _aBuffer_DMA2D[XSIZE_PHYS * sizeof(U32)];
 static U32 _aBuffer_FG   [XSIZE_PHYS * sizeof(U32)];
 static U32 _aBuffer_BG   [XSIZE_PHYS * sizeof(U32)];
+
+//
+// Number of colors which fit into one DMA2D line buffer
+//
+#define BUFFER_ITEMS GUI_COUNTOF(_aBuffer_DMA2D)
 /*********************************************************************
 *
 *       Static data
@@ -442,53 +452,24 @@ static void _DMA_AlphaBlendingBulk(LCD_COLOR * pColorFG, LCD_COLOR * pColorBG, L
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
   //
-  // Set up mode
-  //
-  DMA2D->CR      = 0x00020000UL | (1 << 9);         // Control Register (Memory to memory with blending of FG and BG and TCIE)
-  //
-  // Set up pointers
-  //
-  DMA2D->FGMAR   = (U32)pColorFG;                   // Foreground Memory Address Register
-  DMA2D->BGMAR   = (U32)pColorBG;                   // Background Memory Address Register
-  DMA2D->OMAR    = (U32)pColorDst;                  // Output Memory Address Register (Destination address)
-  //
-  // Set up offsets
-  //
-  DMA2D->FGOR    = 0;                               // Foreground Offset Register
-  DMA2D->BGOR    = 0;                               // Background Offset Register
-  DMA2D->OOR     = 0;                               // Output Offset Register
+  // Blend with alpha values of both colors
   //
-  // Set up pixel format
-  //
-  DMA2D->FGPFCCR = LTDC_Pixelformat_ARGB8888;       // Foreground PFC Control Register (Defines the FG pixel format)
-  DMA2D->BGPFCCR = LTDC_Pixelformat_ARGB8888;       // Background PFC Control Register (Defines the BG pixel format)
-  DMA2D->OPFCCR  = LTDC_Pixelformat_ARGB8888;       // Output     PFC Control Register (Defines the output pixel format)
-  //
-  // Set up size
-  //
-  DMA2D->NLR     = (U32)(NumItems << 16) | 1;       // Number of Line Register (Size configuration of area to be transfered)
-  //
-  // Execute operation
-  //
-  
-  DMA2D->CR     |= 1;  
-    
-  while (DMA2D->CR & DMA2D_CR_START) {
-    __WFI();                                        // Sleep until next interrupt
-  }
+  TM_DMA2DGRAPHIC_Blend(pColorFG, CM_ARGB8888, pColorBG, CM_ARGB8888, pColorDst, CM_ARGB8888, NumItems, 1, 0, 0, 0, DMA2D_GRAPHIC_ALPHA_PIXEL);
 }
 
 /*********************************************************************
 *
-*       _DMA_MixColors
+*       _MixColors
 *
 * Purpose:
 *   Function for mixing up 2 colors with the given intensity.
 *   If the background color is completely transparent the
 *   foreground color should be used unchanged.
+*   Setting up DMA2D for a single pixel takes longer than mixing with CPU,
+*   so all 4 channels are mixed here, 2 channels with one multiplication.
 */
-static LCD_COLOR _DMA_MixColors(LCD_COLOR Color, LCD_COLOR BkColor, U8 Intens) {
-  U32 ColorFG, ColorBG, ColorDst;	
+static LCD_COLOR _MixColors(LCD_COLOR Color, LCD_COLOR BkColor, U8 Intens) {
+  U32 RB, AG;	
 	
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
@@ -496,46 +477,9 @@ static LCD_COLOR _DMA_MixColors(LCD_COLOR Color, LCD_COLOR BkColor, U8 Intens) {
   if ((BkColor & 0xFF000000) == 0xFF000000) {
     return Color;
   }
-  ColorFG = Color   ^ 0xFF000000;
-  ColorBG = BkColor ^ 0xFF000000;
-  //
-  // Set up mode
-  //
-  DMA2D->CR      = 0x00020000UL | (1 << 9);         // Control Register (Memory to memory with blending of FG and BG and TCIE)
-  //
-  // Set up pointers
-  //
-  DMA2D->FGMAR   = (U32)&ColorFG;                   // Foreground Memory Address Register
-  DMA2D->BGMAR   = (U32)&ColorBG;                   // Background Memory Address Register
-  DMA2D->OMAR    = (U32)&ColorDst;                  // Output Memory Address Register (Destination address)
-  //
-  // Set up pixel format
-  //
-  DMA2D->FGPFCCR = LTDC_Pixelformat_ARGB8888
-                 | (1UL << 16)
-                 | ((U32)Intens << 24);
-  DMA2D->BGPFCCR = LTDC_Pixelformat_ARGB8888
-                 | (0UL << 16)
-                 | ((U32)(255 - Intens) << 24);
-  DMA2D->OPFCCR  = LTDC_Pixelformat_ARGB8888;
-  //
-  // Set up size
-  //
-  DMA2D->NLR     = (U32)(1 << 16) | 1;              // Number of Line Register (Size configuration of area to be transfered)
-  //
-  // Execute operation
-  //
-
-  //_DMA_ExecOperation();
-  DMA2D->CR     |= 1;                               // Control Register (Start operation)
-  //
-  // Wait until transfer is done
-  //
-  while (DMA2D->CR & DMA2D_CR_START) {
-    __WFI();                                        // Sleep until next interrupt
-  }
-
-  return ColorDst ^ 0xFF000000;
+  RB = ((( Color        & 0x00FF00FF) * Intens + ( BkColor        & 0x00FF00FF) * (255 - Intens)) >> 8) & 0x00FF00FF;
+  AG = ((((Color >> 8)  & 0x00FF00FF) * Intens + ((BkColor >> 8)  & 0x00FF00FF) * (255 - Intens))     ) & 0xFF00FF00;
+  return RB | AG;
 }
 
 /*********************************************************************
@@ -545,37 +489,8 @@ static LCD_COLOR _DMA_MixColors(LCD_COLOR Color, LCD_COLOR BkColor, U8 Intens) {
 static void _DMA_ConvertColor(void * pSrc, void * pDst,  U32 PixelFormatSrc, U32 PixelFormatDst, U32 NumItems) {	
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
-  //
-  // Set up mode
-  //
-  DMA2D->CR      = 0x00010000UL | (1 << 9);         // Control Register (Memory to memory with pixel format conversion and TCIE)
-  //
-  // Set up pointers
-  //
-  DMA2D->FGMAR   = (U32)pSrc;                       // Foreground Memory Address Register (Source address)
-  DMA2D->OMAR    = (U32)pDst;                       // Output Memory Address Register (Destination address)
-  //
-  // Set up offsets
-  //
-  DMA2D->FGOR    = 0;                               // Foreground Offset Register (Source line offset)
-  DMA2D->OOR     = 0;                               // Output Offset Register (Destination line offset)
-  //
-  // Set up pixel format
-  //
-  DMA2D->FGPFCCR = PixelFormatSrc;                  // Foreground PFC Control Register (Defines the input pixel format)
-  DMA2D->OPFCCR  = PixelFormatDst;                  // Output PFC Control Register (Defines the output pixel format)
-  //
-  // Set up size
-  //
-  DMA2D->NLR     = (U32)(NumItems << 16) | 1;       // Number of Line Register (Size configuration of area to be transfered)
-  //
-  // Execute operation
-  //
-  DMA2D->CR     |= 1;  
-    
-  while (DMA2D->CR & DMA2D_CR_START) {
-    //__WFI();                                        // Sleep until next interrupt
-  }
+
+  TM_DMA2DGRAPHIC_Convert(pSrc, PixelFormatSrc, pDst, PixelFormatDst, NumItems, 1, 0, 0);
 }
 
 /*********************************************************************
@@ -641,63 +556,50 @@ static LCD_PIXELINDEX * _LCD_GetpPalConvTable(const LCD_LOGPALETTE GUI_UNI_PTR *
 /*********************************************************************
 *
 *       _DMA_MixColorsBulk
+*
+* Purpose:
+*   Mixes foreground with intensity over background. Background is used as opaque,
+*   so the result is a linear mix of both colors, like _MixColors() does.
 */
 static void _DMA_MixColorsBulk(LCD_COLOR * pColorFG, LCD_COLOR * pColorBG, LCD_COLOR * pColorDst, U8 Intens, U32 NumItems) {	
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
-  //
-  // Set up mode
-  //
-  DMA2D->CR      = 0x00020000UL | (1 << 9);         // Control Register (Memory to memory with blending of FG and BG and TCIE)
-  //
-  // Set up pointers
-  //
-  DMA2D->FGMAR   = (U32)pColorFG;                   // Foreground Memory Address Register
-  DMA2D->BGMAR   = (U32)pColorBG;                   // Background Memory Address Register
-  DMA2D->OMAR    = (U32)pColorDst;                  // Output Memory Address Register (Destination address)
-  //
-  // Set up pixel format
-  //
-  DMA2D->FGPFCCR = LTDC_Pixelformat_ARGB8888
-                 | (1UL << 16)
-                 | ((U32)Intens << 24);
-  DMA2D->BGPFCCR = LTDC_Pixelformat_ARGB8888
-                 | (0UL << 16)
-                 | ((U32)(255 - Intens) << 24);
-  DMA2D->OPFCCR  = LTDC_Pixelformat_ARGB8888;
-  //
-  // Set up size
-  //
-  DMA2D->NLR     = (U32)(NumItems << 16) | 1;              // Number of Line Register (Size configuration of area to be transfered)
-  //
-  // Execute operation
-  //
-  DMA2D->CR     |= 1;  
-    
-  while (DMA2D->CR & DMA2D_CR_START) {
-    //__WFI();                                        // Sleep until next interrupt
-  }
+
+  TM_DMA2DGRAPHIC_Blend(pColorFG, CM_ARGB8888, pColorBG, CM_ARGB8888, pColorDst, CM_ARGB8888, NumItems, 1, 0, 0, 0, Intens);
 }
+
 /*********************************************************************
 *
 *       _DMA_AlphaBlending
 */
 static void _DMA_AlphaBlending(LCD_COLOR * pColorFG, LCD_COLOR * pColorBG, LCD_COLOR * pColorDst, U32 NumItems) {	
+  U32 Num;
+
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
   //
-  // Invert alpha values
-  //
-  _InvertAlpha(pColorFG, _aBuffer_FG, NumItems);
-  _InvertAlpha(pColorBG, _aBuffer_BG, NumItems);
-  //
-  // Use DMA2D for mixing
+  // Process in parts which fit into line buffers
   //
-  _DMA_AlphaBlendingBulk(_aBuffer_FG, _aBuffer_BG, _aBuffer_DMA2D, NumItems);
-  //
-  // Invert alpha values
-  //
-  _InvertAlpha(_aBuffer_DMA2D, pColorDst, NumItems);
+  while (NumItems) {
+    Num = NumItems > BUFFER_ITEMS ? BUFFER_ITEMS : NumItems;
+    //
+    // Invert alpha values
+    //
+    _InvertAlpha(pColorFG, _aBuffer_FG, Num);
+    _InvertAlpha(pColorBG, _aBuffer_BG, Num);
+    //
+    // Use DMA2D for mixing
+    //
+    _DMA_AlphaBlendingBulk(_aBuffer_FG, _aBuffer_BG, _aBuffer_DMA2D, Num);
+    //
+    // Invert alpha values
+    //
+    _InvertAlpha(_aBuffer_DMA2D, pColorDst, Num);
+    pColorFG  += Num;
+    pColorBG  += Num;
+    pColorDst += Num;
+    NumItems  -= Num;
+  }
 }
 
 /*********************************************************************
@@ -711,16 +613,25 @@ static void _DMA_AlphaBlending(LCD_COLOR * pColorFG, LCD_COLOR * pColorBG, LCD_C
 *   transparent the color array needs to be converted after DMA2D has been used.
 */
 static void _DMA_Index2ColorBulk(void * pIndex, LCD_COLOR * pColor, U32 NumItems, U8 SizeOfIndex, U32 PixelFormat) {	
+  U32 Num;
+
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
-  //
-  // Use DMA2D for the conversion
-  //
-  _DMA_ConvertColor(pIndex, _aBuffer_DMA2D, PixelFormat, LTDC_Pixelformat_ARGB8888, NumItems);
-  //
-  // Convert colors from ARGB to ABGR and invert alpha values
-  //
-  _InvertAlpha_SwapRB(_aBuffer_DMA2D, pColor, NumItems);
+
+  while (NumItems) {
+    Num = NumItems > BUFFER_ITEMS ? BUFFER_ITEMS : NumItems;
+    //
+    // Use DMA2D for the conversion
+    //
+    _DMA_ConvertColor(pIndex, _aBuffer_DMA2D, PixelFormat, LTDC_Pixelformat_ARGB8888, Num);
+    //
+    // Convert colors from ARGB to ABGR and invert alpha values
+    //
+    _InvertAlpha_SwapRB(_aBuffer_DMA2D, pColor, Num);
+    pIndex    = (U8 *)pIndex + Num * SizeOfIndex;
+    pColor   += Num;
+    NumItems -= Num;
+  }
 }
 
 /*********************************************************************
@@ -734,16 +645,25 @@ static void _DMA_Index2ColorBulk(void * pIndex, LCD_COLOR * pColor, U32 NumItems
 *   transparent the given color array needs to be converted before DMA2D can be used.
 */
 static void _DMA_Color2IndexBulk(LCD_COLOR * pColor, void * pIndex, U32 NumItems, U8 SizeOfIndex, U32 PixelFormat) {	
+  U32 Num;
+
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
-  //
-  // Convert colors from ABGR to ARGB and invert alpha values
-  //
-  _InvertAlpha_SwapRB(pColor, _aBuffer_DMA2D, NumItems);
-  //
-  // Use DMA2D for the conversion
-  //
-  _DMA_ConvertColor(_aBuffer_DMA2D, pIndex, LTDC_Pixelformat_ARGB8888, PixelFormat, NumItems);
+
+  while (NumItems) {
+    Num = NumItems > BUFFER_ITEMS ? BUFFER_ITEMS : NumItems;
+    //
+    // Convert colors from ABGR to ARGB and invert alpha values
+    //
+    _InvertAlpha_SwapRB(pColor, _aBuffer_DMA2D, Num);
+    //
+    // Use DMA2D for the conversion
+    //
+    _DMA_ConvertColor(_aBuffer_DMA2D, pIndex, LTDC_Pixelformat_ARGB8888, PixelFormat, Num);
+    pIndex    = (U8 *)pIndex + Num * SizeOfIndex;
+    pColor   += Num;
+    NumItems -= Num;
+  }
 }
 
 /*********************************************************************
@@ -893,20 +813,7 @@ static void _DMA_Copy(int LayerIndex, void * pSrc, void * pDst, int xSize, int y
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
 
   PixelFormat = _GetPixelformat(LayerIndex);
-  DMA2D->CR      = 0x00000000UL | (1 << 9);         // Control Register (Memory to memory and TCIE)
-  DMA2D->FGMAR   = (U32)pSrc;                       // Foreground Memory Address Register (Source address)
-  DMA2D->OMAR    = (U32)pDst;                       // Output Memory Address Register (Destination address)
-  DMA2D->FGOR    = OffLineSrc;                      // Foreground Offset Register (Source line offset)
-  DMA2D->OOR     = OffLineDst;                      // Output Offset Register (Destination line offset)
-  DMA2D->FGPFCCR = PixelFormat;                     // Foreground PFC Control Register (Defines the input pixel format)
-  DMA2D->NLR     = (U32)(xSize << 16) | (U16)ySize; // Number of Line Register (Size configuration of area to be transfered)
-  DMA2D->CR     |= 1;                               // Start operation
-  //
-  // Wait until transfer is done
-  //
-  while (DMA2D->CR & DMA2D_CR_START) {
-    //__WFI();                                        // Sleep until next interrupt
-  }
+  TM_DMA2DGRAPHIC_Convert(pSrc, PixelFormat, pDst, PixelFormat, xSize, ySize, OffLineSrc, OffLineDst);
 }
 
 /*********************************************************************
@@ -965,8 +872,10 @@ static void _LCD_InitController(int LayerIndex) {
 
     //LCD_Init();
     //
-    // Enable line interrupt
+    // Enable line interrupt on line 0, which is in vertical synchronization period.
+    // Frame buffer address is changed there, so new buffer is shown from the beginning of the next frame
     //
+    LTDC_LIPConfig(0);
     LTDC_ITConfig(LTDC_IER_LIE, ENABLE);
     NVIC_SetPriority(LTDC_IRQn, 0);
     NVIC_EnableIRQ(LTDC_IRQn);
@@ -1073,41 +982,12 @@ static U32 _GetBufferSize(int LayerIndex) {
 static void _DMA_DrawBitmapL8(void * pSrc, void * pDst,  U32 OffSrc, U32 OffDst, U32 PixelFormatDst, U32 xSize, U32 ySize) {
   /* Function was called, EMWIN has do some job, update LCD when necessary */
   EMWIN_LCD_DRIVER_CB_CALLED = 1;
-	
-  //
-  // Set up mode
-  //
-  DMA2D->CR      = 0x00010000UL | (1 << 9);         // Control Register (Memory to memory with pixel format conversion and TCIE)
   //
-  // Set up pointers
+  // CLUT has been loaded before by _LCD_GetpPalConvTable()
   //
-  DMA2D->FGMAR   = (U32)pSrc;                       // Foreground Memory Address Register (Source address)
-  DMA2D->OMAR    = (U32)pDst;                       // Output Memory Address Register (Destination address)
-  //
-  // Set up offsets
-  //
-  DMA2D->FGOR    = OffSrc;                          // Foreground Offset Register (Source line offset)
-  DMA2D->OOR     = OffDst;                          // Output Offset Register (Destination line offset)
-  //
-  // Set up pixel format
-  //
-  DMA2D->FGPFCCR = LTDC_Pixelformat_L8;             // Foreground PFC Control Register (Defines the input pixel format)
-  DMA2D->OPFCCR  = PixelFormatDst;                  // Output PFC Control Register (Defines the output pixel format)
-  //
-  // Set up size
-  //
-  DMA2D->NLR     = (U32)(xSize << 16) | ySize;      // Number of Line Register (Size configuration of area to be transfered)
-  //
-  // Execute operation
-  //
-  DMA2D->CR     |= 1;                               // Start operation
-  //
-  // Wait until transfer is done
-  //
-  while (DMA2D->CR & DMA2D_CR_START) {
-    //__WFI();                                        // Sleep until next interrupt
-  }
+  TM_DMA2DGRAPHIC_Convert(pSrc, LTDC_Pixelformat_L8, pDst, PixelFormatDst, xSize, ySize, OffSrc, OffDst);
 }
+
 /*********************************************************************
 *
 *       _LCD_CopyBuffer
@@ -1122,6 +1002,10 @@ static void _LCD_CopyBuffer(int LayerIndex, int IndexSrc, int IndexDst) {
   AddrSrc    = _aAddr[LayerIndex] + BufferSize * IndexSrc;
   AddrDst    = _aAddr[LayerIndex] + BufferSize * IndexDst;
   _DMA_Copy(LayerIndex, (void *)AddrSrc, (void *)AddrDst, _axSize[LayerIndex], _aySize[LayerIndex], 0, 0);
+  //
+  // After this function has been called all drawing operations are routed to Buffer[IndexDst]
+  //
+  _aBufferIndex[LayerIndex] = IndexDst;
 }
 
 /*********************************************************************
@@ -1177,11 +1061,35 @@ static void _LCD_DrawBitmap16bpp(int LayerIndex, int x, int y, U16 const * p, in
 
   BufferSize = _GetBufferSize(LayerIndex);
   AddrDst = _aAddr[LayerIndex] + BufferSize * _aBufferIndex[LayerIndex] + (y * _axSize[LayerIndex] + x) * _aBytesPerPixels[LayerIndex];
-  OffLineSrc = 240/*(BytesPerLine / 2)*/ - xSize;
+  OffLineSrc = (BytesPerLine / 2) - xSize;
   OffLineDst = _axSize[LayerIndex] - xSize;
   _DMA_Copy(LayerIndex, (void *)p, (void *)AddrDst, xSize, ySize, OffLineSrc, OffLineDst);
 }
 
+#ifdef LCD_DEVFUNC_DRAWBMP_32BPP
+/*********************************************************************
+*
+*       _LCD_DrawBitmap32bpp
+*
+* Purpose:
+*   Draws 32bpp ARGB bitmap with alpha values over layer content.
+*   DMA2D blends bitmap with framebuffer and converts it to layer pixel format at once.
+*/
+static void _LCD_DrawBitmap32bpp(int LayerIndex, int x, int y, U32 const * p, int xSize, int ySize, int BytesPerLine) {
+  U32 BufferSize, AddrDst, PixelFormat;
+  int OffLineSrc, OffLineDst;
+		
+  /* Function was called, EMWIN has do some job, update LCD when necessary */
+  EMWIN_LCD_DRIVER_CB_CALLED = 1;
+
+  BufferSize = _GetBufferSize(LayerIndex);
+  AddrDst = _aAddr[LayerIndex] + BufferSize * _aBufferIndex[LayerIndex] + (y * _axSize[LayerIndex] + x) * _aBytesPerPixels[LayerIndex];
+  OffLineSrc = (BytesPerLine / 4) - xSize;
+  OffLineDst = _axSize[LayerIndex] - xSize;
+  PixelFormat = _GetPixelformat(LayerIndex);
+  TM_DMA2DGRAPHIC_Blend(p, CM_ARGB8888, (void *)AddrDst, PixelFormat, (void *)AddrDst, PixelFormat, xSize, ySize, OffLineSrc, OffLineDst, OffLineDst, DMA2D_GRAPHIC_ALPHA_PIXEL);
+}
+#endif
 
 /*********************************************************************
 *
@@ -1251,7 +1159,6 @@ void LTDC_ISR_Handler(void) {
       //
       // Clear pending buffer flag of layer
       //
-      _aBufferIndex[i] = _aPendingBuffer[i];
       _aPendingBuffer[i] = -1;
     }
   }
@@ -1482,6 +1389,15 @@ void LCD_X_Config(void) {
     if (_GetPixelformat(i) == LTDC_Pixelformat_RGB565) {
       LCD_SetDevFunc(i, LCD_DEVFUNC_DRAWBMP_16BPP, (void(*)(void))_LCD_DrawBitmap16bpp);     // Set up drawing routine for 16bpp bitmap using DMA2D. Makes only sense with RGB565
     }
+#ifdef LCD_DEVFUNC_DRAWBMP_32BPP
+    //
+    // Set up drawing routine for 32bpp bitmap with alpha using DMA2D blending, works for all direct color modes.
+    // Device function is available since emWin V5.24, headers of older versions don't have it
+    //
+    if (_GetPixelformat(i) <= LTDC_Pixelformat_ARGB4444) {
+      LCD_SetDevFunc(i, LCD_DEVFUNC_DRAWBMP_32BPP, (void(*)(void))_LCD_DrawBitmap32bpp);
+    }
+#endif
     
   //
   // Set up custom color conversion using DMA2D, works only for direct color modes because of missing LUT for DMA2D destination
@@ -1503,9 +1419,9 @@ void LCD_X_Config(void) {
   //
   GUI_SetFuncGetpPalConvTable(_LCD_GetpPalConvTable);
   //
-  // Set up a custom function for mixing up single colors using DMA2D
+  // Set up a custom function for mixing up single colors
   //
-  GUI_SetFuncMixColors(_DMA_MixColors);
+  GUI_SetFuncMixColors(_MixColors);
   //
   // Set up a custom function for mixing up arrays of colors using DMA2D
   //
@@ -267,6 +267,9 @@ static volatile DSTATUS TM_FATFS_SD_SDIO_Stat = STA_NOINIT;	/* Physical drive st
 
 #define BLOCK_SIZE            512
 
+/* Buffer in SRAM for unaligned buffers and buffers in CCM RAM, which DMA can't access */
+static DWORD scratch[BLOCK_SIZE / 4];
+
 uint8_t TM_FATFS_SDIO_WriteEnabled(void) {
 #if FATFS_USE_WRITEPROTECT_PIN > 0
 	return !TM_GPIO_GetInputPinValue(FATFS_USE_WRITEPROTECT_PIN_PORT, FATFS_USE_WRITEPROTECT_PIN_PIN);
@@ -339,9 +342,8 @@ DRESULT TM_FATFS_SD_SDIO_disk_read(BYTE *buff, DWORD sector, UINT count) {
 		return RES_NOTRDY;
 	}
 	
-	if ((DWORD)buff & 3) {
+	if (((DWORD)buff & 3) || TM_IS_CCM(buff)) {
 		DRESULT res = RES_OK;
-		DWORD scratch[BLOCK_SIZE / 4];
 
 		while (count--) {
 			res = TM_FATFS_SD_SDIO_disk_read((void *)scratch, sector++, 1);
@@ -388,9 +390,8 @@ DRESULT TM_FATFS_SD_SDIO_disk_write(const BYTE *buff, DWORD sector, UINT count)
 		return RES_NOTRDY;
 	}
 
-	if ((DWORD)buff & 3) {
+	if (((DWORD)buff & 3) || TM_IS_CCM(buff)) {
 		DRESULT res = RES_OK;
-		DWORD scratch[BLOCK_SIZE / 4];
 
 		while (count--) {
 			memcpy(scratch, buff, BLOCK_SIZE);
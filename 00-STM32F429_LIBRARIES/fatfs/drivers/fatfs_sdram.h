@@ -64,6 +64,7 @@ extern C {
 #include "stm32f4xx.h"
 #include "defines.h"
 #include "tm_stm32f4_sdram.h"
+#include "string.h"
 
 /* FATFS functions */
 #include "diskio.h"
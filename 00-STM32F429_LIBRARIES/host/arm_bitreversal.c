@@ -0,0 +1,43 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * C version of arm_bitreversal_32 for PC build of CMSIS DSP complex FFT,
+ * CMSIS has this function only in ARM assembler file arm_bitreversal2.S
+ */
+#include <stdint.h>
+
+void
+arm_bitreversal_32(uint32_t* pSrc, const uint16_t bitRevLen, const uint16_t* pBitRevTable) {
+    uint32_t i, a, b, tmp;
+
+    /* Table has pairs of byte offsets for complex values to swap */
+    for (i = 0; i < ((uint32_t)bitRevLen + 1) / 2; i++) {
+        a = pBitRevTable[2 * i] >> 2;
+        b = pBitRevTable[2 * i + 1] >> 2;
+
+        /* Real part */
+        tmp = pSrc[a];
+        pSrc[a] = pSrc[b];
+        pSrc[b] = tmp;
+
+        /* Imaginary part */
+        tmp = pSrc[a + 1];
+        pSrc[a + 1] = pSrc[b + 1];
+        pSrc[b + 1] = tmp;
+    }
+}
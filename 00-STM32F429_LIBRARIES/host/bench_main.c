@@ -0,0 +1,59 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * Runs TM BENCH suites from bench/ folder on PC
+ *
+ * Usage: bench [-f filter]
+ *
+ *  -f: Run only cases which contain filter text in "suite,case" name, for example "fft," or ",read_4k"
+ *
+ * Results are printed to standard output as CSV, same format as on STM32F4xx.
+ */
+#include "tm_host_sim.h"
+#include "bench_suites.h"
+#include <unistd.h>
+
+static void
+Output(const char* str) {
+    fputs(str, stdout);
+    fflush(stdout);
+}
+
+int
+main(int argc, char** argv) {
+    const char* filter = NULL;
+    int opt;
+
+    /* Parse arguments */
+    while ((opt = getopt(argc, argv, "f:")) != -1) {
+        if (opt == 'f') {
+            filter = optarg;
+        } else {
+            fprintf(stderr, "Usage: %s [-f filter]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    /* Memory map must be ready before any library call */
+    if (!TM_SIM_Init()) {
+        return 2;
+    }
+
+    TM_BENCH_Init();
+    return TM_BENCH_Run(BENCH_Suites, BENCH_SuitesCount, filter, Output) ? 0 : 1;
+}
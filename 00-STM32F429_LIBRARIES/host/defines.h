@@ -0,0 +1,60 @@
+/**
+ *  Defines for host simulator build
+ *
+ *  @author     Tilen MAJERLE
+ *  @email      tilen@majerle.eu
+ *  @website    http://stm32f4-discovery.net
+ *  @version    v1.0
+ *  @ide        GCC, Linux
+ *  @license    GNU GPL v3
+ *
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#ifndef TM_DEFINES_H
+#define TM_DEFINES_H
+
+/* Put your global defines for all libraries here used in your project */
+
+/* DMA2D transfers are done in software by simulator, when library waits for them */
+#include <stdint.h>
+uint8_t TM_SIM_DMA2D_Working(void);
+#define DMA2D_WORKING           TM_SIM_DMA2D_Working()
+
+/* TM LCD library has LTDC timings for 640x480 LCD on STM32439-Eval board */
+#define USE_LCD_STM324x9_EVAL
+
+/* Image decoder reads from memory on PC, FatFs is not used */
+#define TM_IMAGE_USE_FATFS      0
+
+/* Benchmark measures time with clock_gettime */
+#define TM_BENCH_HOST           1
+
+/* Interrupts can't be disabled on PC */
+#define TM_HEAP_IRQ_SAFE        0
+#define TM_POOL_IRQ_SAFE        0
+
+/* Benchmark measures string table with hash index */
+#define TM_STRING_USE_HASH      1
+
+/* Benchmark puts whole block of GPS sentences to USART1 buffer */
+#define TM_USART1_BUFFER_SIZE   1024
+
+/* Benchmark uses FatFs on RAM disk in simulated SDRAM */
+#define FATFS_USE_SDRAM         1
+
+#endif
@@ -0,0 +1,410 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * Graphic benchmark and golden image test for display libraries on PC
+ *
+ * Usage: graphic_benchmark [-n iterations] [-o output_dir] [-g golden_dir]
+ *
+ *  -n: Number of calls for each primitive, default 1000. Use 0 to skip benchmark
+ *  -o: Directory where rendered scenes are saved as PPM files, default current directory
+ *  -g: Directory with golden PPM files. Rendered scenes are compared with them
+ *      and program returns 1 if any pixel is different
+ *
+ * Benchmark reports for each primitive:
+ *  - prim/s: Primitives per second on PC, time spent in DMA2D software model is not included
+ *  - xfer/prim: Number of DMA2D transfers per primitive
+ *  - px/prim: Number of pixels written by DMA2D per primitive
+ *  - bytes/prim: Number of bytes DMA2D read and wrote per primitive
+ */
+#include "tm_host_sim.h"
+#include "tm_stm32f4_ili9341_ltdc.h"
+#include "tm_stm32f4_dma2d_graphic.h"
+#include "tm_stm32f4_lcd.h"
+#include "tm_stm32f4_fonts.h"
+#include "tm_stm32f4_scanline.h"
+#include "tm_stm32f4_sprite.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Benchmark entry */
+typedef struct {
+    const char* Name;
+    void (*Func)(void);
+} Benchmark_t;
+
+/* Scene for golden image */
+typedef struct {
+    const char* Name;
+    void (*Draw)(void);
+} Scene_t;
+
+/* Font atlases and copy source must be below 4GB for DMA2D, so they are global */
+static uint8_t AtlasBuffer[16 * 26 * TM_FONTS_CHARACTERS];
+static TM_FONTS_Atlas_t Atlas;
+static uint16_t Sprite[64 * 64];
+static uint32_t SpriteARGB[32 * 32];
+static uint32_t SpriteSave[2][32 * 32];
+static TM_SPRITE_t Sprites[2] = {
+    {SpriteARGB, SpriteSave[0], CM_ARGB8888, 32, 32},
+    {SpriteARGB, SpriteSave[1], CM_ARGB8888, 32, 32},
+};
+
+/* Random generator with fixed seed, so each run draws the same */
+static uint32_t Seed;
+
+static uint32_t
+Random(uint32_t max) {
+    Seed = Seed * 1664525UL + 1013904223UL;
+    return (Seed >> 8) % max;
+}
+
+#define RX()        Random(240)
+#define RY()        Random(320)
+#define RC()        Random(0x10000)
+
+/* DMA2D GRAPHIC primitives */
+static void Bench_DMA2D_Fill(void) { TM_DMA2DGRAPHIC_Fill(RC()); }
+static void Bench_DMA2D_Pixel(void) { TM_DMA2DGRAPHIC_DrawPixel(RX(), RY(), RC()); }
+static void Bench_DMA2D_Line(void) { TM_DMA2DGRAPHIC_DrawLine(RX(), RY(), RX(), RY(), RC()); }
+static void Bench_DMA2D_HLine(void) { TM_DMA2DGRAPHIC_DrawHorizontalLine(Random(120), RY(), 1 + Random(120), RC()); }
+static void Bench_DMA2D_VLine(void) { TM_DMA2DGRAPHIC_DrawVerticalLine(RX(), Random(160), 1 + Random(160), RC()); }
+static void Bench_DMA2D_Rect(void) { TM_DMA2DGRAPHIC_DrawRectangle(Random(120), Random(160), 1 + Random(120), 1 + Random(160), RC()); }
+static void Bench_DMA2D_FillRect(void) { TM_DMA2DGRAPHIC_DrawFilledRectangle(Random(120), Random(160), 1 + Random(120), 1 + Random(160), RC()); }
+static void Bench_DMA2D_FillRoundRect(void) { TM_DMA2DGRAPHIC_DrawFilledRoundedRectangle(Random(120), Random(160), 20 + Random(100), 20 + Random(140), Random(10), RC()); }
+static void Bench_DMA2D_Circle(void) { TM_DMA2DGRAPHIC_DrawCircle(RX(), RY(), Random(60), RC()); }
+static void Bench_DMA2D_FillCircle(void) { TM_DMA2DGRAPHIC_DrawFilledCircle(RX(), RY(), Random(60), RC()); }
+static void Bench_DMA2D_FillTriangle(void) { TM_DMA2DGRAPHIC_DrawFilledTriangle(RX(), RY(), RX(), RY(), RX(), RY(), RC()); }
+static void Bench_DMA2D_Copy(void) { TM_DMA2DGRAPHIC_CopyBuffer(Sprite, (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + Random(176) + 240 * Random(256), 64, 64, 0, 240 - 64); }
+
+static void
+Bench_DMA2D_BlendA8(void) {
+    TM_DMA2DGRAPHIC_BlendA8(TM_FONTS_GetAtlasChar(&Atlas, 'A' + Random(26)), (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + Random(229) + 240 * Random(302), 11, 18, 0, 240 - 11, RC(), DMA2D_GRAPHIC_TRANSPARENT);
+}
+
+static void
+Bench_DMA2D_Blend(void) {
+    uint16_t* pDst = (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + Random(208) + 240 * Random(288);
+    TM_DMA2DGRAPHIC_Blend(SpriteARGB, CM_ARGB8888, pDst, CM_RGB565, pDst, CM_RGB565, 32, 32, 0, 240 - 32, 240 - 32, DMA2D_GRAPHIC_ALPHA_PIXEL);
+}
+
+static void
+Bench_DMA2D_Convert(void) {
+    TM_DMA2DGRAPHIC_Convert(SpriteARGB, CM_ARGB8888, (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + Random(208) + 240 * Random(288), CM_RGB565, 32, 32, 0, 240 - 32);
+}
+
+/* Sprite compositor */
+static void Bench_Sprite_Move(void) { TM_SPRITE_Move(&Sprites[0], Random(240) - 16, Random(320) - 16); }
+static void Bench_Sprite_Overlay(void) { TM_SPRITE_SetOverlayPosition(Random(40) - 20, Random(40) - 20); }
+
+/* Scanline shapes on DMA2D GRAPHIC */
+static void
+Bench_Scanline_Polygon(void) {
+    TM_SCANLINE_Point_t Points[6];
+    uint8_t i;
+    for (i = 0; i < 6; i++) {
+        Points[i].X = RX();
+        Points[i].Y = RY();
+    }
+    TM_SCANLINE_FillPolygon(TM_DMA2DGRAPHIC_GetScanline(), Points, 6, RC());
+}
+static void Bench_Scanline_Ellipse(void) { TM_SCANLINE_FillEllipse(TM_DMA2DGRAPHIC_GetScanline(), RX(), RY(), Random(80), Random(80), RC()); }
+static void Bench_Scanline_Arc(void) { TM_SCANLINE_FillArc(TM_DMA2DGRAPHIC_GetScanline(), RX(), RY(), Random(30), 30 + Random(50), Random(360), Random(360), RC()); }
+
+/* ILI9341 LTDC primitives */
+static void Bench_ILI9341_Fill(void) { TM_ILI9341_Fill(RC()); }
+static void Bench_ILI9341_Pixel(void) { TM_ILI9341_DrawPixel(RX(), RY(), RC()); }
+static void Bench_ILI9341_Line(void) { TM_ILI9341_DrawLine(RX(), RY(), RX(), RY(), RC()); }
+static void Bench_ILI9341_FillRect(void) { TM_ILI9341_DrawFilledRectangle(Random(120), Random(160), 120 + Random(120), 160 + Random(160), RC()); }
+static void Bench_ILI9341_FillRoundRect(void) { TM_ILI9341_DrawFilledRoundedRectangle(Random(120), Random(160), 120 + Random(120), 160 + Random(160), Random(20), RC()); }
+static void Bench_ILI9341_Circle(void) { TM_ILI9341_DrawCircle(RX(), RY(), Random(60), RC()); }
+static void Bench_ILI9341_FillCircle(void) { TM_ILI9341_DrawFilledCircle(RX(), RY(), Random(60), RC()); }
+static void Bench_ILI9341_Puts(void) { TM_ILI9341_SetFontAtlas(NULL); TM_ILI9341_Puts(Random(100), RY(), "Benchmark", &TM_Font_11x18, RC(), RC()); }
+static void Bench_ILI9341_PutsAtlas(void) { TM_ILI9341_SetFontAtlas(&Atlas); TM_ILI9341_Puts(Random(100), RY(), "Benchmark", &TM_Font_11x18, RC(), RC()); }
+
+/* LCD primitives */
+static void Bench_LCD_Fill(void) { TM_LCD_Fill(RC()); }
+static void Bench_LCD_FillRect(void) { TM_LCD_DrawFilledRectangle(Random(120), Random(160), 1 + Random(120), 1 + Random(160), RC()); }
+static void Bench_LCD_FillCircle(void) { TM_LCD_DrawFilledCircle(RX(), RY(), Random(60), RC()); }
+static void Bench_LCD_Puts(void) { TM_LCD_SetFontAtlas(NULL); TM_LCD_SetXY(Random(100), RY()); TM_LCD_Puts("Benchmark"); }
+static void Bench_LCD_PutsAtlas(void) { TM_LCD_SetFontAtlas(&Atlas); TM_LCD_SetXY(Random(100), RY()); TM_LCD_Puts("Benchmark"); }
+
+static const Benchmark_t DMA2D_Benchmarks[] = {
+    {"DMA2D Fill", Bench_DMA2D_Fill},
+    {"DMA2D DrawPixel", Bench_DMA2D_Pixel},
+    {"DMA2D DrawLine", Bench_DMA2D_Line},
+    {"DMA2D DrawHorizontalLine", Bench_DMA2D_HLine},
+    {"DMA2D DrawVerticalLine", Bench_DMA2D_VLine},
+    {"DMA2D DrawRectangle", Bench_DMA2D_Rect},
+    {"DMA2D DrawFilledRectangle", Bench_DMA2D_FillRect},
+    {"DMA2D DrawFilledRoundedRect", Bench_DMA2D_FillRoundRect},
+    {"DMA2D DrawCircle", Bench_DMA2D_Circle},
+    {"DMA2D DrawFilledCircle", Bench_DMA2D_FillCircle},
+    {"DMA2D DrawFilledTriangle", Bench_DMA2D_FillTriangle},
+    {"DMA2D CopyBuffer 64x64", Bench_DMA2D_Copy},
+    {"DMA2D BlendA8 11x18", Bench_DMA2D_BlendA8},
+    {"DMA2D Blend ARGB8888 32x32", Bench_DMA2D_Blend},
+    {"DMA2D Convert ARGB8888 32x32", Bench_DMA2D_Convert},
+    {"SPRITE Move 32x32", Bench_Sprite_Move},
+    {"SPRITE SetOverlayPosition", Bench_Sprite_Overlay},
+    {"SCANLINE FillPolygon 6", Bench_Scanline_Polygon},
+    {"SCANLINE FillEllipse", Bench_Scanline_Ellipse},
+    {"SCANLINE FillArc", Bench_Scanline_Arc},
+    {NULL, NULL}
+};
+
+static const Benchmark_t ILI9341_Benchmarks[] = {
+    {"ILI9341 Fill", Bench_ILI9341_Fill},
+    {"ILI9341 DrawPixel", Bench_ILI9341_Pixel},
+    {"ILI9341 DrawLine", Bench_ILI9341_Line},
+    {"ILI9341 DrawFilledRectangle", Bench_ILI9341_FillRect},
+    {"ILI9341 DrawFilledRoundedRect", Bench_ILI9341_FillRoundRect},
+    {"ILI9341 DrawCircle", Bench_ILI9341_Circle},
+    {"ILI9341 DrawFilledCircle", Bench_ILI9341_FillCircle},
+    {"ILI9341 Puts 9 chars", Bench_ILI9341_Puts},
+    {"ILI9341 Puts 9 chars, atlas", Bench_ILI9341_PutsAtlas},
+    {NULL, NULL}
+};
+
+static const Benchmark_t LCD_Benchmarks[] = {
+    {"LCD Fill", Bench_LCD_Fill},
+    {"LCD DrawFilledRectangle", Bench_LCD_FillRect},
+    {"LCD DrawFilledCircle", Bench_LCD_FillCircle},
+    {"LCD Puts 9 chars", Bench_LCD_Puts},
+    {"LCD Puts 9 chars, atlas", Bench_LCD_PutsAtlas},
+    {NULL, NULL}
+};
+
+static void
+Scene_ILI9341(void) {
+    TM_ILI9341_Rotate(TM_ILI9341_Orientation_Portrait_2);
+    TM_ILI9341_Fill(ILI9341_COLOR_WHITE);
+    TM_ILI9341_DrawFilledRectangle(10, 10, 120, 60, ILI9341_COLOR_BLUE);
+    TM_ILI9341_DrawRectangle(5, 5, 125, 65, ILI9341_COLOR_BLACK);
+    TM_ILI9341_DrawFilledRoundedRectangle(130, 10, 230, 60, 12, ILI9341_COLOR_GREEN);
+    TM_ILI9341_DrawRoundedRectangle(128, 8, 232, 62, 14, ILI9341_COLOR_BLACK);
+    TM_ILI9341_DrawFilledCircle(60, 120, 40, ILI9341_COLOR_RED);
+    TM_ILI9341_DrawCircle(60, 120, 45, ILI9341_COLOR_BLACK);
+    TM_ILI9341_DrawLine(120, 80, 230, 170, ILI9341_COLOR_MAGENTA);
+    TM_ILI9341_DrawLine(230, 80, 120, 170, ILI9341_COLOR_CYAN);
+    TM_ILI9341_SetFontAtlas(NULL);
+    TM_ILI9341_Puts(10, 180, "Font 11x18", &TM_Font_11x18, ILI9341_COLOR_BLACK, ILI9341_COLOR_YELLOW);
+    TM_ILI9341_SetFontAtlas(&Atlas);
+    TM_ILI9341_Puts(10, 205, "Atlas 11x18", &TM_Font_11x18, ILI9341_COLOR_BLACK, ILI9341_TRANSPARENT);
+    TM_ILI9341_Puts(10, 230, "Atlas on color", &TM_Font_11x18, ILI9341_COLOR_WHITE, ILI9341_COLOR_BLUE);
+    TM_ILI9341_SetFontAtlas(NULL);
+    TM_ILI9341_Rotate(TM_ILI9341_Orientation_Landscape_1);
+    TM_ILI9341_Puts(5, 5, "Landscape", &TM_Font_7x10, ILI9341_COLOR_BLACK, ILI9341_COLOR_WHITE);
+    TM_ILI9341_Rotate(TM_ILI9341_Orientation_Portrait_2);
+}
+
+static void
+Scene_DMA2D(void) {
+    TM_SCANLINE_Point_t Star[] = {{120, 190}, {135, 235}, {180, 235}, {145, 262}, {158, 305}, {120, 280}, {82, 305}, {95, 262}, {60, 235}, {105, 235}};
+    uint16_t i;
+
+    TM_DMA2DGRAPHIC_SetLayer(1);
+    TM_DMA2DGRAPHIC_SetOrientation(1);
+    TM_DMA2DGRAPHIC_Fill(GRAPHIC_COLOR_GRAY);
+    TM_DMA2DGRAPHIC_DrawFilledRectangle(10, 10, 100, 50, GRAPHIC_COLOR_BLUE);
+    TM_DMA2DGRAPHIC_DrawRectangle(8, 8, 104, 54, GRAPHIC_COLOR_WHITE);
+    TM_DMA2DGRAPHIC_DrawFilledRoundedRectangle(120, 10, 110, 50, 10, GRAPHIC_COLOR_ORANGE);
+    TM_DMA2DGRAPHIC_DrawRoundedRectangle(118, 8, 114, 54, 12, GRAPHIC_COLOR_WHITE);
+    TM_DMA2DGRAPHIC_DrawFilledCircle(50, 110, 35, GRAPHIC_COLOR_RED);
+    TM_DMA2DGRAPHIC_DrawCircle(50, 110, 40, GRAPHIC_COLOR_WHITE);
+    TM_DMA2DGRAPHIC_DrawFilledTriangle(110, 150, 170, 75, 230, 150, GRAPHIC_COLOR_GREEN);
+    TM_DMA2DGRAPHIC_DrawTriangle(110, 150, 170, 75, 230, 150, GRAPHIC_COLOR_BLACK);
+    TM_SCANLINE_FillPolygon(TM_DMA2DGRAPHIC_GetScanline(), Star, sizeof(Star) / sizeof(Star[0]), GRAPHIC_COLOR_YELLOW);
+    TM_SCANLINE_FillEllipse(TM_DMA2DGRAPHIC_GetScanline(), 40, 200, 30, 15, GRAPHIC_COLOR_CYAN);
+    TM_SCANLINE_FillArc(TM_DMA2DGRAPHIC_GetScanline(), 200, 200, 15, 30, 30, 300, GRAPHIC_COLOR_MAGENTA);
+
+    /* Sprite copied with DMA2D */
+    for (i = 0; i < 64 * 64; i++) {
+        Sprite[i] = ((i % 64) / 8 + (i / 64) / 8) & 1 ? GRAPHIC_COLOR_BLACK : GRAPHIC_COLOR_WHITE;
+    }
+    TM_DMA2DGRAPHIC_CopyBuffer(Sprite, (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + 10 + 240 * 245, 64, 64, 0, 240 - 64);
+
+    /* ARGB8888 sprite with alpha blended over copied sprite */
+    TM_DMA2DGRAPHIC_Blend(SpriteARGB, CM_ARGB8888, (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + 26 + 240 * 261, CM_RGB565,
+        (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + 26 + 240 * 261, CM_RGB565, 32, 32, 0, 240 - 32, 240 - 32, DMA2D_GRAPHIC_ALPHA_PIXEL);
+
+    /* Text from atlas, blended over background */
+    for (i = 0; i < 5; i++) {
+        TM_DMA2DGRAPHIC_BlendA8(TM_FONTS_GetAtlasChar(&Atlas, "DMA2D"[i]), (uint16_t *)DMA2D_GRAPHIC_RAM_ADDR + 160 + 11 * i + 240 * 290, 11, 18, 0, 240 - 11, GRAPHIC_COLOR_BLACK, DMA2D_GRAPHIC_TRANSPARENT);
+    }
+}
+
+static void
+Scene_Sprite(void) {
+    /* Background on layer 1, sprites on overlay layer 2 */
+    TM_ILI9341_SetLayer1();
+    TM_ILI9341_Fill(ILI9341_COLOR_BLUE);
+    TM_ILI9341_DrawFilledRectangle(0, 160, 239, 319, ILI9341_COLOR_YELLOW);
+    TM_SPRITE_Init();
+    TM_SPRITE_Show(&Sprites[0], 20, 20);
+    TM_SPRITE_Show(&Sprites[1], 40, 30);
+    TM_SPRITE_Move(&Sprites[1], 100, 150);
+    TM_SPRITE_Move(&Sprites[0], 220, 300);
+    TM_SPRITE_SetOverlayPosition(-10, 5);
+}
+
+static void
+Scene_LCD(void) {
+    TM_LCD_SetLayer1();
+    TM_LCD_Fill(0xFFFF);
+    TM_LCD_DrawFilledRectangle(10, 10, 100, 50, 0x001F);
+    TM_LCD_DrawRectangle(8, 8, 104, 54, 0x0000);
+    TM_LCD_DrawFilledRoundedRectangle(120, 10, 110, 50, 10, 0x07E0);
+    TM_LCD_DrawFilledCircle(60, 120, 40, 0xF800);
+    TM_LCD_DrawCircle(60, 120, 45, 0x0000);
+    TM_LCD_DrawLine(120, 80, 230, 170, 0xF81F);
+    TM_LCD_SetFontAtlas(NULL);
+    TM_LCD_SetColors(0x0000, 0xFFE0);
+    TM_LCD_SetXY(10, 180);
+    TM_LCD_Puts("TM LCD");
+    TM_LCD_SetFontAtlas(&Atlas);
+    TM_LCD_SetXY(10, 205);
+    TM_LCD_Puts("TM LCD atlas");
+}
+
+/* Output settings */
+static const char* OutputDir = ".";
+static const char* GoldenDir = NULL;
+static uint32_t Iterations = 1000;
+static uint32_t Failed = 0;
+
+static void
+RunBenchmarks(const Benchmark_t* Bench) {
+    TM_SIM_Stats_t stats;
+    uint64_t start, time;
+    uint32_t i;
+
+    for (; Bench->Name != NULL && Iterations; Bench++) {
+        /* Same random values on every run */
+        Seed = 1;
+        TM_SIM_ResetStats();
+
+        start = TM_SIM_GetTime();
+        for (i = 0; i < Iterations; i++) {
+            Bench->Func();
+        }
+        TM_SIM_DMA2D_Working();
+        time = TM_SIM_GetTime() - start;
+        TM_SIM_GetStats(&stats);
+
+        /* Time in DMA2D model is not part of library code */
+        time = time > stats.ModelTime ? time - stats.ModelTime : 1;
+
+        printf("%-32s %12.0f %10.2f %10.0f %12.0f\n",
+            Bench->Name,
+            (double)Iterations * 1e9 / (double)time,
+            (double)stats.Transfers / Iterations,
+            (double)stats.Pixels / Iterations,
+            (double)(stats.BytesRead + stats.BytesWritten) / Iterations
+        );
+    }
+}
+
+static void
+RunScene(const Scene_t* Scene) {
+    char file[512], golden[512];
+    int32_t diff;
+
+    /* Draw and save scene */
+    Scene->Draw();
+    snprintf(file, sizeof(file), "%s/%s.ppm", OutputDir, Scene->Name);
+    if (!TM_SIM_SaveLTDC(file)) {
+        printf("Scene %s: can't save %s\n", Scene->Name, file);
+        Failed++;
+        return;
+    }
+
+    /* Compare with golden image */
+    if (GoldenDir != NULL) {
+        snprintf(golden, sizeof(golden), "%s/%s.ppm", GoldenDir, Scene->Name);
+        diff = TM_SIM_ComparePPM(file, golden);
+        if (diff) {
+            printf("Scene %s: %s differs from %s (%d pixels)\n", Scene->Name, file, golden, (int)diff);
+            Failed++;
+        } else {
+            printf("Scene %s: OK\n", Scene->Name);
+        }
+    }
+}
+
+int
+main(int argc, char** argv) {
+    const Scene_t SceneILI9341 = {"ili9341_ltdc", Scene_ILI9341};
+    const Scene_t SceneDMA2D = {"dma2d_graphic", Scene_DMA2D};
+    const Scene_t SceneLCD = {"lcd", Scene_LCD};
+    const Scene_t SceneSprite = {"sprite", Scene_Sprite};
+    int opt;
+
+    /* Parse arguments */
+    while ((opt = getopt(argc, argv, "n:o:g:")) != -1) {
+        if (opt == 'n') {
+            Iterations = strtoul(optarg, NULL, 0);
+        } else if (opt == 'o') {
+            OutputDir = optarg;
+        } else if (opt == 'g') {
+            GoldenDir = optarg;
+        } else {
+            fprintf(stderr, "Usage: %s [-n iterations] [-o output_dir] [-g golden_dir]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    /* Memory map must be ready before any library call */
+    if (!TM_SIM_Init()) {
+        return 2;
+    }
+
+    /* Font atlas for A8 blending */
+    TM_FONTS_CreateAtlas(&Atlas, &TM_Font_11x18, AtlasBuffer);
+
+    /* Red ARGB8888 sprite, alpha increases from left to right */
+    for (opt = 0; opt < 32 * 32; opt++) {
+        SpriteARGB[opt] = ((uint32_t)(opt % 32) * 8 << 24) | 0x00FF0000;
+    }
+
+    if (Iterations) {
+        printf("%-32s %12s %10s %10s %12s\n", "Primitive", "prim/s", "xfer/prim", "px/prim", "bytes/prim");
+    }
+
+    /* ILI9341 with LTDC and DMA2D GRAPHIC on the same framebuffer */
+    TM_ILI9341_Init();
+    TM_ILI9341_Rotate(TM_ILI9341_Orientation_Portrait_2);
+    TM_DMA2DGRAPHIC_Init();
+    TM_DMA2DGRAPHIC_SetOrientation(1);
+    TM_SPRITE_Init();
+    TM_SPRITE_Show(&Sprites[0], 0, 0);
+    RunBenchmarks(ILI9341_Benchmarks);
+    RunBenchmarks(DMA2D_Benchmarks);
+    TM_SPRITE_Hide(&Sprites[0]);
+    RunScene(&SceneSprite);
+    TM_ILI9341_Init();
+    RunScene(&SceneILI9341);
+    RunScene(&SceneDMA2D);
+
+    /* LCD library reconfigures LTDC and DMA2D GRAPHIC */
+    TM_LCD_Init();
+    RunBenchmarks(LCD_Benchmarks);
+    RunScene(&SceneLCD);
+
+    return Failed ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * QOI image decoder benchmark against raw RGB565 images on PC
+ *
+ * Usage: image_benchmark [-n iterations] [-s sd_speed] image.qoi [image.565] ...
+ *
+ *  -n: Number of decodes for each image, default 100
+ *  -s: SD card read speed in kB/s for screen load estimation, default 4000
+ *
+ * When raw RGB565 image with the same name and .565 extension exists, decoded image
+ * is compared with it and program returns 1 if any pixel is different.
+ *
+ * Benchmark reports for each image:
+ *  - ratio: Raw RGB565 size / QOI size
+ *  - MB/s: Decoded RGB565 megabytes per second on PC
+ *  - raw ms, qoi ms: Screen load time, SD read time at given speed plus decode time on PC.
+ *    Decoding on STM32F429 is about 10 - 20 times slower than on PC
+ */
+#include "tm_host_sim.h"
+#include "tm_stm32f4_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Compressed data in memory */
+typedef struct {
+    const uint8_t* Data;
+    uint32_t Size;
+    uint32_t Pos;
+} Memory_t;
+
+static uint8_t*
+ReadFile(const char* filename, uint32_t* size) {
+    FILE* f;
+    uint8_t* data;
+    long len;
+
+    f = fopen(filename, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = malloc(len ? len : 1);
+    if (fread(data, 1, len, f) != (size_t)len) {
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *size = len;
+    return data;
+}
+
+/* Read function for decoder, works like f_read */
+static uint32_t
+MemoryRead(void* Param, uint8_t* Buffer, uint32_t Count) {
+    Memory_t* m = Param;
+
+    if (Count > m->Size - m->Pos) {
+        Count = m->Size - m->Pos;
+    }
+    memcpy(Buffer, m->Data + m->Pos, Count);
+    m->Pos += Count;
+    return Count;
+}
+
+int
+main(int argc, char** argv) {
+    int opt, i, n, iterations = 100, failed = 0;
+    double sd_speed = 4000, decode_ms, raw_ms, qoi_ms;
+    TM_IMAGE_Info_t Info;
+    TM_IMAGE_Result_t result;
+    Memory_t m;
+    uint64_t start, time;
+    uint32_t raw_size, size, px;
+    uint16_t* Frame;
+    uint8_t *data, *raw;
+    char raw_name[1024];
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+        if (opt == 'n') {
+            iterations = atoi(optarg);
+        } else if (opt == 's') {
+            sd_speed = atof(optarg);
+        } else {
+            fprintf(stderr, "Usage: %s [-n iterations] [-s sd_speed] image.qoi ...\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    printf("%-24s %9s %9s %6s %8s %8s %8s\n", "image", "raw", "qoi", "ratio", "MB/s", "raw ms", "qoi ms");
+    for (i = optind; i < argc; i++) {
+        data = ReadFile(argv[i], &size);
+        if (!data) {
+            fprintf(stderr, "%s: can't read file\n", argv[i]);
+            failed = 1;
+            continue;
+        }
+
+        /* Get image size */
+        m.Data = data;
+        m.Size = size;
+        m.Pos = 0;
+        if (TM_IMAGE_Decode(MemoryRead, &m, NULL, 0, 0, 0, &Info) == TM_IMAGE_Result_Format) {
+            fprintf(stderr, "%s: not QOI image\n", argv[i]);
+            free(data);
+            failed = 1;
+            continue;
+        }
+        px = Info.Width * Info.Height;
+        Frame = malloc(px * 2);
+
+        /* Decode */
+        start = TM_SIM_GetTime();
+        for (n = 0; n < iterations; n++) {
+            m.Pos = 0;
+            result = TM_IMAGE_Decode(MemoryRead, &m, Frame, Info.Width, Info.Width, Info.Height, &Info);
+        }
+        time = TM_SIM_GetTime() - start;
+        if (result != TM_IMAGE_Result_Ok) {
+            fprintf(stderr, "%s: decode error %d\n", argv[i], result);
+            failed = 1;
+        }
+
+        /* Compare with raw image */
+        snprintf(raw_name, sizeof(raw_name), "%.*s.565", (int)(strrchr(argv[i], '.') ? strrchr(argv[i], '.') - argv[i] : (long)strlen(argv[i])), argv[i]);
+        raw = ReadFile(raw_name, &raw_size);
+        if (raw) {
+            if (raw_size != px * 2 || memcmp(raw, Frame, raw_size)) {
+                fprintf(stderr, "%s: decoded image is different than %s\n", argv[i], raw_name);
+                failed = 1;
+            }
+            free(raw);
+        }
+
+        /* Screen load time, raw image is only read, QOI image is read and decoded */
+        decode_ms = (double)time / iterations / 1e6;
+        raw_ms = (double)px * 2 / 1024 / sd_speed * 1000;
+        qoi_ms = (double)size / 1024 / sd_speed * 1000 + decode_ms;
+
+        printf("%-24.24s %9u %9u %6.1f %8.1f %8.2f %8.2f\n", argv[i], px * 2, size,
+            (double)px * 2 / size, (double)px * 2 * iterations / ((double)time / 1e9) / 1e6, raw_ms, qoi_ms);
+
+        free(Frame);
+        free(data);
+    }
+
+    return failed;
+}
@@ -0,0 +1,354 @@
+/**
+ *  Converts PNG or PPM images to QOI format for TM IMAGE library
+ *
+ *  @author     Tilen MAJERLE
+ *  @email      tilen@majerle.eu
+ *  @website    http://stm32f4-discovery.net
+ *  @version    v1.0
+ *  @ide        GCC, Linux
+ *  @license    GNU GPL v3
+ *
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * Usage: image_convert [-q] [-r raw.565] input.png|input.ppm output.qoi
+ *  -q: Round colors to RGB565 before compression, decoded image is then
+ *      exactly the same as raw RGB565 image and file is smaller
+ *  -r: Write raw RGB565 image too, little endian, like it is in framebuffer
+ *
+ * PNG images must be 8-bit, not interlaced. Gray, RGB, palette and alpha are supported.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+/* Image in RGBA format */
+typedef struct {
+    uint32_t Width;
+    uint32_t Height;
+    uint8_t Channels;
+    uint8_t* Pixels;
+} Image_t;
+
+static uint8_t*
+ReadFile(const char* filename, size_t* size) {
+    FILE* f;
+    uint8_t* data;
+    long len;
+
+    f = fopen(filename, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = malloc(len ? len : 1);
+    if (fread(data, 1, len, f) != (size_t)len) {
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *size = len;
+    return data;
+}
+
+static uint32_t
+BE32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static uint8_t
+Paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+static int
+LoadPNG(const uint8_t* data, size_t size, Image_t* img) {
+    static const uint8_t sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t *idat = NULL, *raw, *prev, *line;
+    uint8_t palette[256 * 4];
+    size_t idat_len = 0, pos = 8;
+    uLongf raw_len;
+    uint32_t len, x, y, i, bpp = 0, stride;
+    uint8_t depth = 0, type = 0, interlace = 0;
+
+    if (size < 8 || memcmp(data, sig, 8)) {
+        return 0;
+    }
+    memset(palette, 0xFF, sizeof(palette));
+
+    /* Read chunks */
+    while (pos + 12 <= size) {
+        len = BE32(data + pos);
+        if (pos + 12 + len > size) {
+            break;
+        }
+        if (!memcmp(data + pos + 4, "IHDR", 4)) {
+            img->Width = BE32(data + pos + 8);
+            img->Height = BE32(data + pos + 12);
+            depth = data[pos + 16];
+            type = data[pos + 17];
+            interlace = data[pos + 20];
+        } else if (!memcmp(data + pos + 4, "PLTE", 4)) {
+            for (i = 0; i < len / 3 && i < 256; i++) {
+                memcpy(palette + i * 4, data + pos + 8 + i * 3, 3);
+            }
+        } else if (!memcmp(data + pos + 4, "tRNS", 4) && type == 3) {
+            for (i = 0; i < len && i < 256; i++) {
+                palette[i * 4 + 3] = data[pos + 8 + i];
+            }
+        } else if (!memcmp(data + pos + 4, "IDAT", 4)) {
+            idat = realloc(idat, idat_len + len);
+            memcpy(idat + idat_len, data + pos + 8, len);
+            idat_len += len;
+        }
+        pos += 12 + len;
+    }
+
+    /* Bytes per pixel in PNG data */
+    switch (type) {
+        case 0: bpp = 1; break;
+        case 2: bpp = 3; break;
+        case 3: bpp = 1; break;
+        case 4: bpp = 2; break;
+        case 6: bpp = 4; break;
+    }
+    if (depth != 8 || interlace || !bpp || !idat) {
+        fprintf(stderr, "Only 8-bit not interlaced PNG images are supported\n");
+        free(idat);
+        return 0;
+    }
+
+    /* Decompress */
+    stride = img->Width * bpp;
+    raw_len = (uLongf)(stride + 1) * img->Height;
+    raw = malloc(raw_len);
+    if (uncompress(raw, &raw_len, idat, idat_len) != Z_OK) {
+        fprintf(stderr, "PNG data can't be decompressed\n");
+        free(raw);
+        free(idat);
+        return 0;
+    }
+    free(idat);
+
+    /* Remove filters */
+    prev = NULL;
+    for (y = 0; y < img->Height; y++) {
+        line = raw + y * (stride + 1) + 1;
+        for (x = 0; x < stride; x++) {
+            uint8_t a = x >= bpp ? line[x - bpp] : 0;
+            uint8_t b = prev ? prev[x] : 0;
+            uint8_t c = (prev && x >= bpp) ? prev[x - bpp] : 0;
+            switch (line[-1]) {
+                case 1: line[x] += a; break;
+                case 2: line[x] += b; break;
+                case 3: line[x] += (a + b) / 2; break;
+                case 4: line[x] += Paeth(a, b, c); break;
+            }
+        }
+        prev = line;
+    }
+
+    /* Convert to RGBA */
+    img->Channels = (type == 4 || type == 6 || type == 3) ? 4 : 3;
+    img->Pixels = malloc(img->Width * img->Height * 4);
+    for (y = 0; y < img->Height; y++) {
+        line = raw + y * (stride + 1) + 1;
+        for (x = 0; x < img->Width; x++) {
+            uint8_t* p = img->Pixels + (y * img->Width + x) * 4;
+            switch (type) {
+                case 0: p[0] = p[1] = p[2] = line[x]; p[3] = 255; break;
+                case 2: memcpy(p, line + x * 3, 3); p[3] = 255; break;
+                case 3: memcpy(p, palette + line[x] * 4, 4); break;
+                case 4: p[0] = p[1] = p[2] = line[x * 2]; p[3] = line[x * 2 + 1]; break;
+                case 6: memcpy(p, line + x * 4, 4); break;
+            }
+        }
+    }
+    free(raw);
+    return 1;
+}
+
+static int
+LoadPPM(const uint8_t* data, size_t size, Image_t* img) {
+    unsigned w, h, max;
+    int n = 0;
+    uint32_t i;
+
+    if (sscanf((const char *)data, "P6 %u %u %u%n", &w, &h, &max, &n) != 3 || max != 255) {
+        return 0;
+    }
+    n++;
+    if ((size_t)n + (size_t)w * h * 3 > size) {
+        return 0;
+    }
+    img->Width = w;
+    img->Height = h;
+    img->Channels = 3;
+    img->Pixels = malloc(w * h * 4);
+    for (i = 0; i < w * h; i++) {
+        memcpy(img->Pixels + i * 4, data + n + i * 3, 3);
+        img->Pixels[i * 4 + 3] = 255;
+    }
+    return 1;
+}
+
+/* Encodes image to QOI, returns size */
+static size_t
+EncodeQOI(const Image_t* img, uint8_t* out) {
+    uint32_t index[64] = {0}, px, prev = 0xFF000000, i, count = img->Width * img->Height;
+    size_t pos = 0;
+    int run = 0;
+
+    /* Header */
+    memcpy(out, "qoif", 4);
+    out[4] = img->Width >> 24; out[5] = img->Width >> 16; out[6] = img->Width >> 8; out[7] = img->Width;
+    out[8] = img->Height >> 24; out[9] = img->Height >> 16; out[10] = img->Height >> 8; out[11] = img->Height;
+    out[12] = img->Channels;
+    out[13] = 0;
+    pos = 14;
+
+    for (i = 0; i < count; i++) {
+        const uint8_t* p = img->Pixels + i * 4;
+        px = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+        if (px == prev) {
+            if (++run == 62 || i == count - 1) {
+                out[pos++] = 0xC0 | (run - 1);
+                run = 0;
+            }
+            continue;
+        }
+        if (run) {
+            out[pos++] = 0xC0 | (run - 1);
+            run = 0;
+        }
+        {
+            uint8_t h = (p[0] * 3 + p[1] * 5 + p[2] * 7 + p[3] * 11) & 0x3F;
+            if (index[h] == px) {
+                out[pos++] = h;
+            } else {
+                index[h] = px;
+                if (p[3] == (prev >> 24)) {
+                    int8_t dr = p[0] - (uint8_t)prev, dg = p[1] - (uint8_t)(prev >> 8), db = p[2] - (uint8_t)(prev >> 16);
+                    int8_t dr_dg = dr - dg, db_dg = db - dg;
+                    if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                        out[pos++] = 0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2);
+                    } else if (dr_dg > -9 && dr_dg < 8 && dg > -33 && dg < 32 && db_dg > -9 && db_dg < 8) {
+                        out[pos++] = 0x80 | (dg + 32);
+                        out[pos++] = (dr_dg + 8) << 4 | (db_dg + 8);
+                    } else {
+                        out[pos++] = 0xFE;
+                        out[pos++] = p[0]; out[pos++] = p[1]; out[pos++] = p[2];
+                    }
+                } else {
+                    out[pos++] = 0xFF;
+                    out[pos++] = p[0]; out[pos++] = p[1]; out[pos++] = p[2]; out[pos++] = p[3];
+                }
+            }
+        }
+        prev = px;
+    }
+
+    /* End marker */
+    memset(out + pos, 0, 7);
+    out[pos + 7] = 1;
+    return pos + 8;
+}
+
+int
+main(int argc, char** argv) {
+    const char* raw_name = NULL;
+    Image_t img = {0};
+    uint8_t *data, *out;
+    size_t size, out_size;
+    uint32_t i;
+    int opt, quantize = 0;
+    FILE* f;
+
+    while ((opt = getopt(argc, argv, "qr:")) != -1) {
+        if (opt == 'q') {
+            quantize = 1;
+        } else if (opt == 'r') {
+            raw_name = optarg;
+        } else {
+            break;
+        }
+    }
+    if (argc - optind != 2) {
+        fprintf(stderr, "Usage: %s [-q] [-r raw.565] input.png|input.ppm output.qoi\n", argv[0]);
+        return 2;
+    }
+
+    /* Load image */
+    data = ReadFile(argv[optind], &size);
+    if (!data || !(LoadPNG(data, size, &img) || LoadPPM(data, size, &img))) {
+        fprintf(stderr, "%s: can't read PNG or PPM image\n", argv[optind]);
+        return 1;
+    }
+    free(data);
+
+    /* Round colors to RGB565, low bits are copied from high bits like DMA2D does */
+    if (quantize) {
+        for (i = 0; i < img.Width * img.Height; i++) {
+            uint8_t* p = img.Pixels + i * 4;
+            p[0] = (p[0] & 0xF8) | (p[0] >> 5);
+            p[1] = (p[1] & 0xFC) | (p[1] >> 6);
+            p[2] = (p[2] & 0xF8) | (p[2] >> 5);
+        }
+    }
+
+    /* Encode, worst case is 5 bytes per pixel */
+    out = malloc((size_t)img.Width * img.Height * 5 + 22);
+    out_size = EncodeQOI(&img, out);
+    f = fopen(argv[optind + 1], "wb");
+    if (!f || fwrite(out, 1, out_size, f) != out_size) {
+        fprintf(stderr, "%s: can't write file\n", argv[optind + 1]);
+        return 1;
+    }
+    fclose(f);
+
+    /* Raw RGB565 image */
+    if (raw_name) {
+        f = fopen(raw_name, "wb");
+        if (!f) {
+            fprintf(stderr, "%s: can't write file\n", raw_name);
+            return 1;
+        }
+        for (i = 0; i < img.Width * img.Height; i++) {
+            uint8_t* p = img.Pixels + i * 4;
+            uint16_t c = ((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3);
+            fputc(c & 0xFF, f);
+            fputc(c >> 8, f);
+        }
+        fclose(f);
+    }
+
+    printf("%s: %ux%u, %u bytes raw RGB565, %u bytes QOI, ratio %.1f\n", argv[optind + 1],
+        img.Width, img.Height, img.Width * img.Height * 2, (unsigned)out_size, (double)img.Width * img.Height * 2 / out_size);
+    free(out);
+    free(img.Pixels);
+    return 0;
+}
@@ -0,0 +1,277 @@
+/**
+ *  Decodes binary records from TM PROFILE library
+ *
+ *  @author     Tilen MAJERLE
+ *  @email      tilen@majerle.eu
+ *  @website    http://stm32f4-discovery.net
+ *  @version    v1.0
+ *  @ide        GCC, Linux
+ *  @license    GNU GPL v3
+ *
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * Usage: profile_decode [-i] [-p port] [file]
+ *  -i: Input is raw SWO capture with ITM packets, like from OpenOCD "tpiu config internal file.bin"
+ *  -p: ITM stimulus port with records, 1 by default, same as TM_PROFILE_ITM_PORT
+ *
+ * Without -i, input is raw records, like from USART. Without file, standard input is read.
+ * Table is printed for each frame record, so live capture can be piped to decoder.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Record types, same as in tm_stm32f4_profile.h */
+#define RECORD_START        0xA5
+#define RECORD_FRAME        0x01
+#define RECORD_NAME         0x02
+#define RECORD_STATS        0x03
+
+#define MAX_ZONES           255
+#define MAX_BUCKETS         16
+
+/* Zone statistics from one frame */
+typedef struct {
+    char Name[256];
+    uint8_t Valid;
+    uint32_t Count;
+    uint64_t Total;
+    uint32_t Min;
+    uint32_t Max;
+    uint32_t Buckets[MAX_BUCKETS];
+} Zone_t;
+
+/* Frame settings and zones */
+static struct {
+    uint8_t Valid;
+    uint32_t Clock;
+    uint32_t Elapsed;
+    uint8_t Zones;
+    uint8_t Buckets;
+    uint8_t Shift;
+    Zone_t Zone[MAX_ZONES];
+} Frame;
+
+/* Record parser */
+static struct {
+    uint8_t Data[4 + 255 + 1];
+    uint16_t Length;
+} Parser;
+
+/* Statistics for bad records */
+static uint32_t Errors = 0;
+
+static uint32_t
+Get32(const uint8_t* data) {
+    return data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+static void
+PrintFrame(void) {
+    uint8_t i, k;
+    double us;
+    Zone_t* z;
+
+    /* Nothing received yet */
+    if (!Frame.Valid || !Frame.Clock) {
+        return;
+    }
+    us = Frame.Clock / 1000000.0;
+
+    /* Header */
+    printf("Clock %u Hz, period %.3f ms, bad records %u\n", Frame.Clock, Frame.Elapsed / us / 1000.0, Errors);
+    printf("%3s %-16s %10s %10s %10s %10s %7s  histogram, first bucket < %u cycles, each next x4\n",
+        "id", "name", "count", "min us", "avg us", "max us", "cpu %", 1U << Frame.Shift);
+
+    /* Zones */
+    for (i = 0; i < Frame.Zones; i++) {
+        z = &Frame.Zone[i];
+        if (!z->Valid) {
+            continue;
+        }
+        printf("%3u %-16s %10u %10.2f %10.2f %10.2f %7.2f ", i, z->Name[0] ? z->Name : "-", z->Count,
+            z->Min / us, (double)z->Total / z->Count / us, z->Max / us,
+            Frame.Elapsed ? 100.0 * z->Total / Frame.Elapsed : 0.0);
+        for (k = 0; k < Frame.Buckets; k++) {
+            printf(" %u", z->Buckets[k]);
+        }
+        printf("\n");
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static void
+ProcessRecord(const uint8_t* rec) {
+    uint8_t type = rec[1], id = rec[2], len = rec[3];
+    const uint8_t* data = &rec[4];
+    Zone_t* z;
+    uint8_t k;
+
+    switch (type) {
+        case RECORD_FRAME:
+            if (len < 11) {
+                break;
+            }
+
+            /* Previous frame is complete */
+            PrintFrame();
+            memset(&Frame, 0, sizeof(Frame));
+            Frame.Valid = 1;
+            Frame.Clock = Get32(&data[0]);
+            Frame.Elapsed = Get32(&data[4]);
+            Frame.Zones = data[8];
+            Frame.Buckets = data[9] > MAX_BUCKETS ? MAX_BUCKETS : data[9];
+            Frame.Shift = data[10];
+            break;
+        case RECORD_NAME:
+            memcpy(Frame.Zone[id].Name, data, len);
+            Frame.Zone[id].Name[len] = 0;
+            break;
+        case RECORD_STATS:
+            if (len < 20 + 4 * Frame.Buckets) {
+                break;
+            }
+            z = &Frame.Zone[id];
+            z->Valid = 1;
+            z->Count = Get32(&data[0]);
+            z->Total = Get32(&data[4]) | (uint64_t)Get32(&data[8]) << 32;
+            z->Min = Get32(&data[12]);
+            z->Max = Get32(&data[16]);
+            for (k = 0; k < Frame.Buckets; k++) {
+                z->Buckets[k] = Get32(&data[20 + 4 * k]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void
+ParseByte(uint8_t ch) {
+    uint8_t bad[sizeof(Parser.Data)];
+    uint16_t i, len;
+    uint8_t sum;
+
+    /* Wait for start of record */
+    if (!Parser.Length && ch != RECORD_START) {
+        return;
+    }
+    Parser.Data[Parser.Length++] = ch;
+
+    /* Wait for whole record */
+    if (Parser.Length < 4 || Parser.Length < Parser.Data[3] + 5) {
+        return;
+    }
+    len = Parser.Length;
+    Parser.Length = 0;
+
+    /* Check checksum */
+    for (sum = 0, i = 0; i < len - 1; i++) {
+        sum += Parser.Data[i];
+    }
+    if (sum == Parser.Data[len - 1]) {
+        ProcessRecord(Parser.Data);
+        return;
+    }
+
+    /* Bad record, look for start in bytes after first one */
+    Errors++;
+    memcpy(bad, Parser.Data, len);
+    for (i = 1; i < len; i++) {
+        ParseByte(bad[i]);
+    }
+}
+
+static void
+ParseITM(FILE* f, uint8_t port) {
+    int ch, i, size;
+
+    while ((ch = fgetc(f)) != EOF) {
+        /* Sync and overflow packets, sync ends with 0x80 */
+        if (ch == 0x00 || ch == 0x80 || ch == 0x70) {
+            continue;
+        }
+
+        /* Protocol packets, like timestamps, have continuation bit in each byte */
+        if (!(ch & 0x03)) {
+            if (ch & 0x80) {
+                while ((ch = fgetc(f)) != EOF && (ch & 0x80));
+            }
+            continue;
+        }
+
+        /* Source packet with 1, 2 or 4 bytes */
+        size = (ch & 0x03) == 3 ? 4 : (ch & 0x03);
+        for (i = 0; i < size; i++) {
+            int data = fgetc(f);
+            if (data == EOF) {
+                return;
+            }
+
+            /* Only software packets from our port */
+            if (!(ch & 0x04) && (ch >> 3) == port) {
+                ParseByte(data);
+            }
+        }
+    }
+}
+
+int
+main(int argc, char** argv) {
+    int opt, ch;
+    uint8_t itm = 0, port = 1;
+    FILE* f = stdin;
+
+    /* Parse arguments */
+    while ((opt = getopt(argc, argv, "ip:")) != -1) {
+        switch (opt) {
+            case 'i': itm = 1; break;
+            case 'p': port = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-i] [-p port] [file]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind < argc) {
+        f = fopen(argv[optind], "rb");
+        if (!f) {
+            fprintf(stderr, "Can't open %s\n", argv[optind]);
+            return 1;
+        }
+    }
+
+    /* Decode records */
+    if (itm) {
+        ParseITM(f, port);
+    } else {
+        while ((ch = fgetc(f)) != EOF) {
+            ParseByte(ch);
+        }
+    }
+
+    /* Print last frame */
+    PrintFrame();
+
+    if (f != stdin) {
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,592 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#define _GNU_SOURCE
+#include "tm_host_sim.h"
+#include <sys/mman.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <time.h>
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE     0x100000
+#endif
+
+/* Converts 32-bit simulated address to pointer */
+#define SIM_PTR(address)        ((uint8_t *)(uintptr_t)(address))
+
+/* DMA2D color modes */
+#define SIM_CM_ARGB8888         0
+#define SIM_CM_RGB888           1
+#define SIM_CM_RGB565           2
+#define SIM_CM_ARGB1555         3
+#define SIM_CM_ARGB4444         4
+#define SIM_CM_L8               5
+#define SIM_CM_AL44             6
+#define SIM_CM_AL88             7
+#define SIM_CM_L4               8
+#define SIM_CM_A8               9
+#define SIM_CM_A4               10
+
+/**
+ * @brief  Memory region mapped to process
+ * @note   Used private
+ */
+typedef struct {
+    uint32_t Address;
+    uint32_t Size;
+} TM_SIM_Region_t;
+
+/**
+ * @brief  DMA2D input layer settings, foreground or background
+ * @note   Used private
+ */
+typedef struct {
+    uint32_t Address;  /*!< Memory address */
+    uint32_t Offset;   /*!< Line offset in pixels */
+    uint32_t PFCCR;    /*!< PFC control register */
+    uint32_t Color;    /*!< Color register, used for A8 and A4 formats */
+    uint32_t CLUT;     /*!< CLUT address, used for L8, L4, AL44 and AL88 formats */
+} TM_SIM_Input_t;
+
+/* Regions from STM32F429 memory map */
+static const TM_SIM_Region_t SIM_Regions[] = {
+    {0x40000000, 0x00080000}, /* APB1, APB2 and AHB1 peripherals */
+    {0x42000000, 0x02000000}, /* Peripheral bit-band alias */
+    {0xA0000000, 0x00001000}, /* FMC registers */
+    {0xC0000000, 0x02000000}, /* SDRAM bank 1 */
+    {0xD0000000, 0x02000000}, /* SDRAM bank 2 */
+    {0xE0000000, 0x00100000}, /* Cortex-M4 internal peripherals */
+};
+
+/* Statistics */
+static TM_SIM_Stats_t SIM_Stats;
+
+/* Private functions */
+static uint8_t TM_SIM_INT_PixelSize(uint8_t cm);
+static uint32_t TM_SIM_INT_ReadPixel(const TM_SIM_Input_t* In, uint32_t index);
+static void TM_SIM_INT_WritePixel(uint32_t address, uint8_t cm, uint32_t argb);
+static uint32_t TM_SIM_INT_Blend(uint32_t fg, uint32_t bg);
+static uint8_t TM_SIM_INT_WritePPM(const char* filename, const uint8_t* rgb, uint16_t width, uint16_t height);
+static uint8_t* TM_SIM_INT_ReadPPM(const char* filename, uint16_t* width, uint16_t* height);
+
+uint8_t
+TM_SIM_Init(void) {
+    void* ptr;
+    uint8_t i;
+
+    /* Map all regions to the same addresses as on STM32F429 */
+    for (i = 0; i < sizeof(SIM_Regions) / sizeof(SIM_Regions[0]); i++) {
+        ptr = mmap(SIM_PTR(SIM_Regions[i].Address), SIM_Regions[i].Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (ptr != SIM_PTR(SIM_Regions[i].Address)) {
+            /* Region is used or kernel does not support fixed mapping */
+            fprintf(stderr, "SIM: Can't map memory at 0x%08X\n", (unsigned int)SIM_Regions[i].Address);
+            return 0;
+        }
+    }
+
+    /* Oscillators and PLLs are always ready */
+    RCC->CR = RCC_CR_HSION | RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY | RCC_CR_PLLI2SRDY | RCC_CR_PLLSAIRDY;
+
+    /* SPI never waits for data */
+    SPI1->SR = SPI2->SR = SPI3->SR = SPI4->SR = SPI5->SR = SPI6->SR = SPI_SR_TXE | SPI_SR_RXNE;
+
+    /* Reset statistics */
+    TM_SIM_ResetStats();
+
+    /* Simulator ready */
+    return 1;
+}
+
+uint8_t
+TM_SIM_DMA2D_Working(void) {
+    TM_SIM_Input_t fg, bg;
+    uint32_t mode, width, height, x, y, size, oor, index, argb;
+    uint8_t ocm, fgsize, bgsize;
+    uint64_t start;
+
+    /* Check if transfer was started */
+    if (!(DMA2D->CR & DMA2D_CR_START)) {
+        return 0;
+    }
+    start = TM_SIM_GetTime();
+
+    /* Read settings */
+    mode = (DMA2D->CR & DMA2D_CR_MODE) >> 16;
+    width = (DMA2D->NLR & DMA2D_NLR_PL) >> 16;
+    height = DMA2D->NLR & DMA2D_NLR_NL;
+    oor = DMA2D->OOR & DMA2D_OOR_LO;
+    ocm = DMA2D->OPFCCR & DMA2D_OPFCCR_CM;
+
+    fg.Address = DMA2D->FGMAR;
+    fg.Offset = DMA2D->FGOR & DMA2D_FGOR_LO;
+    fg.PFCCR = DMA2D->FGPFCCR;
+    fg.Color = DMA2D->FGCOLR;
+    fg.CLUT = DMA2D->FGCMAR;
+    fgsize = TM_SIM_INT_PixelSize(fg.PFCCR & DMA2D_FGPFCCR_CM);
+
+    bg.Address = DMA2D->BGMAR;
+    bg.Offset = DMA2D->BGOR & DMA2D_BGOR_LO;
+    bg.PFCCR = DMA2D->BGPFCCR;
+    bg.Color = DMA2D->BGCOLR;
+    bg.CLUT = DMA2D->BGCMAR;
+    bgsize = TM_SIM_INT_PixelSize(bg.PFCCR & DMA2D_BGPFCCR_CM);
+
+    if (mode == 0) {
+        /* Memory to memory, data are copied without conversion, size is set with foreground format */
+        size = fgsize ? fgsize : 1;
+        for (y = 0; y < height; y++) {
+            memmove(
+                SIM_PTR(DMA2D->OMAR + y * (width + oor) * size),
+                SIM_PTR(fg.Address + y * (width + fg.Offset) * size),
+                width * size
+            );
+        }
+        SIM_Stats.BytesRead += (uint64_t)width * height * size;
+        SIM_Stats.BytesWritten += (uint64_t)width * height * size;
+    } else if (mode == 3) {
+        /* Register to memory, color is already in output format */
+        size = TM_SIM_INT_PixelSize(ocm);
+        for (y = 0; y < height; y++) {
+            for (x = 0; x < width; x++) {
+                memcpy(SIM_PTR(DMA2D->OMAR + (y * (width + oor) + x) * size), (const void *)&DMA2D->OCOLR, size);
+            }
+        }
+        SIM_Stats.BytesWritten += (uint64_t)width * height * size;
+    } else {
+        /* Memory to memory with pixel format conversion, with or without blending */
+        size = TM_SIM_INT_PixelSize(ocm);
+        for (y = 0; y < height; y++) {
+            for (x = 0; x < width; x++) {
+                argb = TM_SIM_INT_ReadPixel(&fg, y * (width + fg.Offset) + x);
+                if (mode == 2) {
+                    argb = TM_SIM_INT_Blend(argb, TM_SIM_INT_ReadPixel(&bg, y * (width + bg.Offset) + x));
+                }
+                TM_SIM_INT_WritePixel(DMA2D->OMAR + (y * (width + oor) + x) * size, ocm, argb);
+            }
+        }
+
+        /* 4-bit formats read half byte per pixel */
+        index = width * height;
+        SIM_Stats.BytesRead += fgsize ? (uint64_t)index * fgsize : (index + 1) / 2;
+        if (mode == 2) {
+            SIM_Stats.BytesRead += bgsize ? (uint64_t)index * bgsize : (index + 1) / 2;
+        }
+        SIM_Stats.BytesWritten += (uint64_t)index * size;
+    }
+
+    /* Update statistics */
+    SIM_Stats.Transfers++;
+    SIM_Stats.ModeTransfers[mode]++;
+    SIM_Stats.Pixels += (uint64_t)width * height;
+    SIM_Stats.ModelTime += TM_SIM_GetTime() - start;
+
+    /* Transfer done. Libraries reset DMA2D with RCC before new settings, which is not visible to simulator, so reset it here */
+    memset((void *)DMA2D, 0, offsetof(DMA2D_TypeDef, RESERVED));
+    DMA2D->ISR = DMA2D_ISR_TCIF;
+
+    return 0;
+}
+
+void
+TM_SIM_GetStats(TM_SIM_Stats_t* Stats) {
+    *Stats = SIM_Stats;
+}
+
+void
+TM_SIM_ResetStats(void) {
+    memset(&SIM_Stats, 0, sizeof(SIM_Stats));
+}
+
+uint64_t
+TM_SIM_GetTime(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+uint8_t
+TM_SIM_SaveLTDC(const char* filename) {
+    LTDC_Layer_TypeDef* layers[2] = {LTDC_Layer1, LTDC_Layer2};
+    LTDC_Layer_TypeDef* L;
+    TM_SIM_Input_t in;
+    uint16_t width, height, hbp, vbp;
+    int32_t x0, x1, y0, y1, x, y, pitch;
+    uint32_t argb, alpha, below, i, c;
+    uint8_t *rgb, *p, status;
+
+    /* Finish drawing */
+    TM_SIM_DMA2D_Working();
+
+    /* Active area is between accumulated back porch and accumulated active size */
+    hbp = (LTDC->BPCR & LTDC_BPCR_AHBP) >> 16;
+    vbp = LTDC->BPCR & LTDC_BPCR_AVBP;
+    width = ((LTDC->AWCR & LTDC_AWCR_AAW) >> 16) - hbp;
+    height = (LTDC->AWCR & LTDC_AWCR_AAH) - vbp;
+    if (width == 0 || height == 0 || width > 4096 || height > 4096) {
+        return 0;
+    }
+
+    /* Start with background color */
+    rgb = malloc((size_t)width * height * 3);
+    if (rgb == NULL) {
+        return 0;
+    }
+    for (i = 0; i < (uint32_t)width * height; i++) {
+        rgb[3 * i + 0] = LTDC->BCCR >> 16;
+        rgb[3 * i + 1] = LTDC->BCCR >> 8;
+        rgb[3 * i + 2] = LTDC->BCCR;
+    }
+
+    /* Layer 2 is on top of layer 1 */
+    for (i = 0; i < 2; i++) {
+        L = layers[i];
+        if (!(L->CR & LTDC_LxCR_LEN)) {
+            continue;
+        }
+
+        /* Window position on screen */
+        x0 = (int32_t)(L->WHPCR & LTDC_LxWHPCR_WHSTPOS) - hbp - 1;
+        x1 = (int32_t)((L->WHPCR & LTDC_LxWHPCR_WHSPPOS) >> 16) - hbp - 1;
+        y0 = (int32_t)(L->WVPCR & LTDC_LxWVPCR_WVSTPOS) - vbp - 1;
+        y1 = (int32_t)((L->WVPCR & LTDC_LxWVPCR_WVSPPOS) >> 16) - vbp - 1;
+        pitch = (L->CFBLR & LTDC_LxCFBLR_CFBP) >> 16;
+
+        /* LTDC and DMA2D use the same codes for the first 8 pixel formats */
+        in.PFCCR = L->PFCR & LTDC_LxPFCR_PF;
+        in.Offset = 0;
+        in.Color = 0;
+        in.CLUT = 0;
+
+        for (y = y0; y <= y1 && y < height; y++) {
+            if (y < 0 || (uint32_t)(y - y0) >= (L->CFBLNR & LTDC_LxCFBLNR_CFBLNBR)) {
+                continue;
+            }
+            for (x = x0; x <= x1 && x < width; x++) {
+                if (x < 0) {
+                    continue;
+                }
+
+                /* Read pixel from line */
+                in.Address = L->CFBAR + (y - y0) * pitch;
+                argb = TM_SIM_INT_ReadPixel(&in, x - x0);
+
+                /* Constant alpha, multiplied with pixel alpha when selected in blending factors */
+                alpha = L->CACR & LTDC_LxCACR_CONSTA;
+                if ((L->BFCR & LTDC_LxBFCR_BF1) == 0x600) {
+                    alpha = alpha * (argb >> 24) / 255;
+                }
+
+                /* Blend with layers below */
+                p = &rgb[3 * (y * width + x)];
+                for (c = 0; c < 3; c++) {
+                    below = p[c];
+                    p[c] = (((argb >> (16 - 8 * c)) & 0xFF) * alpha + below * (255 - alpha) + 127) / 255;
+                }
+            }
+        }
+    }
+
+    /* Save image */
+    status = TM_SIM_INT_WritePPM(filename, rgb, width, height);
+    free(rgb);
+
+    return status;
+}
+
+uint8_t
+TM_SIM_SaveBuffer(const char* filename, uint32_t address, uint16_t width, uint16_t height) {
+    TM_SIM_Input_t in;
+    uint32_t i, argb;
+    uint8_t *rgb, status;
+
+    /* Finish drawing */
+    TM_SIM_DMA2D_Working();
+
+    rgb = malloc((size_t)width * height * 3);
+    if (rgb == NULL) {
+        return 0;
+    }
+
+    /* Convert RGB565 to RGB888 */
+    in.Address = address;
+    in.Offset = 0;
+    in.PFCCR = SIM_CM_RGB565;
+    for (i = 0; i < (uint32_t)width * height; i++) {
+        argb = TM_SIM_INT_ReadPixel(&in, i);
+        rgb[3 * i + 0] = argb >> 16;
+        rgb[3 * i + 1] = argb >> 8;
+        rgb[3 * i + 2] = argb;
+    }
+
+    /* Save image */
+    status = TM_SIM_INT_WritePPM(filename, rgb, width, height);
+    free(rgb);
+
+    return status;
+}
+
+int32_t
+TM_SIM_ComparePPM(const char* filename1, const char* filename2) {
+    uint16_t w1, h1, w2, h2;
+    uint8_t *a, *b;
+    int32_t diff = -1;
+    uint32_t i;
+
+    /* Read both images */
+    a = TM_SIM_INT_ReadPPM(filename1, &w1, &h1);
+    b = TM_SIM_INT_ReadPPM(filename2, &w2, &h2);
+
+    /* Count different pixels */
+    if (a != NULL && b != NULL && w1 == w2 && h1 == h2) {
+        diff = 0;
+        for (i = 0; i < (uint32_t)w1 * h1; i++) {
+            if (memcmp(&a[3 * i], &b[3 * i], 3)) {
+                diff++;
+            }
+        }
+    }
+
+    free(a);
+    free(b);
+
+    return diff;
+}
+
+static uint8_t
+TM_SIM_INT_PixelSize(uint8_t cm) {
+    /* Bytes per pixel, 0 for 4-bit formats */
+    switch (cm) {
+        case SIM_CM_ARGB8888:
+            return 4;
+        case SIM_CM_RGB888:
+            return 3;
+        case SIM_CM_RGB565:
+        case SIM_CM_ARGB1555:
+        case SIM_CM_ARGB4444:
+        case SIM_CM_AL88:
+            return 2;
+        case SIM_CM_L8:
+        case SIM_CM_AL44:
+        case SIM_CM_A8:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static uint32_t
+TM_SIM_INT_ReadPixel(const TM_SIM_Input_t* In, uint32_t index) {
+    uint8_t* p;
+    uint32_t argb, r, g, b, a, v;
+    uint8_t cm = In->PFCCR & DMA2D_FGPFCCR_CM;
+
+    p = SIM_PTR(In->Address + index * TM_SIM_INT_PixelSize(cm));
+    switch (cm) {
+        case SIM_CM_ARGB8888:
+            argb = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+            break;
+        case SIM_CM_RGB888:
+            argb = 0xFF000000 | p[0] | (p[1] << 8) | (p[2] << 16);
+            break;
+        case SIM_CM_RGB565:
+            v = p[0] | (p[1] << 8);
+            r = (v >> 11) & 0x1F;
+            g = (v >> 5) & 0x3F;
+            b = v & 0x1F;
+            argb = 0xFF000000 | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+            break;
+        case SIM_CM_ARGB1555:
+            v = p[0] | (p[1] << 8);
+            r = (v >> 10) & 0x1F;
+            g = (v >> 5) & 0x1F;
+            b = v & 0x1F;
+            argb = ((v & 0x8000) ? 0xFF000000 : 0) | (((r << 3) | (r >> 2)) << 16) | (((g << 3) | (g >> 2)) << 8) | ((b << 3) | (b >> 2));
+            break;
+        case SIM_CM_ARGB4444:
+            v = p[0] | (p[1] << 8);
+            argb = (((v >> 12) & 0xF) * 0x11 << 24) | (((v >> 8) & 0xF) * 0x11 << 16) | (((v >> 4) & 0xF) * 0x11 << 8) | ((v & 0xF) * 0x11);
+            break;
+        case SIM_CM_L8:
+        case SIM_CM_AL44:
+        case SIM_CM_AL88:
+        case SIM_CM_L4:
+            /* Get alpha and CLUT index */
+            if (cm == SIM_CM_L8) {
+                a = 0xFF;
+                v = p[0];
+            } else if (cm == SIM_CM_AL44) {
+                a = (p[0] >> 4) * 0x11;
+                v = p[0] & 0x0F;
+            } else if (cm == SIM_CM_AL88) {
+                a = p[1];
+                v = p[0];
+            } else {
+                a = 0xFF;
+                p = SIM_PTR(In->Address + index / 2);
+                v = (index & 1) ? (p[0] >> 4) : (p[0] & 0x0F);
+            }
+
+            /* Read CLUT entry, in ARGB8888 or RGB888 format */
+            if (In->CLUT == 0) {
+                argb = v * 0x010101;
+            } else if (In->PFCCR & DMA2D_FGPFCCR_CCM) {
+                p = SIM_PTR(In->CLUT + v * 3);
+                argb = p[0] | (p[1] << 8) | (p[2] << 16);
+            } else {
+                p = SIM_PTR(In->CLUT + v * 4);
+                argb = p[0] | (p[1] << 8) | (p[2] << 16);
+            }
+            argb |= a << 24;
+            break;
+        case SIM_CM_A8:
+            argb = ((uint32_t)p[0] << 24) | (In->Color & 0x00FFFFFF);
+            break;
+        case SIM_CM_A4:
+            p = SIM_PTR(In->Address + index / 2);
+            a = (index & 1) ? (p[0] >> 4) : (p[0] & 0x0F);
+            argb = ((a * 0x11) << 24) | (In->Color & 0x00FFFFFF);
+            break;
+        default:
+            argb = 0;
+            break;
+    }
+
+    /* Alpha mode: 0 = no change, 1 = replace, 2 = multiply */
+    a = (In->PFCCR & DMA2D_FGPFCCR_ALPHA) >> 24;
+    if ((In->PFCCR & DMA2D_FGPFCCR_AM) == DMA2D_FGPFCCR_AM_0) {
+        argb = (argb & 0x00FFFFFF) | (a << 24);
+    } else if ((In->PFCCR & DMA2D_FGPFCCR_AM) == DMA2D_FGPFCCR_AM_1) {
+        argb = (argb & 0x00FFFFFF) | (((argb >> 24) * a / 255) << 24);
+    }
+
+    return argb;
+}
+
+static void
+TM_SIM_INT_WritePixel(uint32_t address, uint8_t cm, uint32_t argb) {
+    uint8_t* p = SIM_PTR(address);
+    uint32_t a = argb >> 24, r = (argb >> 16) & 0xFF, g = (argb >> 8) & 0xFF, b = argb & 0xFF, v;
+
+    /* Lower bits are truncated, like on DMA2D */
+    switch (cm) {
+        case SIM_CM_ARGB8888:
+            p[0] = b;
+            p[1] = g;
+            p[2] = r;
+            p[3] = a;
+            break;
+        case SIM_CM_RGB888:
+            p[0] = b;
+            p[1] = g;
+            p[2] = r;
+            break;
+        case SIM_CM_RGB565:
+            v = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+            p[0] = v;
+            p[1] = v >> 8;
+            break;
+        case SIM_CM_ARGB1555:
+            v = ((a >> 7) << 15) | ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+            p[0] = v;
+            p[1] = v >> 8;
+            break;
+        case SIM_CM_ARGB4444:
+            v = ((a >> 4) << 12) | ((r >> 4) << 8) | ((g >> 4) << 4) | (b >> 4);
+            p[0] = v;
+            p[1] = v >> 8;
+            break;
+        default:
+            break;
+    }
+}
+
+static uint32_t
+TM_SIM_INT_Blend(uint32_t fg, uint32_t bg) {
+    uint32_t fa = fg >> 24, ba = bg >> 24, ma, oa, c, i, out;
+
+    /* Blending formula from reference manual */
+    ma = fa * ba / 255;
+    oa = fa + ba - ma;
+    if (oa == 0) {
+        return 0;
+    }
+
+    out = oa << 24;
+    for (i = 0; i < 24; i += 8) {
+        c = (((fg >> i) & 0xFF) * fa + ((bg >> i) & 0xFF) * ba - ((bg >> i) & 0xFF) * ma) / oa;
+        out |= (c > 0xFF ? 0xFF : c) << i;
+    }
+
+    return out;
+}
+
+static uint8_t
+TM_SIM_INT_WritePPM(const char* filename, const uint8_t* rgb, uint16_t width, uint16_t height) {
+    FILE* f;
+    size_t size = (size_t)width * height * 3;
+
+    f = fopen(filename, "wb");
+    if (f == NULL) {
+        return 0;
+    }
+
+    /* Binary PPM with 8 bits per color */
+    fprintf(f, "P6\n%u %u\n255\n", width, height);
+    if (fwrite(rgb, 1, size, f) != size) {
+        fclose(f);
+        return 0;
+    }
+    fclose(f);
+
+    return 1;
+}
+
+static uint8_t*
+TM_SIM_INT_ReadPPM(const char* filename, uint16_t* width, uint16_t* height) {
+    FILE* f;
+    unsigned int w, h, max;
+    uint8_t* rgb;
+    size_t size;
+
+    f = fopen(filename, "rb");
+    if (f == NULL) {
+        return NULL;
+    }
+
+    /* Only files written with this simulator are supported */
+    if (fscanf(f, "P6 %u %u %u", &w, &h, &max) != 3 || max != 255 || w > 0xFFFF || h > 0xFFFF || fgetc(f) == EOF) {
+        fclose(f);
+        return NULL;
+    }
+
+    size = (size_t)w * h * 3;
+    rgb = malloc(size);
+    if (rgb != NULL && fread(rgb, 1, size, f) != size) {
+        free(rgb);
+        rgb = NULL;
+    }
+    fclose(f);
+
+    *width = w;
+    *height = h;
+
+    return rgb;
+}
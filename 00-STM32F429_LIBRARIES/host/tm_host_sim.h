@@ -0,0 +1,221 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     GCC, Linux
+ * @license GNU GPL v3
+ * @brief   STM32F429 framebuffer simulator for running graphic libraries on PC
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_HOST_SIM_H
+#define TM_HOST_SIM_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_HOST_SIM
+ * @brief    STM32F429 framebuffer simulator for running graphic libraries on PC
+ * @{
+ *
+ * Simulator allows you to compile graphic libraries for Linux without any change,
+ * so you can profile them and check rendered images without board.
+ *
+ * \par How it works
+ *
+ * Libraries and STD peripheral drivers use fixed addresses for peripherals and SDRAM.
+ * Simulator maps normal memory to the same addresses in process, so all register writes
+ * and framebuffer accesses go to memory, exactly like on STM32F429:
+ *
+@verbatim
+Region                 Address       Size
+Peripherals            0x40000000    512kB
+Peripheral bit-band    0x42000000    32MB
+FMC registers          0xA0000000    4kB
+SDRAM bank 1           0xC0000000    32MB
+SDRAM bank 2           0xD0000000    32MB
+Cortex-M4 peripherals  0xE0000000    1MB
+@endverbatim
+ *
+ * After that, some peripherals need to act like hardware:
+ *  - RCC oscillator and PLL ready flags are always set
+ *  - SPI TXE and RXNE flags are always set, so SPI transfers never wait
+ *  - DMA2D transfer is done in software when library waits for it.
+ *    For that, DMA2D_WORKING macro is overwritten in defines.h with @ref TM_SIM_DMA2D_Working function.
+ *    All modes are supported: register to memory, memory to memory, memory to memory with pixel format conversion and blending
+ *  - LTDC is not simulated while running, but when frame is saved with @ref TM_SIM_SaveLTDC function,
+ *    both layers are read and blended from LTDC registers, like LTDC would do
+ *
+ * \par Limitations
+ *
+ *  - Program must be linked with -no-pie option, so global and static variables are at addresses below 4GB.
+ *    DMA2D uses 32-bit addresses and can't reach stack or heap above 4GB. Use global buffers for DMA2D
+ *  - Interrupts are not simulated. Libraries, which wait for interrupts (like ILI9341_USE_BUFFERING) can't be used
+ *  - DMA2D CLUT is read directly from memory, CLUT loading is not simulated
+ *  - Peripheral reset with RCC is not simulated. Libraries reset DMA2D before each new configuration,
+ *    so DMA2D registers are cleared after each transfer instead
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - Linux (mmap, clock_gettime)
+ - stdio.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "stdio.h"
+
+/**
+ * @defgroup TM_HOST_SIM_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Simulator statistics
+ */
+typedef struct {
+    uint32_t Transfers;       /*!< Number of DMA2D transfers */
+    uint32_t ModeTransfers[4];/*!< Number of DMA2D transfers for each mode: M2M, M2M_PFC, M2M_BLEND and R2M */
+    uint64_t Pixels;          /*!< Number of pixels DMA2D has written */
+    uint64_t BytesRead;       /*!< Number of bytes DMA2D has read from foreground and background memory */
+    uint64_t BytesWritten;    /*!< Number of bytes DMA2D has written to output memory */
+    uint64_t ModelTime;       /*!< Time in nanoseconds spent in DMA2D software model */
+} TM_SIM_Stats_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_HOST_SIM_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes simulator, maps memory regions and sets peripheral flags
+ * @note   Must be called before any library function
+ * @param  None
+ * @retval Initialization status:
+ *           - 0: Memory regions can't be mapped
+ *           - > 0: Simulator ready
+ */
+uint8_t TM_SIM_Init(void);
+
+/**
+ * @brief  Executes started DMA2D transfer in software
+ * @note   Used in DMA2D_WORKING macro, so transfer is done when library waits for it
+ * @param  None
+ * @retval Always 0, DMA2D is never working after this function
+ */
+uint8_t TM_SIM_DMA2D_Working(void);
+
+/**
+ * @brief  Gets simulator statistics
+ * @param  *Stats: Pointer to @ref TM_SIM_Stats_t structure to fill
+ * @retval None
+ */
+void TM_SIM_GetStats(TM_SIM_Stats_t* Stats);
+
+/**
+ * @brief  Resets simulator statistics to zero
+ * @param  None
+ * @retval None
+ */
+void TM_SIM_ResetStats(void);
+
+/**
+ * @brief  Gets time from monotonic clock
+ * @param  None
+ * @retval Time in nanoseconds
+ */
+uint64_t TM_SIM_GetTime(void);
+
+/**
+ * @brief  Saves LCD image, as LTDC would send it to LCD, to PPM file
+ * @note   Enabled LTDC layers are blended over background color with their windows, pixel formats and alpha settings
+ * @param  *filename: Name of PPM file
+ * @retval Status:
+ *           - 0: File can't be written or LTDC is not configured
+ *           - > 0: Image saved
+ */
+uint8_t TM_SIM_SaveLTDC(const char* filename);
+
+/**
+ * @brief  Saves RGB565 framebuffer from memory to PPM file
+ * @note   Pending DMA2D transfer is finished first
+ * @param  *filename: Name of PPM file
+ * @param  address: Address of framebuffer in simulated memory
+ * @param  width: Framebuffer width in pixels
+ * @param  height: Framebuffer height in pixels
+ * @retval Status:
+ *           - 0: File can't be written
+ *           - > 0: Image saved
+ */
+uint8_t TM_SIM_SaveBuffer(const char* filename, uint32_t address, uint16_t width, uint16_t height);
+
+/**
+ * @brief  Compares 2 PPM images
+ * @param  *filename1: Name of first PPM file
+ * @param  *filename2: Name of second PPM file
+ * @retval Number of different pixels, or -1 if files can't be read or sizes are not the same
+ */
+int32_t TM_SIM_ComparePPM(const char* filename1, const char* filename2);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
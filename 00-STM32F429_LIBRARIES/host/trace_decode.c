@@ -0,0 +1,377 @@
+/**
+ *  Converts SWO capture with TM TRACE records to Chrome trace JSON
+ *
+ *  @author     Tilen MAJERLE
+ *  @email      tilen@majerle.eu
+ *  @website    http://stm32f4-discovery.net
+ *  @version    v1.0
+ *  @ide        GCC, Linux
+ *  @license    GNU GPL v3
+ *
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ *
+ * Usage: trace_decode [-c clock] [-n names.txt] [-o trace.json] [capture.bin]
+ *  -c: CPU clock in Hz, 180000000 by default, used to convert timestamps to microseconds
+ *  -n: File with names, one per line: "event 1 FFT" or "watch 0 MaxValue"
+ *  -o: Output file, standard output by default
+ *
+ * Input is raw SWO capture with ITM packets, standard input is read without file.
+ * Output can be opened in https://ui.perfetto.dev or chrome://tracing.
+ * Ports must be the same as in TM TRACE library, they are defined below.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Ports and event format, same as in tm_stm32f4_trace.h */
+#define PORT_TEXT           2
+#define PORT_EVENT          3
+#define PORT_WATCH          8
+#define WATCHES             8
+
+#define EVENT_INSTANT       0x00
+#define EVENT_BEGIN         0x01
+#define EVENT_END           0x02
+
+/* Timeline threads */
+#define TID_EVENTS          1
+#define TID_IRQ             2
+#define TID_TEXT            3
+#define TID_PC              4
+
+/* Packets waiting for next timestamp */
+#define MAX_PENDING         1024
+#define MAX_TEXT            256
+
+static char Pending[MAX_PENDING][MAX_TEXT + 64];
+static uint32_t PendingCount = 0;
+
+/* Current time in cycles */
+static uint64_t Time = 0;
+static double Clock = 180000000.0;
+
+/* Output */
+static FILE* Out;
+static uint32_t Records = 0;
+
+/* Names from file */
+static char* EventNames[64];
+static char* WatchNames[WATCHES];
+
+/* Text being received */
+static char Text[MAX_TEXT];
+static uint16_t TextLength = 0;
+
+/* Statistics */
+static uint32_t Overflows = 0;
+
+static void
+WriteRecord(const char* record, uint64_t time) {
+    fprintf(Out, "%s\n{%s,\"pid\":1,\"ts\":%.3f}", Records++ ? "," : "", record, time * 1000000.0 / Clock);
+}
+
+static void
+AddRecord(const char* format, ...) {
+    va_list args;
+
+    /* Write now when buffer is full, time is not accurate then */
+    if (PendingCount == MAX_PENDING) {
+        WriteRecord(Pending[0], Time);
+        memmove(Pending[0], Pending[1], sizeof(Pending[0]) * (MAX_PENDING - 1));
+        PendingCount--;
+    }
+
+    va_start(args, format);
+    vsnprintf(Pending[PendingCount++], sizeof(Pending[0]), format, args);
+    va_end(args);
+}
+
+static void
+Timestamp(uint32_t delta) {
+    uint32_t i;
+
+    /* Timestamp comes after packets it belongs to */
+    Time += delta;
+    for (i = 0; i < PendingCount; i++) {
+        WriteRecord(Pending[i], Time);
+    }
+    PendingCount = 0;
+}
+
+static void
+ThreadName(uint8_t tid, const char* name) {
+    fprintf(Out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", Records++ ? "," : "", tid, name);
+}
+
+static void
+Escape(char* dst, const char* src, size_t size) {
+    size_t i = 0;
+
+    /* Make text safe for JSON string */
+    while (*src && i + 7 < size) {
+        if (*src == '"' || *src == '\\') {
+            dst[i++] = '\\';
+            dst[i++] = *src;
+        } else if ((uint8_t)*src < 0x20) {
+            i += sprintf(&dst[i], "\\u%04x", (uint8_t)*src);
+        } else {
+            dst[i++] = *src;
+        }
+        src++;
+    }
+    dst[i] = 0;
+}
+
+static void
+ExceptionName(char* name, uint16_t number) {
+    static const char* names[16] = {
+        "Thread", "Reset", "NMI", "HardFault", "MemManage", "BusFault", "UsageFault", "Reserved",
+        "Reserved", "Reserved", "Reserved", "SVCall", "DebugMon", "Reserved", "PendSV", "SysTick"
+    };
+
+    if (number < 16) {
+        strcpy(name, names[number]);
+    } else {
+        sprintf(name, "IRQ %u", number - 16);
+    }
+}
+
+static void
+SoftwarePacket(uint8_t port, uint32_t value, uint8_t size) {
+    char name[MAX_TEXT * 6 + 1];
+    uint8_t i, type, id;
+
+    if (port == PORT_TEXT) {
+        /* Characters till zero make one text */
+        for (i = 0; i < size; i++) {
+            char ch = value >> (8 * i);
+            if (ch && TextLength < MAX_TEXT - 1) {
+                Text[TextLength++] = ch;
+            }
+            if (!ch && TextLength) {
+                /* Remove new line at the end */
+                while (TextLength && (Text[TextLength - 1] == '\n' || Text[TextLength - 1] == '\r')) {
+                    TextLength--;
+                }
+                Text[TextLength] = 0;
+                TextLength = 0;
+                Escape(name, Text, MAX_TEXT);
+                AddRecord("\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"tid\":%u", name, TID_TEXT);
+            }
+        }
+    } else if (port == PORT_EVENT && size == 4) {
+        type = value >> 30;
+        id = (value >> 24) & 0x3F;
+        if (EventNames[id]) {
+            Escape(name, EventNames[id], sizeof(name));
+        } else {
+            sprintf(name, "Event %u", id);
+        }
+        if (type == EVENT_BEGIN) {
+            AddRecord("\"name\":\"%s\",\"ph\":\"B\",\"tid\":%u", name, TID_EVENTS);
+        } else if (type == EVENT_END) {
+            AddRecord("\"name\":\"%s\",\"ph\":\"E\",\"tid\":%u", name, TID_EVENTS);
+        } else {
+            AddRecord("\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"tid\":%u,\"args\":{\"arg\":%u}", name, TID_EVENTS, value & 0xFFFFFF);
+        }
+    } else if (port >= PORT_WATCH && port < PORT_WATCH + WATCHES) {
+        id = port - PORT_WATCH;
+        if (WatchNames[id]) {
+            Escape(name, WatchNames[id], sizeof(name));
+        } else {
+            sprintf(name, "Watch %u", id);
+        }
+        AddRecord("\"name\":\"%s\",\"ph\":\"C\",\"args\":{\"value\":%d}", name, (int32_t)value);
+    }
+}
+
+static void
+HardwarePacket(uint8_t disc, uint32_t value, uint8_t size) {
+    char name[32];
+    uint16_t number;
+
+    if (disc == 1) {
+        /* Exception trace, enter or exit, return to preempted exception is not new event */
+        number = value & 0x1FF;
+        ExceptionName(name, number);
+        if (((value >> 12) & 0x03) == 1) {
+            AddRecord("\"name\":\"%s\",\"ph\":\"B\",\"tid\":%u", name, TID_IRQ);
+        } else if (((value >> 12) & 0x03) == 2) {
+            AddRecord("\"name\":\"%s\",\"ph\":\"E\",\"tid\":%u", name, TID_IRQ);
+        }
+    } else if (disc == 2) {
+        /* PC sample, 1 byte packet means CPU was sleeping */
+        if (size == 4) {
+            AddRecord("\"name\":\"0x%08X\",\"ph\":\"i\",\"s\":\"t\",\"tid\":%u", value, TID_PC);
+        } else {
+            AddRecord("\"name\":\"Sleep\",\"ph\":\"i\",\"s\":\"t\",\"tid\":%u", TID_PC);
+        }
+    } else if (disc >= 8 && disc < 16 && !(disc & 0x01)) {
+        /* PC of data access */
+        AddRecord("\"name\":\"DWT %u at 0x%08X\",\"ph\":\"i\",\"s\":\"t\",\"tid\":%u", (disc >> 1) & 0x03, value, TID_PC);
+    } else if (disc >= 16 && disc < 24) {
+        /* Data value */
+        AddRecord("\"name\":\"DWT %u\",\"ph\":\"C\",\"args\":{\"%s\":%u}", (disc >> 1) & 0x03, disc & 0x01 ? "write" : "read", value);
+    }
+}
+
+static void
+Decode(FILE* f) {
+    int ch, data, i, size;
+    uint32_t value;
+
+    while ((ch = fgetc(f)) != EOF) {
+        /* Sync packet, ends with 0x80 */
+        if (ch == 0x00 || ch == 0x80) {
+            continue;
+        }
+
+        /* Overflow, some packets were lost */
+        if (ch == 0x70) {
+            Overflows++;
+            AddRecord("\"name\":\"Overflow\",\"ph\":\"i\",\"s\":\"g\",\"tid\":%u", TID_EVENTS);
+            continue;
+        }
+
+        /* Source packet with 1, 2 or 4 bytes */
+        if (ch & 0x03) {
+            size = (ch & 0x03) == 3 ? 4 : (ch & 0x03);
+            value = 0;
+            for (i = 0; i < size; i++) {
+                if ((data = fgetc(f)) == EOF) {
+                    return;
+                }
+                value |= (uint32_t)data << (8 * i);
+            }
+            if (ch & 0x04) {
+                HardwarePacket(ch >> 3, value, size);
+            } else {
+                SoftwarePacket(ch >> 3, value, size);
+            }
+            continue;
+        }
+
+        /* Short local timestamp */
+        if (!(ch & 0x80) && !(ch & 0x0F)) {
+            Timestamp((ch >> 4) & 0x07);
+            continue;
+        }
+
+        /* Long local timestamp, 7 bits in each continuation byte */
+        if ((ch & 0xCF) == 0xC0) {
+            value = 0;
+            i = 0;
+            do {
+                if ((data = fgetc(f)) == EOF) {
+                    return;
+                }
+                value |= (uint32_t)(data & 0x7F) << (7 * i++);
+            } while ((data & 0x80) && i < 5);
+            Timestamp(value);
+            continue;
+        }
+
+        /* Global timestamps and extension packets are skipped */
+        if (ch & 0x80) {
+            while ((data = fgetc(f)) != EOF && (data & 0x80));
+        }
+    }
+}
+
+static void
+ReadNames(const char* filename) {
+    char line[256], type[16], name[200];
+    unsigned id;
+    FILE* f;
+
+    f = fopen(filename, "r");
+    if (!f) {
+        fprintf(stderr, "Can't open %s\n", filename);
+        exit(1);
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%15s %u %199[^\r\n]", type, &id, name) != 3) {
+            continue;
+        }
+        if (!strcmp(type, "event") && id < 64) {
+            EventNames[id] = strdup(name);
+        } else if (!strcmp(type, "watch") && id < WATCHES) {
+            WatchNames[id] = strdup(name);
+        }
+    }
+    fclose(f);
+}
+
+int
+main(int argc, char** argv) {
+    FILE* f = stdin;
+    int opt;
+
+    Out = stdout;
+
+    /* Parse arguments */
+    while ((opt = getopt(argc, argv, "c:n:o:")) != -1) {
+        switch (opt) {
+            case 'c': Clock = atof(optarg); break;
+            case 'n': ReadNames(optarg); break;
+            case 'o':
+                Out = fopen(optarg, "w");
+                if (!Out) {
+                    fprintf(stderr, "Can't open %s\n", optarg);
+                    return 1;
+                }
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-c clock] [-n names.txt] [-o trace.json] [capture.bin]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind < argc) {
+        f = fopen(argv[optind], "rb");
+        if (!f) {
+            fprintf(stderr, "Can't open %s\n", argv[optind]);
+            return 1;
+        }
+    }
+
+    /* Write JSON */
+    fprintf(Out, "{\"traceEvents\":[");
+    ThreadName(TID_EVENTS, "Events");
+    ThreadName(TID_IRQ, "Interrupts");
+    ThreadName(TID_TEXT, "Text");
+    ThreadName(TID_PC, "PC samples");
+    Decode(f);
+    Timestamp(0);
+    fprintf(Out, "\n]}\n");
+
+    /* Report lost data */
+    if (Overflows) {
+        fprintf(stderr, "ITM overflow %u times, use faster SWO clock or less trace\n", Overflows);
+    }
+
+    if (f != stdin) {
+        fclose(f);
+    }
+    if (Out != stdout) {
+        fclose(Out);
+    }
+    return 0;
+}
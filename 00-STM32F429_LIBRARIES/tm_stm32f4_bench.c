@@ -0,0 +1,217 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_bench.h"
+
+#if TM_BENCH_HOST
+#include <time.h>
+
+/* Time in nanoseconds */
+#define BENCH_UNIT              "ns"
+#define BENCH_CLOCK             1000000000UL
+#else
+/* Time in CPU cycles */
+#define BENCH_UNIT              "cycles"
+#define BENCH_CLOCK             SystemCoreClock
+#endif
+
+/* Runs for overhead measurement */
+#define BENCH_OVERHEAD_RUNS     1024
+
+/* Maximal number of runs in one sample */
+#define BENCH_MAX_RUNS          (1UL << 20)
+
+/* Time of BENCH_OVERHEAD_RUNS empty runs */
+static uint32_t Overhead = 0;
+
+/* Samples of current case */
+static uint32_t Samples[TM_BENCH_MAX_SAMPLES];
+
+/* Result sink for TM_BENCH_Use */
+static volatile uint32_t Sink;
+
+/* Private functions */
+static uint32_t TM_BENCH_INT_Now(void);
+static uint32_t TM_BENCH_INT_Sample(void (*Run)(void), uint32_t Runs);
+static void TM_BENCH_INT_Empty(void);
+
+void
+TM_BENCH_Init(void) {
+    uint32_t time;
+    uint8_t i;
+
+#if !TM_BENCH_HOST
+    /* Enable DWT cycle counter, running counter is not reset */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    /* Time of loop and call, take minimal value */
+    Overhead = 0xFFFFFFFF;
+    for (i = 0; i < 5; i++) {
+        time = TM_BENCH_INT_Sample(TM_BENCH_INT_Empty, BENCH_OVERHEAD_RUNS);
+        if (time < Overhead) {
+            Overhead = time;
+        }
+    }
+}
+
+void
+TM_BENCH_RunCase(const TM_BENCH_Case_t* Case, TM_BENCH_Result_t* Result) {
+    uint32_t runs, time, overhead, i, k;
+    uint64_t sum = 0;
+
+    /* Prepare case */
+    if (Case->Setup) {
+        Case->Setup();
+    }
+
+    /* Double number of runs till sample is long enough */
+    for (runs = 1; runs < BENCH_MAX_RUNS; runs *= 2) {
+        if (TM_BENCH_INT_Sample(Case->Run, runs) >= TM_BENCH_MIN_TIME) {
+            break;
+        }
+    }
+    overhead = (uint32_t)(((uint64_t)Overhead * runs) / BENCH_OVERHEAD_RUNS);
+
+    /* Warm up */
+    for (i = 0; i < TM_BENCH_WARMUP; i++) {
+        TM_BENCH_INT_Sample(Case->Run, runs);
+    }
+
+    /* Measure samples */
+    for (i = 0; i < TM_BENCH_SAMPLES; i++) {
+        time = TM_BENCH_INT_Sample(Case->Run, runs);
+        time = time > overhead ? time - overhead : 0;
+        sum += time;
+
+        /* Insert sorted */
+        for (k = i; k > 0 && Samples[k - 1] > time; k--) {
+            Samples[k] = Samples[k - 1];
+        }
+        Samples[k] = time;
+    }
+
+    /* Fill result for one run, 99th percentile with nearest rank */
+    Result->Runs = runs;
+    Result->Samples = TM_BENCH_SAMPLES;
+    Result->Min = Samples[0] / runs;
+    Result->Median = Samples[TM_BENCH_SAMPLES / 2] / runs;
+    Result->P99 = Samples[(TM_BENCH_SAMPLES * 99 + 99) / 100 - 1] / runs;
+    Result->Max = Samples[TM_BENCH_SAMPLES - 1] / runs;
+    Result->Mean = (uint32_t)(sum / TM_BENCH_SAMPLES / runs);
+
+    /* Throughput from median */
+    Result->BytesPerSecond = 0;
+    if (Case->Bytes && Samples[TM_BENCH_SAMPLES / 2]) {
+        Result->BytesPerSecond = (uint32_t)((uint64_t)Case->Bytes * runs * BENCH_CLOCK / Samples[TM_BENCH_SAMPLES / 2]);
+    }
+}
+
+uint16_t
+TM_BENCH_Run(const TM_BENCH_Suite_t* const* Suites, uint16_t Count, const char* Filter, TM_BENCH_Output_t Output) {
+    char line[128];
+    TM_BENCH_Result_t result;
+    const TM_BENCH_Suite_t* suite;
+    uint16_t s, c, cases = 0;
+
+    /* Header */
+    sprintf(line, "# TM BENCH 1, unit %s, clock %lu\n", BENCH_UNIT, (unsigned long)BENCH_CLOCK);
+    Output(line);
+    Output("suite,case,runs,samples,min,median,p99,max,mean,bytes_per_s\n");
+
+    for (s = 0; s < Count; s++) {
+        suite = Suites[s];
+
+        /* Check if any case is selected before suite is initialized */
+        for (c = 0; c < suite->Count; c++) {
+            snprintf(line, sizeof(line), "%s,%s", suite->Name, suite->Cases[c].Name);
+            if (!Filter || strstr(line, Filter)) {
+                break;
+            }
+        }
+        if (c == suite->Count) {
+            continue;
+        }
+
+        /* Prepare suite */
+        if (suite->Init && !suite->Init()) {
+            snprintf(line, sizeof(line), "# %s skipped, init failed\n", suite->Name);
+            Output(line);
+            continue;
+        }
+
+        /* Run selected cases */
+        for (c = 0; c < suite->Count; c++) {
+            snprintf(line, sizeof(line), "%s,%s", suite->Name, suite->Cases[c].Name);
+            if (Filter && !strstr(line, Filter)) {
+                continue;
+            }
+            TM_BENCH_RunCase(&suite->Cases[c], &result);
+            snprintf(line, sizeof(line), "%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+                suite->Name, suite->Cases[c].Name,
+                (unsigned long)result.Runs, (unsigned long)result.Samples,
+                (unsigned long)result.Min, (unsigned long)result.Median,
+                (unsigned long)result.P99, (unsigned long)result.Max,
+                (unsigned long)result.Mean, (unsigned long)result.BytesPerSecond
+            );
+            Output(line);
+            cases++;
+        }
+    }
+
+    /* Return number of cases */
+    return cases;
+}
+
+void
+TM_BENCH_Use(uint32_t Value) {
+    /* Volatile write can't be removed */
+    Sink = Value;
+}
+
+/* Private functions */
+static uint32_t
+TM_BENCH_INT_Now(void) {
+#if TM_BENCH_HOST
+    struct timespec ts;
+
+    /* Nanoseconds, only differences are used so overflow is not a problem */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+static uint32_t
+TM_BENCH_INT_Sample(void (*Run)(void), uint32_t Runs) {
+    uint32_t start, i;
+
+    /* Measure runs together, so timer overhead is small */
+    start = TM_BENCH_INT_Now();
+    for (i = 0; i < Runs; i++) {
+        Run();
+    }
+    return TM_BENCH_INT_Now() - start;
+}
+
+static void
+TM_BENCH_INT_Empty(void) {
+    /* Used to measure loop and call overhead */
+}
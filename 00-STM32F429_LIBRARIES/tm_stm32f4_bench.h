@@ -0,0 +1,310 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Micro benchmark framework for libraries which runs on STM32F4xx and on PC
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_BENCH_H
+#define TM_BENCH_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_BENCH
+ * @brief    Micro benchmark framework for libraries which runs on STM32F4xx and on PC
+ * @{
+ *
+ * Library measures how long functions take, so you can compare library versions and settings with real numbers.
+ *
+ * \par Cases and suites
+ *
+ * Case is a function which does one piece of work, like one FFT or one file write.
+ * Cases are grouped to suites, each suite can have init function which prepares everything, like LCD or file system:
+ *
+\code{.c}
+static void CaseFill(void) {
+    TM_ILI9341_Fill(ILI9341_COLOR_RED);
+}
+
+static const TM_BENCH_Case_t GraphicCases[] = {
+    TM_BENCH_CASE("fill", CaseFill),
+    TM_BENCH_CASE_BYTES("fill_bytes", CaseFill, 240 * 320 * 2),
+};
+TM_BENCH_SUITE(GraphicSuite, "graphic", GraphicInit, GraphicCases);
+\endcode
+ *
+ * \par Measurement
+ *
+ * For each case library:
+ *
+ *  - Calls setup function of case, if set
+ *  - Finds number of runs for one sample, so that one sample takes at least TM_BENCH_MIN_TIME
+ *  - Makes TM_BENCH_WARMUP samples which are not counted, to fill caches and buffers
+ *  - Makes TM_BENCH_SAMPLES samples and sorts them
+ *
+ * Results are time for one run: minimum, median, 99th percentile, maximum and mean.
+ * Time of calling empty function is measured in @ref TM_BENCH_Init and subtracted.
+ *
+ * On STM32F4xx, time is in CPU cycles from DWT counter. On PC, time is in nanoseconds from clock_gettime.
+ * Set TM_BENCH_HOST to 1 in defines.h for PC build.
+ *
+ * \par Output
+ *
+ * Results are printed as CSV text with output function, like USART, SWO or stdout:
+ *
+@verbatim
+# TM BENCH 1, unit cycles, clock 180000000
+suite,case,runs,samples,min,median,p99,max,mean,bytes_per_s
+fft,f32_1024,16,31,52012,52040,52361,52361,52071,0
+@endverbatim
+ *
+ * Lines starting with # are comments. bytes_per_s is calculated from median for cases with bytes set.
+ *
+ * Suites for TM libraries are in bench/ folder, 64-STM32F429_BENCHMARK runs them on board
+ * and "make bench-run" in host/ folder runs them on PC.
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - string.h
+ - stdio.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "string.h"
+#include "stdio.h"
+
+/**
+ * @defgroup TM_BENCH_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Set to 1 when library is compiled for PC
+ */
+#ifndef TM_BENCH_HOST
+#define TM_BENCH_HOST           0
+#endif
+
+/**
+ * @brief  Number of measured samples for each case, maximal value is TM_BENCH_MAX_SAMPLES
+ */
+#ifndef TM_BENCH_SAMPLES
+#define TM_BENCH_SAMPLES        31
+#endif
+
+/**
+ * @brief  Number of samples before measurement which are not counted
+ */
+#ifndef TM_BENCH_WARMUP
+#define TM_BENCH_WARMUP         2
+#endif
+
+/**
+ * @brief  Minimal time for one sample, in cycles on STM32F4xx or nanoseconds on PC
+ */
+#ifndef TM_BENCH_MIN_TIME
+#if TM_BENCH_HOST
+#define TM_BENCH_MIN_TIME       200000
+#else
+#define TM_BENCH_MIN_TIME       50000
+#endif
+#endif
+
+/**
+ * @brief  Size of array for samples
+ */
+#define TM_BENCH_MAX_SAMPLES    101
+
+/* Check settings */
+#if TM_BENCH_SAMPLES > TM_BENCH_MAX_SAMPLES || TM_BENCH_SAMPLES < 1
+#error "TM_BENCH_SAMPLES must be from 1 to TM_BENCH_MAX_SAMPLES"
+#endif
+
+/**
+ * @brief  Creates case
+ * @param  name: Case name
+ * @param  run: Measured function
+ */
+#define TM_BENCH_CASE(name, run)                        {(name), NULL, (run), 0}
+
+/**
+ * @brief  Creates case with number of bytes processed in one run, for throughput
+ * @param  name: Case name
+ * @param  run: Measured function
+ * @param  bytes: Number of bytes processed in one run
+ */
+#define TM_BENCH_CASE_BYTES(name, run, bytes)           {(name), NULL, (run), (bytes)}
+
+/**
+ * @brief  Creates case with setup function, which is called once before case and is not measured
+ * @param  name: Case name
+ * @param  setup: Setup function
+ * @param  run: Measured function
+ * @param  bytes: Number of bytes processed in one run, 0 if not used
+ */
+#define TM_BENCH_CASE_SETUP(name, setup, run, bytes)    {(name), (setup), (run), (bytes)}
+
+/**
+ * @brief  Creates suite variable from array of cases
+ * @param  var: Variable name
+ * @param  name: Suite name
+ * @param  init: Init function for suite or NULL. It returns 0 when suite can't run
+ * @param  cases: Array of @ref TM_BENCH_Case_t structures
+ */
+#define TM_BENCH_SUITE(var, name, init, cases)          const TM_BENCH_Suite_t var = {(name), (init), (cases), sizeof(cases) / sizeof((cases)[0])}
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_BENCH_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Benchmark case
+ */
+typedef struct {
+    const char* Name;           /*!< Case name */
+    void (*Setup)(void);        /*!< Function called once before case, not measured. Can be NULL */
+    void (*Run)(void);          /*!< Measured function */
+    uint32_t Bytes;             /*!< Number of bytes processed in one run, 0 if throughput is not calculated */
+} TM_BENCH_Case_t;
+
+/**
+ * @brief  Benchmark suite
+ */
+typedef struct {
+    const char* Name;               /*!< Suite name */
+    uint8_t (*Init)(void);          /*!< Init function, returns 0 when suite can't run. Can be NULL */
+    const TM_BENCH_Case_t* Cases;   /*!< Array of cases */
+    uint16_t Count;                 /*!< Number of cases */
+} TM_BENCH_Suite_t;
+
+/**
+ * @brief  Result for one case, times are for one run
+ */
+typedef struct {
+    uint32_t Runs;              /*!< Number of runs in one sample */
+    uint32_t Samples;           /*!< Number of samples */
+    uint32_t Min;               /*!< Minimal time */
+    uint32_t Median;            /*!< Median time */
+    uint32_t P99;               /*!< 99th percentile time */
+    uint32_t Max;               /*!< Maximal time */
+    uint32_t Mean;              /*!< Mean time */
+    uint32_t BytesPerSecond;    /*!< Throughput from median, 0 if case has no bytes set */
+} TM_BENCH_Result_t;
+
+/**
+ * @brief  Output function for text
+ * @param  *str: Text to output
+ * @retval None
+ */
+typedef void (*TM_BENCH_Output_t)(const char* str);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_BENCH_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes time source and measures overhead of empty run
+ * @param  None
+ * @retval None
+ */
+void TM_BENCH_Init(void);
+
+/**
+ * @brief  Runs one case
+ * @param  *Case: Pointer to @ref TM_BENCH_Case_t structure
+ * @param  *Result: Pointer to @ref TM_BENCH_Result_t structure to save result to
+ * @retval None
+ */
+void TM_BENCH_RunCase(const TM_BENCH_Case_t* Case, TM_BENCH_Result_t* Result);
+
+/**
+ * @brief  Runs suites and prints results
+ * @param  **Suites: Array of pointers to @ref TM_BENCH_Suite_t structures
+ * @param  Count: Number of suites in array
+ * @param  *Filter: Only suites and cases which contain this text in "suite,case" name are run. NULL to run all
+ * @param  Output: Output function for results
+ * @retval Number of cases run
+ */
+uint16_t TM_BENCH_Run(const TM_BENCH_Suite_t* const* Suites, uint16_t Count, const char* Filter, TM_BENCH_Output_t Output);
+
+/**
+ * @brief  Prevents compiler from removing calculation which result is not used
+ * @param  Value: Result of calculation
+ * @retval None
+ */
+void TM_BENCH_Use(uint32_t Value);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -17,6 +17,9 @@
  * |----------------------------------------------------------------------
  */
 #include "tm_stm32f4_button.h"
+#if TM_BUTTON_USE_POOL == 1
+#include "tm_stm32f4_pool.h"
+#endif
 
 /* Button states */
 #define BUTTON_STATE_START        0
@@ -30,6 +33,11 @@ typedef struct {
 } TM_BUTTON_INT_t;
 static TM_BUTTON_INT_t Buttons;
 
+#if TM_BUTTON_USE_POOL == 1
+/* Static memory for buttons */
+TM_POOL_DEFINE(ButtonPool, TM_BUTTON_t, BUTTON_MAX_BUTTONS);
+#endif
+
 /* Internal functions */
 void TM_BUTTON_INT_CheckButton(TM_BUTTON_t* ButtonStruct);
 
@@ -47,7 +55,11 @@ TM_BUTTON_Init(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, uint8_t ButtonState, void
     }
 
     /* Allocate memory for button */
+#if TM_BUTTON_USE_POOL == 1
+    ButtonStruct = TM_POOL_New(&ButtonPool, TM_BUTTON_t);
+#else
     ButtonStruct = (TM_BUTTON_t*) malloc(sizeof(TM_BUTTON_t));
+#endif
 
     /* Check if allocated */
     if (ButtonStruct == NULL) {
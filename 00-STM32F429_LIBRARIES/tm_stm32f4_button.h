@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/04/library-57-buttons-for-stm32f4xx/
- * @version v1.0
+ * @version v1.1
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   Buttons library for STM32F4xx devices
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_BUTTON_H
-#define TM_BUTTON_H 100
+#define TM_BUTTON_H 110
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -48,9 +48,19 @@ extern "C" {
  * This library works with external buttons.
  * It can detect button on pressed, normal button press and long button press
  *
+ * \par Memory
+ *
+ * By default, memory for each button is allocated with malloc.
+ * Set TM_BUTTON_USE_POOL to 1 in defines.h and buttons are taken from static TM POOL with BUTTON_MAX_BUTTONS objects.
+ * Add tm_stm32f4_pool.c to project in this case.
+ *
  * \par Changelog
  *
 @verbatim
+ Version 1.1
+  - October 16, 2026
+  - Added TM_BUTTON_USE_POOL to use static pool instead of malloc
+
  Version 1.0
   - First release
 @endverbatim
@@ -62,6 +72,7 @@ extern "C" {
  - defines.h
  - TM GPIO
  - TM DELAY
+ - TM POOL, if TM_BUTTON_USE_POOL is 1
  - stdlib.h
 @endverbatim
  */
@@ -93,6 +104,11 @@ extern "C" {
 #define BUTTON_LONG_PRESS_TIME    1500
 #endif
 
+/* Set to 1 to take buttons from static pool instead of malloc */
+#ifndef TM_BUTTON_USE_POOL
+#define TM_BUTTON_USE_POOL        0
+#endif
+
 /**
  * @}
  */
@@ -139,7 +155,8 @@ typedef struct _TM_BUTTON_t {
 
 /**
  * @brief  Initializes a new button to library
- * @note   This library uses @ref malloc() to allocate memory, so make sure you have enough heap memory
+ * @note   This library uses @ref malloc() to allocate memory, so make sure you have enough heap memory.
+ *         When TM_BUTTON_USE_POOL is 1, static pool is used instead
  * @param  *GPIOx: Pointer to GPIOx where button is located
  * @param  GPIO_Pin: GPIO pin where button is located
  * @param  ButtonState: Button state when it is pressed.
@@ -0,0 +1,62 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_ccm.h"
+
+#if defined (__GNUC__) && !defined (__CC_ARM) && TM_CCM_ENABLED == 1
+/* Symbols from STM32F429_CCM.ld */
+extern uint32_t _siccmram, _sccmram, _eccmram, _sccmbss, _eccmbss;
+extern uint8_t end, _heap_limit;
+
+void
+TM_CCM_Init(void) {
+    /* Copy initial values from flash */
+    memcpy(&_sccmram, &_siccmram, (uint8_t *)&_eccmram - (uint8_t *)&_sccmram);
+
+    /* Clear zero variables */
+    memset(&_sccmbss, 0, (uint8_t *)&_eccmbss - (uint8_t *)&_sccmbss);
+}
+
+/* Heap for malloc, from end of .bss to end of SRAM */
+/* Default _sbrk compares heap with stack pointer, which is in CCM RAM now. Own _sbrk in project is used instead of this one */
+__weak void*
+_sbrk(int incr) {
+    static uint8_t* heap = NULL;
+    uint8_t* prev;
+
+    /* First call */
+    if (heap == NULL) {
+        heap = &end;
+    }
+
+    /* Check memory */
+    if (heap + incr > &_heap_limit) {
+        return (void *)-1;
+    }
+
+    /* Move heap end */
+    prev = heap;
+    heap += incr;
+    return prev;
+}
+#else
+void
+TM_CCM_Init(void) {
+    /* Scatter loading in __main does it for Keil, nothing to do when CCM RAM is disabled */
+}
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   CCM RAM startup initialization and memory checks
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_CCM_H
+#define TM_CCM_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_CCM
+ * @brief    CCM RAM startup initialization and memory checks
+ * @{
+ *
+ * STM32F429 has 64kB of CCM (core coupled memory) RAM at address 0x10000000.
+ * It is connected directly to CPU data bus, so CPU reads it without wait states also when DMA2D, LTDC
+ * and Ethernet DMA use SRAM at full speed. DMA controllers can't access CCM RAM.
+ *
+ * \par Placing variables
+ *
+ * Use TM_CCM_DATA or TM_CCM_BSS from attributes.h after variable name:
+ *
+\code{.c}
+//Variable with initial value
+static uint32_t Counter TM_CCM_DATA = 10;
+
+//Variable set to zero at startup
+static float32_t Samples[512] TM_CCM_BSS;
+\endcode
+ *
+ * When CCM RAM is enabled, these libraries put their internal state there:
+ *
+ *  - TM FFT: copies of twiddle factor tables, TM_FFT_TWIDDLE_CCM_SIZE bytes
+ *  - TM GPS: parser state
+ *  - TM USART: ring buffer control structures, buffers stay in SRAM
+ *  - TM PROFILE: zone statistics table
+ *
+ * \par Linker
+ *
+ * Linker must know where CCM sections go. linker/ folder has files for STM32F429ZI:
+ *
+ *  - STM32F429_CCM.sct for Keil uVision. Scatter loading copies and clears CCM sections
+ *  - STM32F429_CCM.ld for GCC. Call @ref TM_CCM_Init at the end of SystemInit() function
+ *
+ * Both files also put main stack to CCM RAM, so interrupts and function calls don't wait for DMA.
+ *
+ * \par DMA
+ *
+ * DMA can't read or write CCM RAM. Local variables are on stack in CCM RAM too.
+ * TM USART DMA and TM SPI DMA return error for buffers in CCM RAM, use global variables for DMA buffers.
+ * SDIO FatFs driver copies sectors through SRAM buffer when buffer is in CCM RAM.
+ * Use TM_IS_CCM() macro to check pointers in your code.
+ *
+ * \par Enable CCM RAM
+ *
+ * CCM RAM is not used by default, TM_CCM_DATA and TM_CCM_BSS are empty and all variables stay in SRAM.
+ * Stock linker files and startup code don't initialize CCM sections, so enable it only together with linker file:
+ *
+ *  - Use STM32F429_CCM.sct or STM32F429_CCM.ld linker file from linker/ folder
+ *  - For GCC, call @ref TM_CCM_Init at the end of SystemInit() function
+ *  - Add "#define TM_CCM_ENABLED 1" to defines.h
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - attributes.h
+ - string.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "attributes.h"
+#include "string.h"
+
+/**
+ * @defgroup TM_CCM_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Copies initial values to TM_CCM_DATA variables and clears TM_CCM_BSS variables
+ * @note   Needed only for GCC with STM32F429_CCM.ld, call it once at the end of SystemInit().
+ *         For Keil, scatter loading does this and function does nothing
+ * @param  None
+ * @retval None
+ */
+void TM_CCM_Init(void);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -50,6 +50,11 @@ TM_CPULOAD_GoToSleepMode(TM_CPULOAD_t* CPU_Load, TM_LOWPOWERMODE_t PowerMode) {
     /* Wait for wake up interrupt, systick can do it too */
     if (PowerMode == TM_LOWPOWERMODE_SleepUntilInterrupt) {
         __WFI();
+    } else if (PowerMode == TM_LOWPOWERMODE_SleepTickless) {
+        /* Delay timer wakes up only when custom timer expires */
+        TM_DELAY_TicklessEnter(0xFFFFFFFF);
+        __WFI();
+        TM_DELAY_TicklessExit();
     } else {
         __WFE();
     }
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/05/library-60-cpu-load-monitor-for-stm32f4xx-devices
- * @version v1.0
+ * @version v1.1
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   CPU load monitoring for STM32F4xx
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_CPU_LOAD_H
-#define TM_CPU_LOAD_H 100
+#define TM_CPU_LOAD_H 110
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -48,6 +48,10 @@ extern "C" {
  * \par Changelog
  *
 @verbatim
+ Version 1.1
+  - October 16, 2026
+  - Added support for TM_LOWPOWERMODE_SleepTickless mode
+
  Version 1.0
   - First release
 @endverbatim
@@ -123,6 +127,7 @@ uint8_t TM_CPULOAD_Init(TM_CPULOAD_t* CPU_Load);
  * @param  PowerMode: Select power mode you want to use for measure CPU load. Valid parameters are:
  *            - TM_LOWPOWERMODE_SleepUntilInterrupt: Go to sleep mode with __WFI() instruction
  *            - TM_LOWPOWERMODE_SleepUntilEvent: Go to sleep mode with __WFE() instruction
+ *            - TM_LOWPOWERMODE_SleepTickless: Go to sleep mode with __WFI() instruction, delay ticks are skipped till next custom timer expires
  * @retval CPU load value updated status.
  *           - 0: CPU load value is not updated, still old results
  *           - > 0: CPU load value is updated
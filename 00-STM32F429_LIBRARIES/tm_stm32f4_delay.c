@@ -23,15 +23,53 @@ __IO uint32_t TM_Time = 0;
 __IO uint32_t TM_Time2 = 0;
 volatile uint32_t mult;
 uint8_t TM_DELAY_Initialized = 0;
+__IO uint32_t TM_DELAY_CyclesEpoch = 0;
+uint32_t TM_DELAY_CyclesPerUs = 0;
+uint8_t TM_DELAY_CyclesDWT = 0;
 
-/* Private structure */
+/* Number of slots in one wheel level */
+#define DELAY_WHEEL_SLOTS       (1UL << DELAY_WHEEL_BITS)
+#define DELAY_WHEEL_MASK        (DELAY_WHEEL_SLOTS - 1)
+
+/* Slot index on level for tick */
+#define DELAY_WHEEL_INDEX(tick, level)  (((tick) >> ((level) * DELAY_WHEEL_BITS)) & DELAY_WHEEL_MASK)
+
+/**
+ * @brief  Hierarchical timing wheel for custom timers
+ * @note   Used private
+ */
 typedef struct {
-    uint8_t Count;
-    TM_DELAY_Timer_t* Timers[DELAY_MAX_CUSTOM_TIMERS];
-} TM_DELAY_Timers_t;
+    uint32_t Time;                                                /*!< Next tick to be processed */
+    TM_DELAY_Timer_t* Slots[DELAY_WHEEL_LEVELS][DELAY_WHEEL_SLOTS]; /*!< Lists of timers, level 0 has 1ms slots, each next level has DELAY_WHEEL_SLOTS times longer slots */
+    TM_DELAY_Timer_t* Deferred;                                   /*!< First timer with pending deferred callback */
+    TM_DELAY_Timer_t** DeferredLast;                              /*!< Pointer to next pointer of last timer in deferred list */
+} TM_DELAY_Wheel_t;
 
 /* Custom timers structure */
-static TM_DELAY_Timers_t CustomTimers;
+static TM_DELAY_Wheel_t Wheel = {0, {{NULL}}, NULL, &Wheel.Deferred};
+
+/* Timers for TM_DELAY_TimerCreate */
+static TM_DELAY_Timer_t TimerPool[DELAY_MAX_CUSTOM_TIMERS];
+
+/**
+ * @brief  Tickless idle state
+ * @note   Used private
+ */
+typedef struct {
+    uint32_t Ticks;  /*!< Number of ticks programmed, 0 when not in tickless mode */
+    uint32_t Reload; /*!< Systick reload value for sleep */
+    uint32_t Start;  /*!< Systick value when sleep started */
+} TM_DELAY_Tickless_t;
+
+static TM_DELAY_Tickless_t Tickless;
+
+/* Private functions */
+static void TM_DELAY_INT_TimersTick(void);
+static void TM_DELAY_INT_Insert(TM_DELAY_Timer_t* Timer);
+static void TM_DELAY_INT_Remove(TM_DELAY_Timer_t* Timer);
+static uint32_t TM_DELAY_INT_NextEvent(uint32_t MaxTicks);
+static void TM_DELAY_INT_Skip(uint32_t Ticks);
+static void TM_DELAY_INT_CyclesUpdate(void);
 
 #if defined(TM_DELAY_TIM)
 void TM_DELAY_INT_InitTIM(void);
@@ -40,15 +78,12 @@ void TM_DELAY_INT_InitTIM(void);
 #if defined(TM_DELAY_TIM)
 void
 TM_DELAY_TIM_IRQ_HANDLER(void) {
-    uint8_t i;
     TM_DELAY_TIM->SR = ~TIM_IT_Update;
 #elif defined(KEIL_IDE)
 void TimingDelay_Decrement(void) {
-    uint8_t i;
 #else
 void
 SysTick_Handler(void) {
-    uint8_t i;
 #endif
 
     TM_Time++;
@@ -56,40 +91,39 @@ SysTick_Handler(void) {
         TM_Time2--;
     }
 
+    /* Track cycle clock counter overflows */
+    TM_DELAY_INT_CyclesUpdate();
+
     /* Call user function */
     TM_DELAY_1msHandler();
 
     /* Check custom timers */
-    for (i = 0; i < CustomTimers.Count; i++) {
-        /* Check if timer is enabled */
-        if (
-            CustomTimers.Timers[i] &&          /*!< Pointer exists */
-            CustomTimers.Timers[i]->Enabled && /*!< Timer is enabled */
-            CustomTimers.Timers[i]->CNT > 0    /*!< Counter is not NULL */
-        ) {
-            /* Decrease counter */
-            CustomTimers.Timers[i]->CNT--;
-
-            /* Check if count is zero */
-            if (CustomTimers.Timers[i]->CNT == 0) {
-                /* Call user callback function */
-                CustomTimers.Timers[i]->Callback(CustomTimers.Timers[i]->UserParameters);
-
-                /* Set new counter value */
-                CustomTimers.Timers[i]->CNT = CustomTimers.Timers[i]->ARR;
-
-                /* Disable timer if auto reload feature is not used */
-                if (!CustomTimers.Timers[i]->AutoReload) {
-                    /* Disable counter */
-                    CustomTimers.Timers[i]->Enabled = 0;
-                }
-            }
-        }
-    }
+    TM_DELAY_INT_TimersTick();
 }
 
 void
 TM_DELAY_Init(void) {
+    uint32_t c;
+
+    /* Enable DWT counter, do not reset it if it is already running */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* Cycles in one microsecond, also used for 1ms ticks when DWT does not run */
+    TM_DELAY_CyclesPerUs = SystemCoreClock / 1000000;
+
+    /* Check if DWT has started */
+    c = DWT->CYCCNT;
+    __NOP();
+    __NOP();
+    if (DWT->CYCCNT != c) {
+        /* Start epoch in current half period only once, other libraries call init again */
+        if (!TM_DELAY_CyclesDWT) {
+            TM_DELAY_CyclesEpoch = DWT->CYCCNT >> 31;
+            TM_DELAY_CyclesDWT = 1;
+        }
+    }
+
 #if defined(TM_DELAY_TIM)
     TM_DELAY_INT_InitTIM();
 #else
@@ -184,57 +218,64 @@ TM_DELAY_INT_InitTIM(void) {
 #endif
 
 TM_DELAY_Timer_t*
-TM_DELAY_TimerCreate(uint32_t ReloadValue, uint8_t AutoReload, uint8_t StartTimer, void (*TM_DELAY_CustomTimerCallback)(void*), void* UserParameters) {
-    TM_DELAY_Timer_t* tmp;
-
-    /* Check if available */
-    if (CustomTimers.Count >= DELAY_MAX_CUSTOM_TIMERS) {
-        return NULL;
-    }
-
-    /* Try to allocate memory for timer structure */
-    tmp = (TM_DELAY_Timer_t*) LIB_ALLOC_FUNC(sizeof(TM_DELAY_Timer_t));
-
-    /* Check if allocated */
-    if (tmp == NULL) {
-        return NULL;
-    }
-
+TM_DELAY_TimerInit(TM_DELAY_Timer_t* Timer, uint32_t ReloadValue, uint8_t AutoReload, uint8_t StartTimer, void (*TM_DELAY_CustomTimerCallback)(void*), void* UserParameters) {
     /* Fill settings */
-    tmp->ARR = ReloadValue;
-    tmp->CNT = tmp->ARR;
-    tmp->AutoReload = AutoReload;
-    tmp->Enabled = StartTimer;
-    tmp->Callback = TM_DELAY_CustomTimerCallback;
-    tmp->UserParameters = UserParameters;
+    Timer->ARR = ReloadValue;
+    Timer->CNT = ReloadValue;
+    Timer->AutoReload = AutoReload;
+    Timer->Enabled = 0;
+    Timer->Callback = TM_DELAY_CustomTimerCallback;
+    Timer->UserParameters = UserParameters;
+    Timer->Next = NULL;
+    Timer->PPrev = NULL;
+    Timer->NextDeferred = NULL;
+    Timer->Deferred = 0;
+    Timer->Pending = 0;
 
-    /* Increase number of timers in memory */
-    CustomTimers.Timers[CustomTimers.Count++] = tmp;
+    /* Start timer */
+    if (StartTimer) {
+        TM_DELAY_TimerStart(Timer);
+    }
 
     /* Return pointer to user */
-    return tmp;
+    return Timer;
 }
 
-void
-TM_DELAY_TimerDelete(TM_DELAY_Timer_t* Timer) {
-    uint8_t i;
+TM_DELAY_Timer_t*
+TM_DELAY_TimerCreate(uint32_t ReloadValue, uint8_t AutoReload, uint8_t StartTimer, void (*TM_DELAY_CustomTimerCallback)(void*), void* UserParameters) {
+    uint16_t i;
     uint32_t irq;
-    TM_DELAY_Timer_t* tmp;
 
-    /* Get location in array of pointers */
-    for (i = 0; i < CustomTimers.Count; i++) {
-        if (Timer == CustomTimers.Timers[i]) {
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+
+    /* Find free timer in pool */
+    __disable_irq();
+    for (i = 0; i < DELAY_MAX_CUSTOM_TIMERS; i++) {
+        if (!TimerPool[i].Allocated) {
+            TimerPool[i].Allocated = 1;
             break;
         }
     }
 
-    /* Check for valid input */
-    if (i == CustomTimers.Count) {
-        return;
+    /* Enable IRQ if necessary */
+    if (!irq) {
+        __enable_irq();
+    }
+
+    /* Check if available */
+    if (i == DELAY_MAX_CUSTOM_TIMERS) {
+        return NULL;
     }
 
-    /* Save pointer to timer */
-    tmp = CustomTimers.Timers[i];
+    /* Fill settings */
+    return TM_DELAY_TimerInit(&TimerPool[i], ReloadValue, AutoReload, StartTimer, TM_DELAY_CustomTimerCallback, UserParameters);
+}
+
+void
+TM_DELAY_TimerDelete(TM_DELAY_Timer_t* Timer) {
+    uint32_t irq;
+    TM_DELAY_Timer_t** pp;
 
     /* Get interrupt status */
     irq = __get_PRIMASK();
@@ -242,37 +283,76 @@ TM_DELAY_TimerDelete(TM_DELAY_Timer_t* Timer) {
     /* Disable interrupts */
     __disable_irq();
 
-    /* Shift array up */
-    for (; i < (CustomTimers.Count - 1); i++) {
-        /* Shift data to the left */
-        CustomTimers.Timers[i] = CustomTimers.Timers[i + 1];
+    /* Remove from wheel */
+    TM_DELAY_INT_Remove(Timer);
+    Timer->Enabled = 0;
+
+    /* Remove from deferred list */
+    if (Timer->Pending) {
+        for (pp = &Wheel.Deferred; *pp != Timer; pp = &(*pp)->NextDeferred);
+        *pp = Timer->NextDeferred;
+        if (Wheel.DeferredLast == &Timer->NextDeferred) {
+            Wheel.DeferredLast = pp;
+        }
+        Timer->Pending = 0;
     }
 
-    /* Decrease count */
-    CustomTimers.Count--;
+    /* Return timer to pool */
+    Timer->Allocated = 0;
 
     /* Enable IRQ if necessary */
     if (!irq) {
         __enable_irq();
     }
-
-    /* Free timer */
-    LIB_FREE_FUNC(tmp);
 }
 
 TM_DELAY_Timer_t*
 TM_DELAY_TimerStop(TM_DELAY_Timer_t* Timer) {
+    uint32_t irq;
+
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+    __disable_irq();
+
+    /* Save remaining time for start */
+    if (Timer->Enabled && Timer->PPrev) {
+        Timer->CNT = Timer->Expire - Wheel.Time + 1;
+    }
+
     /* Disable timer */
+    TM_DELAY_INT_Remove(Timer);
     Timer->Enabled = 0;
 
+    /* Enable IRQ if necessary */
+    if (!irq) {
+        __enable_irq();
+    }
+
     /* Return pointer */
     return Timer;
 }
 
 TM_DELAY_Timer_t*
 TM_DELAY_TimerStart(TM_DELAY_Timer_t* Timer) {
-    /* Enable timer */
-    Timer->Enabled = 1;
+    uint32_t irq;
+
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+    __disable_irq();
+
+    /* Enable timer, it continues with remaining time */
+    if (!Timer->Enabled) {
+        Timer->Enabled = 1;
+        if (Timer->CNT) {
+            Timer->Expire = Wheel.Time + Timer->CNT - 1;
+            TM_DELAY_INT_Insert(Timer);
+        }
+    }
+
+    /* Enable IRQ if necessary */
+    if (!irq) {
+        __enable_irq();
+    }
 
     /* Return pointer */
     return Timer;
@@ -280,9 +360,29 @@ TM_DELAY_TimerStart(TM_DELAY_Timer_t* Timer) {
 
 TM_DELAY_Timer_t*
 TM_DELAY_TimerReset(TM_DELAY_Timer_t* Timer) {
+    uint32_t irq;
+
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+    __disable_irq();
+
     /* Reset timer */
     Timer->CNT = Timer->ARR;
 
+    /* Move running timer to new position */
+    if (Timer->Enabled) {
+        TM_DELAY_INT_Remove(Timer);
+        if (Timer->CNT) {
+            Timer->Expire = Wheel.Time + Timer->CNT - 1;
+            TM_DELAY_INT_Insert(Timer);
+        }
+    }
+
+    /* Enable IRQ if necessary */
+    if (!irq) {
+        __enable_irq();
+    }
+
     /* Return pointer */
     return Timer;
 }
@@ -304,3 +404,404 @@ TM_DELAY_TimerAutoReloadValue(TM_DELAY_Timer_t* Timer, uint32_t AutoReloadValue)
     /* Return pointer */
     return Timer;
 }
+
+TM_DELAY_Timer_t*
+TM_DELAY_TimerDeferred(TM_DELAY_Timer_t* Timer, uint8_t Deferred) {
+    /* Set callback mode */
+    Timer->Deferred = Deferred;
+
+    /* Return pointer */
+    return Timer;
+}
+
+void
+TM_DELAY_TimerProcess(void) {
+    TM_DELAY_Timer_t* Timer;
+    uint8_t pending;
+    uint32_t irq;
+
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+
+    while (1) {
+        /* Get first timer from deferred list */
+        __disable_irq();
+        Timer = Wheel.Deferred;
+        if (Timer) {
+            Wheel.Deferred = Timer->NextDeferred;
+            if (!Wheel.Deferred) {
+                Wheel.DeferredLast = &Wheel.Deferred;
+            }
+            pending = Timer->Pending;
+            Timer->Pending = 0;
+        }
+        if (!irq) {
+            __enable_irq();
+        }
+
+        /* No more callbacks */
+        if (!Timer) {
+            break;
+        }
+
+        /* Call callback for each expiration */
+        while (pending--) {
+            Timer->Callback(Timer->UserParameters);
+        }
+    }
+}
+
+uint32_t
+TM_DELAY_TicklessEnter(uint32_t MaxTime) {
+    uint32_t ticks, max;
+#if defined(TM_DELAY_TIM)
+    /* Timer counts microseconds, 16-bit timers can count only 65ms */
+    if (TM_DELAY_TIM == TIM2 || TM_DELAY_TIM == TIM5) {
+        max = 0xFFFFFFFF / 1000;
+    } else {
+        max = 0xFFFF / 1000;
+    }
+#else
+    uint32_t cpt = SystemCoreClock / 1000;
+
+    /* Systick has 24-bit counter */
+    max = SysTick_LOAD_RELOAD_Msk / cpt;
+#endif
+
+    /* Cycle clock needs interrupt at least every 2^31 CPU cycles */
+    if (max > 0x7FFFFFFF / (SystemCoreClock / 1000) - 1) {
+        max = 0x7FFFFFFF / (SystemCoreClock / 1000) - 1;
+    }
+
+    /* Ticks till next timer expires */
+    if (MaxTime < max) {
+        max = MaxTime;
+    }
+    ticks = TM_DELAY_INT_NextEvent(max);
+
+    /* Not worth it, next tick is needed anyway */
+    Tickless.Ticks = 0;
+    if (ticks < 2) {
+        return 0;
+    }
+
+#if defined(TM_DELAY_TIM)
+    /* Timer continues counting, update event comes after the rest of current and (ticks - 1) milliseconds */
+    TM_DELAY_TIM->ARR = ticks * 1000 - 1;
+    if (TM_DELAY_TIM->SR & TIM_IT_Update) {
+        /* Tick happened in the meantime */
+        TM_DELAY_TIM->ARR = 999;
+        return 0;
+    }
+#else
+    /* Stop Systick, tick interrupt must not be pending */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        return 0;
+    }
+
+    /* Rest of current tick plus (ticks - 1) full ticks */
+    Tickless.Start = SysTick->VAL;
+    Tickless.Reload = Tickless.Start + (ticks - 1) * cpt;
+    SysTick->LOAD = Tickless.Reload;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+#endif
+
+    /* Save number of ticks */
+    Tickless.Ticks = ticks;
+    return ticks;
+}
+
+void
+TM_DELAY_TicklessExit(void) {
+    uint32_t ticks;
+#if defined(TM_DELAY_TIM)
+    uint32_t cnt;
+
+    /* Not in tickless mode */
+    if (!Tickless.Ticks) {
+        return;
+    }
+
+    /* Read counter before update flag, so update between them is not missed */
+    cnt = TM_DELAY_TIM->CNT;
+    if (TM_DELAY_TIM->SR & TIM_IT_Update) {
+        /* Slept all the time, pending interrupt counts the last tick */
+        TM_DELAY_TIM->ARR = 999;
+        ticks = Tickless.Ticks - 1;
+    } else {
+        /* Woken up by other interrupt, count passed milliseconds and continue in current one */
+        ticks = cnt / 1000;
+        TM_DELAY_TIM->CNT = cnt - ticks * 1000;
+        TM_DELAY_TIM->ARR = 999;
+    }
+#else
+    uint32_t ctrl, val, elapsed, remaining, cpt = SystemCoreClock / 1000;
+
+    /* Not in tickless mode */
+    if (!Tickless.Ticks) {
+        return;
+    }
+
+    /* Stop Systick, count flag is cleared on read */
+    ctrl = SysTick->CTRL;
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+    val = SysTick->VAL;
+
+    if (ctrl & SysTick_CTRL_COUNTFLAG_Msk) {
+        /* Slept all the time, pending interrupt counts the last tick */
+        ticks = Tickless.Ticks - 1;
+
+        /* Counter was reloaded, continue with the rest of next tick */
+        elapsed = Tickless.Reload - val;
+        remaining = elapsed < cpt ? cpt - elapsed : 1;
+    } else {
+        /* Woken up by other interrupt, count ticks which passed */
+        elapsed = Tickless.Reload - val;
+        if (elapsed < Tickless.Start) {
+            ticks = 0;
+            remaining = Tickless.Start - elapsed;
+        } else {
+            elapsed -= Tickless.Start;
+            ticks = 1 + elapsed / cpt;
+            remaining = cpt - elapsed % cpt;
+        }
+    }
+
+    /* Continue till the end of current tick, then use normal period */
+    SysTick->LOAD = remaining > 1 ? remaining - 1 : 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = cpt - 1;
+#endif
+
+    /* Count skipped ticks */
+    Tickless.Ticks = 0;
+    TM_DELAY_INT_Skip(ticks);
+}
+
+uint32_t
+TM_DELAY_DeadlineRemaining(const TM_DELAY_Deadline_t* Deadline) {
+    uint64_t now = TM_DELAY_Cycles();
+
+    /* Already expired */
+    if (now >= Deadline->Expire) {
+        return 0;
+    }
+
+    /* Return remaining microseconds */
+    return (uint32_t)TM_DELAY_CyclesToUs(Deadline->Expire - now);
+}
+
+/* Private functions */
+static void
+TM_DELAY_INT_CyclesUpdate(void) {
+    uint32_t epoch = TM_DELAY_CyclesEpoch;
+    uint32_t cnt = TM_DELAY_CyclesDWT ? DWT->CYCCNT : TM_Time;
+
+    /* Counter is in next half period, only this function writes epoch */
+    if ((cnt >> 31) != (epoch & 0x01)) {
+        TM_DELAY_CyclesEpoch = epoch + 1;
+    }
+}
+
+static uint32_t
+TM_DELAY_INT_NextEvent(uint32_t MaxTicks) {
+    uint32_t k, tick, best = MaxTicks;
+    uint8_t level;
+
+    /* Level 0 slots have exact expire time */
+    for (k = 0; k < DELAY_WHEEL_SLOTS && k < best; k++) {
+        if (Wheel.Slots[0][(Wheel.Time + k) & DELAY_WHEEL_MASK]) {
+            best = k + 1;
+            break;
+        }
+    }
+
+    /* Higher level slots must be cascaded when their time comes */
+    for (level = 1; level < DELAY_WHEEL_LEVELS; level++) {
+        /* First tick when this level is cascaded */
+        tick = (Wheel.Time + (1UL << (level * DELAY_WHEEL_BITS)) - 1) & ~((1UL << (level * DELAY_WHEEL_BITS)) - 1);
+        for (k = 0; k < DELAY_WHEEL_SLOTS && tick - Wheel.Time + 1 < best; k++, tick += 1UL << (level * DELAY_WHEEL_BITS)) {
+            if (Wheel.Slots[level][DELAY_WHEEL_INDEX(tick, level)]) {
+                best = tick - Wheel.Time + 1;
+                break;
+            }
+        }
+    }
+
+    /* Number of ticks to next event, 1 means next tick */
+    return best;
+}
+
+static void
+TM_DELAY_INT_Skip(uint32_t Ticks) {
+    uint32_t start, first, n, index, shift;
+    int8_t level;
+    TM_DELAY_Timer_t* list;
+    TM_DELAY_Timer_t* Timer;
+
+    /* Time went on without interrupts */
+    TM_Time += Ticks;
+    TM_Time2 = TM_Time2 > Ticks ? TM_Time2 - Ticks : 0;
+    TM_DELAY_INT_CyclesUpdate();
+
+    /* Move wheel at once, not tick by tick */
+    start = Wheel.Time;
+    Wheel.Time += Ticks;
+
+    /* Go through slots which were passed on each level, highest level first */
+    for (level = DELAY_WHEEL_LEVELS - 1; level >= 0; level--) {
+        shift = level * DELAY_WHEEL_BITS;
+
+        /* First tick in skipped time when this level's slot is reached */
+        first = (start + (1UL << shift) - 1) & ~((1UL << shift) - 1);
+        if (first - start >= Ticks) {
+            continue;
+        }
+
+        /* Number of passed slots, each slot is checked only once */
+        n = ((Wheel.Time - 1 - first) >> shift) + 1;
+        if (n > DELAY_WHEEL_SLOTS) {
+            n = DELAY_WHEEL_SLOTS;
+        }
+
+        /* TM_DELAY_TicklessEnter sleeps only till next used slot, so these are normally empty */
+        for (index = DELAY_WHEEL_INDEX(first, level); n--; index = (index + 1) & DELAY_WHEEL_MASK) {
+            list = Wheel.Slots[level][index];
+            Wheel.Slots[level][index] = NULL;
+
+            /* Insert again from new wheel time, expired timers come on next tick */
+            while (list) {
+                Timer = list;
+                list = list->Next;
+                TM_DELAY_INT_Insert(Timer);
+            }
+        }
+    }
+}
+
+static void
+TM_DELAY_INT_Insert(TM_DELAY_Timer_t* Timer) {
+    uint32_t delta, expire;
+    uint8_t level;
+    TM_DELAY_Timer_t** slot;
+
+    /* Find level where timer's slot is reached before it expires */
+    expire = Timer->Expire;
+    delta = expire - Wheel.Time;
+    if ((int32_t)delta < 0) {
+        /* Already expired, process on next tick */
+        expire = Wheel.Time;
+        level = 0;
+    } else {
+        /* Longer timeouts than the wheel are put to last slot and inserted again when reached */
+        if (delta >= (1UL << (DELAY_WHEEL_LEVELS * DELAY_WHEEL_BITS)) - 1) {
+            expire = Wheel.Time + (1UL << (DELAY_WHEEL_LEVELS * DELAY_WHEEL_BITS)) - 1;
+            delta = expire - Wheel.Time;
+        }
+        for (level = 0; level < DELAY_WHEEL_LEVELS - 1; level++) {
+            if (delta < (1UL << ((level + 1) * DELAY_WHEEL_BITS))) {
+                break;
+            }
+        }
+    }
+
+    /* Add to the beginning of slot list */
+    slot = &Wheel.Slots[level][DELAY_WHEEL_INDEX(expire, level)];
+    Timer->Next = *slot;
+    if (Timer->Next) {
+        Timer->Next->PPrev = &Timer->Next;
+    }
+    Timer->PPrev = slot;
+    *slot = Timer;
+}
+
+static void
+TM_DELAY_INT_Remove(TM_DELAY_Timer_t* Timer) {
+    /* Not in wheel */
+    if (!Timer->PPrev) {
+        return;
+    }
+
+    /* Unlink */
+    *Timer->PPrev = Timer->Next;
+    if (Timer->Next) {
+        Timer->Next->PPrev = Timer->PPrev;
+    }
+    Timer->Next = NULL;
+    Timer->PPrev = NULL;
+}
+
+static uint32_t
+TM_DELAY_INT_Cascade(uint8_t level) {
+    uint32_t index = DELAY_WHEEL_INDEX(Wheel.Time, level);
+    TM_DELAY_Timer_t* Timer;
+    TM_DELAY_Timer_t* list;
+
+    /* Move timers from slot to lower levels */
+    list = Wheel.Slots[level][index];
+    Wheel.Slots[level][index] = NULL;
+    while (list) {
+        Timer = list;
+        list = list->Next;
+        TM_DELAY_INT_Insert(Timer);
+    }
+
+    /* Return index, next level is cascaded when this is 0 */
+    return index;
+}
+
+static void
+TM_DELAY_INT_TimersTick(void) {
+    uint32_t index = Wheel.Time & DELAY_WHEEL_MASK;
+    uint8_t level;
+    TM_DELAY_Timer_t* list;
+    TM_DELAY_Timer_t* Timer;
+
+    /* Level 0 wrapped, move timers from higher levels */
+    if (!index) {
+        for (level = 1; level < DELAY_WHEEL_LEVELS; level++) {
+            if (TM_DELAY_INT_Cascade(level)) {
+                break;
+            }
+        }
+    }
+    Wheel.Time++;
+
+    /* Take all timers which expire now, callback can stop or start any of them */
+    list = Wheel.Slots[0][index];
+    Wheel.Slots[0][index] = NULL;
+    if (list) {
+        list->PPrev = &list;
+    }
+    while ((Timer = list) != NULL) {
+        TM_DELAY_INT_Remove(Timer);
+
+        /* Insert again before callback, so callback can stop it */
+        if (Timer->AutoReload && Timer->ARR) {
+            Timer->Expire += Timer->ARR;
+            TM_DELAY_INT_Insert(Timer);
+        } else {
+            Timer->CNT = Timer->ARR;
+            Timer->Enabled = 0;
+        }
+
+        if (Timer->Deferred) {
+            /* Add to deferred list for TM_DELAY_TimerProcess */
+            if (!Timer->Pending++) {
+                Timer->NextDeferred = NULL;
+                *Wheel.DeferredLast = Timer;
+                Wheel.DeferredLast = &Timer->NextDeferred;
+            } else if (!Timer->Pending) {
+                /* Keep counter saturated */
+                Timer->Pending = 0xFF;
+            }
+        } else {
+            /* Call user callback function */
+            Timer->Callback(Timer->UserParameters);
+        }
+    }
+}
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/04/library-03-stm32f429-discovery-system-clock-and-pretty-precise-delay-library/
- * @version v2.4
+ * @version v2.5
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   Pretty accurate delay functions with SysTick or any other timer
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_DELAY_H
-#define TM_DELAY_H 240
+#define TM_DELAY_H 250
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -101,9 +101,97 @@ Another way is to use ARM compiler.
  *
  * You can use variable settings for count, reload value and auto reload feature.
  *
+ * Timers are kept in hierarchical timing wheel. Each timer is put into slot of the time when it expires,
+ * so 1ms interrupt only checks one slot and does not depend on number of running timers.
+ * Stopped timers are not in the wheel and take no time at all.
+ *
+ * @ref TM_DELAY_TimerCreate takes timer from static pool with DELAY_MAX_CUSTOM_TIMERS timers.
+ * If you need more timers or want to control memory yourself, use @ref TM_DELAY_TimerInit with your own structure:
+ *
+\code{.c}
+static TM_DELAY_Timer_t LedTimer;
+
+//Toggle LED every 500ms
+TM_DELAY_TimerInit(&LedTimer, 500, 1, 1, LedToggle, NULL);
+\endcode
+ *
+ * Callbacks are called from interrupt by default. If callback is slow or uses functions which are not safe in interrupt,
+ * enable deferred callback with @ref TM_DELAY_TimerDeferred and call @ref TM_DELAY_TimerProcess in main loop.
+ *
+ * \par Tickless idle
+ *
+ * When MCU sleeps, 1ms interrupt wakes it up every millisecond only to increase time.
+ * With @ref TM_DELAY_TicklessEnter, delay timer is programmed to make next interrupt when next custom timer expires
+ * and @ref TM_DELAY_TicklessExit adds time which passed in sleep to TM_Time, so @ref TM_DELAY_Time stays accurate.
+ * Use @ref TM_LOWPOWER_SleepTickless function from TM LOWPOWER library or do it manually:
+ *
+\code{.c}
+__disable_irq();
+TM_DELAY_TicklessEnter(0xFFFFFFFF);
+__WFI();
+TM_DELAY_TicklessExit();
+__enable_irq();
+\endcode
+ *
+ * One sleep is limited to about 99ms with Systick on 168MHz, 65ms with 16-bit TIMx and 49 days with TIM2 or TIM5.
+ *
+ * @note   @ref TM_DELAY_1msHandler is not called for skipped ticks
+ *
+ * \par Cycle clock and deadlines
+ *
+ * @ref TM_DELAY_Init enables DWT cycle counter in Cortex-M4 core. Its 32-bit value overflows every 24 seconds on 180MHz,
+ * so library extends it to 64-bit monotonic clock @ref TM_DELAY_Cycles, which can be read from main loop and any interrupt.
+ * Use it for precise timestamps, for example for sensor samples or profiling.
+ *
+ * For timeouts in blocking loops, use deadline:
+ *
+\code{.c}
+TM_DELAY_Deadline_t Deadline;
+
+//Wait max 500us for flag
+TM_DELAY_DeadlineSet(&Deadline, 500);
+while (!(I2C3->SR1 & I2C_SR1_SB)) {
+    if (TM_DELAY_DeadlineExpired(&Deadline)) {
+        //Timeout
+        return 0;
+    }
+}
+\endcode
+ *
+ * @ref TM_DELAY_Until waits till deadline, so periodic tasks do not drift:
+ *
+\code{.c}
+TM_DELAY_DeadlineSet(&Deadline, 0);
+while (1) {
+    //Read sensor every 1250us
+    TM_DELAY_DeadlineAdd(&Deadline, 1250);
+    TM_DELAY_Until(&Deadline);
+    ReadSensor();
+}
+\endcode
+ *
+ * @note   Do not reset DWT->CYCCNT when cycle clock is used.
+ *         Delay interrupt must come at least every 2^31 CPU cycles to track overflows, which is always true with 1ms ticks and tickless idle.
+ * @note   When DWT counter does not run, cycle clock counts 1ms ticks from @ref TM_DELAY_Time, so deadlines have 1ms resolution.
+ *         It is extended to 64-bit too and does not wrap after 49 days, but @ref TM_DELAY_SetTime makes it jump.
+ *         Calling @ref TM_DELAY_Init again, also from other libraries, does not change cycle clock value.
+ *
+ * With Systick as delay timer, Delay function for microseconds uses DWT counter too and is now accurate with any compiler.
+ *
  * \par Changelog
  *
 @verbatim
+ Version 2.5
+  - October 16, 2026
+  - Custom timers are in hierarchical timing wheel, 1ms interrupt does not check all timers anymore
+  - Timers are taken from static pool instead of malloc, added TM_DELAY_TimerInit for user memory
+  - Added deferred callbacks with TM_DELAY_TimerDeferred and TM_DELAY_TimerProcess
+  - Added tickless idle with TM_DELAY_TicklessEnter and TM_DELAY_TicklessExit
+  - Tickless exit moves timing wheel at once instead of processing every skipped tick
+  - Added 64-bit cycle clock on DWT counter with deadlines and TM_DELAY_Until
+  - Cycle clock counts 1ms ticks when DWT counter does not run, extended to 64-bit with epoch
+  - Delay in microseconds uses DWT counter when Systick is used for delay
+
  Version 2.4
   - May 26, 2015
   - Added support for custom timers which can be called periodically
@@ -165,15 +253,30 @@ Another way is to use ARM compiler.
 
 /**
  * @brief  Custom timer structure
+ * @note   Do not change members directly, use functions instead
+ */
+typedef struct _TM_DELAY_Timer_t {
+    uint32_t ARR;                           /*!< Auto reload value */
+    uint32_t AutoReload;                    /*!< Set to 1 if timer should be auto reloaded when it reaches zero */
+    uint32_t CNT;                           /*!< Remaining milliseconds, valid when timer is stopped */
+    uint8_t Enabled;                        /*!< Set to 1 when timer is enabled */
+    void (*Callback)(void*);                /*!< Callback which will be called when timer reaches zero */
+    void* UserParameters;                   /*!< Pointer to user parameters used for callback function */
+    uint32_t Expire;                        /*!< Tick when timer expires. Used private */
+    struct _TM_DELAY_Timer_t* Next;         /*!< Next timer in the same wheel slot. Used private */
+    struct _TM_DELAY_Timer_t** PPrev;       /*!< Pointer to pointer which points to this timer, NULL when not in wheel. Used private */
+    struct _TM_DELAY_Timer_t* NextDeferred; /*!< Next timer with pending deferred callback. Used private */
+    uint8_t Deferred;                       /*!< Set to 1 when callback is called from @ref TM_DELAY_TimerProcess */
+    uint8_t Pending;                        /*!< Number of deferred callbacks not called yet. Used private */
+    uint8_t Allocated;                      /*!< Set to 1 when timer is used from static pool. Used private */
+} TM_DELAY_Timer_t;
+
+/**
+ * @brief  Deadline for timeouts, see @ref TM_DELAY_DeadlineSet
  */
 typedef struct {
-    uint32_t ARR;             /*!< Auto reload value */
-    uint32_t AutoReload;      /*!< Set to 1 if timer should be auto reloaded when it reaches zero */
-    uint32_t CNT;             /*!< Counter value, counter counts down */
-    uint8_t Enabled;          /*!< Set to 1 when timer is enabled */
-    void (*Callback)(void*);  /*!< Callback which will be called when timer reaches zero */
-    void* UserParameters;     /*!< Pointer to user parameters used for callback function */
-} TM_DELAY_Timer_t;
+    uint64_t Expire; /*!< Cycle clock value when deadline expires */
+} TM_DELAY_Deadline_t;
 
 /**
  * @}
@@ -186,13 +289,31 @@ typedef struct {
  */
 
 /**
- * @brief  Number of allowed custom timers
- * @note   Should be changes in defines.h file if necessary
+ * @brief  Number of timers in static pool for @ref TM_DELAY_TimerCreate
+ * @note   Should be changes in defines.h file if necessary.
+ *         Timers initialized with @ref TM_DELAY_TimerInit are not limited
  */
 #ifndef DELAY_MAX_CUSTOM_TIMERS
 #define DELAY_MAX_CUSTOM_TIMERS   5
 #endif
 
+/**
+ * @brief  Number of bits for slots in one timing wheel level, each level has 2^DELAY_WHEEL_BITS slots
+ * @note   DELAY_WHEEL_BITS * DELAY_WHEEL_LEVELS must be less than 32.
+ *         With default values, wheel covers 17 minutes and takes 512 bytes of RAM.
+ *         Longer timeouts work too, they are only moved in wheel a few more times
+ */
+#ifndef DELAY_WHEEL_BITS
+#define DELAY_WHEEL_BITS          5
+#endif
+
+/**
+ * @brief  Number of timing wheel levels
+ */
+#ifndef DELAY_WHEEL_LEVELS
+#define DELAY_WHEEL_LEVELS        4
+#endif
+
 /* Memory allocation function */
 #ifndef LIB_ALLOC_FUNC
 #define LIB_ALLOC_FUNC    malloc
@@ -221,6 +342,24 @@ extern __IO uint32_t TM_Time;
 extern __IO uint32_t TM_Time2;
 extern __IO uint32_t mult;
 
+/**
+ * Number of DWT counter half periods (2^31 cycles), used for 64-bit cycle clock
+ * When DWT counter does not run, it counts half periods of TM_Time instead
+ * It is updated on each delay interrupt
+ */
+extern __IO uint32_t TM_DELAY_CyclesEpoch;
+
+/**
+ * Number of CPU cycles in one microsecond, set in @ref TM_DELAY_Init
+ */
+extern uint32_t TM_DELAY_CyclesPerUs;
+
+/**
+ * Set to 1 in @ref TM_DELAY_Init when DWT counter runs
+ * When it is 0, cycle clock counts 1ms ticks and microsecond delay uses loop
+ */
+extern uint8_t TM_DELAY_CyclesDWT;
+
 /**
  * @}
  */
@@ -253,6 +392,14 @@ static __INLINE void Delay(uint32_t micros) {
 #else
     uint32_t amicros;
 
+    /* Count CPU cycles if DWT counter works */
+    if (TM_DELAY_CyclesDWT) {
+        amicros = DWT->CYCCNT;
+        micros *= TM_DELAY_CyclesPerUs;
+        while ((DWT->CYCCNT - amicros) < micros);
+        return;
+    }
+
     /* Multiply micro seconds */
     amicros = (micros) * (mult);
 
@@ -303,12 +450,121 @@ static __INLINE void Delayms(uint32_t millis) {
 
 /**
  * @brief  Initializes timer settings for delay
- * @note   This function will initialize Systick or user timer, according to settings
+ * @note   This function will initialize Systick or user timer, according to settings, and DWT counter for cycle clock
  * @param  None
  * @retval None
  */
 void TM_DELAY_Init(void);
 
+/**
+ * @brief  Gets 64-bit cycle clock value
+ * @note   Clock counts CPU cycles and never overflows. It can be called from any interrupt
+ *         When DWT counter does not run, value is in 1ms steps and is extended from TM_Time the same way
+ * @param  None
+ * @retval Number of CPU cycles
+ * @note   Declared as static inline
+ */
+static __INLINE uint64_t TM_DELAY_Cycles(void) {
+    uint32_t epoch, cnt;
+    uint64_t value;
+
+    /* Epoch must be read before counter, 1ms ticks are counted when DWT counter does not run */
+    epoch = TM_DELAY_CyclesEpoch;
+    cnt = TM_DELAY_CyclesDWT ? DWT->CYCCNT : TM_Time;
+
+    /* Counter went to next half period after epoch was updated */
+    if ((cnt >> 31) != (epoch & 0x01)) {
+        epoch++;
+    }
+
+    /* Half periods give upper 32 bits */
+    value = ((uint64_t)(epoch >> 1) << 32) | cnt;
+    if (!TM_DELAY_CyclesDWT) {
+        return value * 1000 * TM_DELAY_CyclesPerUs;
+    }
+    return value;
+}
+
+/**
+ * @brief  Converts CPU cycles to microseconds
+ * @param  cycles: Number of CPU cycles
+ * @retval Number of microseconds
+ */
+#define TM_DELAY_CyclesToUs(cycles)     ((uint64_t)(cycles) / TM_DELAY_CyclesPerUs)
+
+/**
+ * @brief  Converts CPU cycles to nanoseconds
+ * @param  cycles: Number of CPU cycles
+ * @retval Number of nanoseconds
+ */
+#define TM_DELAY_CyclesToNs(cycles)     ((uint64_t)(cycles) * 1000 / TM_DELAY_CyclesPerUs)
+
+/**
+ * @brief  Converts microseconds to CPU cycles
+ * @param  micros: Number of microseconds
+ * @retval Number of CPU cycles
+ */
+#define TM_DELAY_UsToCycles(micros)     ((uint64_t)(micros) * TM_DELAY_CyclesPerUs)
+
+/**
+ * @brief  Gets time in microseconds from cycle clock
+ * @param  None
+ * @retval Time in microseconds
+ */
+#define TM_DELAY_Micros()               TM_DELAY_CyclesToUs(TM_DELAY_Cycles())
+
+/**
+ * @brief  Sets deadline relative to current time
+ * @param  *Deadline: Pointer to @ref TM_DELAY_Deadline_t structure
+ * @param  micros: Time from now in microseconds
+ * @retval None
+ * @note   Declared as static inline
+ */
+static __INLINE void TM_DELAY_DeadlineSet(TM_DELAY_Deadline_t* Deadline, uint32_t micros) {
+    Deadline->Expire = TM_DELAY_Cycles() + TM_DELAY_UsToCycles(micros);
+}
+
+/**
+ * @brief  Moves deadline for periodic tasks
+ * @note   New deadline is relative to old one, so period does not drift
+ * @param  *Deadline: Pointer to @ref TM_DELAY_Deadline_t structure
+ * @param  micros: Time from old deadline in microseconds
+ * @retval None
+ * @note   Declared as static inline
+ */
+static __INLINE void TM_DELAY_DeadlineAdd(TM_DELAY_Deadline_t* Deadline, uint32_t micros) {
+    Deadline->Expire += TM_DELAY_UsToCycles(micros);
+}
+
+/**
+ * @brief  Checks if deadline has expired
+ * @param  *Deadline: Pointer to @ref TM_DELAY_Deadline_t structure
+ * @retval Deadline status:
+ *            - 0: Deadline has not expired yet
+ *            - > 0: Deadline has expired
+ * @note   Declared as static inline
+ */
+static __INLINE uint8_t TM_DELAY_DeadlineExpired(const TM_DELAY_Deadline_t* Deadline) {
+    return TM_DELAY_Cycles() >= Deadline->Expire;
+}
+
+/**
+ * @brief  Gets remaining time till deadline
+ * @param  *Deadline: Pointer to @ref TM_DELAY_Deadline_t structure
+ * @retval Remaining time in microseconds, 0 if deadline has expired
+ */
+uint32_t TM_DELAY_DeadlineRemaining(const TM_DELAY_Deadline_t* Deadline);
+
+/**
+ * @brief  Waits till deadline expires
+ * @param  *Deadline: Pointer to @ref TM_DELAY_Deadline_t structure
+ * @retval None
+ * @note   Declared as static inline
+ */
+static __INLINE void TM_DELAY_Until(const TM_DELAY_Deadline_t* Deadline) {
+    while (!TM_DELAY_DeadlineExpired(Deadline));
+}
+
 /**
  * @brief  Gets the TM_Time variable value
  * @param  None
@@ -357,18 +613,32 @@ void TM_DELAY_DisableDelayTimer(void);
 
 /**
  * @brief  Creates a new custom timer which has 1ms resolution
- * @note   It uses @ref malloc for memory allocation for timer structure
+ * @note   Timer structure is taken from static pool with DELAY_MAX_CUSTOM_TIMERS timers
  * @param  ReloadValue: Number of milliseconds when timer reaches zero and callback function is called
  * @param  AutoReload: If set to 1, timer will start again when it reaches zero and callback is called
  * @param  StartTimer: If set to 1, timer will start immediately
  * @param  *TM_DELAY_CustomTimerCallback: Pointer to callback function which will be called when timer reaches zero
  * @param  *UserParameters: Pointer to void pointer to user parameters used as first parameter in callback function
- * @retval Pointer to allocated timer structure
+ * @retval Pointer to allocated timer structure or NULL if pool is empty
  */
 TM_DELAY_Timer_t* TM_DELAY_TimerCreate(uint32_t ReloadValue, uint8_t AutoReload, uint8_t StartTimer, void (*TM_DELAY_CustomTimerCallback)(void*), void* UserParameters);
 
 /**
- * @brief  Deletes already allocated timer
+ * @brief  Initializes custom timer in user memory
+ * @note   Timer must not be running when initialized
+ * @param  *Timer: Pointer to @ref TM_DELAY_Timer_t structure. It must be valid while timer is used, use global or static variable
+ * @param  ReloadValue: Number of milliseconds when timer reaches zero and callback function is called
+ * @param  AutoReload: If set to 1, timer will start again when it reaches zero and callback is called
+ * @param  StartTimer: If set to 1, timer will start immediately
+ * @param  *TM_DELAY_CustomTimerCallback: Pointer to callback function which will be called when timer reaches zero
+ * @param  *UserParameters: Pointer to void pointer to user parameters used as first parameter in callback function
+ * @retval Pointer to @ref TM_DELAY_Timer_t structure
+ */
+TM_DELAY_Timer_t* TM_DELAY_TimerInit(TM_DELAY_Timer_t* Timer, uint32_t ReloadValue, uint8_t AutoReload, uint8_t StartTimer, void (*TM_DELAY_CustomTimerCallback)(void*), void* UserParameters);
+
+/**
+ * @brief  Deletes timer
+ * @note   Timer from pool is returned to pool, timer in user memory is only stopped
  * @param  *Timer: Pointer to @ref TM_DELAY_Timer_t structure
  * @retval None
  */
@@ -413,6 +683,38 @@ TM_DELAY_Timer_t* TM_DELAY_TimerAutoReload(TM_DELAY_Timer_t* Timer, uint8_t Auto
  */
 TM_DELAY_Timer_t* TM_DELAY_TimerAutoReloadValue(TM_DELAY_Timer_t* Timer, uint32_t AutoReloadValue);
 
+/**
+ * @brief  Sets where timer callback is called
+ * @param  *Timer: Pointer to @ref TM_DELAY_Timer_t structure
+ * @param  Deferred: Set to 1 to call callback from @ref TM_DELAY_TimerProcess or 0 to call it from interrupt
+ * @retval Pointer to @ref TM_DELAY_Timer_t structure
+ */
+TM_DELAY_Timer_t* TM_DELAY_TimerDeferred(TM_DELAY_Timer_t* Timer, uint8_t Deferred);
+
+/**
+ * @brief  Calls deferred callbacks for timers which expired
+ * @note   Call this function periodically in main loop. Callback is called once for each expiration
+ * @param  None
+ * @retval None
+ */
+void TM_DELAY_TimerProcess(void);
+
+/**
+ * @brief  Programs delay timer to skip ticks till next custom timer expires
+ * @note   Interrupts must be disabled with __disable_irq() before this function is called and enabled after @ref TM_DELAY_TicklessExit
+ * @param  MaxTime: Maximal sleep time in milliseconds
+ * @retval Number of milliseconds till next delay interrupt or 0 if next tick is not skipped
+ */
+uint32_t TM_DELAY_TicklessEnter(uint32_t MaxTime);
+
+/**
+ * @brief  Adds time which passed in sleep and returns delay timer to 1ms interrupts
+ * @note   Call it after wakeup, before interrupts are enabled again
+ * @param  None
+ * @retval None
+ */
+void TM_DELAY_TicklessExit(void);
+
 /**
  * @brief  User function, called each 1ms when interrupt from timer happen
  * @note   Here user should put things which has to be called periodically
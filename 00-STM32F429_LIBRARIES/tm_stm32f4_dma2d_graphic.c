@@ -21,6 +21,13 @@
 /* Absolute number */
 #define ABS(X)  ((X) > 0 ? (X) : -(X))
 
+/* Converts RGB565 color to RGB888 for DMA2D color registers */
+#define RGB565_TO_RGB888(c)     (\
+    ((((c) & 0xF800) << 8) | (((c) & 0xE000) << 3)) | \
+    ((((c) & 0x07E0) << 5) | (((c) & 0x0600) >> 1)) | \
+    ((((c) & 0x001F) << 3) | (((c) & 0x001C) >> 2))   \
+)
+
 /* Internal structure */
 typedef struct {
     uint16_t Width;
@@ -34,6 +41,9 @@ typedef struct {
     uint8_t Initialized;
     uint8_t Orientation;
     uint8_t PixelSize;
+    uint32_t Origin;   /* Memory index of pixel at logical 0,0 for current orientation */
+    int32_t XStep;     /* Memory index step when logical X increases by 1 */
+    int32_t YStep;     /* Memory index step when logical Y increases by 1 */
 } TM_INT_DMA2D_t;
 
 /* Private structures */
@@ -41,16 +51,32 @@ static DMA2D_InitTypeDef GRAPHIC_DMA2D_InitStruct;
 //static DMA2D_FG_InitTypeDef GRAPHIC_DMA2D_FG_InitStruct;
 volatile TM_INT_DMA2D_t DIS;
 
+/* Minimal span length for DMA2D, shorter spans are faster with CPU */
+#define DMA2DGRAPHIC_SPAN_DMA2D     32
+
+/* Gets memory address of pixel, orientation is already handled with steps */
+#define PIXEL_ADDR(x, y)    ((__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * (DIS.Origin + (x) * DIS.XStep + (y) * DIS.YStep)))
+
 __STATIC_INLINE void
-DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
-    TM_DMA2DGRAPHIC_DrawHorizontalLine(x, y, 1, color);
+DrawPixel(int16_t x, int16_t y, uint32_t color) {
+    /* Check coordinates, negative values are filtered as big unsigned values */
+    if ((uint16_t)x >= DIS.CurrentWidth || (uint16_t)y >= DIS.CurrentHeight) {
+        return;
+    }
+
+    /* Draw pixel directly with CPU, DMA2D setup is too slow for single pixel */
+    *PIXEL_ADDR(x, y) = color;
 }
 
 /* Private functions */
 void TM_INT_DMA2DGRAPHIC_InitAndTransfer(void);
 void TM_INT_DMA2DGRAPHIC_SetMemory(uint32_t MemoryAddress, uint32_t Offset, uint32_t NumberOfLine, uint32_t PixelPerLine);
+void TM_INT_DMA2DGRAPHIC_SetRectangle(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
 void TM_INT_DMA2DGRAPHIC_DrawCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color);
-void TM_INT_DMA2DGRAPHIC_DrawFilledCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color);
+static void TM_INT_DMA2DGRAPHIC_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color);
+
+/* Device for scanline fill engine */
+static TM_SCANLINE_t DMA2DGRAPHIC_Scanline = {TM_INT_DMA2DGRAPHIC_Span, 0, 0};
 
 void
 TM_DMA2DGRAPHIC_Init(void) {
@@ -66,6 +92,9 @@ TM_DMA2DGRAPHIC_Init(void) {
     DIS.PixelSize = 2;
     DIS.LayerOffset = DMA2D_GRAPHIC_LCD_WIDTH * DMA2D_GRAPHIC_LCD_HEIGHT * DIS.PixelSize;
 
+    /* Calculate memory steps for default orientation */
+    TM_DMA2DGRAPHIC_SetOrientation(DIS.Orientation);
+
     /* Enable DMA2D clock */
     RCC->AHB1ENR |= RCC_AHB1ENR_DMA2DEN;
 
@@ -81,31 +110,89 @@ TM_DMA2DGRAPHIC_SetLayer(uint8_t layer_number) {
 
 void
 TM_DMA2DGRAPHIC_DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
-    if (DIS.Orientation == 1) { /* Normal */
-        *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * (y * DIS.Width + x)) = color;
-    } else if (DIS.Orientation == 0) { /* 180 */
-        *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * ((DIS.Height - y - 1) * DIS.Width + (DIS.Width - x - 1))) = color;
-    } else if (DIS.Orientation == 3) {
-        /* 90 */ /* x + width * y */
-        *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * ((x) * DIS.Width + DIS.Width - y - 1)) = color;
-    } else if (DIS.Orientation == 2) { /* 270 */
-        *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * ((DIS.Height - x - 1) * DIS.Width + y)) = color;
-    }
+    /* Set pixel in memory */
+    *PIXEL_ADDR(x, y) = color;
 }
 
 uint32_t
 TM_DMA2DGRAPHIC_GetPixel(uint16_t x, uint16_t y) {
-    if (DIS.Orientation == 1) { /* Normal */
-        return *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * (y * DIS.Width + x));
-    } else if (DIS.Orientation == 0) { /* 180 */
-        return *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * ((DIS.Height - y - 1) * DIS.Width + (DIS.Width - x - 1)));
-    } else if (DIS.Orientation == 3) {
-        /* 90 */ /* x + width * y */
-        return *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * ((x) * DIS.Width + DIS.Width - y - 1));
-    } else if (DIS.Orientation == 2) { /* 270 */
-        return *(__IO uint16_t*) (DIS.StartAddress + DIS.Offset + DIS.PixelSize * ((DIS.Height - x - 1) * DIS.Width + y));
+    /* Get pixel from memory */
+    return *PIXEL_ADDR(x, y);
+}
+
+void
+TM_DMA2DGRAPHIC_DrawSpan(int16_t x, int16_t y, uint16_t length, uint32_t color) {
+    __IO uint16_t* addr;
+    int32_t step;
+
+    /* Filter */
+    if (
+        x >= DIS.CurrentWidth ||
+        y < 0 || y >= DIS.CurrentHeight ||
+        length == 0
+    ) {
+        return;
+    }
+
+    /* Clip on the left side */
+    if (x < 0) {
+        if (length <= -x) {
+            return;
+        }
+        length += x;
+        x = 0;
+    }
+
+    /* Clip on the right side */
+    if ((x + length) > DIS.CurrentWidth) {
+        length = DIS.CurrentWidth - x;
+    }
+
+    /* Calculate address only once, then step through memory */
+    addr = PIXEL_ADDR(x, y);
+    step = DIS.XStep;
+    while (length--) {
+        *addr = color;
+        addr += step;
+    }
+}
+
+void
+TM_DMA2DGRAPHIC_DrawPixels(int16_t x, int16_t y, const uint16_t* colors, uint16_t count) {
+    __IO uint16_t* addr;
+    int32_t step;
+
+    /* Filter */
+    if (
+        x >= DIS.CurrentWidth ||
+        y < 0 || y >= DIS.CurrentHeight ||
+        count == 0
+    ) {
+        return;
+    }
+
+    /* Clip on the left side */
+    if (x < 0) {
+        if (count <= -x) {
+            return;
+        }
+        count += x;
+        colors -= x;
+        x = 0;
+    }
+
+    /* Clip on the right side */
+    if ((x + count) > DIS.CurrentWidth) {
+        count = DIS.CurrentWidth - x;
+    }
+
+    /* Calculate address only once, then step through memory */
+    addr = PIXEL_ADDR(x, y);
+    step = DIS.XStep;
+    while (count--) {
+        *addr = *colors++;
+        addr += step;
     }
-    return 0;
 }
 
 void
@@ -118,15 +205,40 @@ TM_DMA2DGRAPHIC_SetOrientation(uint8_t orientation) {
     /* Save new orientation */
     DIS.Orientation = orientation;
 
+    /* Calculate memory origin and steps only once for all drawing functions */
+    switch (orientation) {
+        case 1: /* Normal */
+            DIS.Origin = 0;
+            DIS.XStep = 1;
+            DIS.YStep = DIS.Width;
+            break;
+        case 0: /* 180 */
+            DIS.Origin = DIS.Pixels - 1;
+            DIS.XStep = -1;
+            DIS.YStep = -(int32_t)DIS.Width;
+            break;
+        case 3: /* 90 */
+            DIS.Origin = DIS.Width - 1;
+            DIS.XStep = DIS.Width;
+            DIS.YStep = -1;
+            break;
+        case 2: /* 270 */
+        default:
+            DIS.Origin = DIS.Pixels - DIS.Width;
+            DIS.XStep = -(int32_t)DIS.Width;
+            DIS.YStep = 1;
+            break;
+    }
+
     if (
         orientation == 0 ||
         orientation == 1
     ) {
-        DIS.CurrentHeight = DMA2D_GRAPHIC_LCD_HEIGHT;
-        DIS.CurrentWidth = DMA2D_GRAPHIC_LCD_WIDTH;
+        DIS.CurrentHeight = DIS.Height;
+        DIS.CurrentWidth = DIS.Width;
     } else {
-        DIS.CurrentHeight = DMA2D_GRAPHIC_LCD_WIDTH;
-        DIS.CurrentWidth = DMA2D_GRAPHIC_LCD_HEIGHT;
+        DIS.CurrentHeight = DIS.Width;
+        DIS.CurrentWidth = DIS.Height;
     }
 }
 
@@ -187,18 +299,7 @@ TM_DMA2DGRAPHIC_DrawFilledRectangle(uint16_t x, uint16_t y, uint16_t width, uint
     GRAPHIC_DMA2D_InitStruct.DMA2D_OutputRed = (0xF800 & color) >> 11;
 
     /* Set memory settings */
-    if (DIS.Orientation == 1) { /* Normal */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (y * DIS.Width + x), DIS.Width - width, height, width);
-    }
-    if (DIS.Orientation == 0) { /* 180 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * ((DIS.Height - height - y) * DIS.Width + DIS.Width - x - width), DIS.Width - width, height, width);
-    }
-    if (DIS.Orientation == 3) { /* 90 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (DIS.Width - y - height + DIS.Width * x), DIS.Width - height, width, height);
-    }
-    if (DIS.Orientation == 2) { /* 270 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (y + DIS.Width * (DIS.Height - width - x)), DIS.Width - height, width, height);
-    }
+    TM_INT_DMA2DGRAPHIC_SetRectangle(x, y, width, height);
 
     /* Start transfer and wait till done */
     TM_INT_DMA2DGRAPHIC_InitAndTransfer();
@@ -286,16 +387,8 @@ TM_DMA2DGRAPHIC_DrawFilledRoundedRectangle(uint16_t x, uint16_t y, uint16_t widt
         return;
     }
 
-    /* Draw rectangles */
-    TM_DMA2DGRAPHIC_DrawFilledRectangle(x + r, y, width - 2 * r, height, color);
-    TM_DMA2DGRAPHIC_DrawFilledRectangle(x, y + r, r, height - 2 * r, color);
-    TM_DMA2DGRAPHIC_DrawFilledRectangle(x + width - r, y + r, r, height - 2 * r, color);
-
-    /* Draw corners */
-    TM_INT_DMA2DGRAPHIC_DrawFilledCircleCorner(x + r, y + r, r, 0x01, color); /* Top left */
-    TM_INT_DMA2DGRAPHIC_DrawFilledCircleCorner(x + width - r - 1, y + r, r, 0x02, color); /* Top right */
-    TM_INT_DMA2DGRAPHIC_DrawFilledCircleCorner(x + width - r - 1, y + height - r - 1, r, 0x04, color); /* Bottom right */
-    TM_INT_DMA2DGRAPHIC_DrawFilledCircleCorner(x + r, y + height - r - 1, r, 0x08, color); /* Bottom left */
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillRoundedRectangle(TM_DMA2DGRAPHIC_GetScanline(), x, y, x + width - 1, y + height - 1, r, color);
 }
 
 void
@@ -338,18 +431,7 @@ TM_DMA2DGRAPHIC_DrawVerticalLine(int16_t x, int16_t y, uint16_t length, uint32_t
     GRAPHIC_DMA2D_InitStruct.DMA2D_OutputRed = (0xF800 & color) >> 11;
 
     /* Set memory settings */
-    if (DIS.Orientation == 1) { /* Normal */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (y * DIS.Width + x), DIS.Width - 1, length, 1);
-    }
-    if (DIS.Orientation == 0) { /* 180 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * ((DIS.Height - length - y) * DIS.Width + DIS.Width - x - 1), DIS.Width - 1, length, 1);
-    }
-    if (DIS.Orientation == 3) { /* 90 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (DIS.Width - y - length + DIS.Width * x), DIS.Width - length, 1, length);
-    }
-    if (DIS.Orientation == 2) { /* 270 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (y + DIS.Width * (DIS.Height - 1 - x)), DIS.Width - length, 1, length);
-    }
+    TM_INT_DMA2DGRAPHIC_SetRectangle(x, y, 1, length);
 
     /* Start transfer and wait till done */
     TM_INT_DMA2DGRAPHIC_InitAndTransfer();
@@ -396,18 +478,7 @@ TM_DMA2DGRAPHIC_DrawHorizontalLine(int16_t x, int16_t y, uint16_t length, uint32
     GRAPHIC_DMA2D_InitStruct.DMA2D_OutputRed = (0xF800 & color) >> 11;
 
     /* Set memory settings */
-    if (DIS.Orientation == 1) { /* Normal */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (y * DIS.Width + x), DIS.Width - length, 1, length);
-    }
-    if (DIS.Orientation == 0) { /* 180 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * ((DIS.Height - 1 - y) * DIS.Width + DIS.Width - x - length), DIS.Width - length, 1, length);
-    }
-    if (DIS.Orientation == 3) { /* 90 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (DIS.Width - y - 1 + DIS.Width * x), DIS.Width - 1, length, 1);
-    }
-    if (DIS.Orientation == 2) { /* 270 */
-        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * (y + DIS.Width * (DIS.Height - length - x)), DIS.Width - 1, length, 1);
-    }
+    TM_INT_DMA2DGRAPHIC_SetRectangle(x, y, length, 1);
 
     /* Start transfer and wait till done */
     TM_INT_DMA2DGRAPHIC_InitAndTransfer();
@@ -419,6 +490,12 @@ TM_DMA2DGRAPHIC_DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_
             yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0,
             curpixel = 0;
 
+    /* Horizontal line is one span with single address calculation */
+    if (y1 == y2) {
+        TM_DMA2DGRAPHIC_DrawSpan(x1 < x2 ? x1 : x2, y1, ABS(x2 - x1) + 1, color);
+        return;
+    }
+
     deltax = ABS(x2 - x1);
     deltay = ABS(y2 - y1);
     x = x1;
@@ -489,10 +566,10 @@ TM_DMA2DGRAPHIC_DrawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint32_t color)
     int16_t x = 0;
     int16_t y = r;
 
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0, y0 + r, 1, color);
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0, y0 - r, 1, color);
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0 + r, y0, 1, color);
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0 - r, y0, 1, color);
+    DrawPixel(x0, y0 + r, color);
+    DrawPixel(x0, y0 - r, color);
+    DrawPixel(x0 + r, y0, color);
+    DrawPixel(x0 - r, y0, color);
 
     while (x < y) {
         if (f >= 0) {
@@ -504,48 +581,22 @@ TM_DMA2DGRAPHIC_DrawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint32_t color)
         ddF_x += 2;
         f += ddF_x;
 
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 + x, y0 + y, 1, color);
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 - x, y0 + y, 1, color);
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 + x, y0 - y, 1, color);
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 - x, y0 - y, 1, color);
+        DrawPixel(x0 + x, y0 + y, color);
+        DrawPixel(x0 - x, y0 + y, color);
+        DrawPixel(x0 + x, y0 - y, color);
+        DrawPixel(x0 - x, y0 - y, color);
 
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 + y, y0 + x, 1, color);
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 - y, y0 + x, 1, color);
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 + y, y0 - x, 1, color);
-        TM_DMA2DGRAPHIC_DrawVerticalLine(x0 - y, y0 - x, 1, color);
+        DrawPixel(x0 + y, y0 + x, color);
+        DrawPixel(x0 - y, y0 + x, color);
+        DrawPixel(x0 + y, y0 - x, color);
+        DrawPixel(x0 - y, y0 - x, color);
     }
 }
 
 void
 TM_DMA2DGRAPHIC_DrawFilledCircle(uint16_t x0, uint16_t y0, uint16_t r, uint32_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
-
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0, y0 + r, 1, color);
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0, y0 - r, 1, color);
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0 + r, y0, 1, color);
-    TM_DMA2DGRAPHIC_DrawVerticalLine(x0 - r, y0, 1, color);
-    TM_DMA2DGRAPHIC_DrawHorizontalLine(x0 - r, y0, 2 * r, color);
-
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        TM_DMA2DGRAPHIC_DrawHorizontalLine(x0 - x, y0 + y, 2 * x, color);
-        TM_DMA2DGRAPHIC_DrawHorizontalLine(x0 - x, y0 - y, 2 * x, color);
-
-        TM_DMA2DGRAPHIC_DrawHorizontalLine(x0 - y, y0 + x, 2 * y, color);
-        TM_DMA2DGRAPHIC_DrawHorizontalLine(x0 - y, y0 - x, 2 * y, color);
-    }
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillCircle(TM_DMA2DGRAPHIC_GetScanline(), x0, y0, r, color);
 }
 
 void
@@ -559,59 +610,8 @@ TM_DMA2DGRAPHIC_DrawTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
 
 void
 TM_DMA2DGRAPHIC_DrawFilledTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint32_t color) {
-    int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0,
-            yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0,
-            curpixel = 0;
-
-    deltax = ABS(x2 - x1);
-    deltay = ABS(y2 - y1);
-    x = x1;
-    y = y1;
-
-    if (x2 >= x1) {
-        xinc1 = 1;
-        xinc2 = 1;
-    } else {
-        xinc1 = -1;
-        xinc2 = -1;
-    }
-
-    if (y2 >= y1) {
-        yinc1 = 1;
-        yinc2 = 1;
-    } else {
-        yinc1 = -1;
-        yinc2 = -1;
-    }
-
-    if (deltax >= deltay) {
-        xinc1 = 0;
-        yinc2 = 0;
-        den = deltax;
-        num = deltax / 2;
-        numadd = deltay;
-        numpixels = deltax;
-    } else {
-        xinc2 = 0;
-        yinc1 = 0;
-        den = deltay;
-        num = deltay / 2;
-        numadd = deltax;
-        numpixels = deltay;
-    }
-
-    for (curpixel = 0; curpixel <= numpixels; curpixel++) {
-        TM_DMA2DGRAPHIC_DrawLine(x, y, x3, y3, color);
-
-        num += numadd;
-        if (num >= den) {
-            num -= den;
-            x += xinc1;
-            y += yinc1;
-        }
-        x += xinc2;
-        y += yinc2;
-    }
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillTriangle(TM_DMA2DGRAPHIC_GetScanline(), x1, y1, x2, y2, x3, y3, color);
 }
 
 void
@@ -651,7 +651,140 @@ TM_DMA2DGRAPHIC_CopyBufferIT(void* pSrc, void* pDst, uint32_t xSize, uint32_t yS
     DMA2D->CR |= DMA2D_CR_START;
 }
 
+void
+TM_DMA2DGRAPHIC_BlendA8(const uint8_t* pSrc, void* pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst, uint32_t foreground, uint32_t background) {
+    /* Blend using interrupt */
+    TM_DMA2DGRAPHIC_BlendA8IT(pSrc, pDst, xSize, ySize, OffLineSrc, OffLineDst, foreground, background);
+
+    /* Wait until transfer is done */
+    DMA2D_WAIT;
+}
+
+void
+TM_DMA2DGRAPHIC_BlendA8IT(const uint8_t* pSrc, void* pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst, uint32_t foreground, uint32_t background) {
+    /* Wait for previous operation to be done */
+    DMA2D_WAIT;
+
+    /* Memory to memory with blending */
+    DMA2D->CR = DMA2D_M2M_BLEND;
+
+    /* Foreground is A8 image with color from color register */
+    DMA2D->FGMAR = (uint32_t)pSrc;
+    DMA2D->FGOR = OffLineSrc;
+    DMA2D->FGPFCCR = CM_A8;
+    DMA2D->FGCOLR = RGB565_TO_RGB888(foreground);
+
+    if (background & DMA2D_GRAPHIC_TRANSPARENT) {
+        /* Background is read from destination memory */
+        DMA2D->BGMAR = (uint32_t)pDst;
+        DMA2D->BGOR = OffLineDst;
+        DMA2D->BGPFCCR = CM_RGB565;
+    } else {
+        /* Background is the same A8 image with alpha replaced by 0xFF, so it is solid color from register */
+        DMA2D->BGMAR = (uint32_t)pSrc;
+        DMA2D->BGOR = OffLineSrc;
+        DMA2D->BGPFCCR = CM_A8 | DMA2D_BGPFCCR_AM_0 | DMA2D_BGPFCCR_ALPHA;
+        DMA2D->BGCOLR = RGB565_TO_RGB888(background);
+    }
+
+    /* Output memory */
+    DMA2D->OMAR = (uint32_t)pDst;
+    DMA2D->OOR = OffLineDst;
+    DMA2D->OPFCCR = DMA2D_RGB565;
+
+    /* Set up size */
+    DMA2D->NLR = (uint32_t)(xSize << 16) | (uint16_t)ySize;
+
+    /* Start DMA2D */
+    DMA2D->CR |= DMA2D_CR_START;
+}
+
+void
+TM_DMA2DGRAPHIC_Convert(const void* pSrc, uint32_t SrcFormat, void* pDst, uint32_t DstFormat, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst) {
+    /* Wait for previous operation to be done */
+    DMA2D_WAIT;
+
+    /* Plain copy when formats are the same, otherwise pixel format conversion */
+    DMA2D->CR = SrcFormat == DstFormat ? DMA2D_M2M : DMA2D_M2M_PFC;
+
+    /* Set up pointers */
+    DMA2D->FGMAR = (uint32_t)pSrc;
+    DMA2D->FGOR = OffLineSrc;
+    DMA2D->OMAR = (uint32_t)pDst;
+    DMA2D->OOR = OffLineDst;
+
+    /* Set up pixel formats, CLUT settings in foreground are kept as they were loaded */
+    DMA2D->FGPFCCR = (DMA2D->FGPFCCR & (DMA2D_FGPFCCR_CCM | DMA2D_FGPFCCR_CS)) | SrcFormat;
+    DMA2D->OPFCCR = DstFormat;
+
+    /* Set up size */
+    DMA2D->NLR = (uint32_t)(xSize << 16) | (uint16_t)ySize;
+
+    /* Start DMA2D and wait */
+    DMA2D->CR |= DMA2D_CR_START;
+    DMA2D_WAIT;
+}
+
+void
+TM_DMA2DGRAPHIC_Blend(const void* pFG, uint32_t FGFormat, const void* pBG, uint32_t BGFormat, void* pDst, uint32_t DstFormat, uint32_t xSize, uint32_t ySize, uint32_t OffLineFG, uint32_t OffLineBG, uint32_t OffLineDst, uint32_t alpha) {
+    /* Wait for previous operation to be done */
+    DMA2D_WAIT;
+
+    /* Memory to memory with blending */
+    DMA2D->CR = DMA2D_M2M_BLEND;
+
+    /* Set up pointers */
+    DMA2D->FGMAR = (uint32_t)pFG;
+    DMA2D->FGOR = OffLineFG;
+    DMA2D->BGMAR = (uint32_t)pBG;
+    DMA2D->BGOR = OffLineBG;
+    DMA2D->OMAR = (uint32_t)pDst;
+    DMA2D->OOR = OffLineDst;
+
+    if (alpha & DMA2D_GRAPHIC_ALPHA_PIXEL) {
+        /* Alpha values from pixels */
+        DMA2D->FGPFCCR = FGFormat;
+        DMA2D->BGPFCCR = BGFormat;
+    } else {
+        /* Foreground alpha is replaced with constant and background is opaque */
+        DMA2D->FGPFCCR = FGFormat | DMA2D_FGPFCCR_AM_0 | ((alpha & 0xFF) << 24);
+        DMA2D->BGPFCCR = BGFormat | DMA2D_BGPFCCR_AM_0 | DMA2D_BGPFCCR_ALPHA;
+    }
+    DMA2D->OPFCCR = DstFormat;
+
+    /* Set up size */
+    DMA2D->NLR = (uint32_t)(xSize << 16) | (uint16_t)ySize;
+
+    /* Start DMA2D and wait */
+    DMA2D->CR |= DMA2D_CR_START;
+    DMA2D_WAIT;
+}
+
+uint16_t
+TM_DMA2DGRAPHIC_MixColors(uint16_t foreground, uint16_t background, uint8_t alpha) {
+    uint32_t fg, bg;
+
+    /* Spread green away from red and blue, so all 3 are mixed with single multiplication */
+    fg = (foreground | ((uint32_t)foreground << 16)) & 0x07E0F81F;
+    bg = (background | ((uint32_t)background << 16)) & 0x07E0F81F;
+
+    /* Mix with alpha rounded to 0 - 32 range, so 0 and 255 give exact colors */
+    bg = ((((fg - bg) * ((alpha + 4) >> 3)) >> 5) + bg) & 0x07E0F81F;
+
+    /* Return RGB565 color */
+    return (uint16_t)(bg | (bg >> 16));
+}
+
 /* Private functions */
+TM_SCANLINE_t*
+TM_DMA2DGRAPHIC_GetScanline(void) {
+    /* Update size for current orientation */
+    DMA2DGRAPHIC_Scanline.Width = DIS.CurrentWidth;
+    DMA2DGRAPHIC_Scanline.Height = DIS.CurrentHeight;
+
+    return &DMA2DGRAPHIC_Scanline;
+}
+
 void
 TM_INT_DMA2DGRAPHIC_SetConf(TM_DMA2DGRAPHIC_INT_Conf_t* Conf) {
     /* Fill settings for DMA2D */
@@ -696,47 +829,24 @@ TM_INT_DMA2DGRAPHIC_SetMemory(uint32_t MemoryAddress, uint32_t Offset, uint32_t
 }
 
 void
-TM_INT_DMA2DGRAPHIC_DrawCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
-
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        if (corner & 0x01) {/* Top left */
-            TM_DMA2DGRAPHIC_DrawPixel(x0 - y, y0 - x, color);
-            TM_DMA2DGRAPHIC_DrawPixel(x0 - x, y0 - y, color);
-        }
-
-        if (corner & 0x02) {/* Top right */
-            TM_DMA2DGRAPHIC_DrawPixel(x0 + x, y0 - y, color);
-            TM_DMA2DGRAPHIC_DrawPixel(x0 + y, y0 - x, color);
-        }
+TM_INT_DMA2DGRAPHIC_SetRectangle(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    uint32_t index;
 
-        if (corner & 0x04) {/* Bottom right */
-            TM_DMA2DGRAPHIC_DrawPixel(x0 + x, y0 + y, color);
-            TM_DMA2DGRAPHIC_DrawPixel(x0 + y, y0 + x, color);
-        }
+    /* Memory index of top left rectangle corner in memory, not on LCD */
+    index = DIS.Origin;
+    index += (x + (DIS.XStep < 0 ? width - 1 : 0)) * DIS.XStep;
+    index += (y + (DIS.YStep < 0 ? height - 1 : 0)) * DIS.YStep;
 
-        if (corner & 0x08) {/* Bottom left */
-            TM_DMA2DGRAPHIC_DrawPixel(x0 - x, y0 + y, color);
-            TM_DMA2DGRAPHIC_DrawPixel(x0 - y, y0 + x, color);
-        }
+    /* LCD X axis is the same as memory X axis for 0 and 180 degrees */
+    if (DIS.XStep == 1 || DIS.XStep == -1) {
+        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * index, DIS.Width - width, height, width);
+    } else {
+        TM_INT_DMA2DGRAPHIC_SetMemory(DIS.PixelSize * index, DIS.Width - height, width, height);
     }
 }
 
 void
-TM_INT_DMA2DGRAPHIC_DrawFilledCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color) {
+TM_INT_DMA2DGRAPHIC_DrawCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color) {
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
@@ -754,23 +864,33 @@ TM_INT_DMA2DGRAPHIC_DrawFilledCircleCorner(int16_t x0, int16_t y0, int16_t r, ui
         f += ddF_x;
 
         if (corner & 0x01) {/* Top left */
-            TM_DMA2DGRAPHIC_DrawLine(x0, y0 - y, x0 - x, y0 - y, color);
-            TM_DMA2DGRAPHIC_DrawLine(x0, y0 - x, x0 - y, y0 - x, color);
+            DrawPixel(x0 - y, y0 - x, color);
+            DrawPixel(x0 - x, y0 - y, color);
         }
 
         if (corner & 0x02) {/* Top right */
-            TM_DMA2DGRAPHIC_DrawLine(x0 + x, y0 - y, x0, y0 - y, color);
-            TM_DMA2DGRAPHIC_DrawLine(x0 + y, y0 - x, x0, y0 - x, color);
+            DrawPixel(x0 + x, y0 - y, color);
+            DrawPixel(x0 + y, y0 - x, color);
         }
 
         if (corner & 0x04) {/* Bottom right */
-            TM_DMA2DGRAPHIC_DrawLine(x0, y0 + y, x0 + x, y0 + y, color);
-            TM_DMA2DGRAPHIC_DrawLine(x0 + y, y0 + x, x0, y0 + x, color);
+            DrawPixel(x0 + x, y0 + y, color);
+            DrawPixel(x0 + y, y0 + x, color);
         }
 
         if (corner & 0x08) {/* Bottom left */
-            TM_DMA2DGRAPHIC_DrawLine(x0 - x, y0 + y, x0, y0 + y, color);
-            TM_DMA2DGRAPHIC_DrawLine(x0, y0 + x, x0 - y, y0 + x, color);
+            DrawPixel(x0 - x, y0 + y, color);
+            DrawPixel(x0 - y, y0 + x, color);
         }
     }
 }
+
+static void
+TM_INT_DMA2DGRAPHIC_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color) {
+    /* Long lines in memory direction are faster with DMA2D */
+    if ((x1 - x0) >= DMA2DGRAPHIC_SPAN_DMA2D && (DIS.XStep == 1 || DIS.XStep == -1)) {
+        TM_DMA2DGRAPHIC_DrawHorizontalLine(x0, y, x1 - x0 + 1, color);
+    } else {
+        TM_DMA2DGRAPHIC_DrawSpan(x0, y, x1 - x0 + 1, color);
+    }
+}
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/01/library-51-chrom-art-accelerator-dma2d-graphic-library-on-stm32f429-discovery
- * @version v1.0
+ * @version v1.3
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   Graphic library for LCD using DMA2D for transferring graphic data to memory for LCD display
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_DMA2DGRAPHIC_H
-#define TM_DMA2DGRAPHIC_H 100
+#define TM_DMA2DGRAPHIC_H 140
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -67,6 +67,27 @@ extern "C" {
  * \par Changelog
  *
 @verbatim
+ Version 1.4
+  - October 16, 2026
+  - Added TM_DMA2DGRAPHIC_Convert() and TM_DMA2DGRAPHIC_Blend() functions for any DMA2D pixel format, used by emWin driver
+
+ Version 1.3
+  - October 16, 2026
+  - DMA2D_WORKING macro can be overwritten in defines.h, used by host simulator
+
+ Version 1.2
+  - October 16, 2026
+  - Filled circles, triangles and rounded rectangles are drawn with TM SCANLINE engine
+  - Added TM_DMA2DGRAPHIC_GetScanline() function for other filled shapes
+
+ Version 1.1
+  - October 16, 2026
+  - Added TM_DMA2DGRAPHIC_BlendA8() and TM_DMA2DGRAPHIC_BlendA8IT() functions for text drawing with font atlas
+  - Added TM_DMA2DGRAPHIC_MixColors() function
+  - Orientation is calculated only once in TM_DMA2DGRAPHIC_SetOrientation() as memory origin and X/Y steps
+  - Lines, circles and corners are drawn with CPU pixel writes instead of DMA2D transfer per pixel
+  - Added TM_DMA2DGRAPHIC_DrawSpan() and TM_DMA2DGRAPHIC_DrawPixels() functions
+
  Version 1.0
   - First release
 @endverbatim
@@ -78,6 +99,8 @@ extern "C" {
  - STM32F4xx RCC
  - STM32F4xx DMA2D
  - defines.h
+ - TM FONTS
+ - TM SCANLINE
 @endverbatim
  */
 
@@ -85,6 +108,8 @@ extern "C" {
 #include "stm32f4xx_rcc.h"
 #include "stm32f4xx_dma2d.h"
 #include "defines.h"
+#include "tm_stm32f4_fonts.h"
+#include "tm_stm32f4_scanline.h"
 
 /**
  * @defgroup TM_DMA2D_GRAPHIC_Macros
@@ -158,8 +183,22 @@ extern "C" {
 #define GRAPHIC_COLOR_GRAY          0x7BEF
 #define GRAPHIC_COLOR_BROWN         0xBBCA
 
+/**
+ * @brief  Transparent background color flag
+ * @note   Use it for background color in @ref TM_DMA2DGRAPHIC_BlendA8 function
+ */
+#define DMA2D_GRAPHIC_TRANSPARENT   0x80000000
+
+/**
+ * @brief  Pixel alpha flag
+ * @note   Use it for alpha parameter in @ref TM_DMA2DGRAPHIC_Blend function to blend with alpha values from pixels
+ */
+#define DMA2D_GRAPHIC_ALPHA_PIXEL   0x80000000
+
 /* Waiting flags */
+#ifndef DMA2D_WORKING
 #define DMA2D_WORKING               ((DMA2D->CR & DMA2D_CR_START))
+#endif
 #define DMA2D_WAIT                  do { while (DMA2D_WORKING); DMA2D->IFCR = DMA2D_IFSR_CTCIF;} while (0);
 
 /**
@@ -265,6 +304,29 @@ void TM_DMA2DGRAPHIC_DrawPixel(uint16_t x, uint16_t y, uint32_t color);
  */
 uint32_t TM_DMA2DGRAPHIC_GetPixel(uint16_t x, uint16_t y);
 
+/**
+ * @brief  Draws horizontal run of pixels with single color on currently active layer
+ * @note   Pixels are written directly with CPU and address is calculated only once.
+ *         This is faster than DMA2D transfer for short lines, like in text and line drawing
+ * @param  x: X coordinate of first pixel on LCD
+ * @param  y: Y coordinate of first pixel on LCD
+ * @param  length: Number of pixels to draw
+ * @param  color: Color in RGB565 format
+ * @retval None
+ */
+void TM_DMA2DGRAPHIC_DrawSpan(int16_t x, int16_t y, uint16_t length, uint32_t color);
+
+/**
+ * @brief  Draws horizontal run of pixels with different colors on currently active layer
+ * @note   Pixels are written directly with CPU and address is calculated only once
+ * @param  x: X coordinate of first pixel on LCD
+ * @param  y: Y coordinate of first pixel on LCD
+ * @param  *colors: Pointer to array of colors in RGB565 format, one per pixel
+ * @param  count: Number of pixels to draw
+ * @retval None
+ */
+void TM_DMA2DGRAPHIC_DrawPixels(int16_t x, int16_t y, const uint16_t* colors, uint16_t count);
+
 /**
  * @brief  Draws vertical line on currently active layer
  * @param  x: X coordinate on LCD
@@ -397,9 +459,88 @@ void TM_DMA2DGRAPHIC_DrawTriangle(uint16_t x1, uint16_t y1,  uint16_t x2, uint16
  */
 void TM_DMA2DGRAPHIC_DrawFilledTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint32_t color);
 
+/**
+ * @brief  Gets device structure for TM SCANLINE engine, used for other filled shapes (polygons, ellipses, arcs)
+ * @note   Call it again after orientation is changed
+ * @param  None
+ * @retval Pointer to @ref TM_SCANLINE_t device structure for currently active layer
+ */
+TM_SCANLINE_t* TM_DMA2DGRAPHIC_GetScanline(void);
+
 void TM_DMA2DGRAPHIC_CopyBuffer(void* pSrc, void* pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst);
 void TM_DMA2DGRAPHIC_CopyBufferIT(void* pSrc, void* pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst);
 
+/**
+ * @brief  Draws 8-bit alpha (A8) image, like character from @ref TM_FONTS_Atlas_t, to RGB565 memory with DMA2D blending
+ * @note   Foreground color is set with DMA2D color register, so single A8 image can be drawn in any color.
+ *         If background is not transparent, background is also generated by DMA2D and destination memory is not read
+ * @note   Function waits till transfer is done
+ * @param  *pSrc: Pointer to A8 source data
+ * @param  *pDst: Pointer to RGB565 destination memory, top left pixel
+ * @param  xSize: Number of pixels per line
+ * @param  ySize: Number of lines
+ * @param  OffLineSrc: Number of source pixels to skip after each line
+ * @param  OffLineDst: Number of destination pixels to skip after each line
+ * @param  foreground: Foreground color in RGB565 format
+ * @param  background: Background color in RGB565 format or @ref DMA2D_GRAPHIC_TRANSPARENT to blend with memory content
+ * @retval None
+ */
+void TM_DMA2DGRAPHIC_BlendA8(const uint8_t* pSrc, void* pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst, uint32_t foreground, uint32_t background);
+
+/**
+ * @brief  Draws 8-bit alpha (A8) image to RGB565 memory with DMA2D blending and does not wait for transfer to finish
+ * @note   Use this for drawing strings, character after character. Use @ref DMA2D_WAIT before memory is used by CPU
+ * @note   Parameters are the same as for @ref TM_DMA2DGRAPHIC_BlendA8 function
+ * @retval None
+ */
+void TM_DMA2DGRAPHIC_BlendA8IT(const uint8_t* pSrc, void* pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst, uint32_t foreground, uint32_t background);
+
+/**
+ * @brief  Mixes 2 RGB565 colors with CPU
+ * @param  foreground: Foreground color in RGB565 format
+ * @param  background: Background color in RGB565 format
+ * @param  alpha: Foreground alpha value, 0 = background only, 255 = foreground only
+ * @retval Mixed color in RGB565 format
+ */
+uint16_t TM_DMA2DGRAPHIC_MixColors(uint16_t foreground, uint16_t background, uint8_t alpha);
+
+/**
+ * @brief  Copies image from one memory to another with DMA2D and converts pixel format if needed
+ * @note   Function waits till transfer is done
+ * @param  *pSrc: Pointer to source data
+ * @param  SrcFormat: Source pixel format. This parameter can be a value of CM_xxx, like CM_ARGB8888, CM_RGB565 or CM_L8
+ * @param  *pDst: Pointer to destination memory
+ * @param  DstFormat: Destination pixel format. This parameter can be CM_ARGB8888, CM_RGB888, CM_RGB565, CM_ARGB1555 or CM_ARGB4444
+ * @param  xSize: Number of pixels per line
+ * @param  ySize: Number of lines
+ * @param  OffLineSrc: Number of source pixels to skip after each line
+ * @param  OffLineDst: Number of destination pixels to skip after each line
+ * @retval None
+ */
+void TM_DMA2DGRAPHIC_Convert(const void* pSrc, uint32_t SrcFormat, void* pDst, uint32_t DstFormat, uint32_t xSize, uint32_t ySize, uint32_t OffLineSrc, uint32_t OffLineDst);
+
+/**
+ * @brief  Blends foreground image over background image to destination memory with DMA2D
+ * @note   Function waits till transfer is done
+ * @note   Background and destination can be the same memory
+ * @param  *pFG: Pointer to foreground data
+ * @param  FGFormat: Foreground pixel format. This parameter can be a value of CM_xxx
+ * @param  *pBG: Pointer to background data
+ * @param  BGFormat: Background pixel format. This parameter can be a value of CM_xxx
+ * @param  *pDst: Pointer to destination memory
+ * @param  DstFormat: Destination pixel format. This parameter can be CM_ARGB8888, CM_RGB888, CM_RGB565, CM_ARGB1555 or CM_ARGB4444
+ * @param  xSize: Number of pixels per line
+ * @param  ySize: Number of lines
+ * @param  OffLineFG: Number of foreground pixels to skip after each line
+ * @param  OffLineBG: Number of background pixels to skip after each line
+ * @param  OffLineDst: Number of destination pixels to skip after each line
+ * @param  alpha: Constant foreground alpha, 0 = background only, 255 = foreground only.
+ *            Background is then used as opaque, so result is linear mix of both images.
+ *            Use @ref DMA2D_GRAPHIC_ALPHA_PIXEL to blend with alpha values from foreground and background pixels
+ * @retval None
+ */
+void TM_DMA2DGRAPHIC_Blend(const void* pFG, uint32_t FGFormat, const void* pBG, uint32_t BGFormat, void* pDst, uint32_t DstFormat, uint32_t xSize, uint32_t ySize, uint32_t OffLineFG, uint32_t OffLineBG, uint32_t OffLineDst, uint32_t alpha);
+
 /* Private functions */
 void TM_INT_DMA2DGRAPHIC_SetConf(TM_DMA2DGRAPHIC_INT_Conf_t* Conf);
 
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/01/library-50-stemwin-for-stm32f429-discovery
- * @version v1.0
+ * @version v1.1
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   STemWin implementation for STM32F429-Discovery
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_EMWIN_H
-#define TM_EMWIN_H 100
+#define TM_EMWIN_H 110
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -49,9 +49,27 @@ extern "C" {
  *
  * To know how to write text and other stuff, you should take a look at emwin manual from segger.
  *
+ * \par DMA2D acceleration
+ *
+ * LCD driver uses DMA2D with @ref TM_DMA2D_GRAPHIC functions for filling, copying, bitmaps,
+ * alpha blending, mixing colors and color conversion, so translucent widgets and memory devices are fast.
+ *
+ * \par Multiple buffering
+ *
+ * Set EMWIN_NUM_BUFFERS to 2 or 3 in defines.h and use GUI_MULTIBUF_Begin() and GUI_MULTIBUF_End() around drawings.
+ * emWin then draws to back buffer in SDRAM and LCD driver changes LTDC framebuffer address in vertical synchronization period,
+ * so there is no flickering and tearing. Don't use @ref TM_EMWIN_MemoryEnable function together with multiple buffering.
+ *
  * \par Changelog
  *
 @verbatim
+ Version 1.1
+  - October 16, 2026
+  - Alpha blending, mixing colors, color conversion and bitmaps go through DMA2D GRAPHIC library
+  - Fixed DMA2D index to color conversion, which converted in wrong direction
+  - Fixed 16bpp bitmaps with width different than LCD width
+  - Multiple buffering with EMWIN_NUM_BUFFERS define, drawing goes always to back buffer
+
  Version 1.0
   - First release
 @endverbatim
@@ -69,6 +87,7 @@ extern "C" {
  - STM32F4xx SPI
  - defines.h
  - TM ILI9341 LTDC
+ - TM DMA2D GRAPHIC
  - TM FONTS
  - TM I2C
  - TM SDRAM
@@ -80,6 +99,7 @@ extern "C" {
 #include "defines.h"
 #include "tm_stm32f4_sdram.h"
 #include "tm_stm32f4_ili9341_ltdc.h"
+#include "tm_stm32f4_dma2d_graphic.h"
 #include "tm_stm32f4_stmpe811.h"
 #include "GUI.h"
 
@@ -103,6 +123,13 @@ extern "C" {
 #define EMWIN_UPDATE_TOUCH_MILLIS       50
 #endif
 
+/**
+ * @brief Number of emWin frame buffers in SDRAM, set to 2 or 3 for multiple buffering
+ */
+#ifndef EMWIN_NUM_BUFFERS
+#define EMWIN_NUM_BUFFERS               1
+#endif
+
 /**
  * @}
  */
@@ -171,7 +171,7 @@ TM_FATFS_Search(char* Folder, char* tmp_buffer, uint16_t tmp_buffer_size, TM_FAT
     /* Check for buffer */
     if (tmp_buffer == NULL) {
         /* Try to allocate memory */
-        tmp_buffer = (char*) LIB_ALLOC_FUNC(tmp_buffer_size);
+        tmp_buffer = (char*) TM_FATFS_ALLOC_FUNC(tmp_buffer_size);
 
         /* Check for success */
         if (tmp_buffer == NULL) {
@@ -196,7 +196,7 @@ TM_FATFS_Search(char* Folder, char* tmp_buffer, uint16_t tmp_buffer_size, TM_FAT
 
     /* Check for malloc */
     if (malloc_used) {
-        LIB_FREE_FUNC(tmp_buffer);
+        TM_FATFS_FREE_FUNC(tmp_buffer);
     }
 
     /* Return result */
@@ -4,7 +4,7 @@
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/07/library-21-read-sd-card-fatfs-stm32f4xx-devices/
  * @link    http://stm32f4-discovery.net/2014/08/library-29-usb-msc-host-usb-flash-drive-stm32f4xx-devices
- * @version v1.7
+ * @version v1.9
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   Fatfs implementation for STM32F4xx devices
@@ -29,7 +29,7 @@
 @endverbatim
  */
 #ifndef TM_FATFS_H
-#define TM_FATFS_H 170
+#define TM_FATFS_H 190
 
 /**
  * @addtogroup TM_STM32F4xx_Libraries
@@ -392,6 +392,14 @@ f_open(&fil, "SD:my_file_sd.txt", FA...);
  * \par Changelog
  *
 @verbatim
+ Version 1.9
+  - October 16, 2026
+  - SDIO driver copies sectors through SRAM buffer when buffer is in CCM RAM, because DMA can't access it
+
+ Version 1.8
+  - October 16, 2026
+  - Added TM_FATFS_ALLOC_FUNC and TM_FATFS_FREE_FUNC defines to select memory for search buffer
+
  Version 1.7
   - April 30, 2015
   - Added support for SDRAM as FATFS drive
@@ -478,6 +486,17 @@ f_open(&fil, "SD:my_file_sd.txt", FA...);
 #define LIB_FREE_FUNC     free
 #endif
 
+/**
+ * @brief  Memory functions for search buffer, LIB_ALLOC_FUNC and LIB_FREE_FUNC by default
+ * @note   Set them in defines.h to use other heap, for example with TM HEAP library
+ */
+#ifndef TM_FATFS_ALLOC_FUNC
+#define TM_FATFS_ALLOC_FUNC    LIB_ALLOC_FUNC
+#endif
+#ifndef TM_FATFS_FREE_FUNC
+#define TM_FATFS_FREE_FUNC     LIB_FREE_FUNC
+#endif
+
 
 /**
  * @}
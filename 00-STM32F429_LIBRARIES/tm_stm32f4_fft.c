@@ -18,6 +18,7 @@
  */
 #include "tm_stm32f4_fft.h"
 #include "stdlib.h"
+#include "string.h"
 
 /* Array with constants for CFFT module */
 /* Requires ARM CONST STRUCTURES files */
@@ -33,6 +34,16 @@ const arm_cfft_instance_f32 CFFT_Instances[] = {
     {4096, twiddleCoef_4096, armBitRevIndexTable4096, ARMBITREVINDEXTABLE4096_TABLE_LENGTH}
 };
 
+#if TM_FFT_TWIDDLE_CCM_SIZE > 0
+/* Copies of twiddle tables in CCM RAM, each FFT size is copied once */
+static float32_t Twiddles[TM_FFT_TWIDDLE_CCM_SIZE / sizeof(float32_t)] TM_CCM_BSS;
+static uint32_t TwiddlesUsed TM_CCM_BSS;
+static arm_cfft_instance_f32 CCM_Instances[sizeof(CFFT_Instances) / sizeof(CFFT_Instances[0])] TM_CCM_BSS;
+
+/* Private functions */
+static const arm_cfft_instance_f32* TM_FFT_INT_CopyTwiddles(uint8_t i);
+#endif
+
 uint8_t
 TM_FFT_Init_F32(TM_FFT_F32_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
     uint8_t i;
@@ -49,7 +60,11 @@ TM_FFT_Init_F32(TM_FFT_F32_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
             FFT->FFT_Size = FFT_Size;
 
             /* Save proper pointer */
+#if TM_FFT_TWIDDLE_CCM_SIZE > 0
+            FFT->S = TM_FFT_INT_CopyTwiddles(i);
+#else
             FFT->S = &CFFT_Instances[i];
+#endif
 
             /* Stop for loop */
             break;
@@ -65,7 +80,7 @@ TM_FFT_Init_F32(TM_FFT_F32_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
     /* If malloc selected for allocation, use it */
     if (use_malloc) {
         /* Allocate input buffer */
-        FFT->Input = (float32_t*) LIB_ALLOC_FUNC((FFT->FFT_Size * 2) * sizeof(float32_t));
+        FFT->Input = (float32_t*) TM_FFT_ALLOC_FUNC((FFT->FFT_Size * 2) * sizeof(float32_t));
 
         /* Check for success */
         if (FFT->Input == NULL) {
@@ -73,12 +88,12 @@ TM_FFT_Init_F32(TM_FFT_F32_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
         }
 
         /* Allocate input buffer */
-        FFT->Output = (float32_t*) LIB_ALLOC_FUNC(FFT->FFT_Size * sizeof(float32_t));
+        FFT->Output = (float32_t*) TM_FFT_ALLOC_FUNC(FFT->FFT_Size * sizeof(float32_t));
 
         /* Check for success */
         if (FFT->Output == NULL) {
             /* Deallocate input buffer */
-            LIB_FREE_FUNC(FFT->Input);
+            TM_FFT_FREE_FUNC(FFT->Input);
 
             /* Return error */
             return 3;
@@ -152,11 +167,38 @@ TM_FFT_Free_F32(TM_FFT_F32_t* FFT) {
 
     /* Check input buffer */
     if (FFT->Input) {
-        LIB_FREE_FUNC(FFT->Input);
+        TM_FFT_FREE_FUNC(FFT->Input);
     }
 
     /* Check output buffer */
     if (FFT->Output) {
-        LIB_FREE_FUNC(FFT->Output);
+        TM_FFT_FREE_FUNC(FFT->Output);
+    }
+}
+
+#if TM_FFT_TWIDDLE_CCM_SIZE > 0
+/* Private functions */
+static const arm_cfft_instance_f32*
+TM_FFT_INT_CopyTwiddles(uint8_t i) {
+    uint32_t count = 2 * CFFT_Instances[i].fftLen;
+
+    /* Table for this size is already copied */
+    if (CCM_Instances[i].fftLen) {
+        return &CCM_Instances[i];
+    }
+
+    /* Check free memory, use table in flash if there is no space */
+    if (TwiddlesUsed + count > sizeof(Twiddles) / sizeof(Twiddles[0])) {
+        return &CFFT_Instances[i];
     }
+
+    /* Copy table and set instance to use it */
+    memcpy(&Twiddles[TwiddlesUsed], CFFT_Instances[i].pTwiddle, count * sizeof(float32_t));
+    CCM_Instances[i] = CFFT_Instances[i];
+    CCM_Instances[i].pTwiddle = &Twiddles[TwiddlesUsed];
+    TwiddlesUsed += count;
+
+    /* Return instance in CCM RAM */
+    return &CCM_Instances[i];
 }
+#endif
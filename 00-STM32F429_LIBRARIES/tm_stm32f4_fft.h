@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/05/library-62-fast-fourier-transform-fft-for-stm32f4xx
- * @version v1.0
+ * @version v1.2
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   FFT library for float 32 and Cortex-M4 little endian
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_FFT_H
-#define TM_FFT_H 100
+#define TM_FFT_H 120
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -49,9 +49,24 @@ extern "C" {
  *
  * For more info about FFT and how it works on Cortex-M4, you should take a look at ARM DSP documentation
  *
+ * \par CCM RAM
+ *
+ * FFT reads twiddle factors from table in flash. On first init of each FFT size, table is copied to CCM RAM,
+ * where CPU reads it without flash wait states. Tables take 8 bytes for each FFT sample, 8kB for 1024 samples.
+ * When TM_FFT_TWIDDLE_CCM_SIZE bytes are used, tables for next FFT sizes are read from flash.
+ * Tables are copied only when TM_CCM_ENABLED is 1 in defines.h, see attributes.h. Otherwise they are always read from flash.
+ *
  * \par Changelog
  *
 @verbatim
+ Version 1.2
+  - October 16, 2026
+  - Twiddle factor tables are copied to CCM RAM when TM_CCM_ENABLED is 1
+
+ Version 1.1
+  - October 16, 2026
+  - Added TM_FFT_ALLOC_FUNC and TM_FFT_FREE_FUNC defines to select memory for buffers
+
  Version 1.0
   - First release
 @endverbatim
@@ -61,6 +76,7 @@ extern "C" {
 @verbatim
  - STM32F4xx
  - defines.h
+ - attributes.h
  - ARM MATH
  - ARM CONST STRUCTS
 @endverbatim
@@ -68,6 +84,7 @@ extern "C" {
 
 #include "stm32f4xx.h"
 #include "defines.h"
+#include "attributes.h"
 
 #include "arm_math.h"
 #include "arm_const_structs.h"
@@ -88,6 +105,28 @@ extern "C" {
 #define LIB_FREE_FUNC     free
 #endif
 
+/**
+ * @brief  Memory functions for FFT buffers, LIB_ALLOC_FUNC and LIB_FREE_FUNC by default
+ * @note   Set them in defines.h to use other heap, for example with TM HEAP library
+ */
+#ifndef TM_FFT_ALLOC_FUNC
+#define TM_FFT_ALLOC_FUNC    LIB_ALLOC_FUNC
+#endif
+#ifndef TM_FFT_FREE_FUNC
+#define TM_FFT_FREE_FUNC     LIB_FREE_FUNC
+#endif
+
+/**
+ * @brief  Bytes of CCM RAM for copies of twiddle factor tables, 8kB when CCM RAM is enabled. Set to 0 to read tables from flash
+ */
+#ifndef TM_FFT_TWIDDLE_CCM_SIZE
+#if TM_CCM_ENABLED == 1
+#define TM_FFT_TWIDDLE_CCM_SIZE    8192
+#else
+#define TM_FFT_TWIDDLE_CCM_SIZE    0
+#endif
+#endif
+
 /**
  * @}
  */
@@ -340,3 +340,26 @@ TM_FONTS_GetStringSize(char* str, TM_FONTS_SIZE_t* SizeStruct, TM_FontDef_t* Fon
     /* Return pointer */
     return str;
 }
+
+TM_FONTS_Atlas_t*
+TM_FONTS_CreateAtlas(TM_FONTS_Atlas_t* Atlas, TM_FontDef_t* Font, uint8_t* Buffer) {
+    uint32_t c, i, j, b;
+    uint8_t* ptr = Buffer;
+
+    /* Expand all characters, row by row */
+    for (c = 0; c < TM_FONTS_CHARACTERS; c++) {
+        for (i = 0; i < Font->FontHeight; i++) {
+            b = Font->data[c * Font->FontHeight + i];
+            for (j = 0; j < Font->FontWidth; j++) {
+                *ptr++ = ((b << j) & 0x8000) ? 0xFF : 0x00;
+            }
+        }
+    }
+
+    /* Fill settings */
+    Atlas->Font = Font;
+    Atlas->Data = Buffer;
+
+    /* Return pointer */
+    return Atlas;
+}
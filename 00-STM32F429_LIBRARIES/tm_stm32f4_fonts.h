@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link
- * @version v1.2
+ * @version v1.3
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   Fonts library for LCD libraries
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_FONTS_H
-#define TM_FONTS_H 120
+#define TM_FONTS_H 130
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -54,9 +54,22 @@ extern "C" {
  *  - 11 x 18 pixels
  *  - 16 x 26 pixels
  *
+ * \par Font atlas
+ *
+ * Fonts are stored as 1 bit per pixel. For fast drawing with DMA2D, font can be expanded
+ * into atlas where each pixel is 8-bit alpha value (A8 format) and each character is stored
+ * as continuous block of FontWidth * FontHeight bytes.
+ *
+ * Atlas buffer can be placed in SDRAM or in internal RAM. Use @ref TM_FONTS_ATLAS_SIZE macro for buffer size.
+ * Atlas can also be generated on PC and saved into flash. In this case, only fill @ref TM_FONTS_Atlas_t structure.
+ *
  * \par Changelog
  *
 @verbatim
+ Version 1.3
+  - October 16, 2026
+  - Added support for 8-bit alpha (A8) font atlas, used for DMA2D text drawing
+
  Version 1.2
   - May 24, 2015
   - Added support for string length and height
@@ -77,6 +90,28 @@ extern "C" {
 #include "defines.h"
 #include "string.h"
 
+/**
+ * @defgroup TM_FONTS_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Number of characters in font, from space (0x20) to tilde (0x7E)
+ */
+#define TM_FONTS_CHARACTERS         95
+
+/**
+ * @brief  Gets size of atlas buffer in bytes for specific font
+ * @param  font: Pointer to @ref TM_FontDef_t font
+ * @retval Atlas size in bytes
+ */
+#define TM_FONTS_ATLAS_SIZE(font)   ((uint32_t)(font)->FontWidth * (font)->FontHeight * TM_FONTS_CHARACTERS)
+
+/**
+ * @}
+ */
+
 /**
  * @defgroup TM_LIB_Typedefs
  * @brief    Library Typedefs
@@ -92,6 +127,14 @@ typedef struct {
     const uint16_t* data; /*!< Pointer to data font data array */
 } TM_FontDef_t;
 
+/**
+ * @brief  Font atlas with 8-bit alpha value (A8 format) for each pixel
+ */
+typedef struct {
+    TM_FontDef_t* Font;   /*!< Pointer to font which was used to create atlas */
+    const uint8_t* Data;  /*!< Pointer to atlas data. Each character has FontWidth * FontHeight bytes, row by row */
+} TM_FONTS_Atlas_t;
+
 /**
  * @brief  String length and height
  */
@@ -144,6 +187,24 @@ extern TM_FontDef_t TM_Font_16x26;
  */
 char* TM_FONTS_GetStringSize(char* str, TM_FONTS_SIZE_t* SizeStruct, TM_FontDef_t* Font);
 
+/**
+ * @brief  Creates A8 atlas from 1 bit per pixel font
+ * @note   Set pixels get alpha 0xFF, cleared pixels get alpha 0x00
+ * @param  *Atlas: Pointer to empty @ref TM_FONTS_Atlas_t structure
+ * @param  *Font: Pointer to @ref TM_FontDef_t font used for atlas
+ * @param  *Buffer: Pointer to buffer for atlas data. It must be at least @ref TM_FONTS_ATLAS_SIZE bytes long
+ * @retval Pointer to atlas
+ */
+TM_FONTS_Atlas_t* TM_FONTS_CreateAtlas(TM_FONTS_Atlas_t* Atlas, TM_FontDef_t* Font, uint8_t* Buffer);
+
+/**
+ * @brief  Gets pointer to A8 data of specific character in atlas
+ * @param  *Atlas: Pointer to @ref TM_FONTS_Atlas_t atlas
+ * @param  c: Character
+ * @retval Pointer to first alpha byte of character
+ */
+#define TM_FONTS_GetAtlasChar(Atlas, c)   ((Atlas)->Data + (uint32_t)((c) - 32) * (Atlas)->Font->FontWidth * (Atlas)->Font->FontHeight)
+
 /**
  * @}
  */
@@ -150,6 +150,14 @@ TM_GENERAL_DWTCounterEnable(void) {
         GENERAL_SystemSpeedInMHz = TM_GENERAL_GetClockSpeed(TM_GENERAL_Clock_SYSCLK) / 1000000;
     }
 
+    /* Check if DWT already counts, TM DELAY cycle clock uses it and it must not be reset */
+    c = DWT->CYCCNT;
+    __ASM volatile ("NOP");
+    __ASM volatile ("NOP");
+    if ((DWT->CTRL & 0x00000001) && DWT->CYCCNT != c) {
+        return 1;
+    }
+
     /* Enable TRC */
     CoreDebug->DEMCR &= ~0x01000000;
     CoreDebug->DEMCR |=  0x01000000;
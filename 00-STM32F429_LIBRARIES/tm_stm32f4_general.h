@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/03/library-54-general-library-for-stm32f4xx-devices
- * @version v1.4
+ * @version v1.5
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   GENERAL library for STM32F4xx devices
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_GENERAL_H
-#define TM_GENERAL_H 140
+#define TM_GENERAL_H 150
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -64,6 +64,10 @@ extern "C" {
  * \par Changelog
  *
 @verbatim
+ Version 1.5
+  - October 16, 2026
+  - TM_GENERAL_DWTCounterEnable does not reset counter which is already running
+
  Version 1.4
   - June 20, 2015
   - Changed interrupt enable/disable functions. They now supports nested interrupt disabling
@@ -245,6 +249,7 @@ uint32_t TM_GENERAL_GetClockSpeed(TM_GENERAL_Clock_t clock);
  *         This happened to me when I use onboard ST-Link on Discovery or Nucleo boards.
  *         When I used external debugger (J-Link or ULINK2) it worked always without problems.
  *         If your DWT doesn't start, you should perform software/hardware reset by yourself.
+ * @note   Counter which is already running (for example started by TM DELAY) is not reset
  */
 uint8_t TM_GENERAL_DWTCounterEnable(void);
 
@@ -18,22 +18,25 @@
  */
 #include "tm_stm32f4_gps.h"
 
-static char GPS_Term[15];
-static uint8_t GPS_Term_Number;
-static uint8_t GPS_Term_Pos;
-static uint8_t TM_GPS_CRC, TM_GPS_CRC_Received;
-static uint8_t TM_GPS_Star;
-static uint8_t TM_GPS_Statement = GPS_ERR;
-static uint32_t GPS_Flags = 0, GPS_Flags_OK;
-static TM_GPS_Data_t TM_GPS_INT_Data;
-static uint8_t TM_GPS_FirstTime;
-static char GPS_Statement_Name[7];
+/* Parser state is used for each received character, it is in CCM RAM */
+static char GPS_Term[15] TM_CCM_BSS;
+static uint8_t GPS_Term_Number TM_CCM_BSS;
+static uint8_t GPS_Term_Pos TM_CCM_BSS;
+static uint8_t TM_GPS_CRC TM_CCM_BSS;
+static uint8_t TM_GPS_CRC_Received TM_CCM_BSS;
+static uint8_t TM_GPS_Star TM_CCM_BSS;
+static uint8_t TM_GPS_Statement TM_CCM_DATA = GPS_ERR;
+static uint32_t GPS_Flags TM_CCM_BSS;
+static uint32_t GPS_Flags_OK TM_CCM_BSS;
+static TM_GPS_Data_t TM_GPS_INT_Data TM_CCM_BSS;
+static uint8_t TM_GPS_FirstTime TM_CCM_BSS;
+static char GPS_Statement_Name[7] TM_CCM_BSS;
 
 #ifndef GPS_DISABLE_GPGSV
-uint8_t GPGSV_StatementsCount = 0;
-uint8_t GPSGV_StatementNumber = 0;
-uint8_t GPGSV_Term_Number = 0;
-uint8_t GPGSV_Term_Mod = 0;
+uint8_t GPGSV_StatementsCount TM_CCM_BSS;
+uint8_t GPSGV_StatementNumber TM_CCM_BSS;
+uint8_t GPGSV_Term_Number TM_CCM_BSS;
+uint8_t GPGSV_Term_Mod TM_CCM_BSS;
 #endif
 
 /* Private */
@@ -3,7 +3,7 @@
  * @email  tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/08/library-27-gps-stm32f4-devices/
- * @version v1.3.1
+ * @version v1.4
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   GPS NMEA standard data parser for STM32F4xx devices
@@ -27,7 +27,7 @@
 @endverbatim
  */
 #ifndef TM_GPS_H
-#define TM_GPS_H 131
+#define TM_GPS_H 140
 /**
  * @addtogroup TM_STM32F4xx_Libraries
  * @{
@@ -117,6 +117,10 @@
  * \par Changelog
  *
 @verbatim
+ Version 1.4
+  - October 16, 2026
+  - Parser state is placed to CCM RAM when TM_CCM_ENABLED is 1
+
  Version 1.3.1
   - May 27, 2015
   - Fixed bug with getting hard-fault some times because flags were not cleared correct
@@ -145,6 +149,7 @@
  - defines.h
  - TM USART
  - defines.h
+ - attributes.h
  - math.h
 @endverbatim
  */
@@ -152,6 +157,7 @@
 #include "stm32f4xx_rcc.h"
 #include "tm_stm32f4_usart.h"
 #include "defines.h"
+#include "attributes.h"
 #include "math.h"
 #include "stdio.h"
 #include "stdlib.h"
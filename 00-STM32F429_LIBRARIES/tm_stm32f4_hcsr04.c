@@ -51,7 +51,8 @@ TM_HCSR04_Init(TM_HCSR04_t* HCSR04, GPIO_TypeDef* ECHO_GPIOx, uint16_t ECHO_GPIO
 
 float
 TM_HCSR04_Read(TM_HCSR04_t* HCSR04) {
-    uint32_t time, timeout;
+    TM_DELAY_Deadline_t Deadline;
+    uint64_t start;
     /* Trigger low */
     TM_GPIO_SetPinLow(HCSR04->TRIGGER_GPIOx, HCSR04->TRIGGER_GPIO_Pin);
     /* Delay 2 us */
@@ -64,25 +65,26 @@ TM_HCSR04_Read(TM_HCSR04_t* HCSR04) {
     TM_GPIO_SetPinLow(HCSR04->TRIGGER_GPIOx, HCSR04->TRIGGER_GPIO_Pin);
 
     /* Give some time for response */
-    timeout = HCSR04_TIMEOUT;
+    TM_DELAY_DeadlineSet(&Deadline, HCSR04_TIMEOUT);
     while (!TM_GPIO_GetInputPinValue(HCSR04->ECHO_GPIOx, HCSR04->ECHO_GPIO_Pin)) {
-        if (timeout-- == 0x00) {
+        if (TM_DELAY_DeadlineExpired(&Deadline)) {
             return -1;
         }
     }
 
     /* Start time */
-    time = 0;
+    start = TM_DELAY_Cycles();
+    TM_DELAY_DeadlineSet(&Deadline, HCSR04_TIMEOUT);
+
     /* Wait till signal is low */
     while (TM_GPIO_GetInputPinValue(HCSR04->ECHO_GPIOx, HCSR04->ECHO_GPIO_Pin)) {
-        /* Increase time */
-        time++;
-        /* Delay 1us */
-        Delay(1);
+        if (TM_DELAY_DeadlineExpired(&Deadline)) {
+            return -1;
+        }
     }
 
-    /* Convert us to cm */
-    HCSR04->Distance =  (float)time * HCSR04_NUMBER;
+    /* Convert us to cm, cycles give echo length with sub microsecond accuracy */
+    HCSR04->Distance = (float)(TM_DELAY_Cycles() - start) / TM_DELAY_CyclesPerUs * HCSR04_NUMBER;
 
     /* Return distance */
     return HCSR04->Distance;
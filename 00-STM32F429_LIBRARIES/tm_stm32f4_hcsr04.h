@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/08/library-30-measure-distance-with-hc-sr04-and-stm32f4xx
- * @version v2.0
+ * @version v2.1
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   Measure distance with HC-SR04 Ultrasonic distance sensor on STM32F4xx devices
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_HCSR04_H
-#define TM_HCSR04_H 200
+#define TM_HCSR04_H 210
 /**
  * @addtogroup TM_STM32F4xx_Libraries
  * @{
@@ -56,6 +56,11 @@ I didn't tested that, but you might use the same ECHO pin for all sensors if you
  * \par Changelog
  *
 @verbatim
+ Version 2.1
+  - October 16, 2026
+  - Echo length is measured with TM DELAY cycle clock instead of counting 1us delays
+  - HCSR04_TIMEOUT is now in microseconds
+
  Version 2.0
   - March 29, 2015
   - Library has been rewritten. Now supports unlimited number of HCSR04 devices
@@ -94,9 +99,12 @@ I didn't tested that, but you might use the same ECHO pin for all sensors if you
  * @{
  */
 
-/* Default timeout pulses */
+/**
+ * @brief  Timeout in microseconds for echo start and echo length
+ * @note   Sensor makes about 38ms long echo when there is no obstacle
+ */
 #ifndef HCSR04_TIMEOUT
-#define HCSR04_TIMEOUT          1000000
+#define HCSR04_TIMEOUT          50000
 #endif
 
 /**
@@ -29,15 +29,46 @@ typedef struct {
     uint8_t currentY;
 } HD44780_Options_t;
 
+/**
+ * @brief  Background output state
+ * @note   Used private
+ */
+typedef struct {
+    uint16_t Queue[HD44780_QUEUE_SIZE]; /*!< Commands and CGRAM data, bit 8 set for data */
+    volatile uint8_t In;                /*!< Queue write position */
+    volatile uint8_t Out;               /*!< Queue read position */
+    uint8_t Cell;                       /*!< Next cell to compare */
+    uint8_t Address;                    /*!< LCD DDRAM address counter, 0xFF when unknown */
+    volatile uint8_t Working;           /*!< Set to 1 when pacing timer is running */
+} HD44780_Output_t;
+
 /* Private functions */
 static void TM_HD44780_InitPins(void);
 static void TM_HD44780_Cmd(uint8_t cmd);
 static void TM_HD44780_Cmd4bit(uint8_t cmd);
 static void TM_HD44780_Data(uint8_t data);
 static void TM_HD44780_CursorSet(uint8_t col, uint8_t row);
+static void TM_HD44780_INT_Write(uint8_t value, uint8_t rs);
+static void TM_HD44780_INT_Queue(uint16_t value);
+static void TM_HD44780_INT_Start(void);
+static void TM_HD44780_INT_Stop(void);
+static void TM_HD44780_INT_InitTimer(void);
+static void TM_HD44780_INT_Tick(void);
 
 /* Private variable */
 static HD44780_Options_t HD44780_Opts;
+static HD44780_Output_t HD44780_Output;
+
+/* Characters which should be on LCD and characters which are currently on LCD */
+static uint8_t HD44780_Shadow[HD44780_MAX_ROWS * HD44780_MAX_COLS];
+static uint8_t HD44780_Screen[HD44780_MAX_ROWS * HD44780_MAX_COLS];
+
+/* DDRAM address of first character in each row */
+static const uint8_t HD44780_RowOffsets[] = {0x00, 0x40, 0x14, 0x54};
+
+#if !defined(HD44780_TIM)
+static TM_DELAY_Timer_t* HD44780_Timer;
+#endif
 
 /* Pin definitions */
 #define HD44780_RS_LOW              TM_GPIO_SetPinLow(HD44780_RS_PORT, HD44780_RS_PIN)
@@ -46,8 +77,12 @@ static HD44780_Options_t HD44780_Opts;
 #define HD44780_E_HIGH              TM_GPIO_SetPinHigh(HD44780_E_PORT, HD44780_E_PIN)
 
 #define HD44780_E_BLINK             HD44780_E_HIGH; HD44780_Delay(20); HD44780_E_LOW; HD44780_Delay(20)
+#define HD44780_E_PULSE             HD44780_E_HIGH; HD44780_Delay(1); HD44780_E_LOW; HD44780_Delay(1)
 #define HD44780_Delay(x)            Delay(x)
 
+/* Queue entry for data */
+#define HD44780_QUEUE_DATA          0x0100
+
 /* Commands*/
 #define HD44780_CLEARDISPLAY        0x01
 #define HD44780_RETURNHOME          0x02
@@ -95,8 +130,8 @@ TM_HD44780_Init(uint8_t cols, uint8_t rows) {
     HD44780_Delay(45000);
 
     /* Set LCD width and height */
-    HD44780_Opts.Rows = rows;
-    HD44780_Opts.Cols = cols;
+    HD44780_Opts.Rows = rows > HD44780_MAX_ROWS ? HD44780_MAX_ROWS : rows;
+    HD44780_Opts.Cols = cols > HD44780_MAX_COLS ? HD44780_MAX_COLS : cols;
 
     /* Set cursor pointer to beginning for LCD */
     HD44780_Opts.currentX = 0;
@@ -124,27 +159,43 @@ TM_HD44780_Init(uint8_t cols, uint8_t rows) {
     HD44780_Delay(100);
 
     /* Set # lines, font size, etc. */
-    TM_HD44780_Cmd(HD44780_FUNCTIONSET | HD44780_Opts.DisplayFunction);
+    TM_HD44780_INT_Write(HD44780_FUNCTIONSET | HD44780_Opts.DisplayFunction, 0);
+    HD44780_Delay(100);
 
     /* Turn the display on with no cursor or blinking default */
     HD44780_Opts.DisplayControl = HD44780_DISPLAYON;
-    TM_HD44780_DisplayOn();
+    TM_HD44780_INT_Write(HD44780_DISPLAYCONTROL | HD44780_Opts.DisplayControl, 0);
+    HD44780_Delay(100);
 
     /* Clear lcd */
-    TM_HD44780_Clear();
+    TM_HD44780_INT_Write(HD44780_CLEARDISPLAY, 0);
+    HD44780_Delay(3000);
 
     /* Default font directions */
     HD44780_Opts.DisplayMode = HD44780_ENTRYLEFT | HD44780_ENTRYSHIFTDECREMENT;
-    TM_HD44780_Cmd(HD44780_ENTRYMODESET | HD44780_Opts.DisplayMode);
+    TM_HD44780_INT_Write(HD44780_ENTRYMODESET | HD44780_Opts.DisplayMode, 0);
 
     /* Delay */
     HD44780_Delay(4500);
+
+    /* LCD and shadow buffer are empty, address counter is at 0 after clear */
+    memset(HD44780_Shadow, ' ', sizeof(HD44780_Shadow));
+    memset(HD44780_Screen, ' ', sizeof(HD44780_Screen));
+    HD44780_Output.In = 0;
+    HD44780_Output.Out = 0;
+    HD44780_Output.Cell = 0;
+    HD44780_Output.Address = 0;
+    HD44780_Output.Working = 0;
+
+    /* Init timer for background output */
+    TM_HD44780_INT_InitTimer();
 }
 
 void
 TM_HD44780_Clear(void) {
-    TM_HD44780_Cmd(HD44780_CLEARDISPLAY);
-    HD44780_Delay(3000);
+    /* Spaces are written to LCD in background, this is faster than clear command */
+    memset(HD44780_Shadow, ' ', sizeof(HD44780_Shadow));
+    TM_HD44780_INT_Start();
 }
 
 void
@@ -162,11 +213,15 @@ TM_HD44780_Puts(uint8_t x, uint8_t y, char* str) {
         } else if (*str == '\r') {
             TM_HD44780_CursorSet(0, HD44780_Opts.currentY);
         } else {
-            TM_HD44780_Data(*str);
+            /* Only shadow buffer is changed */
+            HD44780_Shadow[HD44780_Opts.currentY * HD44780_Opts.Cols + HD44780_Opts.currentX] = *str;
             HD44780_Opts.currentX++;
         }
         str++;
     }
+
+    /* Send changes */
+    TM_HD44780_INT_Start();
 }
 
 void
@@ -230,30 +285,26 @@ TM_HD44780_CreateChar(uint8_t location, uint8_t* data) {
 void
 TM_HD44780_PutCustom(uint8_t x, uint8_t y, uint8_t location) {
     TM_HD44780_CursorSet(x, y);
-    TM_HD44780_Data(location);
+    HD44780_Shadow[HD44780_Opts.currentY * HD44780_Opts.Cols + HD44780_Opts.currentX] = location;
+    TM_HD44780_INT_Start();
+}
+
+uint8_t
+TM_HD44780_UpdateWorking(void) {
+    return HD44780_Output.Working;
 }
 
 /* Private functions */
 static void
 TM_HD44780_Cmd(uint8_t cmd) {
-    /* Command mode */
-    HD44780_RS_LOW;
-
-    /* High nibble */
-    TM_HD44780_Cmd4bit(cmd >> 4);
-    /* Low nibble */
-    TM_HD44780_Cmd4bit(cmd & 0x0F);
+    /* Commands are sent by output timer */
+    TM_HD44780_INT_Queue(cmd);
 }
 
 static void
 TM_HD44780_Data(uint8_t data) {
-    /* Data mode */
-    HD44780_RS_HIGH;
-
-    /* High nibble */
-    TM_HD44780_Cmd4bit(data >> 4);
-    /* Low nibble */
-    TM_HD44780_Cmd4bit(data & 0x0F);
+    /* Data are sent by output timer */
+    TM_HD44780_INT_Queue(HD44780_QUEUE_DATA | data);
 }
 
 static void
@@ -268,20 +319,196 @@ TM_HD44780_Cmd4bit(uint8_t cmd) {
 
 static void
 TM_HD44780_CursorSet(uint8_t col, uint8_t row) {
-    uint8_t row_offsets[] = {0x00, 0x40, 0x14, 0x54};
-
     /* Go to beginning */
     if (row >= HD44780_Opts.Rows) {
         row = 0;
     }
+    if (col >= HD44780_Opts.Cols) {
+        col = 0;
+    }
 
-    /* Set current column and row */
+    /* Set current column and row, LCD cursor is set by output timer when needed */
     HD44780_Opts.currentX = col;
     HD44780_Opts.currentY = row;
+}
 
-    /* Set location address */
-    TM_HD44780_Cmd(HD44780_SETDDRAMADDR | (col + row_offsets[row]));
+static void
+TM_HD44780_INT_Write(uint8_t value, uint8_t rs) {
+    /* Register select */
+    if (rs) {
+        HD44780_RS_HIGH;
+    } else {
+        HD44780_RS_LOW;
+    }
+
+    /* High nibble */
+    TM_GPIO_SetPinValue(HD44780_D7_PORT, HD44780_D7_PIN, (value & 0x80));
+    TM_GPIO_SetPinValue(HD44780_D6_PORT, HD44780_D6_PIN, (value & 0x40));
+    TM_GPIO_SetPinValue(HD44780_D5_PORT, HD44780_D5_PIN, (value & 0x20));
+    TM_GPIO_SetPinValue(HD44780_D4_PORT, HD44780_D4_PIN, (value & 0x10));
+    HD44780_E_PULSE;
+
+    /* Low nibble */
+    TM_GPIO_SetPinValue(HD44780_D7_PORT, HD44780_D7_PIN, (value & 0x08));
+    TM_GPIO_SetPinValue(HD44780_D6_PORT, HD44780_D6_PIN, (value & 0x04));
+    TM_GPIO_SetPinValue(HD44780_D5_PORT, HD44780_D5_PIN, (value & 0x02));
+    TM_GPIO_SetPinValue(HD44780_D4_PORT, HD44780_D4_PIN, (value & 0x01));
+    HD44780_E_PULSE;
+}
+
+static void
+TM_HD44780_INT_Queue(uint16_t value) {
+    uint8_t next = (HD44780_Output.In + 1) % HD44780_QUEUE_SIZE;
+
+    /* Wait for free space */
+    while (next == HD44780_Output.Out) {
+        TM_HD44780_INT_Start();
+    }
+
+    /* Add to queue and send it */
+    HD44780_Output.Queue[HD44780_Output.In] = value;
+    HD44780_Output.In = next;
+    TM_HD44780_INT_Start();
+}
+
+static void
+TM_HD44780_INT_Tick(void) {
+    uint16_t value;
+    uint8_t i, count, row, col, address;
+
+    /* Commands first */
+    if (HD44780_Output.Out != HD44780_Output.In) {
+        value = HD44780_Output.Queue[HD44780_Output.Out];
+        HD44780_Output.Out = (HD44780_Output.Out + 1) % HD44780_QUEUE_SIZE;
+        TM_HD44780_INT_Write(value, (value & HD44780_QUEUE_DATA) != 0);
+
+        /* Address counter is in CGRAM now */
+        if (!(value & HD44780_QUEUE_DATA) && (value & 0xC0) == HD44780_SETCGRAMADDR) {
+            HD44780_Output.Address = 0xFF;
+        }
+        return;
+    }
+
+    /* Find next changed cell */
+    count = HD44780_Opts.Rows * HD44780_Opts.Cols;
+    i = HD44780_Output.Cell;
+    while (count--) {
+        if (i >= HD44780_Opts.Rows * HD44780_Opts.Cols) {
+            i = 0;
+        }
+        if (HD44780_Shadow[i] != HD44780_Screen[i]) {
+            /* Changed cell found */
+            row = i / HD44780_Opts.Cols;
+            col = i % HD44780_Opts.Cols;
+            address = HD44780_RowOffsets[row] + col;
+            HD44780_Output.Cell = i;
+
+            /* Set LCD cursor only when it is not already on this cell */
+            if (HD44780_Output.Address != address) {
+                TM_HD44780_INT_Write(HD44780_SETDDRAMADDR | address, 0);
+                HD44780_Output.Address = address;
+                return;
+            }
+
+            /* Write character, LCD increases address counter */
+            value = HD44780_Shadow[i];
+            TM_HD44780_INT_Write(value, 1);
+            HD44780_Screen[i] = value;
+            HD44780_Output.Address++;
+            HD44780_Output.Cell = i + 1;
+            return;
+        }
+        i++;
+    }
+
+    /* Everything is sent */
+    TM_HD44780_INT_Stop();
+}
+
+static void
+TM_HD44780_INT_Start(void) {
+    /* Timer is already running */
+    if (HD44780_Output.Working) {
+        return;
+    }
+    HD44780_Output.Working = 1;
+
+    /* Start timer */
+#if defined(HD44780_TIM)
+    HD44780_TIM->CR1 |= TIM_CR1_CEN;
+#else
+    TM_DELAY_TimerStart(HD44780_Timer);
+#endif
+}
+
+static void
+TM_HD44780_INT_Stop(void) {
+    /* Stop timer */
+#if defined(HD44780_TIM)
+    HD44780_TIM->CR1 &= ~TIM_CR1_CEN;
+#else
+    TM_DELAY_TimerStop(HD44780_Timer);
+#endif
+
+    HD44780_Output.Working = 0;
+}
+
+#if defined(HD44780_TIM)
+static void
+TM_HD44780_INT_InitTimer(void) {
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStruct;
+    NVIC_InitTypeDef NVIC_InitStruct;
+    TM_TIMER_PROPERTIES_t TIM_Data;
+
+    /* Get timer properties */
+    TM_TIMER_PROPERTIES_GetTimerProperties(HD44780_TIM, &TIM_Data);
+
+    /* Enable clock */
+    TM_TIMER_PROPERTIES_EnableClock(HD44780_TIM);
+
+    /* Timer counts microseconds, update interrupt sends one byte */
+    TIM_TimeBaseStruct.TIM_ClockDivision = 0;
+    TIM_TimeBaseStruct.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseStruct.TIM_Period = HD44780_TIM_PERIOD - 1;
+    TIM_TimeBaseStruct.TIM_Prescaler = TIM_Data.TimerFrequency / 1000000 - 1;
+    TIM_TimeBaseStruct.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(HD44780_TIM, &TIM_TimeBaseStruct);
+
+    /* Enable interrupt */
+    HD44780_TIM->SR = ~TIM_IT_Update;
+    HD44780_TIM->DIER |= TIM_IT_Update;
+
+    /* Set NVIC parameters */
+    NVIC_InitStruct.NVIC_IRQChannel = HD44780_TIM_IRQ;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = HD44780_NVIC_PRIORITY;
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+    NVIC_Init(&NVIC_InitStruct);
+}
+
+void
+HD44780_TIM_IRQ_HANDLER(void) {
+    /* Clear flag */
+    HD44780_TIM->SR = ~TIM_IT_Update;
+
+    /* Send next byte */
+    TM_HD44780_INT_Tick();
+}
+#else
+static void
+TM_HD44780_INT_TimerCallback(void* UserParameters) {
+    /* Send next byte */
+    TM_HD44780_INT_Tick();
+}
+
+static void
+TM_HD44780_INT_InitTimer(void) {
+    /* Timer is created only once, it is stopped when there is nothing to send */
+    if (HD44780_Timer == NULL) {
+        HD44780_Timer = TM_DELAY_TimerCreate(1, 1, 0, TM_HD44780_INT_TimerCallback, NULL);
+    }
 }
+#endif
 
 static void
 TM_HD44780_InitPins(void) {
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/06/library-16-interfacing-hd44780-lcd-controller-with-stm32f4/
- * @version v1.2
+ * @version v1.3
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   HD44780 LCD driver library for STM32F4xx
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_HD44780_H
-#define TM_HD44780_H 120
+#define TM_HD44780_H 130
 /**
  * @addtogroup TM_STM32F4xx_Libraries
  * @{
@@ -86,10 +86,42 @@ K       GND             Ground for back light
 #define HD44780_D7_PORT     GPIOB
 #define HD44780_D7_PIN      GPIO_PIN_13
 @endverbatim
+ *
+ * \par Background output
+ *
+ * Library keeps shadow buffer with all characters on LCD. @ref TM_HD44780_Puts() and @ref TM_HD44780_Clear() only
+ * change shadow buffer and return immediately. Timer interrupt compares shadow buffer with characters already on LCD
+ * and sends one byte to LCD on each interrupt, only for changed characters.
+ * Cursor address command is sent only when next changed character is not on current LCD address,
+ * so changed parts of text are sent as continuous runs.
+ *
+ * Timer is stopped when LCD is up to date, so there is no CPU load when nothing changes.
+ *
+ * By default, TM DELAY custom timer with 1ms period is used, so complete 20x4 LCD is updated in about 90ms.
+ * For faster updates, select hardware timer in defines.h, which sends one byte every HD44780_TIM_PERIOD microseconds:
+ *
+@verbatim
+//Use TIM3 for background output
+#define HD44780_TIM                 TIM3
+#define HD44780_TIM_IRQ             TIM3_IRQn
+#define HD44780_TIM_IRQ_HANDLER     TIM3_IRQHandler
+
+//Time between 2 bytes in microseconds, LCD needs at least 37us
+#define HD44780_TIM_PERIOD          50
+@endverbatim
+ *
+ * Other commands (display on/off, cursor, scroll, custom characters) are put to queue and also sent by timer.
+ * Don't call library functions from interrupts with higher priority than timer's interrupt.
  *
  * \par Changelog
  *
 @verbatim
+ Version 1.3
+  - October 16, 2026
+  - Characters are written to shadow buffer, only changed characters are sent to LCD
+  - LCD is updated in timer interrupt, without blocking delays
+  - Added TM_HD44780_UpdateWorking() function
+
  Version 1.2
   - March 11, 2015
   - Added support for my new GPIO library
@@ -108,6 +140,10 @@ K       GND             Ground for back light
  - STM32F4xx
  - STM32F4xx RCC
  - defines.h
+ - TM DELAY
+ - TM GPIO
+ - TM TIMER PROPERTIES, when HD44780_TIM is used
+ - string.h
 @endverbatim
  */
 #include "stm32f4xx.h"
@@ -116,6 +152,12 @@ K       GND             Ground for back light
 #include "defines.h"
 #include "tm_stm32f4_delay.h"
 #include "tm_stm32f4_gpio.h"
+#include "string.h"
+#if defined(HD44780_TIM)
+#include "tm_stm32f4_timer_properties.h"
+#include "stm32f4xx_tim.h"
+#include "misc.h"
+#endif
 
 /**
  * @defgroup TM_HD44780_Macros
@@ -157,6 +199,29 @@ K       GND             Ground for back light
 #define HD44780_D7_PIN              GPIO_PIN_13
 #endif
 
+/* Maximal LCD size for shadow buffer */
+#ifndef HD44780_MAX_COLS
+#define HD44780_MAX_COLS            20
+#endif
+#ifndef HD44780_MAX_ROWS
+#define HD44780_MAX_ROWS            4
+#endif
+
+/* Number of commands and custom character bytes in queue */
+#ifndef HD44780_QUEUE_SIZE
+#define HD44780_QUEUE_SIZE          32
+#endif
+
+/* Time between 2 bytes in microseconds when hardware timer is used */
+#ifndef HD44780_TIM_PERIOD
+#define HD44780_TIM_PERIOD          50
+#endif
+
+/* Hardware timer interrupt priority */
+#ifndef HD44780_NVIC_PRIORITY
+#define HD44780_NVIC_PRIORITY       0x0A
+#endif
+
 /**
  * @}
  */
@@ -198,6 +263,7 @@ void TM_HD44780_Clear(void);
 
 /**
  * @brief  Puts string on lcd
+ * @note   String is written to shadow buffer, LCD is updated in background
  * @param  x location
  * @param  y location
  * @param  *str: pointer to string to display
@@ -205,6 +271,15 @@ void TM_HD44780_Clear(void);
  */
 void TM_HD44780_Puts(uint8_t x, uint8_t y, char* str);
 
+/**
+ * @brief  Checks if LCD is being updated in background
+ * @param  None
+ * @retval Update status:
+ *           - 0: LCD is up to date
+ *           - > 0: Changes are still being sent
+ */
+uint8_t TM_HD44780_UpdateWorking(void);
+
 /**
  * @brief  Enables cursor blink
  * @param  None
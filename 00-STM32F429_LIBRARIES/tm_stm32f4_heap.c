@@ -0,0 +1,446 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_heap.h"
+
+/* Block flags in low bits of size */
+#define BLOCK_FREE              0x01
+#define BLOCK_PREV_FREE         0x02
+#define BLOCK_FLAGS             0x03
+
+/* Block header before data and smallest data size, free block must hold list pointers */
+#define BLOCK_HEADER            ((uint32_t)offsetof(TM_HEAP_Block_t, NextFree))
+#define BLOCK_MIN_SIZE          ((uint32_t)(sizeof(TM_HEAP_Block_t) - BLOCK_HEADER))
+
+/* Sizes below this are in first level list 0 */
+#define SMALL_SIZE              (1UL << TM_HEAP_FL_SHIFT)
+
+/* Block macros */
+#define BLOCK_SIZE(b)           ((b)->Size & ~BLOCK_FLAGS)
+#define BLOCK_DATA(b)           ((void *)((uint8_t *)(b) + BLOCK_HEADER))
+#define BLOCK_FROM_DATA(p)      ((TM_HEAP_Block_t *)((uint8_t *)(p) - BLOCK_HEADER))
+#define BLOCK_NEXT(b)           ((TM_HEAP_Block_t *)((uint8_t *)(b) + BLOCK_HEADER + BLOCK_SIZE(b)))
+#define ALIGN_UP(x)             (((x) + TM_HEAP_ALIGN - 1) & ~(TM_HEAP_ALIGN - 1))
+
+/* First and last set bit, CLZ instruction is used on Cortex-M4 */
+#if defined(__GNUC__)
+#define FFS(x)                  ((uint32_t)__builtin_ctz(x))
+#define FLS(x)                  (31 - (uint32_t)__builtin_clz(x))
+#else
+#define FFS(x)                  ((uint32_t)__CLZ(__RBIT(x)))
+#define FLS(x)                  (31 - (uint32_t)__CLZ(x))
+#endif
+
+/* Interrupts are disabled while lists are changed */
+#if TM_HEAP_IRQ_SAFE
+#define HEAP_LOCK()             irq = __get_PRIMASK(); __disable_irq()
+#define HEAP_UNLOCK()           if (!irq) { __enable_irq(); }
+#else
+#define HEAP_LOCK()             irq = 0
+#define HEAP_UNLOCK()           (void)irq
+#endif
+
+/* List of all heaps, for free */
+static TM_HEAP_t* Heaps = NULL;
+
+/* Private functions */
+static void TM_HEAP_INT_Mapping(uint32_t Size, uint32_t* fl, uint32_t* sl);
+static void TM_HEAP_INT_Insert(TM_HEAP_t* Heap, TM_HEAP_Block_t* Block);
+static void TM_HEAP_INT_Remove(TM_HEAP_t* Heap, TM_HEAP_Block_t* Block);
+static TM_HEAP_Block_t* TM_HEAP_INT_Find(TM_HEAP_t* Heap, uint32_t Size);
+
+uint8_t
+TM_HEAP_Init(TM_HEAP_t* Heap, void* Memory, uint32_t Size) {
+    TM_HEAP_Block_t* block;
+    TM_HEAP_Block_t* sentinel;
+    TM_HEAP_t* h;
+    TM_HEAP_t* next;
+    uint8_t* start;
+    uint8_t* end;
+    uint32_t irq;
+
+    /* Align memory start and end */
+    start = (uint8_t *)ALIGN_UP((uintptr_t)Memory);
+    end = (uint8_t *)(((uintptr_t)Memory + Size) & ~(uintptr_t)(TM_HEAP_ALIGN - 1));
+
+    /* Check size, one block with sentinel must fit */
+    if (end <= start || (uint32_t)(end - start) < 2 * BLOCK_HEADER + BLOCK_MIN_SIZE) {
+        return 0;
+    }
+    Size = (uint32_t)(end - start) - 2 * BLOCK_HEADER;
+    if (Size >= (1UL << TM_HEAP_MAX_LOG2)) {
+        return 0;
+    }
+
+    /* Clear structure, keep link if heap is initialized again */
+    HEAP_LOCK();
+    for (h = Heaps; h && h != Heap; h = h->Next);
+    next = h ? Heap->Next : Heaps;
+    memset(Heap, 0, sizeof(TM_HEAP_t));
+    Heap->Next = next;
+    Heap->Start = start;
+    Heap->End = end;
+
+    /* One free block over whole memory */
+    block = (TM_HEAP_Block_t *)start;
+    block->PrevPhys = NULL;
+    block->Size = Size | BLOCK_FREE;
+
+    /* Sentinel at the end, it is never free so blocks are not merged over it */
+    sentinel = BLOCK_NEXT(block);
+    sentinel->PrevPhys = block;
+    sentinel->Size = 0 | BLOCK_PREV_FREE;
+
+    TM_HEAP_INT_Insert(Heap, block);
+
+    /* Add to list of heaps */
+    if (h == NULL) {
+        Heaps = Heap;
+    }
+    HEAP_UNLOCK();
+
+    /* Heap is ready */
+    return 1;
+}
+
+uint8_t
+TM_HEAP_InitSDRAM(TM_HEAP_t* Heap, uint32_t Offset) {
+    /* Check offset */
+    if (Offset >= SDRAM_MEMORY_SIZE) {
+        return 0;
+    }
+
+    /* Init SDRAM, it does nothing if already initialized */
+    if (!TM_SDRAM_Init()) {
+        return 0;
+    }
+
+    /* Heap from offset to the end */
+    return TM_HEAP_Init(Heap, (void *)(uintptr_t)(SDRAM_START_ADR + Offset), SDRAM_MEMORY_SIZE - Offset);
+}
+
+void*
+TM_HEAP_Malloc(TM_HEAP_t* Heap, uint32_t Size) {
+    TM_HEAP_Block_t* block;
+    TM_HEAP_Block_t* rest;
+    uint32_t irq;
+
+    /* Check size */
+    if (Size == 0 || Size >= (1UL << TM_HEAP_MAX_LOG2) / 2) {
+        return NULL;
+    }
+
+    /* Real block size */
+    Size = ALIGN_UP(Size);
+    if (Size < BLOCK_MIN_SIZE) {
+        Size = BLOCK_MIN_SIZE;
+    }
+
+    HEAP_LOCK();
+
+    /* Find free block in list where all blocks are big enough */
+    block = TM_HEAP_INT_Find(Heap, Size);
+    if (block == NULL) {
+        Heap->Failed++;
+        HEAP_UNLOCK();
+        return NULL;
+    }
+    TM_HEAP_INT_Remove(Heap, block);
+
+    /* Split block when rest can be new block */
+    if (BLOCK_SIZE(block) >= Size + BLOCK_HEADER + BLOCK_MIN_SIZE) {
+        rest = (TM_HEAP_Block_t *)((uint8_t *)BLOCK_DATA(block) + Size);
+        rest->PrevPhys = block;
+        rest->Size = (BLOCK_SIZE(block) - Size - BLOCK_HEADER) | BLOCK_FREE;
+        block->Size = Size | (block->Size & BLOCK_PREV_FREE);
+
+        /* Block after rest already knows previous is free */
+        BLOCK_NEXT(rest)->PrevPhys = rest;
+        TM_HEAP_INT_Insert(Heap, rest);
+    } else {
+        BLOCK_NEXT(block)->Size &= ~BLOCK_PREV_FREE;
+    }
+
+    /* Block is used */
+    block->Size &= ~BLOCK_FREE;
+
+    /* Statistics */
+    Heap->Used += BLOCK_SIZE(block) + BLOCK_HEADER;
+    if (Heap->Used > Heap->Peak) {
+        Heap->Peak = Heap->Used;
+    }
+    Heap->Allocations++;
+
+    HEAP_UNLOCK();
+
+    /* Return pointer to data */
+    return BLOCK_DATA(block);
+}
+
+void*
+TM_HEAP_Calloc(TM_HEAP_t* Heap, uint32_t Count, uint32_t Size) {
+    void* ptr;
+
+    /* Check overflow */
+    if (Size && Count > 0xFFFFFFFF / Size) {
+        return NULL;
+    }
+
+    /* Allocate and clear */
+    ptr = TM_HEAP_Malloc(Heap, Count * Size);
+    if (ptr) {
+        memset(ptr, 0, Count * Size);
+    }
+    return ptr;
+}
+
+void
+TM_HEAP_Free(void* Ptr) {
+    TM_HEAP_t* Heap;
+    TM_HEAP_Block_t* block;
+    TM_HEAP_Block_t* next;
+    uint32_t irq;
+
+    HEAP_LOCK();
+
+    /* Find heap with this pointer */
+    for (Heap = Heaps; Heap; Heap = Heap->Next) {
+        if ((uint8_t *)Ptr > Heap->Start && (uint8_t *)Ptr < Heap->End) {
+            break;
+        }
+    }
+    block = BLOCK_FROM_DATA(Ptr);
+
+    /* Not from heap or already free */
+    if (Heap == NULL || (block->Size & BLOCK_FREE)) {
+        HEAP_UNLOCK();
+        return;
+    }
+
+    /* Statistics */
+    Heap->Used -= BLOCK_SIZE(block) + BLOCK_HEADER;
+    Heap->Allocations--;
+
+    /* Merge with previous free block */
+    if (block->Size & BLOCK_PREV_FREE) {
+        TM_HEAP_INT_Remove(Heap, block->PrevPhys);
+        block->PrevPhys->Size += BLOCK_HEADER + BLOCK_SIZE(block);
+        block = block->PrevPhys;
+    }
+
+    /* Merge with next free block */
+    next = BLOCK_NEXT(block);
+    if (next->Size & BLOCK_FREE) {
+        TM_HEAP_INT_Remove(Heap, next);
+        block->Size += BLOCK_HEADER + BLOCK_SIZE(next);
+    }
+
+    /* Mark free and tell next block */
+    block->Size |= BLOCK_FREE;
+    next = BLOCK_NEXT(block);
+    next->PrevPhys = block;
+    next->Size |= BLOCK_PREV_FREE;
+    TM_HEAP_INT_Insert(Heap, block);
+
+    HEAP_UNLOCK();
+}
+
+void
+TM_HEAP_GetStats(TM_HEAP_t* Heap, TM_HEAP_Stats_t* Stats) {
+    TM_HEAP_Block_t* block;
+    uint32_t irq;
+
+    HEAP_LOCK();
+
+    /* Counters */
+    memset(Stats, 0, sizeof(TM_HEAP_Stats_t));
+    Stats->Size = (uint32_t)(Heap->End - Heap->Start);
+    Stats->Used = Heap->Used;
+    Stats->Peak = Heap->Peak;
+    Stats->Allocations = Heap->Allocations;
+    Stats->Failed = Heap->Failed;
+
+    /* Go through all blocks till sentinel */
+    for (block = (TM_HEAP_Block_t *)Heap->Start; BLOCK_SIZE(block); block = BLOCK_NEXT(block)) {
+        if (block->Size & BLOCK_FREE) {
+            Stats->Free += BLOCK_SIZE(block);
+            Stats->FreeBlocks++;
+            if (BLOCK_SIZE(block) > Stats->LargestFree) {
+                Stats->LargestFree = BLOCK_SIZE(block);
+            }
+        }
+    }
+
+    HEAP_UNLOCK();
+
+    /* Free memory which can't be allocated at once */
+    if (Stats->Free) {
+        Stats->Fragmentation = (uint8_t)((uint64_t)(Stats->Free - Stats->LargestFree) * 100 / Stats->Free);
+    }
+}
+
+uint8_t
+TM_HEAP_Check(TM_HEAP_t* Heap) {
+    TM_HEAP_Block_t* block;
+    TM_HEAP_Block_t* prev = NULL;
+    uint32_t fl, sl, free_blocks = 0, listed = 0, used = 0, irq;
+    uint8_t ok = 1;
+
+    HEAP_LOCK();
+
+    /* Physical blocks, sizes and flags must match neighbours */
+    for (block = (TM_HEAP_Block_t *)Heap->Start; ok; block = BLOCK_NEXT(block)) {
+        if ((uint8_t *)block >= Heap->End || block->PrevPhys != prev) {
+            ok = 0;
+            break;
+        }
+        if (prev && !!(prev->Size & BLOCK_FREE) != !!(block->Size & BLOCK_PREV_FREE)) {
+            ok = 0;
+            break;
+        }
+        if (prev && (prev->Size & BLOCK_FREE) && (block->Size & BLOCK_FREE)) {
+            ok = 0;
+            break;
+        }
+
+        /* Sentinel */
+        if (BLOCK_SIZE(block) == 0) {
+            ok = (uint8_t *)block + BLOCK_HEADER == Heap->End;
+            break;
+        }
+        if (block->Size & BLOCK_FREE) {
+            free_blocks++;
+        } else {
+            used += BLOCK_SIZE(block) + BLOCK_HEADER;
+        }
+        prev = block;
+    }
+
+    /* Free lists must have all free blocks in correct list */
+    for (fl = 0; ok && fl < TM_HEAP_FL_COUNT; fl++) {
+        for (sl = 0; ok && sl < TM_HEAP_SL_COUNT; sl++) {
+            uint32_t f, s;
+
+            if (!!(Heap->SLBitmap[fl] & (1UL << sl)) != (Heap->Blocks[fl][sl] != NULL)) {
+                ok = 0;
+            }
+            for (block = Heap->Blocks[fl][sl]; ok && block; block = block->NextFree) {
+                TM_HEAP_INT_Mapping(BLOCK_SIZE(block), &f, &s);
+                if (!(block->Size & BLOCK_FREE) || f != fl || s != sl) {
+                    ok = 0;
+                }
+                listed++;
+            }
+        }
+        if (!!(Heap->FLBitmap & (1UL << fl)) != (Heap->SLBitmap[fl] != 0)) {
+            ok = 0;
+        }
+    }
+
+    HEAP_UNLOCK();
+
+    /* Counters must match */
+    return ok && free_blocks == listed && used == Heap->Used;
+}
+
+/* Private functions */
+static void
+TM_HEAP_INT_Mapping(uint32_t Size, uint32_t* fl, uint32_t* sl) {
+    if (Size < SMALL_SIZE) {
+        /* Small blocks are in first list, linear */
+        *fl = 0;
+        *sl = Size / (SMALL_SIZE / TM_HEAP_SL_COUNT);
+    } else {
+        /* Power of 2 and 16 parts of it */
+        *fl = FLS(Size);
+        *sl = (Size >> (*fl - TM_HEAP_SL_LOG2)) ^ TM_HEAP_SL_COUNT;
+        *fl -= TM_HEAP_FL_SHIFT - 1;
+    }
+}
+
+static void
+TM_HEAP_INT_Insert(TM_HEAP_t* Heap, TM_HEAP_Block_t* Block) {
+    uint32_t fl, sl;
+
+    /* Add to start of list */
+    TM_HEAP_INT_Mapping(BLOCK_SIZE(Block), &fl, &sl);
+    Block->PrevFree = NULL;
+    Block->NextFree = Heap->Blocks[fl][sl];
+    if (Block->NextFree) {
+        Block->NextFree->PrevFree = Block;
+    }
+    Heap->Blocks[fl][sl] = Block;
+
+    /* List is not empty */
+    Heap->FLBitmap |= 1UL << fl;
+    Heap->SLBitmap[fl] |= 1UL << sl;
+}
+
+static void
+TM_HEAP_INT_Remove(TM_HEAP_t* Heap, TM_HEAP_Block_t* Block) {
+    uint32_t fl, sl;
+
+    /* Remove from list */
+    TM_HEAP_INT_Mapping(BLOCK_SIZE(Block), &fl, &sl);
+    if (Block->NextFree) {
+        Block->NextFree->PrevFree = Block->PrevFree;
+    }
+    if (Block->PrevFree) {
+        Block->PrevFree->NextFree = Block->NextFree;
+    } else {
+        Heap->Blocks[fl][sl] = Block->NextFree;
+
+        /* Clear bits when list is empty */
+        if (Block->NextFree == NULL) {
+            Heap->SLBitmap[fl] &= ~(1UL << sl);
+            if (Heap->SLBitmap[fl] == 0) {
+                Heap->FLBitmap &= ~(1UL << fl);
+            }
+        }
+    }
+}
+
+static TM_HEAP_Block_t*
+TM_HEAP_INT_Find(TM_HEAP_t* Heap, uint32_t Size) {
+    uint32_t fl, sl, map;
+
+    /* Round size up to next list, so each block in list is big enough */
+    if (Size >= SMALL_SIZE) {
+        Size += (1UL << (FLS(Size) - TM_HEAP_SL_LOG2)) - 1;
+    }
+    TM_HEAP_INT_Mapping(Size, &fl, &sl);
+    if (fl >= TM_HEAP_FL_COUNT) {
+        return NULL;
+    }
+
+    /* Same first level, same or bigger second level */
+    map = Heap->SLBitmap[fl] & (~0UL << sl);
+    if (map == 0) {
+        /* Bigger first level */
+        map = Heap->FLBitmap & (~0UL << (fl + 1));
+        if (map == 0) {
+            return NULL;
+        }
+        fl = FFS(map);
+        map = Heap->SLBitmap[fl];
+    }
+    sl = FFS(map);
+
+    /* First block in list */
+    return Heap->Blocks[fl][sl];
+}
@@ -0,0 +1,326 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Real-time memory allocator with multiple heaps in SDRAM, CCM and SRAM
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_HEAP_H
+#define TM_HEAP_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_HEAP
+ * @brief    Real-time memory allocator with multiple heaps in SDRAM, CCM and SRAM
+ * @{
+ *
+ * malloc from C library has one heap in internal RAM and time of each call depends on heap history.
+ * This library uses TLSF (two level segregated fit) algorithm, where malloc and free take always the same,
+ * short time and don't depend on number of allocated blocks.
+ *
+ * \par How it works
+ *
+ * Free blocks are kept in lists by size. First level splits sizes by power of 2, second level splits each
+ * power of 2 to 16 parts. Bitmaps say which lists are not empty, so suitable list is found with 2 CLZ instructions.
+ * When block is freed, it is merged with free neighbours immediately.
+ *
+ * Each block has 8 bytes header, blocks are 8 bytes aligned. Wasted memory is at most 1/16 of block size.
+ *
+ * \par Multiple heaps
+ *
+ * Each heap is @ref TM_HEAP_t structure over its own memory. You can have heap in SDRAM for big buffers,
+ * heap in CCM RAM for fast CPU only data and heap in SRAM for DMA buffers:
+ *
+\code{.c}
+TM_HEAP_t HeapSDRAM, HeapSRAM;
+uint8_t SRAM_Memory[16 * 1024];
+
+//Init SDRAM and heap after LCD frame buffers and sprite overlay
+TM_HEAP_InitSDRAM(&HeapSDRAM, TM_HEAP_SDRAM_OFFSET);
+TM_HEAP_Init(&HeapSRAM, SRAM_Memory, sizeof(SRAM_Memory));
+
+float* frame = TM_HEAP_Malloc(&HeapSDRAM, 4096 * sizeof(float));
+uint8_t* dma = TM_HEAP_Malloc(&HeapSRAM, 512);
+
+//Free finds heap by itself
+TM_HEAP_Free(frame);
+TM_HEAP_Free(dma);
+\endcode
+ *
+ * \par Use with other libraries
+ *
+ * Libraries which allocate memory use LIB_ALLOC_FUNC and LIB_FREE_FUNC defines, malloc and free by default.
+ * Add lines below at the end of defines.h file and all of them will use SDRAM heap:
+ *
+\code{.c}
+#include "tm_stm32f4_heap.h"
+extern TM_HEAP_t HeapSDRAM;
+
+#define LIB_ALLOC_FUNC(size)    TM_HEAP_Malloc(&HeapSDRAM, size)
+#define LIB_FREE_FUNC           TM_HEAP_Free
+\endcode
+ *
+ * Each of these libraries also has its own define, like TM_FFT_ALLOC_FUNC, TM_STRING_ALLOC_FUNC and TM_FATFS_ALLOC_FUNC,
+ * so you can select heap for each library. FFT buffers can go to SDRAM, strings to CCM:
+ *
+\code{.c}
+#define TM_FFT_ALLOC_FUNC(size)     TM_HEAP_Malloc(&HeapSDRAM, size)
+#define TM_FFT_FREE_FUNC            TM_HEAP_Free
+#define TM_STRING_ALLOC_FUNC(size)  TM_HEAP_Malloc(&HeapCCM, size)
+#define TM_STRING_FREE_FUNC         TM_HEAP_Free
+\endcode
+ *
+ * \par Statistics
+ *
+ * @ref TM_HEAP_GetStats returns used and free memory, peak usage, number of failed allocations,
+ * largest free block and fragmentation. It goes through all blocks, so use it for diagnostics only.
+ *
+ * \par Interrupts
+ *
+ * Functions disable interrupts for the time of list update, so they can be used from interrupts too.
+ * Set TM_HEAP_IRQ_SAFE to 0 in defines.h if heap is used only from main loop.
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - TM SDRAM
+ - string.h
+ - stddef.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "tm_stm32f4_sdram.h"
+#include "string.h"
+#include "stddef.h"
+
+/**
+ * @defgroup TM_HEAP_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Disable interrupts while heap is changed, enabled by default
+ */
+#ifndef TM_HEAP_IRQ_SAFE
+#define TM_HEAP_IRQ_SAFE        1
+#endif
+
+/**
+ * @brief  Largest block is smaller than 2 ^ TM_HEAP_MAX_LOG2 bytes, 16MB by default
+ */
+#ifndef TM_HEAP_MAX_LOG2
+#define TM_HEAP_MAX_LOG2        24
+#endif
+
+/**
+ * @brief  Default offset of SDRAM heap from SDRAM start, space before it is for LCD frame buffers and sprite overlay
+ * @note   See SDRAM memory map in TM SDRAM library
+ */
+#ifndef TM_HEAP_SDRAM_OFFSET
+#define TM_HEAP_SDRAM_OFFSET    SDRAM_HEAP_OFFSET
+#endif
+
+/**
+ * @brief  Alignment of allocated memory in bytes
+ */
+#define TM_HEAP_ALIGN           8
+
+/* Number of second level lists for each first level and sizes of first level */
+#define TM_HEAP_SL_LOG2         4
+#define TM_HEAP_SL_COUNT        (1 << TM_HEAP_SL_LOG2)
+#define TM_HEAP_FL_SHIFT        (TM_HEAP_SL_LOG2 + 3)
+#define TM_HEAP_FL_COUNT        (TM_HEAP_MAX_LOG2 - TM_HEAP_FL_SHIFT + 1)
+
+/* Check settings */
+#if TM_HEAP_MAX_LOG2 < 12 || TM_HEAP_MAX_LOG2 > 31
+#error "TM_HEAP_MAX_LOG2 must be from 12 to 31"
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_HEAP_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Memory block header, meant for private use
+ */
+typedef struct _TM_HEAP_Block_t {
+    struct _TM_HEAP_Block_t* PrevPhys; /*!< Previous block in memory */
+    uint32_t Size;                     /*!< Size of data in block, bits 0 and 1 are flags */
+    struct _TM_HEAP_Block_t* NextFree; /*!< Next block in free list, only in free blocks */
+    struct _TM_HEAP_Block_t* PrevFree; /*!< Previous block in free list, only in free blocks */
+} TM_HEAP_Block_t;
+
+/**
+ * @brief  Heap structure
+ */
+typedef struct _TM_HEAP_t {
+    uint32_t FLBitmap;                                           /*!< First level lists which are not empty. Meant for private use */
+    uint16_t SLBitmap[TM_HEAP_FL_COUNT];                         /*!< Second level lists which are not empty. Meant for private use */
+    TM_HEAP_Block_t* Blocks[TM_HEAP_FL_COUNT][TM_HEAP_SL_COUNT]; /*!< Free lists. Meant for private use */
+    uint8_t* Start;                                              /*!< Start of heap memory */
+    uint8_t* End;                                                /*!< End of heap memory */
+    uint32_t Used;                                               /*!< Bytes in allocated blocks, with headers */
+    uint32_t Peak;                                               /*!< Maximal value of used bytes */
+    uint32_t Allocations;                                        /*!< Number of allocated blocks */
+    uint32_t Failed;                                             /*!< Number of failed allocations */
+    struct _TM_HEAP_t* Next;                                     /*!< Next heap in list of all heaps. Meant for private use */
+} TM_HEAP_t;
+
+/**
+ * @brief  Heap statistics
+ */
+typedef struct {
+    uint32_t Size;          /*!< Heap size in bytes */
+    uint32_t Used;          /*!< Bytes in allocated blocks, with headers */
+    uint32_t Free;          /*!< Bytes in free blocks, without headers */
+    uint32_t Peak;          /*!< Maximal value of used bytes */
+    uint32_t Allocations;   /*!< Number of allocated blocks */
+    uint32_t Failed;        /*!< Number of failed allocations */
+    uint32_t FreeBlocks;    /*!< Number of free blocks */
+    uint32_t LargestFree;   /*!< Size of largest free block */
+    uint8_t Fragmentation;  /*!< Percent of free memory which is not in largest free block */
+} TM_HEAP_Stats_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_HEAP_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes heap over memory
+ * @note   Memory is not cleared
+ * @param  *Heap: Pointer to empty @ref TM_HEAP_t structure
+ * @param  *Memory: Start of memory for heap
+ * @param  Size: Memory size in bytes
+ * @retval Heap status:
+ *            - 0: Memory is too small or too big for TM_HEAP_MAX_LOG2
+ *            - > 0: Heap is ready
+ */
+uint8_t TM_HEAP_Init(TM_HEAP_t* Heap, void* Memory, uint32_t Size);
+
+/**
+ * @brief  Initializes SDRAM and heap over SDRAM memory from offset to the end
+ * @param  *Heap: Pointer to empty @ref TM_HEAP_t structure
+ * @param  Offset: Offset from SDRAM start in bytes. Memory before it is not used, use TM_HEAP_SDRAM_OFFSET to keep LCD frame buffers and sprite overlay
+ * @retval Heap status:
+ *            - 0: SDRAM or heap init failed
+ *            - > 0: Heap is ready
+ */
+uint8_t TM_HEAP_InitSDRAM(TM_HEAP_t* Heap, uint32_t Offset);
+
+/**
+ * @brief  Allocates memory from heap
+ * @param  *Heap: Pointer to @ref TM_HEAP_t structure
+ * @param  Size: Number of bytes to allocate
+ * @retval Pointer to memory, 8 bytes aligned, or NULL when there is no free block big enough
+ */
+void* TM_HEAP_Malloc(TM_HEAP_t* Heap, uint32_t Size);
+
+/**
+ * @brief  Allocates memory from heap and sets it to zero
+ * @param  *Heap: Pointer to @ref TM_HEAP_t structure
+ * @param  Count: Number of elements
+ * @param  Size: Size of one element
+ * @retval Pointer to memory, 8 bytes aligned, or NULL when there is no free block big enough
+ */
+void* TM_HEAP_Calloc(TM_HEAP_t* Heap, uint32_t Count, uint32_t Size);
+
+/**
+ * @brief  Frees memory allocated from any initialized heap
+ * @note   Pointers which are not from any heap, including NULL, are ignored
+ * @param  *Ptr: Pointer returned from @ref TM_HEAP_Malloc or @ref TM_HEAP_Calloc
+ * @retval None
+ */
+void TM_HEAP_Free(void* Ptr);
+
+/**
+ * @brief  Gets heap statistics
+ * @note   Function goes through all blocks, it is meant for diagnostics
+ * @param  *Heap: Pointer to @ref TM_HEAP_t structure
+ * @param  *Stats: Pointer to @ref TM_HEAP_Stats_t structure to save statistics to
+ * @retval None
+ */
+void TM_HEAP_GetStats(TM_HEAP_t* Heap, TM_HEAP_Stats_t* Stats);
+
+/**
+ * @brief  Checks headers and free lists of heap
+ * @note   Function goes through all blocks, use it to find memory corruption
+ * @param  *Heap: Pointer to @ref TM_HEAP_t structure
+ * @retval Heap status:
+ *            - 0: Heap is damaged
+ *            - > 0: Heap is OK
+ */
+uint8_t TM_HEAP_Check(TM_HEAP_t* Heap);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -90,6 +90,36 @@ void TM_ILI9341_SendCommand(uint8_t data);
 void TM_ILI9341_Delay(volatile unsigned int delay);
 void TM_ILI9341_SetCursorPosition(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 void TM_ILI9341_INT_Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+static void TM_ILI9341_INT_DrawRun(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t color);
+static void TM_ILI9341_INT_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color);
+static void TM_ILI9341_INT_WriteWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t* data);
+
+/* Device for scanline fill engine */
+static TM_SCANLINE_t ILI9341_Scanline = {TM_ILI9341_INT_Span, 0, 0};
+
+/* Buffer for character pixels, sent to LCD in one window */
+static uint16_t ILI9341_GlyphBuffer[ILI9341_GLYPH_BUFFER_SIZE];
+
+#if defined(ILI9341_USE_SHADOW)
+/**
+ * @brief  Dirty rectangle, all coordinates are inclusive
+ * @note   Used private
+ */
+typedef struct {
+    uint16_t x0;
+    uint16_t y0;
+    uint16_t x1;
+    uint16_t y1;
+} TM_ILI9341_Rect_t;
+
+/* Rectangle area in pixels */
+#define ILI9341_RECT_AREA(x0, y0, x1, y1)   ((int32_t)((x1) - (x0) + 1) * (int32_t)((y1) - (y0) + 1))
+
+/* Shadow framebuffer and list of changed areas */
+static uint16_t* ILI9341_Shadow = ILI9341_SHADOW_BUFFER;
+static TM_ILI9341_Rect_t ILI9341_Dirty[ILI9341_DIRTY_RECTS];
+static uint8_t ILI9341_DirtyCount = 0;
+#endif
 
 void
 TM_ILI9341_Init() {
@@ -111,6 +141,11 @@ TM_ILI9341_Init() {
     /* Init DMA for SPI */
     TM_SPI_DMA_Init(ILI9341_SPI);
 
+#if defined(ILI9341_SHADOW_SDRAM)
+    /* Init SDRAM for shadow framebuffer */
+    TM_SDRAM_Init();
+#endif
+
     /* Init LCD */
     TM_ILI9341_InitLCD();
 
@@ -122,6 +157,11 @@ TM_ILI9341_Init() {
 
     /* Fill with white color */
     TM_ILI9341_Fill(ILI9341_COLOR_WHITE);
+
+#if defined(ILI9341_USE_SHADOW)
+    /* Send white screen to LCD */
+    TM_ILI9341_Flush();
+#endif
 }
 
 void
@@ -264,11 +304,22 @@ TM_ILI9341_SendData(uint8_t data) {
 
 void
 TM_ILI9341_DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
+#if defined(ILI9341_USE_SHADOW)
+    /* Check for overflow */
+    if (x >= ILI9341_Opts.width || y >= ILI9341_Opts.height) {
+        return;
+    }
+
+    /* Write to shadow and mark as changed */
+    ILI9341_Shadow[y * ILI9341_Opts.width + x] = color;
+    TM_ILI9341_Invalidate(x, y, x, y);
+#else
     TM_ILI9341_SetCursorPosition(x, y, x, y);
 
     TM_ILI9341_SendCommand(ILI9341_GRAM);
     TM_ILI9341_SendData(color >> 8);
     TM_ILI9341_SendData(color & 0xFF);
+#endif
 }
 
 
@@ -295,6 +346,32 @@ TM_ILI9341_Fill(uint32_t color) {
 
 void
 TM_ILI9341_INT_Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
+#if defined(ILI9341_USE_SHADOW)
+    uint16_t* ptr;
+    uint16_t x, y;
+
+    /* Check for overflow */
+    if (x1 >= ILI9341_Opts.width) {
+        x1 = ILI9341_Opts.width - 1;
+    }
+    if (y1 >= ILI9341_Opts.height) {
+        y1 = ILI9341_Opts.height - 1;
+    }
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    /* Fill rectangle in shadow */
+    for (y = y0; y <= y1; y++) {
+        ptr = &ILI9341_Shadow[y * ILI9341_Opts.width + x0];
+        for (x = x0; x <= x1; x++) {
+            *ptr++ = color;
+        }
+    }
+
+    /* Mark as changed */
+    TM_ILI9341_Invalidate(x0, y0, x1, y1);
+#else
     uint32_t pixels_count;
 
     /* Set cursor position */
@@ -330,6 +407,7 @@ TM_ILI9341_INT_Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t
 
     /* Go back to 8-bit SPI mode */
     TM_SPI_SetDataSize(ILI9341_SPI, TM_SPI_DataSize_8b);
+#endif
 }
 
 void
@@ -359,6 +437,11 @@ TM_ILI9341_Rotate(TM_ILI9341_Orientation_t orientation) {
         ILI9341_Opts.height = ILI9341_WIDTH;
         ILI9341_Opts.orientation = TM_ILI9341_Landscape;
     }
+
+#if defined(ILI9341_USE_SHADOW)
+    /* Shadow has pixels in old row order, clear it and send it on next flush */
+    TM_ILI9341_Fill(ILI9341_COLOR_WHITE);
+#endif
 }
 
 void
@@ -404,7 +487,8 @@ TM_ILI9341_GetStringSize(char* str, TM_FontDef_t* font, uint16_t* width, uint16_
 
 void
 TM_ILI9341_Putc(uint16_t x, uint16_t y, char c, TM_FontDef_t* font, uint32_t foreground, uint32_t background) {
-    uint32_t i, b, j;
+    uint32_t i, b, j, width, height, start, run;
+    uint16_t* ptr;
     /* Set coordinates */
     ILI9341_x = x;
     ILI9341_y = y;
@@ -415,17 +499,50 @@ TM_ILI9341_Putc(uint16_t x, uint16_t y, char c, TM_FontDef_t* font, uint32_t for
         ILI9341_x = 0;
     }
 
-    /* Draw rectangle for background */
-    TM_ILI9341_INT_Fill(ILI9341_x, ILI9341_y, ILI9341_x + font->FontWidth, ILI9341_y + font->FontHeight, background);
+    /* Check visible part of character */
+    width = font->FontWidth;
+    height = font->FontHeight;
+    if (width > ILI9341_Opts.width) {
+        width = ILI9341_Opts.width;
+    }
+    if (ILI9341_y >= ILI9341_Opts.height) {
+        height = 0;
+    } else if ((ILI9341_y + height) > ILI9341_Opts.height) {
+        height = ILI9341_Opts.height - ILI9341_y;
+    }
 
-    /* Draw font data */
-    for (i = 0; i < font->FontHeight; i++) {
-        b = font->data[(c - 32) * font->FontHeight + i];
-        for (j = 0; j < font->FontWidth; j++) {
-            if ((b << j) & 0x8000) {
-                TM_ILI9341_DrawPixel(ILI9341_x + j, (ILI9341_y + i), foreground);
+    if (background & ILI9341_TRANSPARENT) {
+        /* Draw only foreground pixels, in horizontal runs */
+        for (i = 0; i < height; i++) {
+            b = font->data[(c - 32) * font->FontHeight + i];
+            for (j = 0; j < width; j++) {
+                if ((b << j) & 0x8000) {
+                    /* Find end of run */
+                    for (run = j + 1; run < width && ((b << run) & 0x8000); run++);
+                    TM_ILI9341_INT_DrawRun(ILI9341_x + j, ILI9341_y + i, ILI9341_x + run - 1, ILI9341_y + i, foreground);
+                    j = run;
+                }
+            }
+        }
+    } else {
+        /* Prepare all character pixels and send them in one window */
+        ptr = ILI9341_GlyphBuffer;
+        start = 0;
+        for (i = 0; i < height; i++) {
+            /* Send lines we have if buffer is full */
+            if ((ptr - ILI9341_GlyphBuffer + width) > ILI9341_GLYPH_BUFFER_SIZE) {
+                TM_ILI9341_INT_WriteWindow(ILI9341_x, ILI9341_y + start, width, i - start, ILI9341_GlyphBuffer);
+                ptr = ILI9341_GlyphBuffer;
+                start = i;
+            }
+            b = font->data[(c - 32) * font->FontHeight + i];
+            for (j = 0; j < width; j++) {
+                *ptr++ = ((b << j) & 0x8000) ? foreground : background;
             }
         }
+        if (i > start) {
+            TM_ILI9341_INT_WriteWindow(ILI9341_x, ILI9341_y + start, width, i - start, ILI9341_GlyphBuffer);
+        }
     }
 
     /* Set new pointer */
@@ -438,7 +555,7 @@ TM_ILI9341_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t
     /* Code by dewoller: https://github.com/dewoller */
 
     int16_t dx, dy, sx, sy, err, e2;
-    uint16_t tmp;
+    uint16_t tmp, rx, ry, px, py;
 
     /* Check for overflow */
     if (x0 >= ILI9341_Opts.width) {
@@ -479,11 +596,16 @@ TM_ILI9341_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t
     sy = (y0 < y1) ? 1 : -1;
     err = ((dx > dy) ? dx : -dy) / 2;
 
+    /* Start of current run of pixels in the same line or column */
+    rx = x0;
+    ry = y0;
+
     while (1) {
-        TM_ILI9341_DrawPixel(x0, y0, color);
         if (x0 == x1 && y0 == y1) {
             break;
         }
+        px = x0;
+        py = y0;
         e2 = err;
         if (e2 > -dx) {
             err -= dy;
@@ -493,7 +615,17 @@ TM_ILI9341_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t
             err += dx;
             y0 += sy;
         }
+
+        /* Both coordinates changed, draw finished run at once */
+        if (x0 != rx && y0 != ry) {
+            TM_ILI9341_INT_DrawRun(rx, ry, px, py, color);
+            rx = x0;
+            ry = y0;
+        }
     }
+
+    /* Draw last run */
+    TM_ILI9341_INT_DrawRun(rx, ry, x1, y1, color);
 }
 
 void
@@ -564,32 +696,197 @@ TM_ILI9341_DrawCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color) {
 
 void
 TM_ILI9341_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillCircle(TM_ILI9341_GetScanline(), x0, y0, r, color);
+}
 
-    TM_ILI9341_DrawPixel(x0, y0 + r, color);
-    TM_ILI9341_DrawPixel(x0, y0 - r, color);
-    TM_ILI9341_DrawPixel(x0 + r, y0, color);
-    TM_ILI9341_DrawPixel(x0 - r, y0, color);
-    TM_ILI9341_DrawLine(x0 - r, y0, x0 + r, y0, color);
+TM_SCANLINE_t*
+TM_ILI9341_GetScanline(void) {
+    /* Update size for current orientation */
+    ILI9341_Scanline.Width = ILI9341_Opts.width;
+    ILI9341_Scanline.Height = ILI9341_Opts.height;
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
+    return &ILI9341_Scanline;
+}
+
+static void
+TM_ILI9341_INT_DrawRun(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t color) {
+    if (x0 == x1 && y0 == y1) {
+        /* Single pixel is faster without DMA */
+        TM_ILI9341_DrawPixel(x0, y0, color);
+    } else {
+        TM_ILI9341_INT_Fill(x0, y0, x1, y1, color);
+    }
+}
+
+static void
+TM_ILI9341_INT_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color) {
+    /* Coordinates are clipped by scanline engine */
+    TM_ILI9341_INT_DrawRun(x0, y, x1, y, color);
+}
+
+static void
+TM_ILI9341_INT_WriteWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t* data) {
+#if defined(ILI9341_USE_SHADOW)
+    uint16_t* ptr;
+    uint16_t i, j;
+
+    /* Copy to shadow */
+    for (i = 0; i < height; i++) {
+        ptr = &ILI9341_Shadow[(y + i) * ILI9341_Opts.width + x];
+        for (j = 0; j < width; j++) {
+            *ptr++ = *data++;
         }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
+    }
 
-        TM_ILI9341_DrawLine(x0 - x, y0 + y, x0 + x, y0 + y, color);
-        TM_ILI9341_DrawLine(x0 + x, y0 - y, x0 - x, y0 - y, color);
+    /* Mark as changed */
+    TM_ILI9341_Invalidate(x, y, x + width - 1, y + height - 1);
+#else
+    /* Set window, LCD moves to next line inside window automatically */
+    TM_ILI9341_SetCursorPosition(x, y, x + width - 1, y + height - 1);
 
-        TM_ILI9341_DrawLine(x0 + y, y0 + x, x0 - y, y0 + x, color);
-        TM_ILI9341_DrawLine(x0 + y, y0 - x, x0 - y, y0 - x, color);
+    /* Set command for GRAM data */
+    TM_ILI9341_SendCommand(ILI9341_GRAM);
+
+    /* Send everything */
+    ILI9341_CS_RESET;
+    ILI9341_WRX_SET;
+
+    /* Go to 16-bit SPI mode */
+    TM_SPI_SetDataSize(ILI9341_SPI, TM_SPI_DataSize_16b);
+
+    /* Send all pixels at once */
+    TM_SPI_DMA_Send16(ILI9341_SPI, data, (uint32_t)width * height);
+
+    /* Wait till done */
+    while (TM_SPI_DMA_Working(ILI9341_SPI));
+
+    ILI9341_CS_SET;
+
+    /* Go back to 8-bit SPI mode */
+    TM_SPI_SetDataSize(ILI9341_SPI, TM_SPI_DataSize_8b);
+#endif
+}
+
+#if defined(ILI9341_USE_SHADOW)
+void
+TM_ILI9341_Invalidate(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    TM_ILI9341_Rect_t* r;
+    int32_t cost, best_cost;
+    uint8_t i, best;
+
+    while (1) {
+        best = ILI9341_DIRTY_RECTS;
+        best_cost = 0x7FFFFFFF;
+
+        for (i = 0; i < ILI9341_DirtyCount; i++) {
+            r = &ILI9341_Dirty[i];
+
+            /* Already inside changed area, nothing to do */
+            if (x0 >= r->x0 && x1 <= r->x1 && y0 >= r->y0 && y1 <= r->y1) {
+                return;
+            }
+
+            /* Number of pixels which would be sent without being changed if rectangles are merged */
+            cost = ILI9341_RECT_AREA(
+                        x0 < r->x0 ? x0 : r->x0, y0 < r->y0 ? y0 : r->y0,
+                        x1 > r->x1 ? x1 : r->x1, y1 > r->y1 ? y1 : r->y1
+                    ) - ILI9341_RECT_AREA(r->x0, r->y0, r->x1, r->y1) - ILI9341_RECT_AREA(x0, y0, x1, y1);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = i;
+            }
+        }
+
+        /* Add as new rectangle if it is far enough from others and we have free space */
+        if (
+            best == ILI9341_DIRTY_RECTS ||
+            (best_cost > ILI9341_DIRTY_MERGE_PIXELS && ILI9341_DirtyCount < ILI9341_DIRTY_RECTS)
+        ) {
+            break;
+        }
+
+        /* Merge with best rectangle and remove it from list */
+        r = &ILI9341_Dirty[best];
+        if (r->x0 < x0) {
+            x0 = r->x0;
+        }
+        if (r->y0 < y0) {
+            y0 = r->y0;
+        }
+        if (r->x1 > x1) {
+            x1 = r->x1;
+        }
+        if (r->y1 > y1) {
+            y1 = r->y1;
+        }
+        *r = ILI9341_Dirty[--ILI9341_DirtyCount];
+
+        /* Merged rectangle may now overlap others, check again */
     }
+
+    /* Save new rectangle */
+    r = &ILI9341_Dirty[ILI9341_DirtyCount++];
+    r->x0 = x0;
+    r->y0 = y0;
+    r->x1 = x1;
+    r->y1 = y1;
+}
+
+void
+TM_ILI9341_Flush(void) {
+    TM_ILI9341_Rect_t* r;
+    uint16_t* ptr;
+    uint32_t count;
+    uint16_t y, width, btw;
+    uint8_t i;
+
+    for (i = 0; i < ILI9341_DirtyCount; i++) {
+        r = &ILI9341_Dirty[i];
+        width = r->x1 - r->x0 + 1;
+        ptr = &ILI9341_Shadow[r->y0 * ILI9341_Opts.width + r->x0];
+
+        /* Set window, LCD moves to next line inside window automatically */
+        TM_ILI9341_SetCursorPosition(r->x0, r->y0, r->x1, r->y1);
+
+        /* Set command for GRAM data */
+        TM_ILI9341_SendCommand(ILI9341_GRAM);
+
+        /* Send everything */
+        ILI9341_CS_RESET;
+        ILI9341_WRX_SET;
+
+        /* Go to 16-bit SPI mode */
+        TM_SPI_SetDataSize(ILI9341_SPI, TM_SPI_DataSize_16b);
+
+        if (width == ILI9341_Opts.width) {
+            /* Lines are one after another in memory, send them in max 65535 pixels blocks */
+            count = (uint32_t)(r->y1 - r->y0 + 1) * width;
+            while (count) {
+                btw = (count > 0xFFFF) ? 0xFFFF : count;
+                TM_SPI_DMA_Send16(ILI9341_SPI, ptr, btw);
+                /* Wait till done */
+                while (TM_SPI_DMA_Working(ILI9341_SPI));
+                ptr += btw;
+                count -= btw;
+            }
+        } else {
+            /* Send line by line, CS stays low so LCD window continues */
+            for (y = r->y0; y <= r->y1; y++) {
+                TM_SPI_DMA_Send16(ILI9341_SPI, ptr, width);
+                /* Wait till done */
+                while (TM_SPI_DMA_Working(ILI9341_SPI));
+                ptr += ILI9341_Opts.width;
+            }
+        }
+
+        ILI9341_CS_SET;
+
+        /* Go back to 8-bit SPI mode */
+        TM_SPI_SetDataSize(ILI9341_SPI, TM_SPI_DataSize_8b);
+    }
+
+    /* Everything is sent */
+    ILI9341_DirtyCount = 0;
 }
+#endif
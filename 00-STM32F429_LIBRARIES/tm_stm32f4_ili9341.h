@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/04/library-08-ili9341-lcd-on-stm32f429-discovery-board/
- * @version v1.3
+ * @version v1.6
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   ILI9341 library for STM32F4xx with SPI communication, without LTDC hardware
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_ILI9341_H
-#define TM_ILI9341_H 130
+#define TM_ILI9341_H 160
 
 /**
  * @addtogroup TM_STM32F4xx_Libraries
@@ -89,11 +89,57 @@ VCC          3.3V         Positive power supply
 //Default RESET pin. Edit this in your defines.h file
 #define ILI9341_RST_PORT            GPIOD
 #define ILI9341_RST_PIN             GPIO_PIN_12
+@endverbatim
+ *
+ * \par Shadow framebuffer
+ *
+ * Drawing pixel by pixel over SPI is slow, because every pixel needs new cursor position.
+ * Library can keep copy of entire screen in RAM (shadow framebuffer). In this mode, all drawing functions
+ * only write to RAM and remember changed areas (dirty rectangles). Overlapping and close rectangles are merged together.
+ * When you call @ref TM_ILI9341_Flush function, only changed areas are sent to LCD using SPI DMA,
+ * one LCD window per rectangle.
+ * Rotation clears shadow framebuffer, so redraw screen after @ref TM_ILI9341_Rotate.
+ *
+ * To enable this mode, add line below to defines.h file
+ *
+@verbatim
+//Enable shadow framebuffer
+#define ILI9341_USE_SHADOW
+@endverbatim
+ *
+ * By default, shadow framebuffer is located at the beginning of external SDRAM (LCD area of SDRAM memory map in TM SDRAM library)
+ * and SDRAM is initialized by library.
+ * If you want your own memory (needs 150kB, must be accessible by DMA, CCM RAM can not be used), you can set it in defines.h file
+ *
+@verbatim
+//Use own memory for shadow framebuffer
+extern uint16_t MyShadowBuffer[];
+#define ILI9341_SHADOW_BUFFER       MyShadowBuffer
+
+//Maximal number of dirty rectangles before they are forced to merge
+#define ILI9341_DIRTY_RECTS         8
+
+//Rectangles are merged, if merged area has at most this number of pixels more than both rectangles together
+#define ILI9341_DIRTY_MERGE_PIXELS  256
 @endverbatim
  *
  * \par Changelog
  *
 @verbatim
+ Version 1.6
+  - October 16, 2026
+  - Filled circles are drawn with TM SCANLINE engine
+  - Added TM_ILI9341_GetScanline() function for other filled shapes
+
+ Version 1.5
+  - October 16, 2026
+  - Characters, lines and filled circles are drawn with LCD windows instead of pixel by pixel
+  - Added support for transparent background for characters and strings
+
+ Version 1.4
+  - October 16, 2026
+  - Added optional shadow framebuffer with dirty rectangles and TM_ILI9341_Flush() function
+
  Version 1.3
   - June 06, 2015
   - Added support for SPI DMA for faster refreshing
@@ -120,6 +166,8 @@ VCC          3.3V         Positive power supply
  - TM SPI DMA
  - TM FONTS
  - TM GPIO
+ - TM SCANLINE
+ - TM SDRAM (only with shadow framebuffer in SDRAM)
 @endverbatim
  */
 
@@ -132,6 +180,14 @@ VCC          3.3V         Positive power supply
 #include "tm_stm32f4_spi.h"
 #include "tm_stm32f4_dma.h"
 #include "tm_stm32f4_spi_dma.h"
+#include "tm_stm32f4_scanline.h"
+
+/* Shadow framebuffer in SDRAM by default */
+#if defined(ILI9341_USE_SHADOW) && !defined(ILI9341_SHADOW_BUFFER)
+#include "tm_stm32f4_sdram.h"
+#define ILI9341_SHADOW_BUFFER       ((uint16_t *)SDRAM_START_ADR)
+#define ILI9341_SHADOW_SDRAM
+#endif
 
 /**
  * @defgroup TM_ILI9341_Macros
@@ -171,6 +227,28 @@ VCC          3.3V         Positive power supply
 #define ILI9341_RST_PIN       GPIO_PIN_12
 #endif
 
+/**
+ * @brief  Maximal number of dirty rectangles for shadow framebuffer
+ */
+#ifndef ILI9341_DIRTY_RECTS
+#define ILI9341_DIRTY_RECTS         8
+#endif
+
+/**
+ * @brief  Maximal number of extra pixels sent when 2 dirty rectangles are merged
+ */
+#ifndef ILI9341_DIRTY_MERGE_PIXELS
+#define ILI9341_DIRTY_MERGE_PIXELS  256
+#endif
+
+/**
+ * @brief  Number of pixels in buffer for drawing characters
+ * @note   Characters which don't fit into buffer are sent in more parts
+ */
+#ifndef ILI9341_GLYPH_BUFFER_SIZE
+#define ILI9341_GLYPH_BUFFER_SIZE   (16 * 26)
+#endif
+
 /* LCD settings */
 #define ILI9341_WIDTH        240
 #define ILI9341_HEIGHT       320
@@ -251,6 +329,8 @@ void TM_ILI9341_Fill(uint32_t color);
 
 /**
  * @brief  Rotates LCD to specific orientation
+ * @note   With ILI9341_USE_SHADOW, shadow framebuffer is filled with white color, because its rows are in old order.
+ *         Redraw screen after rotation, LCD is cleared on next @ref TM_ILI9341_Flush
  * @param  orientation: LCD orientation. This parameter can be a value of @ref TM_ILI9341_Orientation_t enumeration
  * @retval None
  */
@@ -343,6 +423,14 @@ void TM_ILI9341_DrawCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color);
  */
 void TM_ILI9341_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color);
 
+/**
+ * @brief  Gets device structure for TM SCANLINE engine, used for other filled shapes (polygons, ellipses, arcs)
+ * @note   Call it again after LCD is rotated
+ * @param  None
+ * @retval Pointer to @ref TM_SCANLINE_t device structure
+ */
+TM_SCANLINE_t* TM_ILI9341_GetScanline(void);
+
 /**
  * @brief   Enables display
  * @note    After initialization, LCD is enabled and you don't need to call this function
@@ -358,6 +446,31 @@ void TM_ILI9341_DisplayOn(void);
  */
 void TM_ILI9341_DisplayOff(void);
 
+#if defined(ILI9341_USE_SHADOW) || defined(__DOXYGEN__)
+
+/**
+ * @brief  Sends all changed areas of shadow framebuffer to LCD
+ * @note   Drawing functions only update shadow framebuffer. Call this function when drawing is finished
+ * @note   Available only when ILI9341_USE_SHADOW is defined
+ * @param  None
+ * @retval None
+ */
+void TM_ILI9341_Flush(void);
+
+/**
+ * @brief  Marks area of shadow framebuffer as changed, so it will be sent on next flush
+ * @note   Use it when you write to shadow framebuffer directly
+ * @note   Available only when ILI9341_USE_SHADOW is defined
+ * @param  x0: X coordinate of top left point
+ * @param  y0: Y coordinate of top left point
+ * @param  x1: X coordinate of bottom right point
+ * @param  y1: Y coordinate of bottom right point
+ * @retval None
+ */
+void TM_ILI9341_Invalidate(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+
+#endif
+
 /**
  * @}
  */
@@ -18,6 +18,7 @@
  */
 #include "tm_stm32f4_ili9341_ltdc.h"
 #include "tm_stm32f4_fonts.h"
+#include "tm_stm32f4_dma2d_graphic.h"
 
 /* Private structures */
 /**
@@ -42,6 +43,9 @@ typedef struct {
     uint8_t Layer1Opacity;
     uint8_t Layer2Opacity;
     TM_ILI9341_Orientation_t Orient;
+    int32_t Origin; /* Pixel index in layer memory for X = 0 and Y = 0 in current orientation */
+    int32_t XStep;  /* Pixel index step in layer memory when X increases by 1 */
+    int32_t YStep;  /* Pixel index step in layer memory when Y increases by 1 */
 } TM_ILI931_Options_t;
 
 /* Private defines */
@@ -62,6 +66,29 @@ typedef struct {
 /* Offset for Layer 2 */
 #define ILI9341_FRAME_OFFSET        (uint32_t)ILI9341_PIXEL * 2
 
+/* Pixel address in current layer, orientation is handled with precalculated steps */
+#define ILI9341_PIXEL_ADDR(x, y)    ((uint16_t *)(ILI9341_FRAME_BUFFER + ILI9341_Opts.CurrentLayerOffset) + ILI9341_Opts.Origin + (int32_t)(x) * ILI9341_Opts.XStep + (int32_t)(y) * ILI9341_Opts.YStep)
+
+/* Frame buffer address for layer 1 buffering, buffers 1 and above are after layer 2 */
+#define ILI9341_BUFFER_ADDR(i)      (ILI9341_FRAME_BUFFER + ((i) ? ((i) + 1) * ILI9341_FRAME_OFFSET : 0))
+
+/* Layer 1 buffer for drawing and last finished layer 1 buffer */
+#if defined(ILI9341_USE_BUFFERING)
+#define ILI9341_LAYER1_BACK         ILI9341_BUFFER_ADDR(ILI9341_Buffers.Draw)
+#define ILI9341_LAYER1_FRONT        ILI9341_BUFFER_ADDR(TM_ILI9341_INT_FrontBuffer())
+#else
+#define ILI9341_LAYER1_BACK         ILI9341_FRAME_BUFFER
+#define ILI9341_LAYER1_FRONT        ILI9341_FRAME_BUFFER
+#endif
+
+/* Buffer states */
+#define ILI9341_BUFFER_FREE         0
+#define ILI9341_BUFFER_DRAW         1
+#define ILI9341_BUFFER_PENDING      2
+#define ILI9341_BUFFER_RELOAD       3
+#define ILI9341_BUFFER_SHOWN        4
+#define ILI9341_BUFFER_NONE         0xFF
+
 /* Commands */
 #define ILI9341_RESET               0x01
 #define ILI9341_SLEEP_OUT           0x11
@@ -98,10 +125,28 @@ typedef struct {
 uint16_t ILI9341_x;
 uint16_t ILI9341_y;
 TM_ILI931_Options_t ILI9341_Opts;
+TM_FONTS_Atlas_t* ILI9341_Atlas;
+
+#if defined(ILI9341_USE_BUFFERING)
+/* Buffering structure */
+typedef struct {
+    volatile uint8_t State[ILI9341_FRAME_BUFFERS]; /* State of each buffer */
+    volatile uint8_t Queue[ILI9341_FRAME_BUFFERS]; /* Buffers waiting to be shown, in order */
+    volatile uint8_t QueueIn;
+    volatile uint8_t QueueOut;
+    volatile uint8_t QueueCount;
+    volatile uint8_t Shown;                        /* Buffer currently on LCD */
+    volatile uint8_t Reload;                       /* Buffer programmed for reload on vertical blanking */
+    uint8_t Draw;                                  /* Buffer used for drawing */
+} TM_ILI9341_Buffers_t;
+static TM_ILI9341_Buffers_t ILI9341_Buffers;
+
+static void TM_ILI9341_INT_InitBuffering(void);
+static uint8_t TM_ILI9341_INT_FrontBuffer(void);
+#endif
 
 /* Private functions */
 void TM_INT_ILI9341_DrawCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color);
-void TM_INT_ILI9341_DrawFilledCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color);
 void TM_ILI9341_InitPins(void);
 void TM_LCD9341_InitLTDC(void);
 void TM_ILI9341_InitLayers(void);
@@ -111,6 +156,13 @@ void TM_ILI9341_SendCommand(uint8_t data);
 void TM_ILI9341_Delay(volatile unsigned int delay);
 void TM_ILI9341_SetCursorPosition(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 void TM_ILI9341_UpdateLayerOpacity(void);
+void TM_INT_ILI9341_Putc(uint16_t x, uint16_t y, char c, TM_FontDef_t* font, uint32_t foreground, uint32_t background);
+void TM_INT_ILI9341_DrawHorizontalLine(uint16_t x, uint16_t y, uint16_t length, uint32_t color);
+void TM_INT_ILI9341_DrawVerticalLine(uint16_t x, uint16_t y, uint16_t length, uint32_t color);
+static void TM_INT_ILI9341_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color);
+
+/* Device for scanline fill engine */
+static TM_SCANLINE_t ILI9341_Scanline = {TM_INT_ILI9341_Span, 0, 0};
 
 void
 TM_ILI9341_Init(void) {
@@ -132,10 +184,7 @@ TM_ILI9341_Init(void) {
     ILI9341_x = ILI9341_y = 0;
 
     /* Set default settings */
-    ILI9341_Opts.Width = ILI9341_WIDTH;
-    ILI9341_Opts.Height = ILI9341_HEIGHT;
-    ILI9341_Opts.Orientation = TM_ILI9341_Portrait;
-    ILI9341_Opts.Orient = TM_ILI9341_Orientation_Portrait_1;
+    TM_ILI9341_Rotate(TM_ILI9341_Orientation_Portrait_1);
     ILI9341_Opts.CurrentLayer = 0;
     ILI9341_Opts.CurrentLayerOffset = 0;
     ILI9341_Opts.Layer1Opacity = 255;
@@ -147,6 +196,11 @@ TM_ILI9341_Init(void) {
     TM_ILI9341_SetLayer2();
     TM_ILI9341_Fill(ILI9341_COLOR_WHITE);
     TM_ILI9341_SetLayer1();
+
+#if defined(ILI9341_USE_BUFFERING)
+    /* Init buffers for layer 1 */
+    TM_ILI9341_INT_InitBuffering();
+#endif
 }
 
 void
@@ -480,33 +534,13 @@ TM_ILI9341_SendData(uint8_t data) {
 
 void
 TM_ILI9341_DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
-    uint16_t tmp;
     if (x >= ILI9341_Opts.Width) {
         return;
     }
     if (y >= ILI9341_Opts.Height) {
         return;
     }
-    if (ILI9341_Opts.Orient == TM_ILI9341_Orientation_Portrait_1) {
-        /* Portrait1 */
-        *(uint16_t*) (ILI9341_FRAME_BUFFER + ILI9341_Opts.CurrentLayerOffset + 2 * (ILI9341_PIXEL - x - ILI9341_Opts.Width * y)) = color;
-    } else if (ILI9341_Opts.Orient == TM_ILI9341_Orientation_Portrait_2) {
-        /* Portrait2, original */
-        *(uint16_t*) (ILI9341_FRAME_BUFFER + ILI9341_Opts.CurrentLayerOffset + 2 * (x + ILI9341_Opts.Width * y)) = color;
-    } else if (ILI9341_Opts.Orient == TM_ILI9341_Orientation_Landscape_1) {
-        /* L andscape 1 */
-        tmp = x;
-        x = y;
-        y = ILI9341_HEIGHT - 1 - tmp;
-        *(uint16_t*) (ILI9341_FRAME_BUFFER + ILI9341_Opts.CurrentLayerOffset + 2 * (x + ILI9341_WIDTH * y)) = color;
-    } else {
-        /* Landscape2 */
-        tmp = y;
-        y = x;
-        x = ILI9341_WIDTH - 1 - tmp;
-        *(uint16_t*) (ILI9341_FRAME_BUFFER + ILI9341_Opts.CurrentLayerOffset + 2 * (x + ILI9341_WIDTH * y)) = color;
-    }
-    return;
+    *ILI9341_PIXEL_ADDR(x, y) = color;
 }
 
 void
@@ -535,11 +569,31 @@ TM_ILI9341_Rotate(TM_ILI9341_Orientation_t orientation) {
         ILI9341_Opts.Height = ILI9341_WIDTH;
         ILI9341_Opts.Orientation = TM_ILI9341_Landscape;
     }
+
+    /* Calculate memory position of X = 0, Y = 0 and steps for X and Y once, instead on every pixel */
+    if (orientation == TM_ILI9341_Orientation_Portrait_1) {
+        ILI9341_Opts.Origin = ILI9341_PIXEL - 1;
+        ILI9341_Opts.XStep = -1;
+        ILI9341_Opts.YStep = -ILI9341_WIDTH;
+    } else if (orientation == TM_ILI9341_Orientation_Portrait_2) {
+        ILI9341_Opts.Origin = 0;
+        ILI9341_Opts.XStep = 1;
+        ILI9341_Opts.YStep = ILI9341_WIDTH;
+    } else if (orientation == TM_ILI9341_Orientation_Landscape_1) {
+        ILI9341_Opts.Origin = ILI9341_WIDTH * (ILI9341_HEIGHT - 1);
+        ILI9341_Opts.XStep = -ILI9341_WIDTH;
+        ILI9341_Opts.YStep = 1;
+    } else {
+        ILI9341_Opts.Origin = ILI9341_WIDTH - 1;
+        ILI9341_Opts.XStep = ILI9341_WIDTH;
+        ILI9341_Opts.YStep = -1;
+    }
 }
 
 void
 TM_ILI9341_SetLayer1(void) {
-    ILI9341_Opts.CurrentLayerOffset = 0;
+    /* Draw to back buffer when buffering is used */
+    ILI9341_Opts.CurrentLayerOffset = ILI9341_LAYER1_BACK - ILI9341_FRAME_BUFFER;
     ILI9341_Opts.CurrentLayer = 0;
 }
 
@@ -572,39 +626,194 @@ TM_ILI9341_UpdateLayerOpacity(void) {
 
 void
 TM_ILI9341_ChangeLayers(void) {
+    /* Wait for previous reload, also from buffer swap */
+    while (LTDC->SRCR & LTDC_SRCR_VBR);
+
     if (ILI9341_Opts.CurrentLayer == 0) {
         TM_ILI9341_SetLayer2();
-        TM_ILI9341_SetLayer1Opacity(0);
-        TM_ILI9341_SetLayer2Opacity(255);
+        ILI9341_Opts.Layer1Opacity = 0;
+        ILI9341_Opts.Layer2Opacity = 255;
     } else {
         TM_ILI9341_SetLayer1();
-        TM_ILI9341_SetLayer1Opacity(255);
-        TM_ILI9341_SetLayer2Opacity(0);
+        ILI9341_Opts.Layer1Opacity = 255;
+        ILI9341_Opts.Layer2Opacity = 0;
     }
+    LTDC_LayerAlpha(LTDC_Layer1, ILI9341_Opts.Layer1Opacity);
+    LTDC_LayerAlpha(LTDC_Layer2, ILI9341_Opts.Layer2Opacity);
+
+    /* Reload on vertical blanking, so there is no tearing */
+    LTDC_ReloadConfig(LTDC_VBReload);
+
+    /* Old layer is on LCD until reload, wait before it is used for drawing */
+    while (LTDC->SRCR & LTDC_SRCR_VBR);
 }
 
-#include "tm_stm32f4_dma2d_graphic.h"
 void
 TM_ILI9341_Layer2To1(void) {
-    /* Make a memory copy */
+    /* Make a memory copy to layer 1 buffer for drawing */
     TM_DMA2DGRAPHIC_CopyBuffer(
         (uint8_t*)(ILI9341_FRAME_BUFFER + ILI9341_FRAME_OFFSET),
-        (uint8_t*)(ILI9341_FRAME_BUFFER),
+        (uint8_t*)(ILI9341_LAYER1_BACK),
         240, 320, 0, 0
     );
 }
 
 void
 TM_ILI9341_Layer1To2(void) {
-    /* Make a memory copy */
+    /* Make a memory copy from last finished layer 1 buffer */
     TM_DMA2DGRAPHIC_CopyBuffer(
-        (uint8_t*)(ILI9341_FRAME_BUFFER),
+        (uint8_t*)(ILI9341_LAYER1_FRONT),
         (uint8_t*)(ILI9341_FRAME_BUFFER + ILI9341_FRAME_OFFSET),
         240, 320, 0, 0
     );
     //memcpy((uint8_t *)(ILI9341_FRAME_BUFFER + ILI9341_FRAME_OFFSET), (uint8_t *)(ILI9341_FRAME_BUFFER), ILI9341_PIXEL * 2);
 }
 
+#if defined(ILI9341_USE_BUFFERING)
+void
+TM_ILI9341_SwapBuffers(void) {
+    uint8_t i, next = ILI9341_BUFFER_NONE;
+
+    /* Drawing with DMA2D must be finished */
+    DMA2D_WAIT;
+
+    /* Add current back buffer to queue, disable LTDC interrupt while queue is changed */
+    NVIC_DisableIRQ(LTDC_IRQn);
+    ILI9341_Buffers.State[ILI9341_Buffers.Draw] = ILI9341_BUFFER_PENDING;
+    ILI9341_Buffers.Queue[ILI9341_Buffers.QueueIn] = ILI9341_Buffers.Draw;
+    if (++ILI9341_Buffers.QueueIn >= ILI9341_FRAME_BUFFERS) {
+        ILI9341_Buffers.QueueIn = 0;
+    }
+    ILI9341_Buffers.QueueCount++;
+    NVIC_EnableIRQ(LTDC_IRQn);
+
+    /* Find free buffer, wait for LTDC interrupt to release one if needed */
+    while (next == ILI9341_BUFFER_NONE) {
+        for (i = 0; i < ILI9341_FRAME_BUFFERS; i++) {
+            if (ILI9341_Buffers.State[i] == ILI9341_BUFFER_FREE) {
+                next = i;
+                break;
+            }
+        }
+    }
+
+    /* Set new back buffer */
+    ILI9341_Buffers.State[next] = ILI9341_BUFFER_DRAW;
+    ILI9341_Buffers.Draw = next;
+
+    /* Draw to new buffer if layer 1 is active */
+    if (ILI9341_Opts.CurrentLayer == 0) {
+        TM_ILI9341_SetLayer1();
+    }
+}
+
+uint32_t
+TM_ILI9341_GetDrawBuffer(void) {
+    return ILI9341_BUFFER_ADDR(ILI9341_Buffers.Draw);
+}
+
+uint8_t
+TM_ILI9341_IsSwapPending(void) {
+    return ILI9341_Buffers.QueueCount || ILI9341_Buffers.Reload != ILI9341_BUFFER_NONE;
+}
+
+static uint8_t
+TM_ILI9341_INT_FrontBuffer(void) {
+    uint8_t i;
+
+    /* LTDC interrupt moves buffers from queue */
+    NVIC_DisableIRQ(LTDC_IRQn);
+    if (ILI9341_Buffers.QueueCount) {
+        /* Last buffer added to queue */
+        i = ILI9341_Buffers.Queue[(ILI9341_Buffers.QueueIn ? ILI9341_Buffers.QueueIn : ILI9341_FRAME_BUFFERS) - 1];
+    } else if (ILI9341_Buffers.Reload != ILI9341_BUFFER_NONE) {
+        /* Buffer waiting for reload */
+        i = ILI9341_Buffers.Reload;
+    } else {
+        /* Buffer on LCD */
+        i = ILI9341_Buffers.Shown;
+    }
+    NVIC_EnableIRQ(LTDC_IRQn);
+
+    return i;
+}
+
+static void
+TM_ILI9341_INT_InitBuffering(void) {
+    NVIC_InitTypeDef NVIC_InitStruct;
+    uint8_t i;
+
+    /* Buffer 0 is on LCD, buffer 1 is for drawing */
+    for (i = 0; i < ILI9341_FRAME_BUFFERS; i++) {
+        ILI9341_Buffers.State[i] = ILI9341_BUFFER_FREE;
+    }
+    ILI9341_Buffers.QueueIn = ILI9341_Buffers.QueueOut = ILI9341_Buffers.QueueCount = 0;
+    ILI9341_Buffers.Reload = ILI9341_BUFFER_NONE;
+    ILI9341_Buffers.Shown = 0;
+    ILI9341_Buffers.State[0] = ILI9341_BUFFER_SHOWN;
+    ILI9341_Buffers.Draw = 1;
+    ILI9341_Buffers.State[1] = ILI9341_BUFFER_DRAW;
+
+    /* Fill back buffers with the same color as layer 1 */
+    for (i = 1; i < ILI9341_FRAME_BUFFERS; i++) {
+        ILI9341_Buffers.Draw = i;
+        TM_ILI9341_SetLayer1();
+        TM_ILI9341_Fill(ILI9341_COLOR_WHITE);
+    }
+    ILI9341_Buffers.Draw = 1;
+    TM_ILI9341_SetLayer1();
+
+    /* Line interrupt on line 0, new address is then loaded on vertical blanking of the same frame */
+    LTDC_LIPConfig(0);
+    LTDC_ClearITPendingBit(LTDC_IT_LI);
+    LTDC_ITConfig(LTDC_IT_LI, ENABLE);
+
+    /* Add to NVIC */
+    NVIC_InitStruct.NVIC_IRQChannel = LTDC_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = ILI9341_NVIC_PRIORITY;
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+}
+
+void
+LTDC_IRQHandler(void) {
+    uint8_t i;
+
+    /* Check line interrupt */
+    if (LTDC->ISR & LTDC_ISR_LIF) {
+        /* Clear flag */
+        LTDC->ICR = LTDC_ICR_CLIF;
+
+        /* Check if reload from previous frame is done */
+        if (ILI9341_Buffers.Reload != ILI9341_BUFFER_NONE && !(LTDC->SRCR & LTDC_SRCR_VBR)) {
+            /* Old buffer is free now */
+            ILI9341_Buffers.State[ILI9341_Buffers.Shown] = ILI9341_BUFFER_FREE;
+            ILI9341_Buffers.Shown = ILI9341_Buffers.Reload;
+            ILI9341_Buffers.State[ILI9341_Buffers.Shown] = ILI9341_BUFFER_SHOWN;
+            ILI9341_Buffers.Reload = ILI9341_BUFFER_NONE;
+        }
+
+        /* Program next buffer in queue */
+        if (ILI9341_Buffers.Reload == ILI9341_BUFFER_NONE && ILI9341_Buffers.QueueCount) {
+            i = ILI9341_Buffers.Queue[ILI9341_Buffers.QueueOut];
+            if (++ILI9341_Buffers.QueueOut >= ILI9341_FRAME_BUFFERS) {
+                ILI9341_Buffers.QueueOut = 0;
+            }
+            ILI9341_Buffers.QueueCount--;
+
+            /* Set new address, reload on vertical blanking */
+            LTDC_Layer1->CFBAR = ILI9341_BUFFER_ADDR(i);
+            LTDC->SRCR = LTDC_SRCR_VBR;
+
+            /* Save buffer */
+            ILI9341_Buffers.State[i] = ILI9341_BUFFER_RELOAD;
+            ILI9341_Buffers.Reload = i;
+        }
+    }
+}
+#endif
+
 void
 TM_ILI9341_Puts(uint16_t x, uint16_t y, char* str, TM_FontDef_t* font, uint32_t foreground, uint32_t background) {
     uint16_t startX = x;
@@ -631,9 +840,17 @@ TM_ILI9341_Puts(uint16_t x, uint16_t y, char* str, TM_FontDef_t* font, uint32_t
             continue;
         }
 
-        /* Put character */
-        TM_ILI9341_Putc(ILI9341_x, ILI9341_y, *str++, font, foreground, background);
+        /* Put character, DMA2D transfer for previous character can still be in progress */
+        TM_INT_ILI9341_Putc(ILI9341_x, ILI9341_y, *str++, font, foreground, background);
     }
+
+    /* Wait till last character is drawn */
+    DMA2D_WAIT;
+}
+
+void
+TM_ILI9341_SetFontAtlas(TM_FONTS_Atlas_t* Atlas) {
+    ILI9341_Atlas = Atlas;
 }
 
 void
@@ -651,7 +868,19 @@ TM_ILI9341_GetStringSize(char* str, TM_FontDef_t* font, uint16_t* width, uint16_
 
 void
 TM_ILI9341_Putc(uint16_t x, uint16_t y, char c, TM_FontDef_t* font, uint32_t foreground, uint32_t background) {
-    uint32_t i, b, j;
+    /* Put character */
+    TM_INT_ILI9341_Putc(x, y, c, font, foreground, background);
+
+    /* Wait if DMA2D was used */
+    DMA2D_WAIT;
+}
+
+void
+TM_INT_ILI9341_Putc(uint16_t x, uint16_t y, char c, TM_FontDef_t* font, uint32_t foreground, uint32_t background) {
+    uint32_t i, b, j, width, height;
+    const uint8_t* alpha;
+    uint16_t* addr;
+    int32_t step;
     /* Set coordinates */
     ILI9341_x = x;
     ILI9341_y = y;
@@ -660,14 +889,61 @@ TM_ILI9341_Putc(uint16_t x, uint16_t y, char c, TM_FontDef_t* font, uint32_t for
         ILI9341_y += font->FontHeight;
         ILI9341_x = 0;
     }
-    for (i = 0; i < font->FontHeight; i++) {
+
+    /* Clip character to LCD size */
+    width = font->FontWidth;
+    height = font->FontHeight;
+    if ((ILI9341_y + height) > ILI9341_Opts.Height) {
+        height = ILI9341_y < ILI9341_Opts.Height ? ILI9341_Opts.Height - ILI9341_y : 0;
+    }
+    if ((ILI9341_x + width) > ILI9341_Opts.Width) {
+        width = ILI9341_x < ILI9341_Opts.Width ? ILI9341_Opts.Width - ILI9341_x : 0;
+    }
+
+    step = ILI9341_Opts.XStep;
+
+    /* Use atlas if available for this font */
+    if (ILI9341_Atlas != NULL && ILI9341_Atlas->Font == font) {
+        alpha = TM_FONTS_GetAtlasChar(ILI9341_Atlas, c);
+        if (step == 1) {
+            /* LCD rows are memory rows, draw character with single DMA2D transfer */
+            if (width && height) {
+                TM_DMA2DGRAPHIC_BlendA8IT(alpha, ILI9341_PIXEL_ADDR(ILI9341_x, ILI9341_y), width, height, font->FontWidth - width, ILI9341_WIDTH - width, foreground, background);
+            }
+        } else {
+            /* Rotated memory, mix colors with CPU row by row */
+            for (i = 0; i < height; i++) {
+                addr = ILI9341_PIXEL_ADDR(ILI9341_x, ILI9341_y + i);
+                for (j = 0; j < width; j++) {
+                    if (alpha[j] == 0xFF) {
+                        *addr = foreground;
+                    } else if (alpha[j]) {
+                        *addr = TM_DMA2DGRAPHIC_MixColors(foreground, (background & ILI9341_TRANSPARENT) ? *addr : background, alpha[j]);
+                    } else if ((background & ILI9341_TRANSPARENT) == 0) {
+                        *addr = background;
+                    }
+                    addr += step;
+                }
+                alpha += font->FontWidth;
+            }
+        }
+
+        /* Go to new X location */
+        ILI9341_x += font->FontWidth;
+        return;
+    }
+
+    for (i = 0; i < height; i++) {
         b = font->data[(c - 32) * font->FontHeight + i];
-        for (j = 0; j < font->FontWidth; j++) {
+        /* Calculate address once per font row */
+        addr = ILI9341_PIXEL_ADDR(ILI9341_x, ILI9341_y + i);
+        for (j = 0; j < width; j++) {
             if ((b << j) & 0x8000) {
-                TM_ILI9341_DrawPixel(ILI9341_x + j, (ILI9341_y + i), foreground);
+                *addr = foreground;
             } else if ((background & ILI9341_TRANSPARENT) == 0) {
-                TM_ILI9341_DrawPixel(ILI9341_x + j, (ILI9341_y + i), background);
+                *addr = background;
             }
+            addr += step;
         }
     }
     /* Go to new X location */
@@ -695,6 +971,16 @@ TM_ILI9341_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t
         y1 = ILI9341_Opts.Height - 1;
     }
 
+    /* Horizontal and vertical lines are written as one run of pixels */
+    if (y0 == y1) {
+        TM_INT_ILI9341_DrawHorizontalLine(x0 < x1 ? x0 : x1, y0, (x0 < x1 ? x1 - x0 : x0 - x1) + 1, color);
+        return;
+    }
+    if (x0 == x1) {
+        TM_INT_ILI9341_DrawVerticalLine(x0, y0 < y1 ? y0 : y1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1, color);
+        return;
+    }
+
     dx = (x0 < x1) ? (x1 - x0) : (x0 - x1);
     dy = (y0 < y1) ? (y1 - y0) : (y0 - y1);
     sx = (x0 < x1) ? 1 : -1;
@@ -778,8 +1064,6 @@ TM_ILI9341_DrawRoundedRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t
 
 void
 TM_ILI9341_DrawFilledRoundedRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t r, uint32_t color) {
-    uint16_t temp;
-
     /* Check input parameters */
     if (x1 == x0 || y1 == y0) {
         return;
@@ -788,40 +1072,11 @@ TM_ILI9341_DrawFilledRoundedRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uin
     /* No radius */
     if (r == 0) {
         TM_ILI9341_DrawFilledRectangle(x0, y0, x1, y1, color);
+        return;
     }
 
-    /* Swap X coordinates */
-    if (x0 > x1) {
-        temp = x1;
-        x1 = x0;
-        x0 = temp;
-    }
-
-    /* Swap Y coordinates */
-    if (y0 > y1) {
-        temp = y1;
-        y1 = y0;
-        y0 = temp;
-    }
-
-    /* Check max radius */
-    if (r > ((x1 - x0) / 2)) {
-        r = (x1 - x0) / 2;
-    }
-    if (r > ((y1 - y0) / 2)) {
-        r = (y1 - y0) / 2;
-    }
-
-    /* Draw rectangles */
-    TM_ILI9341_DrawFilledRectangle(x0 + r, y0, x1 - r, y1, color);
-    TM_ILI9341_DrawFilledRectangle(x0, y0 + r, x0 + r, y1 - r, color);
-    TM_ILI9341_DrawFilledRectangle(x1 - r, y0 + r, x1, y1 - r, color);
-
-    /* Draw corners */
-    TM_INT_ILI9341_DrawFilledCircleCorner(x0 + r, y0 + r, r, 0x01, color);
-    TM_INT_ILI9341_DrawFilledCircleCorner(x1 - r, y0 + r, r, 0x02, color);
-    TM_INT_ILI9341_DrawFilledCircleCorner(x1 - r, y1 - r - 1, r, 0x04, color);
-    TM_INT_ILI9341_DrawFilledCircleCorner(x0 + r, y1 - r - 1, r, 0x08, color);
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillRoundedRectangle(TM_ILI9341_GetScanline(), x0, y0, x1, y1, r, color);
 }
 
 void
@@ -868,37 +1123,50 @@ TM_ILI9341_DrawCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color) {
 
 void
 TM_ILI9341_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillCircle(TM_ILI9341_GetScanline(), x0, y0, r, color);
+}
 
-    TM_ILI9341_DrawPixel(x0, y0 + r, color);
-    TM_ILI9341_DrawPixel(x0, y0 - r, color);
-    TM_ILI9341_DrawPixel(x0 + r, y0, color);
-    TM_ILI9341_DrawPixel(x0 - r, y0, color);
-    TM_ILI9341_DrawLine(x0 - r, y0, x0 + r, y0, color);
+TM_SCANLINE_t*
+TM_ILI9341_GetScanline(void) {
+    /* Update size for current orientation */
+    ILI9341_Scanline.Width = ILI9341_Opts.Width;
+    ILI9341_Scanline.Height = ILI9341_Opts.Height;
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
+    return &ILI9341_Scanline;
+}
 
-        TM_ILI9341_DrawLine(x0 - x, y0 + y, x0 + x, y0 + y, color);
-        TM_ILI9341_DrawLine(x0 + x, y0 - y, x0 - x, y0 - y, color);
+/* Internal functions */
+void
+TM_INT_ILI9341_DrawHorizontalLine(uint16_t x, uint16_t y, uint16_t length, uint32_t color) {
+    uint16_t* addr = ILI9341_PIXEL_ADDR(x, y);
+    int32_t step = ILI9341_Opts.XStep;
+
+    /* Coordinates are already checked, just step through memory */
+    while (length--) {
+        *addr = color;
+        addr += step;
+    }
+}
 
-        TM_ILI9341_DrawLine(x0 + y, y0 + x, x0 - y, y0 + x, color);
-        TM_ILI9341_DrawLine(x0 + y, y0 - x, x0 - y, y0 - x, color);
+void
+TM_INT_ILI9341_DrawVerticalLine(uint16_t x, uint16_t y, uint16_t length, uint32_t color) {
+    uint16_t* addr = ILI9341_PIXEL_ADDR(x, y);
+    int32_t step = ILI9341_Opts.YStep;
+
+    /* Coordinates are already checked, just step through memory */
+    while (length--) {
+        *addr = color;
+        addr += step;
     }
 }
 
-/* Internal functions */
+static void
+TM_INT_ILI9341_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color) {
+    /* Coordinates are clipped by scanline engine */
+    TM_INT_ILI9341_DrawHorizontalLine(x0, y, x1 - x0 + 1, color);
+}
+
 void
 TM_INT_ILI9341_DrawCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color) {
     int16_t f = 1 - r;
@@ -939,43 +1207,3 @@ TM_INT_ILI9341_DrawCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corne
     }
 }
 
-void
-TM_INT_ILI9341_DrawFilledCircleCorner(int16_t x0, int16_t y0, int16_t r, uint8_t corner, uint32_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
-
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        if (corner & 0x01) {
-            TM_ILI9341_DrawLine(x0, y0 - y, x0 - x, y0 - y, color);
-            TM_ILI9341_DrawLine(x0, y0 - x, x0 - y, y0 - x, color);
-        }
-
-        if (corner & 0x02) {
-            TM_ILI9341_DrawLine(x0 + x, y0 - y, x0, y0 - y, color);
-            TM_ILI9341_DrawLine(x0 + y, y0 - x, x0, y0 - x, color);
-        }
-
-        if (corner & 0x04) {
-            TM_ILI9341_DrawLine(x0, y0 + y, x0 + x, y0 + y, color);
-            TM_ILI9341_DrawLine(x0 + y, y0 + x, x0, y0 + x, color);
-        }
-
-        if (corner & 0x08) {
-            TM_ILI9341_DrawLine(x0 - x, y0 + y, x0, y0 + y, color);
-            TM_ILI9341_DrawLine(x0, y0 + x, x0 - y, y0 + x, color);
-        }
-    }
-}
-
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/06/library-18-ili9341-ltdc-stm32f429-discovery/
- * @version v1.4
+ * @version v1.6
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   ILI9341 library for LCD on STM32F429 Discovery using LTDC and external ram
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_ILI9341_LTDC_H
-#define TM_ILI9341_LTDC_H 140
+#define TM_ILI9341_LTDC_H 160
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -57,10 +57,42 @@ PA11 <-> R4    | PB9  <-> B7 |                |             |                 |
 PA12 <-> R5    | PB10 <-> G4 |                |             |                 | PG12 <-> B4     |
                | PB11 <-> G5 |                |             |                 |                 |
 @endverbatim
+ *
+ * \par Double and triple buffering
+ *
+ * Library can use more frame buffers for layer 1 in SDRAM. You always draw into back buffer,
+ * then call @ref TM_ILI9341_SwapBuffers function. Buffer is shown on next frame, when LTDC line interrupt
+ * reprograms layer address and reloads it on vertical blanking, so there is no tearing and no copy.
+ *
+ * To enable it, add lines below in defines.h file:
+ *
+@verbatim
+//Enable buffering on layer 1
+#define ILI9341_USE_BUFFERING
+
+//Set number of buffers for layer 1, 2 for double or 3 for triple buffering
+#define ILI9341_FRAME_BUFFERS       3
+@endverbatim
+ *
+ * @note  With buffering enabled, this library uses LTDC_IRQHandler.
+ * @note  Content of new back buffer is frame drawn before, so whole screen should be redrawn before next swap.
  *
  * \par Changelog
  *
 @verbatim
+ Version 1.6
+  - October 16, 2026
+  - Filled circles and rounded rectangles are drawn with TM SCANLINE engine
+  - Added TM_ILI9341_GetScanline() function for other filled shapes
+
+ Version 1.5
+  - October 16, 2026
+  - Orientation is calculated once in TM_ILI9341_Rotate() as memory origin and X/Y steps
+  - Characters, horizontal and vertical lines are written as runs with single address calculation
+  - Added TM_ILI9341_SetFontAtlas() function for drawing characters with DMA2D and A8 font atlas
+  - Added support for double/triple buffering on layer 1 with buffer swap on vertical blanking
+  - TM_ILI9341_ChangeLayers changes layers on vertical blanking instead of immediate reload
+
  Version 1.4
   - March 14, 2015
   - Added support for new GPIO system
@@ -94,6 +126,8 @@ PA12 <-> R5    | PB10 <-> G4 |                |             |                 |
  - TM FONTS
  - TM SDRAM
  - TM GPIO
+ - TM DMA2D GRAPHIC
+ - TM SCANLINE
 @endverbatim
  */
 #include "stm32f4xx.h"
@@ -105,6 +139,7 @@ PA12 <-> R5    | PB10 <-> G4 |                |             |                 |
 #include "tm_stm32f4_fonts.h"
 #include "tm_stm32f4_sdram.h"
 #include "tm_stm32f4_gpio.h"
+#include "tm_stm32f4_scanline.h"
 
 /**
  * @defgroup TM_ILI9341_LTDC_Macros
@@ -160,6 +195,21 @@ PA12 <-> R5    | PB10 <-> G4 |                |             |                 |
  */
 #define ILI9341_TRANSPARENT         0x80000000
 
+/**
+ * @brief  Number of frame buffers for layer 1 when buffering is enabled
+ * @note   Buffer 0 is normal layer 1 memory, other buffers are placed after layer 2 memory
+ */
+#ifndef ILI9341_FRAME_BUFFERS
+#define ILI9341_FRAME_BUFFERS       3
+#endif
+
+/**
+ * @brief  NVIC priority for LTDC line interrupt used for buffer swapping
+ */
+#ifndef ILI9341_NVIC_PRIORITY
+#define ILI9341_NVIC_PRIORITY       0x04
+#endif
+
 /**
  * @}
  */
@@ -254,6 +304,16 @@ void TM_ILI9341_Puts(uint16_t x, uint16_t y, char* str, TM_FontDef_t* font, uint
  */
 void TM_ILI9341_GetStringSize(char* str, TM_FontDef_t* font, uint16_t* width, uint16_t* height);
 
+/**
+ * @brief  Sets A8 font atlas used for drawing characters
+ * @note   When font used in @ref TM_ILI9341_Putc or @ref TM_ILI9341_Puts matches atlas font,
+ *         characters are drawn from atlas, using DMA2D in @ref TM_ILI9341_Orientation_Portrait_2 orientation
+ *         and CPU color mixing in other orientations. Atlas with anti-aliased alpha values is supported too.
+ * @param  *Atlas: Pointer to @ref TM_FONTS_Atlas_t atlas created with @ref TM_FONTS_CreateAtlas. Use NULL to disable atlas
+ * @retval None
+ */
+void TM_ILI9341_SetFontAtlas(TM_FONTS_Atlas_t* Atlas);
+
 /**
  * @brief  Draws line to LCD
  * @param  x0: X coordinate of starting point
@@ -331,6 +391,14 @@ void TM_ILI9341_DrawCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color);
  */
 void TM_ILI9341_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, uint32_t color);
 
+/**
+ * @brief  Gets device structure for TM SCANLINE engine, used for other filled shapes (polygons, ellipses, arcs)
+ * @note   Call it again after LCD is rotated
+ * @param  None
+ * @retval Pointer to @ref TM_SCANLINE_t device structure for currently active layer
+ */
+TM_SCANLINE_t* TM_ILI9341_GetScanline(void);
+
 /**
  * @brief  Sets layer 2 to currently active layer
  * @param  None
@@ -364,6 +432,8 @@ void TM_ILI9341_SetLayer2Opacity(uint8_t opacity);
  *         It sets transparency to 0 and 255 depends on which layer is selected
 
  * @note   If current layer is Layer 1, then now will be Layer 2 and vice versa
+ * @note   Layers are changed on vertical blanking, function waits for it, up to one frame
+ * @note   With buffering, layer 1 shows front buffer and drawing goes to back buffer
  * @retval None
  */
 void TM_ILI9341_ChangeLayers(void);
@@ -371,6 +441,7 @@ void TM_ILI9341_ChangeLayers(void);
 /**
  * @brief  Copies content of layer 2 to layer 1
  * @note   It will do a memory copy from layer 2 to layer 1
+ * @note   With buffering, layer 2 is copied to back buffer of layer 1
  * @retval None
  */
 void TM_ILI9341_Layer2To1(void);
@@ -378,6 +449,7 @@ void TM_ILI9341_Layer2To1(void);
 /**
  * @brief  Copies content of layer 1 to layer 2
  * @note   It will do a memory copy from layer 1 to layer 2
+ * @note   With buffering, last swapped buffer of layer 1 is copied
  * @retval None
  */
 void TM_ILI9341_Layer1To2(void);
@@ -397,6 +469,36 @@ void TM_ILI9341_DisplayOn(void);
  */
 void TM_ILI9341_DisplayOff(void);
 
+#if defined(ILI9341_USE_BUFFERING) || defined(__DOXYGEN__)
+/**
+ * @brief   Shows current back buffer on next frame and sets new back buffer for drawing
+ * @note    Function does not wait for vertical blanking. It blocks only when there is no free buffer,
+ *          which happens in double buffering mode until previous swap is done
+ * @note    Available only when ILI9341_USE_BUFFERING is defined
+ * @param   None
+ * @retval  None
+ */
+void TM_ILI9341_SwapBuffers(void);
+
+/**
+ * @brief   Gets address of buffer used for drawing on layer 1
+ * @note    Available only when ILI9341_USE_BUFFERING is defined
+ * @param   None
+ * @retval  Buffer address in SDRAM
+ */
+uint32_t TM_ILI9341_GetDrawBuffer(void);
+
+/**
+ * @brief   Checks if any buffer is still waiting to be shown on LCD
+ * @note    Available only when ILI9341_USE_BUFFERING is defined
+ * @param   None
+ * @retval  Swap status:
+ *            - 0: All swapped buffers are on LCD
+ *            - > 0: Swap is pending
+ */
+uint8_t TM_ILI9341_IsSwapPending(void);
+#endif
+
 /**
  * @}
  */
@@ -0,0 +1,264 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_image.h"
+
+/* QOI operations */
+#define QOI_OP_INDEX        0x00
+#define QOI_OP_DIFF         0x40
+#define QOI_OP_LUMA         0x80
+#define QOI_OP_RUN          0xC0
+#define QOI_OP_RGB          0xFE
+#define QOI_OP_RGBA         0xFF
+#define QOI_MASK            0xC0
+
+/* Position in color index */
+#define QOI_HASH(r, g, b, a)    (((r) * 3 + (g) * 5 + (b) * 7 + (a) * 11) & 0x3F)
+
+/* Converts 8-bit channels to RGB565 */
+#define RGB565(r, g, b)         ((uint16_t)((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3)))
+
+/**
+ * @brief  Input stream
+ * @note   Used private
+ */
+typedef struct {
+    TM_IMAGE_ReadFunc_t ReadFunc; /*!< Read function */
+    void* Param;                  /*!< Parameter for read function */
+    uint32_t Pos;                 /*!< Position of next byte in buffer */
+    uint32_t Len;                 /*!< Number of valid bytes in buffer */
+    uint32_t BytesRead;           /*!< Number of all bytes read */
+    uint8_t End;                  /*!< Set to 1 when there is no more data */
+} TM_IMAGE_Input_t;
+
+/* Input buffer */
+static uint8_t ImageBuffer[TM_IMAGE_BUFFER_SIZE];
+
+#if TM_IMAGE_USE_FATFS
+static FIL ImageFile;
+#endif
+
+/* Gets next byte from input, buffer is refilled when empty */
+#define IMAGE_NEXT(In)      ((In)->Pos < (In)->Len ? ImageBuffer[(In)->Pos++] : TM_IMAGE_INT_Refill(In))
+
+/* Private functions */
+static uint8_t TM_IMAGE_INT_Refill(TM_IMAGE_Input_t* In);
+
+TM_IMAGE_Result_t
+TM_IMAGE_Decode(TM_IMAGE_ReadFunc_t ReadFunc, void* Param, uint16_t* Dst, uint32_t Pitch, uint16_t MaxWidth, uint16_t MaxHeight, TM_IMAGE_Info_t* Info) {
+    TM_IMAGE_Input_t In;
+    uint32_t Index[64];
+    uint16_t Index565[64];
+    uint8_t header[14];
+    uint8_t r, g, b, a, b1, b2, vg, i;
+    uint32_t width, height, remaining, x, run, n;
+    uint16_t color;
+
+    /* Prepare input */
+    In.ReadFunc = ReadFunc;
+    In.Param = Param;
+    In.Pos = 0;
+    In.Len = 0;
+    In.BytesRead = 0;
+    In.End = 0;
+
+    /* Read header */
+    for (i = 0; i < sizeof(header); i++) {
+        header[i] = IMAGE_NEXT(&In);
+    }
+    if (In.End) {
+        return TM_IMAGE_Result_Error;
+    }
+
+    /* Check magic */
+    if (header[0] != 'q' || header[1] != 'o' || header[2] != 'i' || header[3] != 'f') {
+        return TM_IMAGE_Result_Format;
+    }
+
+    /* Image size, big endian */
+    width = (uint32_t)header[4] << 24 | (uint32_t)header[5] << 16 | (uint32_t)header[6] << 8 | header[7];
+    height = (uint32_t)header[8] << 24 | (uint32_t)header[9] << 16 | (uint32_t)header[10] << 8 | header[11];
+
+    /* Save informations */
+    if (Info) {
+        Info->Width = width;
+        Info->Height = height;
+        Info->Channels = header[12];
+        Info->BytesRead = 0;
+    }
+
+    /* Check format */
+    if ((header[12] != 3 && header[12] != 4) || !width || !height) {
+        return TM_IMAGE_Result_Format;
+    }
+    if (width > MaxWidth || height > MaxHeight) {
+        return TM_IMAGE_Result_Size;
+    }
+
+    /* Initial state */
+    for (i = 0; i < 64; i++) {
+        Index[i] = 0;
+        Index565[i] = 0;
+    }
+    r = g = b = 0;
+    a = 255;
+    color = 0;
+    remaining = width * height;
+    x = 0;
+
+    while (remaining) {
+        b1 = IMAGE_NEXT(&In);
+        run = 1;
+
+        if ((b1 & QOI_MASK) == QOI_OP_INDEX) {
+            /* Color from index, index is not changed */
+            r = Index[b1];
+            g = Index[b1] >> 8;
+            b = Index[b1] >> 16;
+            a = Index[b1] >> 24;
+            color = Index565[b1];
+        } else if (b1 < QOI_OP_RGB && (b1 & QOI_MASK) == QOI_OP_RUN) {
+            /* Run of previous color, it is stored to index in case it was never stored before */
+            run = (b1 & 0x3F) + 1;
+            Index[QOI_HASH(r, g, b, a)] = (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24;
+            Index565[QOI_HASH(r, g, b, a)] = color;
+        } else {
+            if (b1 == QOI_OP_RGB) {
+                r = IMAGE_NEXT(&In);
+                g = IMAGE_NEXT(&In);
+                b = IMAGE_NEXT(&In);
+            } else if (b1 == QOI_OP_RGBA) {
+                r = IMAGE_NEXT(&In);
+                g = IMAGE_NEXT(&In);
+                b = IMAGE_NEXT(&In);
+                a = IMAGE_NEXT(&In);
+            } else if ((b1 & QOI_MASK) == QOI_OP_DIFF) {
+                r += ((b1 >> 4) & 0x03) - 2;
+                g += ((b1 >> 2) & 0x03) - 2;
+                b += (b1 & 0x03) - 2;
+            } else {
+                /* Luma difference */
+                b2 = IMAGE_NEXT(&In);
+                vg = (b1 & 0x3F) - 32;
+                r += vg - 8 + ((b2 >> 4) & 0x0F);
+                g += vg;
+                b += vg - 8 + (b2 & 0x0F);
+            }
+
+            /* New color is stored to index */
+            color = RGB565(r, g, b);
+            i = QOI_HASH(r, g, b, a);
+            Index[i] = (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24;
+            Index565[i] = color;
+        }
+
+        /* Check for end of data */
+        if (In.End) {
+            return TM_IMAGE_Result_Error;
+        }
+
+        /* Write pixels */
+        if (run > remaining) {
+            run = remaining;
+        }
+        remaining -= run;
+        if (run == 1) {
+            *Dst++ = color;
+            if (++x == width) {
+                x = 0;
+                Dst += Pitch - width;
+            }
+        } else {
+            while (run) {
+                /* Pixels till end of line */
+                n = width - x;
+                if (n > run) {
+                    n = run;
+                }
+                run -= n;
+                x += n;
+                while (n--) {
+                    *Dst++ = color;
+                }
+                if (x == width) {
+                    x = 0;
+                    Dst += Pitch - width;
+                }
+            }
+        }
+    }
+
+    /* Save number of bytes read */
+    if (Info) {
+        Info->BytesRead = In.BytesRead;
+    }
+
+    /* Return OK */
+    return TM_IMAGE_Result_Ok;
+}
+
+#if TM_IMAGE_USE_FATFS
+static uint32_t
+TM_IMAGE_INT_FileRead(void* Param, uint8_t* Buffer, uint32_t Count) {
+    UINT br;
+
+    /* Read from file */
+    if (f_read((FIL *)Param, Buffer, Count, &br) != FR_OK) {
+        return 0;
+    }
+    return br;
+}
+
+TM_IMAGE_Result_t
+TM_IMAGE_DecodeFile(const char* filename, uint16_t* Dst, uint32_t Pitch, uint16_t MaxWidth, uint16_t MaxHeight, TM_IMAGE_Info_t* Info) {
+    TM_IMAGE_Result_t result;
+
+    /* Open file */
+    if (f_open(&ImageFile, filename, FA_OPEN_EXISTING | FA_READ) != FR_OK) {
+        return TM_IMAGE_Result_Error;
+    }
+
+    /* Decode */
+    result = TM_IMAGE_Decode(TM_IMAGE_INT_FileRead, &ImageFile, Dst, Pitch, MaxWidth, MaxHeight, Info);
+
+    /* Close file */
+    f_close(&ImageFile);
+
+    /* Return result */
+    return result;
+}
+#endif
+
+/* Private functions */
+static uint8_t
+TM_IMAGE_INT_Refill(TM_IMAGE_Input_t* In) {
+    /* Read next chunk */
+    In->Len = In->ReadFunc(In->Param, ImageBuffer, TM_IMAGE_BUFFER_SIZE);
+    In->BytesRead += In->Len;
+    In->Pos = 0;
+
+    /* End of data */
+    if (!In->Len) {
+        In->End = 1;
+        return 0;
+    }
+
+    /* Return first byte */
+    In->Pos = 1;
+    return ImageBuffer[0];
+}
@@ -0,0 +1,223 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Streaming QOI image decoder to RGB565 framebuffer
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_IMAGE_H
+#define TM_IMAGE_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_IMAGE
+ * @brief    Streaming QOI image decoder to RGB565 framebuffer
+ * @{
+ *
+ * Full screen RGB565 image on STM32F429-Discovery has 150kB and reading it from SD card takes most of the time when screen changes.
+ * UI images compress very well with QOI (Quite OK Image) lossless format, usually 5 - 20 times.
+ *
+ * Library reads compressed file in small chunks to internal buffer and writes decoded pixels
+ * directly to RGB565 memory, so there is no need for big buffer in RAM.
+ * Memory can be LTDC framebuffer or any other memory (tile cache), which is later copied to LCD with DMA2D.
+ *
+ * \par Create images
+ *
+ * Use image_convert tool in host folder to convert PNG or PPM images to QOI.
+ * With -q option colors are first rounded to RGB565, so decoded image is exactly the same as raw RGB565 image
+ * and file is smaller:
+ *
+@verbatim
+./image_convert -q background.png background.qoi
+@endverbatim
+ *
+ * \par Decode from FatFs
+ *
+@verbatim
+//Draw image from SD card to layer 1 on STM32F429-Discovery
+TM_IMAGE_Info_t Info;
+if (TM_IMAGE_DecodeFile("SD:/background.qoi", (uint16_t *)0xD0000000, 240, 240, 320, &Info) == TM_IMAGE_Result_Ok) {
+    //Image drawn
+}
+@endverbatim
+ *
+ * \par Decode from other source
+ *
+ * Decoder reads data with read function, so data can come from any source, like USB or internal flash.
+ * See @ref TM_IMAGE_Decode function.
+ *
+ * \par Limitations
+ *
+ *  - Alpha channel from RGBA images is ignored, all pixels are drawn
+ *  - Image must fit to destination size, it is not clipped
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - FatFs, when TM_IMAGE_USE_FATFS is 1
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+
+/**
+ * @defgroup TM_IMAGE_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Size of input buffer in bytes
+ * @note   Use multiple of 512 bytes, so FatFs can read complete sectors directly to buffer
+ */
+#ifndef TM_IMAGE_BUFFER_SIZE
+#define TM_IMAGE_BUFFER_SIZE        1024
+#endif
+
+/**
+ * @brief  Enables @ref TM_IMAGE_DecodeFile function with FatFs
+ */
+#ifndef TM_IMAGE_USE_FATFS
+#define TM_IMAGE_USE_FATFS          1
+#endif
+
+#if TM_IMAGE_USE_FATFS
+#include "ff.h"
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_IMAGE_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Result enumeration
+ */
+typedef enum {
+    TM_IMAGE_Result_Ok = 0, /*!< Image decoded */
+    TM_IMAGE_Result_Error,  /*!< File can't be opened or data can't be read */
+    TM_IMAGE_Result_Format, /*!< Data is not valid QOI image */
+    TM_IMAGE_Result_Size    /*!< Image is bigger than destination */
+} TM_IMAGE_Result_t;
+
+/**
+ * @brief  Image informations
+ */
+typedef struct {
+    uint32_t Width;      /*!< Image width in pixels */
+    uint32_t Height;     /*!< Image height in pixels */
+    uint8_t Channels;    /*!< 3 for RGB, 4 for RGBA image */
+    uint32_t BytesRead;  /*!< Number of compressed bytes read */
+} TM_IMAGE_Info_t;
+
+/**
+ * @brief  Read function for compressed data
+ * @param  *Param: Parameter passed to @ref TM_IMAGE_Decode function
+ * @param  *Buffer: Buffer to store data
+ * @param  Count: Number of bytes to read
+ * @retval Number of bytes read, 0 on end of data or error
+ */
+typedef uint32_t (*TM_IMAGE_ReadFunc_t)(void* Param, uint8_t* Buffer, uint32_t Count);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_IMAGE_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Decodes QOI image to RGB565 memory
+ * @param  ReadFunc: Function to read compressed data
+ * @param  *Param: Parameter passed to read function, like file pointer
+ * @param  *Dst: Pointer to top left pixel of destination memory
+ * @param  Pitch: Number of pixels in one destination line
+ * @param  MaxWidth: Maximal image width
+ * @param  MaxHeight: Maximal image height
+ * @param  *Info: Pointer to @ref TM_IMAGE_Info_t structure to store image informations. Can be NULL
+ * @retval Member of @ref TM_IMAGE_Result_t
+ */
+TM_IMAGE_Result_t TM_IMAGE_Decode(TM_IMAGE_ReadFunc_t ReadFunc, void* Param, uint16_t* Dst, uint32_t Pitch, uint16_t MaxWidth, uint16_t MaxHeight, TM_IMAGE_Info_t* Info);
+
+#if TM_IMAGE_USE_FATFS || defined(__DOXYGEN__)
+/**
+ * @brief  Decodes QOI image from file to RGB565 memory
+ * @note   Available only when TM_IMAGE_USE_FATFS is 1. Filesystem must be mounted before
+ * @param  *filename: File name, like "SD:/image.qoi"
+ * @param  *Dst: Pointer to top left pixel of destination memory
+ * @param  Pitch: Number of pixels in one destination line
+ * @param  MaxWidth: Maximal image width
+ * @param  MaxHeight: Maximal image height
+ * @param  *Info: Pointer to @ref TM_IMAGE_Info_t structure to store image informations. Can be NULL
+ * @retval Member of @ref TM_IMAGE_Result_t
+ */
+TM_IMAGE_Result_t TM_IMAGE_DecodeFile(const char* filename, uint16_t* Dst, uint32_t Pitch, uint16_t MaxWidth, uint16_t MaxHeight, TM_IMAGE_Info_t* Info);
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
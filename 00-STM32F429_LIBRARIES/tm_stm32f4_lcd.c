@@ -23,6 +23,7 @@ static void TM_LCD_INT_InitLTDC(void);
 static void TM_LCD_INT_InitLayers(void);
 static void TM_LCD_INT_InitLCD(void);
 static void TM_LCD_INT_InitPins(void);
+static TM_LCD_Result_t TM_LCD_INT_Putc(char c);
 
 /* Private structure */
 typedef struct _TM_LCD_INT_t {
@@ -33,6 +34,7 @@ typedef struct _TM_LCD_INT_t {
     uint32_t FrameOffset;
     uint8_t CurrentLayer;
     TM_FontDef_t* CurrentFont;
+    TM_FONTS_Atlas_t* CurrentAtlas;
     uint32_t ForegroundColor;
     uint32_t BackgroundColor;
     uint16_t CurrentX;
@@ -146,6 +148,15 @@ TM_LCD_SetFont(TM_FontDef_t* Font) {
     return TM_LCD_Result_Ok;
 }
 
+TM_LCD_Result_t
+TM_LCD_SetFontAtlas(TM_FONTS_Atlas_t* Atlas) {
+    /* Set atlas, used when atlas font matches current font */
+    LCD.CurrentAtlas = Atlas;
+
+    /* Return OK */
+    return TM_LCD_Result_Ok;
+}
+
 TM_LCD_Result_t
 TM_LCD_SetColors(uint32_t Foreground, uint32_t Background) {
     /* Set new colors */
@@ -158,19 +169,53 @@ TM_LCD_SetColors(uint32_t Foreground, uint32_t Background) {
 
 TM_LCD_Result_t
 TM_LCD_Putc(char c) {
+    TM_LCD_Result_t result;
+
+    /* Put character */
+    result = TM_LCD_INT_Putc(c);
+
+    /* Wait if DMA2D was used */
+    DMA2D_WAIT;
+
+    /* Return result */
+    return result;
+}
+
+static TM_LCD_Result_t
+TM_LCD_INT_Putc(char c) {
     uint32_t i, b, j;
 
     /* Check current coordinates */
     if ((LCD.CurrentX + LCD.CurrentFont->FontWidth) >= LCD.Width) {
         /* If at the end of a line of display, go to new line and set x to 0 position */
         LCD.CurrentY += LCD.CurrentFont->FontHeight;
-        LCD.CurrentY = 0;
+        LCD.CurrentX = 0;
+    }
 
-        /* Check for Y position */
-        if (LCD.CurrentY >= LCD.Height) {
-            /* Return error */
-            return TM_LCD_Result_Error;
-        }
+    /* Check for Y position */
+    if ((LCD.CurrentY + LCD.CurrentFont->FontHeight) > LCD.Height) {
+        /* Return error */
+        return TM_LCD_Result_Error;
+    }
+
+    /* Draw character with single DMA2D transfer if atlas is available for current font */
+    if (LCD.CurrentAtlas != NULL && LCD.CurrentAtlas->Font == LCD.CurrentFont) {
+        TM_DMA2DGRAPHIC_BlendA8IT(
+            TM_FONTS_GetAtlasChar(LCD.CurrentAtlas, c),
+            (void *)(LCD.CurrentFrameBuffer + 2 * ((LCD.CurrentY * LCD.Width) + LCD.CurrentX)),
+            LCD.CurrentFont->FontWidth,
+            LCD.CurrentFont->FontHeight,
+            0,
+            LCD.Width - LCD.CurrentFont->FontWidth,
+            LCD.ForegroundColor,
+            LCD.BackgroundColor
+        );
+
+        /* Go to new X location */
+        TM_LCD_SetXY(LCD.CurrentX + LCD.CurrentFont->FontWidth, LCD.CurrentY);
+
+        /* Return OK */
+        return TM_LCD_Result_Ok;
     }
 
     /* Draw all pixels */
@@ -211,8 +256,11 @@ TM_LCD_Result_t
 TM_LCD_Puts(char* str) {
     /* Send till string ends or error returned */
     while (*str) {
-        /* Check if string OK */
-        if (TM_LCD_Putc(*str) != TM_LCD_Result_Ok) {
+        /* Check if string OK, DMA2D can still draw previous character */
+        if (TM_LCD_INT_Putc(*str) != TM_LCD_Result_Ok) {
+            /* Wait DMA2D */
+            DMA2D_WAIT;
+
             /* Return error */
             return TM_LCD_Result_Error;
         }
@@ -221,6 +269,9 @@ TM_LCD_Puts(char* str) {
         str++;
     }
 
+    /* Wait till last character is drawn */
+    DMA2D_WAIT;
+
     /* Return OK */
     return TM_LCD_Result_Ok;
 }
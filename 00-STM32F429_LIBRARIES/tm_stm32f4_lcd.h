@@ -135,6 +135,7 @@ uint32_t TM_LCD_GetFrameBuffer(void);
 
 TM_LCD_Result_t TM_LCD_SetXY(uint16_t X, uint16_t Y);
 TM_LCD_Result_t TM_LCD_SetFont(TM_FontDef_t* Font);
+TM_LCD_Result_t TM_LCD_SetFontAtlas(TM_FONTS_Atlas_t* Atlas);
 TM_LCD_Result_t TM_LCD_SetColors(uint32_t Foreground, uint32_t Background);
 TM_LCD_Result_t TM_LCD_Putc(char c);
 TM_LCD_Result_t TM_LCD_Puts(char* str);
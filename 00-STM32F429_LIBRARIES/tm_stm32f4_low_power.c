@@ -37,6 +37,25 @@ TM_LOWPOWER_SleepUntilInterrupt(uint8_t delay_timer) {
     }
 }
 
+void
+TM_LOWPOWER_SleepTickless(uint32_t MaxTime) {
+    /* Wakeup interrupt is executed after time is updated */
+    __disable_irq();
+
+    /* Skip delay ticks */
+    TM_DELAY_TicklessEnter(MaxTime);
+
+    /* Wait for interrupt */
+    __DSB();
+    __WFI();
+
+    /* Add time spent in sleep */
+    TM_DELAY_TicklessExit();
+
+    /* Execute interrupt which woke MCU up */
+    __enable_irq();
+}
+
 void
 TM_LOWPOWER_SleepUntilEvent(void) {
     /* We don't need delay timer disable, because delay timer does not make an event */
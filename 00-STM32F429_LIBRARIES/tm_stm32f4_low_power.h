@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/10/library-39-power-consumption-modes-for-stm32f4
- * @version v1.2
+ * @version v1.3
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   STM32F4xx low power modes library
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_LOWPOWER_H
-#define TM_LOWPOWER_H 120
+#define TM_LOWPOWER_H 130
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -53,7 +53,8 @@ extern "C" {
  * - Peripherals kept running
  * - How to enter this mode?
  *    - Use TM_LOWPOWER_SleepUntilInterrupt() or
- *    - Use TM_LOWPOWER_SleepUntilEvent();
+ *    - Use TM_LOWPOWER_SleepUntilEvent() or
+ *    - Use TM_LOWPOWER_SleepTickless() to skip delay ticks till next custom timer expires
  * - How to exit this mode?
  *    - Any peripheral interrupt acknowledged by the nested vectored interrupt controller (NVIC)
  *
@@ -88,6 +89,10 @@ extern "C" {
  * \par Changelog
  *
 @verbatim
+ Version 1.3
+  - October 16, 2026
+  - Added TM_LOWPOWER_SleepTickless() for sleep without 1ms delay interrupts
+
  Version 1.2
   - March 23, 2015
   - Fixed problems with entering to standby mode
@@ -138,7 +143,8 @@ typedef enum {
     TM_LOWPOWERMODE_SleepUntilEvent,            /*!< Sleep mode until any event occurs */
     TM_LOWPOWERMODE_StopUntilInterrupt,         /*!< Stop mode until interrupt in EXTI line occurs */
     TM_LOWPOWERMODE_StopUntilEvent,             /*!< Stop mode until event occurs */
-    TM_LOWPOWERMODE_Standby                     /*!< Standby mode until any interrupt occurs */
+    TM_LOWPOWERMODE_Standby,                    /*!< Standby mode until any interrupt occurs */
+    TM_LOWPOWERMODE_SleepTickless               /*!< Sleep mode until any interrupt occurs, delay ticks are skipped till next custom timer expires */
 } TM_LOWPOWERMODE_t;
 
 /**
@@ -166,6 +172,15 @@ typedef enum {
  */
 void TM_LOWPOWER_SleepUntilInterrupt(uint8_t delay_timer);
 
+/**
+ * @brief  Put device into sleep mode without 1ms delay interrupts
+ * @note   Delay timer wakes MCU only when next custom timer from TM DELAY expires or when MaxTime passes.
+ *         Any other interrupt wakes it up too. TM_Time is updated with time spent in sleep
+ * @param  MaxTime: Maximal sleep time in milliseconds
+ * @retval None
+ */
+void TM_LOWPOWER_SleepTickless(uint32_t MaxTime);
+
 /**
  * @brief  Put device into sleep mode
  * @note   MCU will be in sleep mode until next event occured
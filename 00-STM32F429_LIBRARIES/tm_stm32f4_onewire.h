@@ -95,7 +95,7 @@ extern "C" {
  * @{
  */
 
-/* OneWire delay */
+/* OneWire delay, slots have fixed timings and nothing waits for the line, so no deadline is needed */
 #define ONEWIRE_DELAY(x)                Delay(x)
 
 /* Pin settings */
@@ -19,10 +19,22 @@
 #include "tm_stm32f4_pcd8544.h"
 
 unsigned char PCD8544_Buffer[PCD8544_BUFFER_SIZE];
-unsigned char PCD8544_UpdateXmin = 0, PCD8544_UpdateXmax = 0, PCD8544_UpdateYmin = 0, PCD8544_UpdateYmax = 0;
 unsigned char PCD8544_x;
 unsigned char PCD8544_y;
 
+//Changed columns of each 8 pixels high bank, bank is not changed when Xmin > Xmax
+static unsigned char PCD8544_UpdateXmin[PCD8544_BANKS], PCD8544_UpdateXmax[PCD8544_BANKS];
+
+//Set to 1 when DMA transfer is in progress and CE is low
+static volatile unsigned char PCD8544_DMAWorking;
+
+//Waits for DMA burst to finish and releases CE
+static void PCD8544_WaitDMA(void);
+
+//Span function for scanline fill engine
+static void PCD8544_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color);
+static TM_SCANLINE_t PCD8544_Scanline = {PCD8544_Span, PCD8544_WIDTH, PCD8544_HEIGHT};
+
 //Fonts 5x7
 const uint8_t PCD8544_Font5x7 [97][PCD8544_CHAR5x7_WIDTH] = {
     { 0x00, 0x00, 0x00, 0x00, 0x00 },   // sp
@@ -256,10 +268,16 @@ PCD8544_InitIO(void) {
 
     //Initialize SPI
     TM_SPI_Init(PCD8544_SPI, PCD8544_SPI_PINSPACK);
+
+    //Initialize SPI DMA for data bursts
+    TM_SPI_DMA_Init(PCD8544_SPI);
 }
 
 void
 PCD8544_send(unsigned char data) {
+    //Previous burst must be finished
+    PCD8544_WaitDMA();
+
     PCD8544_CE_LOW;
     TM_SPI_Send(PCD8544_SPI, data);
     PCD8544_CE_HIGH;
@@ -290,14 +308,23 @@ PCD8544_Pin(PCD8544_Pin_t pin, PCD8544_State_t state) {
 
 void
 PCD8544_Delay(unsigned long micros) {
-    volatile unsigned long i;
-    for (i = 0; i < micros; i++) {
-
-    }
+    //Microsecond delay from TM DELAY library
+    Delay(micros);
 }
 
 void
 PCD8544_Init(unsigned char contrast) {
+    unsigned char i;
+
+    //Initialize delay
+    TM_DELAY_Init();
+
+    //Nothing to update yet
+    for (i = 0; i < PCD8544_BANKS; i++) {
+        PCD8544_UpdateXmin[i] = PCD8544_WIDTH - 1;
+        PCD8544_UpdateXmax[i] = 0;
+    }
+
     //Initialize IO's
     PCD8544_InitIO();
     //Reset
@@ -335,6 +362,9 @@ PCD8544_Init(unsigned char contrast) {
 
 void
 PCD8544_Write(PCD8544_WriteType_t cd, unsigned char data) {
+    //DC pin must not change while burst is sent
+    PCD8544_WaitDMA();
+
     switch (cd) {
         //Send data to lcd's ram
         case PCD8544_DATA:
@@ -415,45 +445,93 @@ PCD8544_Home(void) {
 
 void
 PCD8544_Refresh(void) {
-    unsigned char i, j;
-    for (i = 0; i < 6; i++) {
-        //Not in range yet
-        if (PCD8544_UpdateYmin > ((i + 1) * 8)) {
+    unsigned char i, last, xmin, xmax;
+
+    for (i = 0; i < PCD8544_BANKS; i++) {
+        //Bank not changed
+        if (PCD8544_UpdateXmin[i] > PCD8544_UpdateXmax[i]) {
             continue;
         }
-        //Over range, stop
-        if ((i * 8) > PCD8544_UpdateYmax) {
-            break;
+        xmin = PCD8544_UpdateXmin[i];
+        xmax = PCD8544_UpdateXmax[i];
+
+        //LCD address wraps to next bank, so full width banks are sent in one burst
+        last = i;
+        if (xmin == 0 && xmax == PCD8544_WIDTH - 1) {
+            while (
+                (last + 1) < PCD8544_BANKS &&
+                PCD8544_UpdateXmin[last + 1] == 0 &&
+                PCD8544_UpdateXmax[last + 1] == PCD8544_WIDTH - 1
+            ) {
+                last++;
+            }
         }
 
-        PCD8544_Write(PCD8544_COMMAND, PCD8544_SETYADDR | i);
-        PCD8544_Write(PCD8544_COMMAND, PCD8544_SETXADDR | PCD8544_UpdateXmin);
+        //Wait for previous burst and keep CE low for complete bank
+        PCD8544_WaitDMA();
+        PCD8544_CE_LOW;
 
-        for (j = PCD8544_UpdateXmin; j <= PCD8544_UpdateXmax; j++) {
-            PCD8544_Write(PCD8544_DATA, PCD8544_Buffer[(i * PCD8544_WIDTH) + j]);
+        //Set address with DC low
+        PCD8544_Pin(PCD8544_Pin_DC, PCD8544_State_Low);
+        TM_SPI_Send(PCD8544_SPI, PCD8544_SETYADDR | i);
+        TM_SPI_Send(PCD8544_SPI, PCD8544_SETXADDR | xmin);
+
+        //Send data with DMA, CE is released when next transfer starts
+        PCD8544_Pin(PCD8544_Pin_DC, PCD8544_State_High);
+        if (TM_SPI_DMA_Transmit(PCD8544_SPI, &PCD8544_Buffer[(i * PCD8544_WIDTH) + xmin], NULL, (last - i) * PCD8544_WIDTH + xmax - xmin + 1)) {
+            PCD8544_DMAWorking = 1;
+        } else {
+            //DMA did not start, send data without DMA and release CE
+            TM_SPI_WriteMulti(PCD8544_SPI, &PCD8544_Buffer[(i * PCD8544_WIDTH) + xmin], (last - i) * PCD8544_WIDTH + xmax - xmin + 1);
+            PCD8544_CE_HIGH;
         }
-    }
 
-    PCD8544_UpdateXmin = PCD8544_WIDTH - 1;
-    PCD8544_UpdateXmax = 0;
-    PCD8544_UpdateYmin = PCD8544_HEIGHT - 1;
-    PCD8544_UpdateYmax = 0;
+        //Banks are up to date
+        for (; i <= last; i++) {
+            PCD8544_UpdateXmin[i] = PCD8544_WIDTH - 1;
+            PCD8544_UpdateXmax[i] = 0;
+        }
+        i--;
+    }
 }
 
 void
 PCD8544_UpdateArea(unsigned char xMin, unsigned char yMin, unsigned char xMax, unsigned char yMax) {
-    if (xMin < PCD8544_UpdateXmin) {
-        PCD8544_UpdateXmin = xMin;
+    unsigned char i;
+
+    //Check limits
+    if (xMax >= PCD8544_WIDTH) {
+        xMax = PCD8544_WIDTH - 1;
     }
-    if (xMax > PCD8544_UpdateXmax) {
-        PCD8544_UpdateXmax = xMax;
+    if (yMax >= PCD8544_HEIGHT) {
+        yMax = PCD8544_HEIGHT - 1;
     }
-    if (yMin < PCD8544_UpdateYmin) {
-        PCD8544_UpdateYmin = yMin;
+
+    //Extend column range of all banks in area
+    for (i = yMin / 8; i <= yMax / 8; i++) {
+        if (xMin < PCD8544_UpdateXmin[i]) {
+            PCD8544_UpdateXmin[i] = xMin;
+        }
+        if (xMax > PCD8544_UpdateXmax[i]) {
+            PCD8544_UpdateXmax[i] = xMax;
+        }
     }
-    if (yMax > PCD8544_UpdateYmax) {
-        PCD8544_UpdateYmax = yMax;
+}
+
+uint8_t
+PCD8544_RefreshWorking(void) {
+    //Release CE when burst is finished
+    if (PCD8544_DMAWorking && !TM_SPI_DMA_Working(PCD8544_SPI)) {
+        PCD8544_CE_HIGH;
+        PCD8544_DMAWorking = 0;
     }
+    return PCD8544_DMAWorking;
+}
+
+static void
+PCD8544_WaitDMA(void) {
+    //Wait for last burst
+    while (PCD8544_RefreshWorking());
 }
 
 void
@@ -623,32 +701,30 @@ PCD8544_DrawCircle(char x0, char y0, char r, PCD8544_Pixel_t color) {
 
 void
 PCD8544_DrawFilledCircle(char x0, char y0, char r, PCD8544_Pixel_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
-
-    PCD8544_DrawPixel(x0, y0 + r, color);
-    PCD8544_DrawPixel(x0, y0 - r, color);
-    PCD8544_DrawPixel(x0 + r, y0, color);
-    PCD8544_DrawPixel(x0 - r, y0, color);
-    PCD8544_DrawLine(x0 - r, y0, x0 + r, y0, color);
+    //Fill with scanline engine
+    TM_SCANLINE_FillCircle(&PCD8544_Scanline, x0, y0, r, color);
+}
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
+TM_SCANLINE_t*
+PCD8544_GetScanline(void) {
+    return &PCD8544_Scanline;
+}
 
-        PCD8544_DrawLine(x0 - x, y0 + y, x0 + x, y0 + y, color);
-        PCD8544_DrawLine(x0 + x, y0 - y, x0 - x, y0 - y, color);
+static void
+PCD8544_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color) {
+    unsigned char* ptr = &PCD8544_Buffer[x0 + (y / 8) * PCD8544_WIDTH];
+    unsigned char mask = 1 << (y % 8);
+    int16_t x;
 
-        PCD8544_DrawLine(x0 + y, y0 + x, x0 - y, y0 + x, color);
-        PCD8544_DrawLine(x0 + y, y0 - x, x0 - y, y0 - x, color);
+    //Set the same bit in all columns of span
+    if (color != PCD8544_Pixel_Clear) {
+        for (x = x0; x <= x1; x++) {
+            *ptr++ |= mask;
+        }
+    } else {
+        for (x = x0; x <= x1; x++) {
+            *ptr++ &= ~mask;
+        }
     }
+    PCD8544_UpdateArea(x0, y, x1, y);
 }
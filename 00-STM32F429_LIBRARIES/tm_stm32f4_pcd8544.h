@@ -6,7 +6,7 @@
  *  @email      tilen@majerle.eu
  *  @website    http://stm32f4-discovery.net
  *  @link       http://stm32f4-discovery.net/pcd8544-nokia-33105110-lcd-stm32f429-discovery-library/
- *  @version    v1.0
+ *  @version    v1.2
  *  @ide        Keil uVision
  *  @license    GNU GPL v3
  *
@@ -63,15 +63,34 @@
  *  #define PCD8544_CE_PORT         GPIOC
  *  #define PCD8544_CE_PIN          GPIO_Pin_13
  *
+ * Partial refresh
+ *
+ * Drawing functions mark changed columns of each 8 pixels high bank.
+ * PCD8544_Refresh sends only changed columns, each changed bank with one DMA burst with CE low.
+ * Neighbour banks which are changed in full width are sent together in one burst.
+ * PCD8544_Refresh returns when last burst is started, CE is released when next SPI transfer starts
+ * or when PCD8544_RefreshWorking is called. There is no DMA interrupt, so CE stays low until then.
+ * You must wait with "while (PCD8544_RefreshWorking());" before you use the same SPI for other devices.
+ * When DMA transfer can't be started, bank is sent without DMA and CE is released at once.
+ *
+ * Version 1.2
+ *  - October 16, 2026
+ *  - Changed banks are sent with SPI DMA, one burst per bank
+ *  - PCD8544_Delay uses TM DELAY microsecond delay
+ *  - Added PCD8544_RefreshWorking function
+ *
  */
 #ifndef PCD8544_H
-#define PCD8544_H 100
+#define PCD8544_H 120
 /**
  * Library dependencies
  * - STM32F4xx
  * - STM32F4xx RCC
  * - STM32F4xx GPIO
  * - TM_SPI
+ * - TM_SPI_DMA
+ * - TM_DELAY
+ * - TM_SCANLINE
  */
 /**
  * Includes
@@ -81,6 +100,9 @@
 #include "stm32f4xx_gpio.h"
 #include "stm32f4xx_rcc.h"
 #include "tm_stm32f4_spi.h"
+#include "tm_stm32f4_spi_dma.h"
+#include "tm_stm32f4_delay.h"
+#include "tm_stm32f4_scanline.h"
 
 //SPI used
 #ifndef PCD8544_SPI
@@ -192,6 +214,7 @@ typedef enum {
 #define PCD8544_CHAR3x5_HEIGHT      6
 
 #define PCD8544_BUFFER_SIZE         PCD8544_WIDTH * PCD8544_HEIGHT / 8
+#define PCD8544_BANKS               (PCD8544_HEIGHT / 8)
 
 
 /**
@@ -230,6 +253,14 @@ extern void PCD8544_Write(PCD8544_WriteType_t cd, unsigned char data);
  */
 extern void PCD8544_UpdateArea(unsigned char xMin, unsigned char yMin, unsigned char xMax, unsigned char yMax);
 
+/**
+ * Check if DMA burst from refresh is still in progress
+ * CE pin is released when burst is finished, so call it until it returns 0 before other SPI devices are used
+ *
+ * Returns 0 when SPI is free, > 0 when burst is in progress
+ */
+extern uint8_t PCD8544_RefreshWorking(void);
+
 /**
  * Initialize LCD
  *
@@ -390,4 +421,14 @@ extern void PCD8544_DrawCircle(char x0, char y0, char r, PCD8544_Pixel_t color);
  */
 extern void PCD8544_DrawFilledCircle(char x0, char y0, char r, PCD8544_Pixel_t color);
 
+/**
+ * Get device structure for TM_SCANLINE engine
+ *
+ * Use it to draw other filled shapes (triangles, polygons, ellipses, arcs)
+ * Call PCD8544_Refresh() after drawing to see changes on LCD
+ *
+ * Returns pointer to TM_SCANLINE_t device structure
+ */
+extern TM_SCANLINE_t* PCD8544_GetScanline(void);
+
 #endif
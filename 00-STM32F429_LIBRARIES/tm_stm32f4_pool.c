@@ -0,0 +1,90 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_pool.h"
+
+/* Interrupts are disabled while list is changed */
+#if TM_POOL_IRQ_SAFE
+#define POOL_LOCK()             irq = __get_PRIMASK(); __disable_irq()
+#define POOL_UNLOCK()           if (!irq) { __enable_irq(); }
+#else
+#define POOL_LOCK()             irq = 0
+#define POOL_UNLOCK()           (void)irq
+#endif
+
+void
+TM_POOL_Init(TM_POOL_t* Pool, void* Memory, uint32_t Size, uint32_t Count) {
+    /* Fill settings, all objects are unused. Rounded size can hold pointer to next free object */
+    Pool->Memory = (uint8_t *)Memory;
+    Pool->Size = TM_POOL_OBJECT_SIZE(Size);
+    Pool->Count = Count;
+    Pool->FreeList = NULL;
+    Pool->Unused = Count;
+    Pool->Used = 0;
+    Pool->Peak = 0;
+    Pool->Failed = 0;
+}
+
+void*
+TM_POOL_Alloc(TM_POOL_t* Pool) {
+    void* ptr;
+    uint32_t irq;
+
+    POOL_LOCK();
+    if (Pool->FreeList != NULL) {
+        /* Take first freed object, next pointer is saved in it */
+        ptr = Pool->FreeList;
+        Pool->FreeList = *(void **)ptr;
+    } else if (Pool->Unused) {
+        /* Take next object which was never used */
+        ptr = Pool->Memory + (Pool->Count - Pool->Unused) * Pool->Size;
+        Pool->Unused--;
+    } else {
+        /* Pool is empty */
+        Pool->Failed++;
+        POOL_UNLOCK();
+        return NULL;
+    }
+
+    /* Update counters */
+    Pool->Used++;
+    if (Pool->Used > Pool->Peak) {
+        Pool->Peak = Pool->Used;
+    }
+    POOL_UNLOCK();
+
+    /* Return object */
+    return ptr;
+}
+
+void
+TM_POOL_Free(TM_POOL_t* Pool, void* Ptr) {
+    uint32_t irq;
+
+    /* Check pointer */
+    if (Ptr == NULL || !TM_POOL_Contains(Pool, Ptr)) {
+        return;
+    }
+
+    /* Add object to start of free list */
+    POOL_LOCK();
+    *(void **)Ptr = Pool->FreeList;
+    Pool->FreeList = Ptr;
+    Pool->Used--;
+    POOL_UNLOCK();
+}
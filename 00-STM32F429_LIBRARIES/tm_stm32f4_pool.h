@@ -0,0 +1,260 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Fixed size object pools with constant time allocation and usage counters
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_POOL_H
+#define TM_POOL_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_POOL
+ * @brief    Fixed size object pools with constant time allocation and usage counters
+ * @{
+ *
+ * Many libraries allocate small structures of the same size with malloc, like buttons.
+ * On device which runs for months, heap gets fragmented and time of malloc is not known.
+ *
+ * Pool is static array of objects of the same type. Memory is reserved at compile time,
+ * so linker tells you if there is not enough RAM, and allocation and free take constant time.
+ *
+ * \par Usage
+ *
+\code{.c}
+typedef struct {
+    uint16_t Value;
+    uint32_t Time;
+} Sample_t;
+
+//Pool of 16 samples
+TM_POOL_DEFINE(SamplePool, Sample_t, 16);
+
+Sample_t* s = TM_POOL_New(&SamplePool, Sample_t);
+if (s) {
+    s->Value = 5;
+    TM_POOL_Free(&SamplePool, s);
+}
+\endcode
+ *
+ * Pool can also be created at run time with @ref TM_POOL_Init over any memory, like CCM or SDRAM.
+ *
+ * \par How it works
+ *
+ * Free objects are linked in list, pointer to next free object is saved inside free object.
+ * Objects which were never used are taken from the end of memory, so pool does not need init loop.
+ * Both operations only change a few pointers.
+ *
+ * \par Statistics
+ *
+ * Pool structure has number of used objects, peak usage and number of failed allocations.
+ * Use peak after long test to set pool size.
+ *
+ * \par Libraries
+ *
+ * Some libraries can use pools instead of malloc, set these in defines.h:
+ *
+ *  - TM BUTTON: TM_BUTTON_USE_POOL, pool size is BUTTON_MAX_BUTTONS
+ *
+ * TM DELAY software timers and files in lwIP fs.c already use static arrays. TM STRING keeps all strings in one arena.
+ *
+ * \par Interrupts
+ *
+ * Functions disable interrupts for the time of list update, so they can be used from interrupts too.
+ * Set TM_POOL_IRQ_SAFE to 0 in defines.h if pools are used only from main loop.
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - stddef.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "stddef.h"
+
+/**
+ * @defgroup TM_POOL_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Disable interrupts while pool is changed, enabled by default
+ */
+#ifndef TM_POOL_IRQ_SAFE
+#define TM_POOL_IRQ_SAFE        1
+#endif
+
+/**
+ * @brief  Alignment of objects in bytes
+ */
+#define TM_POOL_ALIGN           8
+
+/**
+ * @brief  Size of one object in pool, rounded up to TM_POOL_ALIGN
+ * @param  size: Object size in bytes
+ */
+#define TM_POOL_OBJECT_SIZE(size)           (((size) + TM_POOL_ALIGN - 1) & ~(TM_POOL_ALIGN - 1))
+
+/**
+ * @brief  Creates static pool and memory for objects
+ * @note   Pool and memory are static variables, visible only in file where they are created
+ * @param  name: Pool variable name, use &name in functions
+ * @param  type: Object type
+ * @param  count: Number of objects
+ */
+#define TM_POOL_DEFINE(name, type, count)   TM_POOL_DEFINE_SIZE(name, sizeof(type), count)
+
+/**
+ * @brief  Creates static pool for objects of selected size in bytes
+ * @param  name: Pool variable name, use &name in functions
+ * @param  size: Object size in bytes
+ * @param  count: Number of objects
+ */
+#define TM_POOL_DEFINE_SIZE(name, size, count)                                                      \
+    static uint64_t name##_Memory[(count) * TM_POOL_OBJECT_SIZE(size) / sizeof(uint64_t)];          \
+    static TM_POOL_t name = {(uint8_t *)name##_Memory, TM_POOL_OBJECT_SIZE(size), (count), NULL, (count), 0, 0, 0}
+
+/**
+ * @brief  Allocates object and casts pointer to type
+ * @param  *Pool: Pointer to @ref TM_POOL_t structure
+ * @param  type: Object type
+ */
+#define TM_POOL_New(Pool, type)             ((type *)TM_POOL_Alloc(Pool))
+
+/**
+ * @brief  Checks if pointer belongs to pool
+ * @param  *Pool: Pointer to @ref TM_POOL_t structure
+ * @param  *Ptr: Pointer to check
+ * @retval 1 if pointer is inside pool memory, 0 otherwise
+ */
+#define TM_POOL_Contains(Pool, Ptr)         ((uint8_t *)(Ptr) >= (Pool)->Memory && (uint8_t *)(Ptr) < (Pool)->Memory + (Pool)->Count * (Pool)->Size)
+
+/**
+ * @brief  Gets number of free objects
+ * @param  *Pool: Pointer to @ref TM_POOL_t structure
+ */
+#define TM_POOL_GetFree(Pool)               ((Pool)->Count - (Pool)->Used)
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_POOL_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Pool structure
+ */
+typedef struct {
+    uint8_t* Memory;    /*!< Memory for objects */
+    uint32_t Size;      /*!< Size of one object in bytes */
+    uint32_t Count;     /*!< Number of objects */
+    void* FreeList;     /*!< First object in list of freed objects. Used private */
+    uint32_t Unused;    /*!< Number of objects at the end of memory which were never used. Used private */
+    uint32_t Used;      /*!< Number of allocated objects */
+    uint32_t Peak;      /*!< Maximal number of allocated objects at the same time */
+    uint32_t Failed;    /*!< Number of allocations when pool was empty */
+} TM_POOL_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_POOL_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes pool over memory at run time
+ * @note   Pools made with @ref TM_POOL_DEFINE don't need this function
+ * @param  *Pool: Pointer to @ref TM_POOL_t structure
+ * @param  *Memory: Memory for objects, aligned to TM_POOL_ALIGN bytes
+ * @param  Size: Size of one object in bytes, it is rounded up to TM_POOL_ALIGN
+ * @param  Count: Number of objects. Memory must have at least Count * TM_POOL_OBJECT_SIZE(Size) bytes
+ * @retval None
+ */
+void TM_POOL_Init(TM_POOL_t* Pool, void* Memory, uint32_t Size, uint32_t Count);
+
+/**
+ * @brief  Allocates one object from pool
+ * @param  *Pool: Pointer to @ref TM_POOL_t structure
+ * @retval Pointer to object or NULL when pool is empty
+ */
+void* TM_POOL_Alloc(TM_POOL_t* Pool);
+
+/**
+ * @brief  Returns object to pool
+ * @note   NULL and pointers which are not from this pool are ignored
+ * @param  *Pool: Pointer to @ref TM_POOL_t structure
+ * @param  *Ptr: Pointer to object from @ref TM_POOL_Alloc
+ * @retval None
+ */
+void TM_POOL_Free(TM_POOL_t* Pool, void* Ptr);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_profile.h"
+
+/* If profiler is enabled */
+#if TM_PROFILE_ENABLED == 1
+
+/* Largest record: header, statistics payload and checksum */
+#define PROFILE_RECORD_MAX      (4 + 20 + 4 * TM_PROFILE_BUCKETS + 1)
+
+/* Zone statistics, updated on each zone end, in CCM RAM */
+TM_PROFILE_Zone_t TM_PROFILE_Zones[TM_PROFILE_ZONES] TM_CCM_BSS;
+
+/* Cycles between 2 counter reads, subtracted from each call */
+uint32_t TM_PROFILE_Overhead TM_CCM_BSS;
+
+/* Cycle counter at last reset */
+static uint32_t ResetTime TM_CCM_BSS;
+
+/* Private functions */
+static void TM_PROFILE_INT_Clear(TM_PROFILE_Zone_t* Zone);
+static void TM_PROFILE_INT_Record(TM_PROFILE_Output_t Output, uint8_t* Record, uint8_t Type, uint8_t Id, uint8_t Length);
+static uint8_t* TM_PROFILE_INT_Put32(uint8_t* Data, uint32_t Value);
+
+void
+TM_PROFILE_Init(void) {
+    uint32_t start, cycles;
+    uint8_t i;
+
+    /* Enable DWT cycle counter, running counter is not reset */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* Measure empty zone, take minimal value */
+    TM_PROFILE_Overhead = 0xFFFFFFFF;
+    for (i = 0; i < 8; i++) {
+        start = DWT->CYCCNT;
+        cycles = DWT->CYCCNT - start;
+        if (cycles < TM_PROFILE_Overhead) {
+            TM_PROFILE_Overhead = cycles;
+        }
+    }
+
+    /* Clear statistics and names */
+    for (i = 0; i < TM_PROFILE_ZONES; i++) {
+        TM_PROFILE_Zones[i].Name = NULL;
+    }
+    TM_PROFILE_Reset();
+}
+
+void
+TM_PROFILE_ZoneName(uint8_t Id, const char* Name) {
+    /* Check ID */
+    if (Id >= TM_PROFILE_ZONES) {
+        return;
+    }
+
+    /* Save name */
+    TM_PROFILE_Zones[Id].Name = Name;
+}
+
+void
+TM_PROFILE_Reset(void) {
+    uint32_t irq;
+    uint8_t i;
+
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+    __disable_irq();
+
+    /* Clear all zones */
+    for (i = 0; i < TM_PROFILE_ZONES; i++) {
+        TM_PROFILE_INT_Clear(&TM_PROFILE_Zones[i]);
+    }
+
+    /* Start new period */
+    ResetTime = DWT->CYCCNT;
+
+    /* Enable IRQ if necessary */
+    if (!irq) {
+        __enable_irq();
+    }
+}
+
+void
+TM_PROFILE_Get(uint8_t Id, TM_PROFILE_Zone_t* Zone) {
+    uint32_t irq;
+
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+    __disable_irq();
+
+    /* Copy statistics, interrupt can't change them in the middle */
+    *Zone = TM_PROFILE_Zones[Id];
+
+    /* Enable IRQ if necessary */
+    if (!irq) {
+        __enable_irq();
+    }
+}
+
+void
+TM_PROFILE_Add(uint8_t Id, uint32_t Cycles) {
+    TM_PROFILE_Zone_t* Zone = &TM_PROFILE_Zones[Id];
+    uint32_t bucket;
+
+    /* Remove measurement cycles */
+    Cycles = Cycles > TM_PROFILE_Overhead ? Cycles - TM_PROFILE_Overhead : 0;
+
+    /* Update statistics */
+    Zone->Count++;
+    Zone->Total += Cycles;
+    if (Cycles < Zone->Min) {
+        Zone->Min = Cycles;
+    }
+    if (Cycles > Zone->Max) {
+        Zone->Max = Cycles;
+    }
+
+    /* Each bucket is 4 times longer than previous one */
+    if (Cycles < (1UL << TM_PROFILE_BUCKET_SHIFT)) {
+        bucket = 0;
+    } else {
+        bucket = (31 - __CLZ(Cycles) - TM_PROFILE_BUCKET_SHIFT) / 2 + 1;
+        if (bucket >= TM_PROFILE_BUCKETS) {
+            bucket = TM_PROFILE_BUCKETS - 1;
+        }
+    }
+    Zone->Buckets[bucket]++;
+}
+
+void
+TM_PROFILE_Send(TM_PROFILE_Output_t Output) {
+    uint8_t record[PROFILE_RECORD_MAX];
+    TM_PROFILE_Zone_t zone;
+    uint8_t* data;
+    uint8_t i, k, len;
+
+    /* Frame record */
+    data = TM_PROFILE_INT_Put32(&record[4], SystemCoreClock);
+    data = TM_PROFILE_INT_Put32(data, DWT->CYCCNT - ResetTime);
+    *data++ = TM_PROFILE_ZONES;
+    *data++ = TM_PROFILE_BUCKETS;
+    *data++ = TM_PROFILE_BUCKET_SHIFT;
+    TM_PROFILE_INT_Record(Output, record, TM_PROFILE_RECORD_FRAME, 0xFF, data - &record[4]);
+
+    /* Send zones */
+    for (i = 0; i < TM_PROFILE_ZONES; i++) {
+        TM_PROFILE_Get(i, &zone);
+
+        /* Name record */
+        if (zone.Name) {
+            for (len = 0; zone.Name[len] && len < PROFILE_RECORD_MAX - 5; len++) {
+                record[4 + len] = zone.Name[len];
+            }
+            TM_PROFILE_INT_Record(Output, record, TM_PROFILE_RECORD_NAME, i, len);
+        }
+
+        /* Zone was not called */
+        if (!zone.Count) {
+            continue;
+        }
+
+        /* Statistics record */
+        data = TM_PROFILE_INT_Put32(&record[4], zone.Count);
+        data = TM_PROFILE_INT_Put32(data, (uint32_t)zone.Total);
+        data = TM_PROFILE_INT_Put32(data, (uint32_t)(zone.Total >> 32));
+        data = TM_PROFILE_INT_Put32(data, zone.Min);
+        data = TM_PROFILE_INT_Put32(data, zone.Max);
+        for (k = 0; k < TM_PROFILE_BUCKETS; k++) {
+            data = TM_PROFILE_INT_Put32(data, zone.Buckets[k]);
+        }
+        TM_PROFILE_INT_Record(Output, record, TM_PROFILE_RECORD_STATS, i, data - &record[4]);
+    }
+}
+
+void
+TM_PROFILE_OutputITM(const uint8_t* Data, uint16_t Count) {
+    /* Check if debugger enabled ITM and our port */
+    if (
+        !(ITM->TCR & ITM_TCR_ITMENA_Msk) ||
+        !(ITM->TER & (1UL << TM_PROFILE_ITM_PORT))
+    ) {
+        return;
+    }
+
+    /* Send words, each makes one ITM packet */
+    while (Count >= 4) {
+        while (ITM->PORT[TM_PROFILE_ITM_PORT].u32 == 0);
+        ITM->PORT[TM_PROFILE_ITM_PORT].u32 = Data[0] | Data[1] << 8 | Data[2] << 16 | (uint32_t)Data[3] << 24;
+        Data += 4;
+        Count -= 4;
+    }
+
+    /* Send remaining bytes */
+    while (Count--) {
+        while (ITM->PORT[TM_PROFILE_ITM_PORT].u32 == 0);
+        ITM->PORT[TM_PROFILE_ITM_PORT].u8 = *Data++;
+    }
+}
+
+/* Private functions */
+static void
+TM_PROFILE_INT_Clear(TM_PROFILE_Zone_t* Zone) {
+    uint8_t i;
+
+    /* Clear statistics */
+    Zone->Count = 0;
+    Zone->Total = 0;
+    Zone->Min = 0xFFFFFFFF;
+    Zone->Max = 0;
+    for (i = 0; i < TM_PROFILE_BUCKETS; i++) {
+        Zone->Buckets[i] = 0;
+    }
+}
+
+static void
+TM_PROFILE_INT_Record(TM_PROFILE_Output_t Output, uint8_t* Record, uint8_t Type, uint8_t Id, uint8_t Length) {
+    uint8_t i, sum = 0;
+
+    /* Fill header */
+    Record[0] = TM_PROFILE_RECORD_START;
+    Record[1] = Type;
+    Record[2] = Id;
+    Record[3] = Length;
+
+    /* Checksum of header and payload */
+    for (i = 0; i < Length + 4; i++) {
+        sum += Record[i];
+    }
+    Record[Length + 4] = sum;
+
+    /* Send record */
+    Output(Record, Length + 5);
+}
+
+static uint8_t*
+TM_PROFILE_INT_Put32(uint8_t* Data, uint32_t Value) {
+    /* Little endian */
+    *Data++ = Value;
+    *Data++ = Value >> 8;
+    *Data++ = Value >> 16;
+    *Data++ = Value >> 24;
+
+    return Data;
+}
+
+#endif
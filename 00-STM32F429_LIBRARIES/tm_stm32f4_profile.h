@@ -0,0 +1,399 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.1
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Cycle accurate profiler for code zones and interrupt handlers with binary output over SWO or USART
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_PROFILE_H
+#define TM_PROFILE_H 110
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_PROFILE
+ * @brief    Cycle accurate profiler for code zones and interrupt handlers with binary output over SWO or USART
+ * @{
+ *
+ * TM CPU LOAD library tells you how much time CPU is busy, but not where this time goes.
+ * This library measures how long each part of code takes, in CPU cycles from DWT counter.
+ *
+ * \par Zones
+ *
+ * Zone is part of code between PROFILE_BEGIN and PROFILE_END with the same ID, from 0 to TM_PROFILE_ZONES - 1.
+ * For each zone library counts:
+ *
+ *  - Number of calls
+ *  - Total, minimal and maximal number of cycles
+ *  - Histogram with TM_PROFILE_BUCKETS buckets. First bucket counts calls shorter than 2^TM_PROFILE_BUCKET_SHIFT cycles,
+ *    each next bucket is 4 times longer and last bucket counts all longer calls
+ *
+\code{.c}
+#define ZONE_FFT    0
+#define ZONE_LCD    1
+
+TM_PROFILE_Init();
+TM_PROFILE_ZoneName(ZONE_FFT, "FFT");
+TM_PROFILE_ZoneName(ZONE_LCD, "LCD");
+
+while (1) {
+    PROFILE_BEGIN(ZONE_FFT);
+    arm_cfft_radix4_f32(&S, Input);
+    PROFILE_END(ZONE_FFT);
+
+    PROFILE_BEGIN(ZONE_LCD);
+    DrawSpectrum();
+    PROFILE_END(ZONE_LCD);
+
+    //Send statistics every second
+    if (TM_Time >= NextSend) {
+        NextSend += 1000;
+        TM_PROFILE_Send(TM_PROFILE_OutputITM);
+    }
+}
+\endcode
+ *
+ * Times are inclusive, interrupts which happen inside zone are counted to zone too.
+ * Zone must not be used from thread and interrupt at the same time, use different ID for each.
+ * Cycles used by PROFILE_BEGIN and PROFILE_END are measured in @ref TM_PROFILE_Init and subtracted.
+ *
+ * \par Interrupt handlers
+ *
+ * Library interrupt handlers, like USART1_IRQHandler in TM USART, SysTick_Handler in TM DELAY,
+ * EXTIx_IRQHandler in TM EXTI or DMAx_Streamy_IRQHandler in TM DMA, and handlers in stm32f4xx_it.c, like ETH_IRQHandler,
+ * can be profiled without changing their source with @ref TM_PROFILE_IRQ macro in one of your C files:
+ *
+\code{.c}
+TM_PROFILE_IRQ(SysTick_Handler, 2)
+TM_PROFILE_IRQ(USART1_IRQHandler, 3)
+TM_PROFILE_IRQ(DMA2_Stream7_IRQHandler, 4)
+\endcode
+ *
+ * Macro creates function Handler_Profiled, like USART1_IRQHandler_Profiled, which measures original handler.
+ * Change entry for handler in vector table in your startup file to profiled function:
+ *
+@verbatim
+//Keil uVision, startup_stm32f429_439xx.s
+                DCD     USART1_IRQHandler_Profiled        ; USART1
+
+//GCC, startup_stm32f429_439xx.s
+  .word     USART1_IRQHandler_Profiled
+@endverbatim
+ *
+ * When TM_PROFILE_ENABLED is 0, profiled function only calls original handler, so vector table can stay as it is.
+ *
+ * \par Binary output
+ *
+ * @ref TM_PROFILE_Send sends statistics as binary records with output function.
+ * @ref TM_PROFILE_OutputITM writes to ITM stimulus port TM_PROFILE_ITM_PORT, so it does not mix with TM SWO printf on port 0.
+ * For USART, write small function which calls TM_USART_Send.
+ *
+ * Each record has the same frame:
+ *
+@verbatim
+Byte    Description
+0       0xA5, start of record
+1       Record type
+2       Zone ID, 0xFF for frame record
+3       N, payload length
+4..     Payload, little endian
+4+N     Checksum, sum of all previous bytes of record
+@endverbatim
+ *
+ * Record types:
+ *
+ *  - 0x01: Frame, sent first: SystemCoreClock (4 bytes), cycles since reset (4 bytes),
+ *          number of zones (1 byte), number of buckets (1 byte), bucket shift (1 byte)
+ *  - 0x02: Zone name, sent only for zones with name: characters without zero at the end
+ *  - 0x03: Zone statistics, sent for zones which were called: count (4 bytes), total (8 bytes),
+ *          min (4 bytes), max (4 bytes), buckets (4 bytes each)
+ *
+ * Host decoder is in host/profile_decode.c. It reads raw records or ITM packets captured from SWO
+ * and prints table with times in microseconds and share of CPU time for each zone.
+ *
+ * \par Disable profiler
+ *
+ * Set TM_PROFILE_ENABLED to 0 in defines.h and all macros become empty, like with TM SWO library.
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.1
+  - October 16, 2026
+  - Zone statistics table and overhead are placed to CCM RAM when TM_CCM_ENABLED is 1
+
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - attributes.h
+ - stdlib.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "attributes.h"
+#include "stdlib.h"
+
+/**
+ * @defgroup TM_PROFILE_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Profiler status, enabled by default
+ */
+#ifndef TM_PROFILE_ENABLED
+#define TM_PROFILE_ENABLED          1
+#endif
+
+/**
+ * @brief  Number of zones, maximal value is 255
+ */
+#ifndef TM_PROFILE_ZONES
+#define TM_PROFILE_ZONES            16
+#endif
+
+/**
+ * @brief  Number of histogram buckets for each zone
+ */
+#ifndef TM_PROFILE_BUCKETS
+#define TM_PROFILE_BUCKETS          8
+#endif
+
+/**
+ * @brief  First histogram bucket counts calls shorter than 2^TM_PROFILE_BUCKET_SHIFT cycles
+ */
+#ifndef TM_PROFILE_BUCKET_SHIFT
+#define TM_PROFILE_BUCKET_SHIFT     6
+#endif
+
+/**
+ * @brief  ITM stimulus port used by @ref TM_PROFILE_OutputITM
+ */
+#ifndef TM_PROFILE_ITM_PORT
+#define TM_PROFILE_ITM_PORT         1
+#endif
+
+/* Check settings */
+#if TM_PROFILE_ZONES > 255
+#error "TM_PROFILE_ZONES can be 255 or less"
+#endif
+#if TM_PROFILE_BUCKETS > 16
+#error "TM_PROFILE_BUCKETS can be 16 or less"
+#endif
+
+/**
+ * @brief  Record types for binary output
+ */
+#define TM_PROFILE_RECORD_START     0xA5 /*!< First byte of each record */
+#define TM_PROFILE_RECORD_FRAME     0x01 /*!< Frame record with clock and settings */
+#define TM_PROFILE_RECORD_NAME      0x02 /*!< Zone name record */
+#define TM_PROFILE_RECORD_STATS     0x03 /*!< Zone statistics record */
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_PROFILE_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Zone statistics
+ */
+typedef struct {
+    uint32_t Count;                         /*!< Number of calls */
+    uint64_t Total;                         /*!< Total number of cycles */
+    uint32_t Min;                           /*!< Minimal number of cycles for one call */
+    uint32_t Max;                           /*!< Maximal number of cycles for one call */
+    uint32_t Buckets[TM_PROFILE_BUCKETS];   /*!< Histogram of call lengths */
+    uint32_t Start;                         /*!< Cycle counter when zone started. Used private */
+    const char* Name;                       /*!< Zone name, NULL if not set */
+} TM_PROFILE_Zone_t;
+
+/**
+ * @brief  Output function for binary records
+ * @param  *Data: Pointer to data to send
+ * @param  Count: Number of bytes to send
+ * @retval None
+ */
+typedef void (*TM_PROFILE_Output_t)(const uint8_t* Data, uint16_t Count);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_PROFILE_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+#if TM_PROFILE_ENABLED == 1
+
+/* Zones and cycles used by measurement itself */
+extern TM_PROFILE_Zone_t TM_PROFILE_Zones[TM_PROFILE_ZONES];
+extern uint32_t TM_PROFILE_Overhead;
+
+/**
+ * @brief  Initializes profiler, enables DWT cycle counter and measures profiler overhead
+ * @note   Running cycle counter is not reset, so TM DELAY cycle clock keeps working
+ * @param  None
+ * @retval None
+ */
+void TM_PROFILE_Init(void);
+
+/**
+ * @brief  Sets zone name, which is sent to host decoder
+ * @param  Id: Zone ID
+ * @param  *Name: Zone name, it must stay in memory, use string constant
+ * @retval None
+ */
+void TM_PROFILE_ZoneName(uint8_t Id, const char* Name);
+
+/**
+ * @brief  Clears statistics for all zones, names are kept
+ * @param  None
+ * @retval None
+ */
+void TM_PROFILE_Reset(void);
+
+/**
+ * @brief  Copies zone statistics, safe when zone is used from interrupt
+ * @param  Id: Zone ID
+ * @param  *Zone: Pointer to @ref TM_PROFILE_Zone_t structure to copy statistics to
+ * @retval None
+ */
+void TM_PROFILE_Get(uint8_t Id, TM_PROFILE_Zone_t* Zone);
+
+/**
+ * @brief  Sends statistics for all zones as binary records
+ * @note   Statistics are not cleared, use @ref TM_PROFILE_Reset after if you want statistics for each period
+ * @param  Output: Output function for records
+ * @retval None
+ */
+void TM_PROFILE_Send(TM_PROFILE_Output_t Output);
+
+/**
+ * @brief  Output function which writes data to ITM stimulus port TM_PROFILE_ITM_PORT
+ * @note   Data are dropped when debugger did not enable ITM or port
+ * @param  *Data: Pointer to data to send
+ * @param  Count: Number of bytes to send
+ * @retval None
+ */
+void TM_PROFILE_OutputITM(const uint8_t* Data, uint16_t Count);
+
+/**
+ * @brief  Adds one call to zone statistics
+ * @note   Used by PROFILE_END, can be called directly with cycles measured elsewhere
+ * @param  Id: Zone ID
+ * @param  Cycles: Number of cycles for call
+ * @retval None
+ */
+void TM_PROFILE_Add(uint8_t Id, uint32_t Cycles);
+
+/**
+ * @brief  Starts zone measurement
+ * @param  id: Zone ID
+ * @retval None
+ */
+#define PROFILE_BEGIN(id)           (TM_PROFILE_Zones[(id)].Start = DWT->CYCCNT)
+
+/**
+ * @brief  Ends zone measurement and adds call to statistics
+ * @param  id: Zone ID
+ * @retval None
+ */
+#define PROFILE_END(id)             TM_PROFILE_Add((id), DWT->CYCCNT - TM_PROFILE_Zones[(id)].Start)
+
+/**
+ * @brief  Creates profiled function Handler_Profiled for interrupt handler
+ * @note   Vector table entry must point to Handler_Profiled function
+ * @param  Handler: Interrupt handler name, like USART1_IRQHandler
+ * @param  id: Zone ID
+ * @retval None
+ */
+#define TM_PROFILE_IRQ(Handler, id)                 \
+extern void Handler(void);                          \
+void Handler##_Profiled(void) {                     \
+    PROFILE_BEGIN(id);                              \
+    Handler();                                      \
+    PROFILE_END(id);                                \
+}
+
+#else
+/* Do nothing here, compiler will throw out these statements because they are empty */
+#define TM_PROFILE_Init()
+#define TM_PROFILE_ZoneName(Id, Name)
+#define TM_PROFILE_Reset()
+#define TM_PROFILE_Get(Id, Zone)
+#define TM_PROFILE_Send(Output)
+#define TM_PROFILE_Add(Id, Cycles)
+#define PROFILE_BEGIN(id)
+#define PROFILE_END(id)
+/* Profiled handler only calls original one, vector table does not have to be changed */
+#define TM_PROFILE_IRQ(Handler, id)                 \
+extern void Handler(void);                          \
+void Handler##_Profiled(void) {                     \
+    Handler();                                      \
+}
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,456 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_scanline.h"
+
+/**
+ * @brief  Polygon edge, from top to bottom
+ * @note   Used private
+ */
+typedef struct {
+    int16_t YMin;  /*!< First line of edge */
+    int16_t YMax;  /*!< Last line of edge */
+    int32_t X;     /*!< X coordinate on first line, 16.16 fixed point */
+    int32_t Slope; /*!< X change per line, 16.16 fixed point */
+} TM_SCANLINE_Edge_t;
+
+/**
+ * @brief  Interval of X coordinates in one line
+ * @note   Used private
+ */
+typedef struct {
+    int32_t Min;
+    int32_t Max;
+} TM_SCANLINE_Interval_t;
+
+/* Infinite interval limits */
+#define SCANLINE_INF            0x7FFF
+
+/* Private functions */
+static void TM_SCANLINE_INT_RoundShape(const TM_SCANLINE_t* Dev, int16_t cx0, int16_t cy0, int16_t cx1, int16_t cy1, int16_t r, uint32_t color);
+static uint16_t TM_SCANLINE_INT_Sqrt(uint32_t value);
+static void TM_SCANLINE_INT_HalfPlane(float a, float b, TM_SCANLINE_Interval_t* Interval);
+
+void
+TM_SCANLINE_Span(const TM_SCANLINE_t* Dev, int16_t x0, int16_t x1, int16_t y, uint32_t color) {
+    /* Check if visible */
+    if (
+        y < 0 || y >= Dev->Height ||
+        x1 < 0 || x0 >= Dev->Width ||
+        x0 > x1
+    ) {
+        return;
+    }
+
+    /* Clip to screen */
+    if (x0 < 0) {
+        x0 = 0;
+    }
+    if (x1 >= Dev->Width) {
+        x1 = Dev->Width - 1;
+    }
+
+    /* Fill span */
+    Dev->Span(x0, x1, y, color);
+}
+
+uint8_t
+TM_SCANLINE_FillPolygon(const TM_SCANLINE_t* Dev, const TM_SCANLINE_Point_t* Points, uint16_t count, uint32_t color) {
+    const TM_SCANLINE_Point_t *a, *b, *tmp;
+    TM_SCANLINE_Edge_t Edges[TM_SCANLINE_MAX_EDGES];
+    int16_t Crossings[TM_SCANLINE_MAX_EDGES];
+    TM_SCANLINE_Edge_t edge;
+    int16_t ymin, ymax, ybottom, y, x, xmin, xmax;
+    uint16_t i, j, n, c;
+
+    /* Check input */
+    if (count < 2) {
+        return 0;
+    }
+
+    /* Build edge table */
+    n = 0;
+    ymin = ymax = Points[0].Y;
+    xmin = xmax = Points[0].X;
+    for (i = 0; i < count; i++) {
+        a = &Points[i];
+        b = &Points[(i + 1) == count ? 0 : (i + 1)];
+
+        /* Polygon limits */
+        if (a->Y < ymin) {
+            ymin = a->Y;
+        }
+        if (a->Y > ymax) {
+            ymax = a->Y;
+        }
+
+        /* Horizontal edges are covered by spans */
+        if (a->Y == b->Y) {
+            continue;
+        }
+
+        /* Too many edges, nothing is drawn */
+        if (n == TM_SCANLINE_MAX_EDGES) {
+            return 0;
+        }
+
+        /* Edges go from top to bottom */
+        if (a->Y > b->Y) {
+            tmp = a;
+            a = b;
+            b = tmp;
+        }
+        edge.YMin = a->Y;
+        edge.YMax = b->Y;
+        edge.X = (int32_t)a->X << 16;
+        edge.Slope = ((int32_t)(b->X - a->X) << 16) / (b->Y - a->Y);
+
+        /* Insert sorted by first line */
+        for (j = n; j > 0 && Edges[j - 1].YMin > edge.YMin; j--) {
+            Edges[j] = Edges[j - 1];
+        }
+        Edges[j] = edge;
+        n++;
+    }
+
+    /* Flat polygon, only one line */
+    if (n == 0) {
+        for (i = 1; i < count; i++) {
+            if (Points[i].X < xmin) {
+                xmin = Points[i].X;
+            }
+            if (Points[i].X > xmax) {
+                xmax = Points[i].X;
+            }
+        }
+        TM_SCANLINE_Span(Dev, xmin, xmax, ymin, color);
+        return 1;
+    }
+
+    /* Clip lines to screen */
+    ybottom = ymax;
+    if (ymin < 0) {
+        ymin = 0;
+    }
+    if (ymax >= Dev->Height) {
+        ymax = Dev->Height - 1;
+    }
+
+    for (y = ymin; y <= ymax; y++) {
+        /* Find all edges crossing this line */
+        c = 0;
+        for (i = 0; i < n && Edges[i].YMin <= y; i++) {
+            /* Last line of edge is used only on the bottom of polygon, so vertices are not counted twice */
+            if (y < Edges[i].YMax || (y == Edges[i].YMax && y == ybottom)) {
+                x = (Edges[i].X + (int32_t)(y - Edges[i].YMin) * Edges[i].Slope + 0x8000) >> 16;
+
+                /* Insert sorted */
+                for (j = c; j > 0 && Crossings[j - 1] > x; j--) {
+                    Crossings[j] = Crossings[j - 1];
+                }
+                Crossings[j] = x;
+                c++;
+            }
+        }
+
+        /* Fill between pairs of crossings */
+        for (i = 1; i < c; i += 2) {
+            TM_SCANLINE_Span(Dev, Crossings[i - 1], Crossings[i], y, color);
+        }
+    }
+
+    /* Polygon is drawn */
+    return 1;
+}
+
+void
+TM_SCANLINE_FillTriangle(const TM_SCANLINE_t* Dev, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, uint32_t color) {
+    TM_SCANLINE_Point_t Points[3];
+
+    /* Fill points */
+    Points[0].X = x1;
+    Points[0].Y = y1;
+    Points[1].X = x2;
+    Points[1].Y = y2;
+    Points[2].X = x3;
+    Points[2].Y = y3;
+
+    /* Fill as polygon */
+    TM_SCANLINE_FillPolygon(Dev, Points, 3, color);
+}
+
+void
+TM_SCANLINE_FillCircle(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t r, uint32_t color) {
+    /* Circle is rounded rectangle with zero size */
+    TM_SCANLINE_INT_RoundShape(Dev, x0, y0, x0, y0, r, color);
+}
+
+void
+TM_SCANLINE_FillRoundedRectangle(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r, uint32_t color) {
+    int16_t tmp;
+
+    /* Check correction */
+    if (x0 > x1) {
+        tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+    if (y0 > y1) {
+        tmp = y0;
+        y0 = y1;
+        y1 = tmp;
+    }
+
+    /* Check max radius */
+    if (r > (x1 - x0) / 2) {
+        r = (x1 - x0) / 2;
+    }
+    if (r > (y1 - y0) / 2) {
+        r = (y1 - y0) / 2;
+    }
+    if (r < 0) {
+        r = 0;
+    }
+
+    /* Corner centers */
+    TM_SCANLINE_INT_RoundShape(Dev, x0 + r, y0 + r, x1 - r, y1 - r, r, color);
+}
+
+void
+TM_SCANLINE_FillEllipse(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint32_t color) {
+    int16_t dy, w;
+    float t;
+
+    /* Check input */
+    if (rx < 0 || ry < 0) {
+        return;
+    }
+
+    /* Middle line */
+    TM_SCANLINE_Span(Dev, x0 - rx, x0 + rx, y0, color);
+
+    /* Lines are symmetric around center */
+    for (dy = 1; dy <= ry; dy++) {
+        /* Skip lines outside screen */
+        if ((y0 + dy) >= Dev->Height && (y0 - dy) < 0) {
+            continue;
+        }
+
+        /* Half width of ellipse in this line */
+        t = (float)dy / (float)ry;
+        w = (int16_t)((float)rx * sqrtf(1.0f - t * t) + 0.5f);
+
+        TM_SCANLINE_Span(Dev, x0 - w, x0 + w, y0 + dy, color);
+        TM_SCANLINE_Span(Dev, x0 - w, x0 + w, y0 - dy, color);
+    }
+}
+
+void
+TM_SCANLINE_FillArc(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t r_inner, int16_t r_outer, int16_t start, int16_t end, uint32_t color) {
+    TM_SCANLINE_Interval_t ring[2], wedge[2], i0, i1;
+    uint8_t ring_count, wedge_count, i, j;
+    float s0, c0, s1, c1;
+    int32_t lo, hi, wo, wi;
+    int16_t dy, sweep;
+
+    /* Check input */
+    if (r_outer < 0 || r_inner > r_outer) {
+        return;
+    }
+    if (r_inner < 0) {
+        r_inner = 0;
+    }
+
+    /* Normalize angles */
+    start %= 360;
+    end %= 360;
+    if (start < 0) {
+        start += 360;
+    }
+    if (end < 0) {
+        end += 360;
+    }
+    sweep = end - start;
+    if (sweep <= 0) {
+        sweep += 360;
+    }
+
+    /* Direction vectors of both edges */
+    s0 = sinf((float)start * 3.14159265f / 180.0f);
+    c0 = cosf((float)start * 3.14159265f / 180.0f);
+    s1 = sinf((float)(start + sweep) * 3.14159265f / 180.0f);
+    c1 = cosf((float)(start + sweep) * 3.14159265f / 180.0f);
+
+    for (dy = -r_outer; dy <= r_outer; dy++) {
+        /* Skip lines outside screen */
+        if ((y0 + dy) < 0 || (y0 + dy) >= Dev->Height) {
+            continue;
+        }
+
+        /* Ring part of line, outside of inner circle */
+        wo = TM_SCANLINE_INT_Sqrt((int32_t)r_outer * r_outer - (int32_t)dy * dy);
+        if (dy > -r_inner && dy < r_inner) {
+            wi = TM_SCANLINE_INT_Sqrt((int32_t)r_inner * r_inner - (int32_t)dy * dy - 1);
+            ring[0].Min = -wo;
+            ring[0].Max = -wi - 1;
+            ring[1].Min = wi + 1;
+            ring[1].Max = wo;
+            ring_count = 2;
+        } else {
+            ring[0].Min = -wo;
+            ring[0].Max = wo;
+            ring_count = 1;
+        }
+
+        /* Angle part of line */
+        if (sweep >= 360) {
+            wedge[0].Min = -SCANLINE_INF;
+            wedge[0].Max = SCANLINE_INF;
+            wedge_count = 1;
+        } else {
+            /* Points after start edge and before end edge */
+            TM_SCANLINE_INT_HalfPlane(-s0, -c0 * dy, &i0);
+            TM_SCANLINE_INT_HalfPlane(s1, c1 * dy, &i1);
+
+            if (sweep <= 180) {
+                /* Both conditions must be true */
+                wedge[0].Min = i0.Min > i1.Min ? i0.Min : i1.Min;
+                wedge[0].Max = i0.Max < i1.Max ? i0.Max : i1.Max;
+                wedge_count = 1;
+            } else if (i0.Min > i0.Max) {
+                /* Only one condition must be true */
+                wedge[0] = i1;
+                wedge_count = 1;
+            } else if (i1.Min > i1.Max) {
+                wedge[0] = i0;
+                wedge_count = 1;
+            } else if (i0.Min <= (i1.Max + 1) && i1.Min <= (i0.Max + 1)) {
+                /* Intervals overlap, join them */
+                wedge[0].Min = i0.Min < i1.Min ? i0.Min : i1.Min;
+                wedge[0].Max = i0.Max > i1.Max ? i0.Max : i1.Max;
+                wedge_count = 1;
+            } else {
+                wedge[0] = i0;
+                wedge[1] = i1;
+                wedge_count = 2;
+            }
+        }
+
+        /* Fill intersections of ring and angle parts */
+        for (i = 0; i < ring_count; i++) {
+            for (j = 0; j < wedge_count; j++) {
+                lo = ring[i].Min > wedge[j].Min ? ring[i].Min : wedge[j].Min;
+                hi = ring[i].Max < wedge[j].Max ? ring[i].Max : wedge[j].Max;
+                if (lo <= hi) {
+                    TM_SCANLINE_Span(Dev, x0 + lo, x0 + hi, y0 + dy, color);
+                }
+            }
+        }
+    }
+}
+
+static void
+TM_SCANLINE_INT_RoundShape(const TM_SCANLINE_t* Dev, int16_t cx0, int16_t cy0, int16_t cx1, int16_t cy1, int16_t r, uint32_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t i, ymin, ymax;
+
+    /* Check input */
+    if (r < 0) {
+        return;
+    }
+
+    /* Middle lines with full width, clipped to screen */
+    ymin = cy0 < 0 ? 0 : cy0;
+    ymax = cy1 >= Dev->Height ? Dev->Height - 1 : cy1;
+    for (i = ymin; i <= ymax; i++) {
+        TM_SCANLINE_Span(Dev, cx0 - r, cx1 + r, i, color);
+    }
+
+    while (x < y) {
+        if (f >= 0) {
+            /* Lines at distance y will not get wider, fill them once */
+            TM_SCANLINE_Span(Dev, cx0 - x, cx1 + x, cy1 + y, color);
+            TM_SCANLINE_Span(Dev, cx0 - x, cx1 + x, cy0 - y, color);
+
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        /* Lines at distance x, when they were not filled above */
+        if (x <= y) {
+            TM_SCANLINE_Span(Dev, cx0 - y, cx1 + y, cy1 + x, color);
+            TM_SCANLINE_Span(Dev, cx0 - y, cx1 + y, cy0 - x, color);
+        }
+    }
+}
+
+static uint16_t
+TM_SCANLINE_INT_Sqrt(uint32_t value) {
+    uint32_t result = 0, bit = 1UL << 30;
+
+    /* Integer square root, rounded down */
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+static void
+TM_SCANLINE_INT_HalfPlane(float a, float b, TM_SCANLINE_Interval_t* Interval) {
+    /* All x where a * x >= b */
+    if (a > 0.0001f) {
+        Interval->Min = (int32_t)ceilf(b / a - 0.001f);
+        Interval->Max = SCANLINE_INF;
+    } else if (a < -0.0001f) {
+        Interval->Min = -SCANLINE_INF;
+        Interval->Max = (int32_t)floorf(b / a + 0.001f);
+    } else if (b <= 0.0001f) {
+        Interval->Min = -SCANLINE_INF;
+        Interval->Max = SCANLINE_INF;
+    } else {
+        /* Empty interval */
+        Interval->Min = 1;
+        Interval->Max = 0;
+    }
+
+    /* Limit, so later calculations don't overflow */
+    if (Interval->Min < -SCANLINE_INF) {
+        Interval->Min = -SCANLINE_INF;
+    }
+    if (Interval->Max > SCANLINE_INF) {
+        Interval->Max = SCANLINE_INF;
+    }
+}
@@ -0,0 +1,272 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Scanline fill engine for filled shapes, shared by all LCD libraries
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_SCANLINE_H
+#define TM_SCANLINE_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_SCANLINE
+ * @brief    Scanline fill engine for filled shapes, shared by all LCD libraries
+ * @{
+ *
+ * Library converts filled shapes into horizontal spans, one or more per line.
+ * It does not know anything about LCD. Each LCD library provides one span function,
+ * which fills pixels from x0 to x1 in line y, and screen size for clipping.
+ *
+ * Span function is always called with coordinates inside screen and x0 <= x1.
+ *
+ * Supported shapes:
+ *  - Triangles
+ *  - Polygons, convex or concave, with even-odd fill rule
+ *  - Circles and rounded rectangles
+ *  - Ellipses
+ *  - Arcs (pies and ring segments)
+ *
+ * LCD libraries use this engine for their own filled shapes.
+ * Other shapes can be drawn with pointer to device structure from LCD library:
+ *
+@verbatim
+//Draw filled polygon on DMA2D graphic layer
+TM_SCANLINE_Point_t Points[] = {{10, 10}, {100, 30}, {60, 50}, {100, 90}, {10, 70}};
+TM_SCANLINE_FillPolygon(TM_DMA2DGRAPHIC_GetScanline(), Points, 5, GRAPHIC_COLOR_RED);
+@endverbatim
+ *
+ * \par Polygon edges
+ *
+ * Polygon edges are stored in edge table on stack, 14 bytes for each edge.
+ * Polygons with more edges are not drawn and @ref TM_SCANLINE_FillPolygon returns 0.
+ * You can change maximal number of edges in defines.h file
+ *
+@verbatim
+//Maximal number of polygon edges
+#define TM_SCANLINE_MAX_EDGES    32
+@endverbatim
+ *
+ * Engine has no static data, so it can be preempted by other fills, like from tasks in interrupts.
+ * LCD libraries which call it are not reentrant, so draw to one LCD only from one context.
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - math.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "math.h"
+
+/**
+ * @defgroup TM_SCANLINE_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Maximal number of polygon edges, edge table takes 14 bytes of stack for each edge
+ */
+#ifndef TM_SCANLINE_MAX_EDGES
+#define TM_SCANLINE_MAX_EDGES    32
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_SCANLINE_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Span fill function, provided by LCD library
+ * @param  x0: X coordinate of first pixel in span
+ * @param  x1: X coordinate of last pixel in span, x1 >= x0
+ * @param  y: Y coordinate of span
+ * @param  color: Color passed to shape function
+ * @retval None
+ */
+typedef void (*TM_SCANLINE_SpanFunc_t)(int16_t x0, int16_t x1, int16_t y, uint32_t color);
+
+/**
+ * @brief  Device structure, provided by LCD library
+ */
+typedef struct {
+    TM_SCANLINE_SpanFunc_t Span; /*!< Span fill function */
+    int16_t Width;               /*!< Screen width in pixels, used for clipping */
+    int16_t Height;              /*!< Screen height in pixels, used for clipping */
+} TM_SCANLINE_t;
+
+/**
+ * @brief  Point for polygons
+ */
+typedef struct {
+    int16_t X; /*!< X coordinate */
+    int16_t Y; /*!< Y coordinate */
+} TM_SCANLINE_Point_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_SCANLINE_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Fills one horizontal span, clipped to screen
+ * @param  *Dev: Pointer to @ref TM_SCANLINE_t device structure
+ * @param  x0: X coordinate of first pixel
+ * @param  x1: X coordinate of last pixel
+ * @param  y: Y coordinate of span
+ * @param  color: Color for span
+ * @retval None
+ */
+void TM_SCANLINE_Span(const TM_SCANLINE_t* Dev, int16_t x0, int16_t x1, int16_t y, uint32_t color);
+
+/**
+ * @brief  Fills polygon using even-odd fill rule
+ * @note   Polygon is closed automatically, last point is connected to first one
+ * @param  *Dev: Pointer to @ref TM_SCANLINE_t device structure
+ * @param  *Points: Pointer to @ref TM_SCANLINE_Point_t array of polygon points
+ * @param  count: Number of points. Coordinates must be between -8192 and 8191
+ * @param  color: Color for polygon
+ * @retval Fill status:
+ *            - 0: Polygon is not drawn, less than 2 points or more than TM_SCANLINE_MAX_EDGES edges
+ *            - > 0: Polygon is drawn
+ */
+uint8_t TM_SCANLINE_FillPolygon(const TM_SCANLINE_t* Dev, const TM_SCANLINE_Point_t* Points, uint16_t count, uint32_t color);
+
+/**
+ * @brief  Fills triangle
+ * @param  *Dev: Pointer to @ref TM_SCANLINE_t device structure
+ * @param  x1: First coordinate X location
+ * @param  y1: First coordinate Y location
+ * @param  x2: Second coordinate X location
+ * @param  y2: Second coordinate Y location
+ * @param  x3: Third coordinate X location
+ * @param  y3: Third coordinate Y location
+ * @param  color: Color for triangle
+ * @retval None
+ */
+void TM_SCANLINE_FillTriangle(const TM_SCANLINE_t* Dev, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, uint32_t color);
+
+/**
+ * @brief  Fills circle
+ * @param  *Dev: Pointer to @ref TM_SCANLINE_t device structure
+ * @param  x0: X coordinate of center
+ * @param  y0: Y coordinate of center
+ * @param  r: Circle radius
+ * @param  color: Color for circle
+ * @retval None
+ */
+void TM_SCANLINE_FillCircle(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t r, uint32_t color);
+
+/**
+ * @brief  Fills rectangle with rounded corners
+ * @note   Radius is decreased if it is too big for rectangle
+ * @param  *Dev: Pointer to @ref TM_SCANLINE_t device structure
+ * @param  x0: X coordinate of top left point
+ * @param  y0: Y coordinate of top left point
+ * @param  x1: X coordinate of bottom right point
+ * @param  y1: Y coordinate of bottom right point
+ * @param  r: Corner radius
+ * @param  color: Color for rectangle
+ * @retval None
+ */
+void TM_SCANLINE_FillRoundedRectangle(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r, uint32_t color);
+
+/**
+ * @brief  Fills ellipse
+ * @param  *Dev: Pointer to @ref TM_SCANLINE_t device structure
+ * @param  x0: X coordinate of center
+ * @param  y0: Y coordinate of center
+ * @param  rx: Radius in X direction
+ * @param  ry: Radius in Y direction
+ * @param  color: Color for ellipse
+ * @retval None
+ */
+void TM_SCANLINE_FillEllipse(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint32_t color);
+
+/**
+ * @brief  Fills arc between 2 radiuses and 2 angles
+ * @note   Angles are in degrees. 0 degrees points to the right and angle grows clockwise on screen
+ * @note   Set inner radius to 0 to fill pie
+ * @param  *Dev: Pointer to @ref TM_SCANLINE_t device structure
+ * @param  x0: X coordinate of center
+ * @param  y0: Y coordinate of center
+ * @param  r_inner: Inner radius
+ * @param  r_outer: Outer radius
+ * @param  start: Start angle in degrees
+ * @param  end: End angle in degrees. When end <= start, 360 degrees are added
+ * @param  color: Color for arc
+ * @retval None
+ */
+void TM_SCANLINE_FillArc(const TM_SCANLINE_t* Dev, int16_t x0, int16_t y0, int16_t r_inner, int16_t r_outer, int16_t start, int16_t end, uint32_t color);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
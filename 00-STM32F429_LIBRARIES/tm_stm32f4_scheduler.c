@@ -0,0 +1,235 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_scheduler.h"
+
+/* Priority masks for main loop and PendSV tasks */
+#define SCHEDULER_MASK(prio)        ((prio) >= 32 ? 0xFFFFFFFF : ((1UL << (prio)) - 1))
+#define SCHEDULER_MAIN_MASK         SCHEDULER_MASK(TM_SCHEDULER_PREEMPT_PRIORITY)
+#define SCHEDULER_PENDSV_MASK       (SCHEDULER_MASK(TM_SCHEDULER_PRIORITIES) & ~SCHEDULER_MAIN_MASK)
+
+/* Tasks for each priority */
+static TM_SCHEDULER_Task_t* Tasks[TM_SCHEDULER_PRIORITIES];
+
+/* Bit for each priority with posted events */
+static volatile uint32_t Ready = 0;
+
+/* Private functions */
+static void TM_SCHEDULER_INT_TimerCallback(void* Param);
+static uint32_t TM_SCHEDULER_INT_Dispatch(uint32_t Mask);
+static __INLINE void TM_SCHEDULER_INT_Or(volatile uint32_t* Value, uint32_t Bits);
+static __INLINE uint32_t TM_SCHEDULER_INT_Take(volatile uint32_t* Value, uint32_t Bits);
+
+void
+TM_SCHEDULER_Init(void) {
+    uint8_t i;
+
+    /* Clear tasks */
+    for (i = 0; i < TM_SCHEDULER_PRIORITIES; i++) {
+        Tasks[i] = NULL;
+    }
+    Ready = 0;
+
+    /* PendSV tasks are interrupted by all other interrupts */
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+}
+
+uint8_t
+TM_SCHEDULER_TaskInit(TM_SCHEDULER_Task_t* Task, TM_SCHEDULER_Func_t Func, void* Param, uint8_t Priority) {
+    TM_SCHEDULER_Task_t** pp;
+    uint32_t irq;
+
+    /* Check priority */
+    if (Priority >= TM_SCHEDULER_PRIORITIES) {
+        return 0;
+    }
+
+    /* Fill settings */
+    Task->Func = Func;
+    Task->Update = NULL;
+    Task->Param = Param;
+    Task->Events = 0;
+    Task->Priority = Priority;
+    Task->Next = NULL;
+
+    /* Timer is not started until period is set */
+    TM_DELAY_TimerInit(&Task->Timer, 0, 1, 0, TM_SCHEDULER_INT_TimerCallback, Task);
+
+    /* Get interrupt status */
+    irq = __get_PRIMASK();
+    __disable_irq();
+
+    /* Add to the end of list, tasks with the same priority are called in order of initialization */
+    for (pp = &Tasks[Priority]; *pp; pp = &(*pp)->Next);
+    *pp = Task;
+
+    /* Enable IRQ if necessary */
+    if (!irq) {
+        __enable_irq();
+    }
+
+    /* Task added */
+    return 1;
+}
+
+uint8_t
+TM_SCHEDULER_TaskInitUpdate(TM_SCHEDULER_Task_t* Task, void (*Update)(void), uint8_t Priority, uint32_t Period) {
+    /* Add task without function */
+    if (!TM_SCHEDULER_TaskInit(Task, NULL, NULL, Priority)) {
+        return 0;
+    }
+
+    /* Set update function */
+    Task->Update = Update;
+
+    /* Start timer */
+    TM_SCHEDULER_TaskPeriodic(Task, Period);
+
+    /* Task added */
+    return 1;
+}
+
+void
+TM_SCHEDULER_TaskPeriodic(TM_SCHEDULER_Task_t* Task, uint32_t Period) {
+    /* Stop timer */
+    TM_DELAY_TimerDelete(&Task->Timer);
+
+    /* Start with new period */
+    if (Period) {
+        TM_DELAY_TimerInit(&Task->Timer, Period, 1, 1, TM_SCHEDULER_INT_TimerCallback, Task);
+    }
+}
+
+void
+TM_SCHEDULER_Post(TM_SCHEDULER_Task_t* Task, uint32_t Events) {
+    uint32_t bit = 1UL << Task->Priority;
+
+    /* Events first, ready bit is cleared before events are taken */
+    TM_SCHEDULER_INT_Or(&Task->Events, Events);
+    TM_SCHEDULER_INT_Or(&Ready, bit);
+
+    /* Call task from PendSV */
+    if (bit & SCHEDULER_PENDSV_MASK) {
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    }
+}
+
+uint32_t
+TM_SCHEDULER_Run(void) {
+    return TM_SCHEDULER_INT_Dispatch(SCHEDULER_MAIN_MASK);
+}
+
+void
+TM_SCHEDULER_Start(void) {
+    while (1) {
+        /* Call tasks while there is something to do */
+        TM_SCHEDULER_Run();
+
+        /* Interrupt which posts event after check must wake MCU up */
+        __disable_irq();
+
+        /* Check again if anything was posted */
+        if (!(Ready & SCHEDULER_MAIN_MASK)) {
+#if TM_SCHEDULER_TICKLESS
+            /* Skip delay ticks till next custom timer expires */
+            TM_DELAY_TicklessEnter(0xFFFFFFFF);
+            __DSB();
+            __WFI();
+            TM_DELAY_TicklessExit();
+#else
+            /* Wait for interrupt */
+            __DSB();
+            __WFI();
+#endif
+        }
+
+        /* Execute interrupt which woke MCU up */
+        __enable_irq();
+    }
+}
+
+#if TM_SCHEDULER_PREEMPT_PRIORITY < TM_SCHEDULER_PRIORITIES
+void
+PendSV_Handler(void) {
+    /* Call tasks with high priorities */
+    TM_SCHEDULER_INT_Dispatch(SCHEDULER_PENDSV_MASK);
+}
+#endif
+
+/* Private functions */
+static void
+TM_SCHEDULER_INT_TimerCallback(void* Param) {
+    /* Timer expired, called from delay interrupt */
+    TM_SCHEDULER_Post((TM_SCHEDULER_Task_t *)Param, TM_SCHEDULER_EVENT_TIMER);
+}
+
+static uint32_t
+TM_SCHEDULER_INT_Dispatch(uint32_t Mask) {
+    TM_SCHEDULER_Task_t* Task;
+    uint32_t ready, events, calls = 0;
+    uint8_t prio;
+
+    /* Take highest ready priority each time, task may post to higher priority task */
+    while ((ready = Ready & Mask) != 0) {
+        prio = 31 - __CLZ(ready);
+
+        /* Clear ready bit before events are taken, so new posts set it again */
+        TM_SCHEDULER_INT_Take(&Ready, 1UL << prio);
+
+        /* Call tasks with events */
+        for (Task = Tasks[prio]; Task; Task = Task->Next) {
+            events = TM_SCHEDULER_INT_Take(&Task->Events, 0xFFFFFFFF);
+            if (!events) {
+                continue;
+            }
+
+            /* Call task */
+            if (Task->Func) {
+                Task->Func(Task->Param, events);
+            } else if (Task->Update) {
+                Task->Update();
+            }
+            calls++;
+        }
+    }
+
+    /* Return number of calls */
+    return calls;
+}
+
+static __INLINE void
+TM_SCHEDULER_INT_Or(volatile uint32_t* Value, uint32_t Bits) {
+    uint32_t old;
+
+    /* Retry if value was changed by interrupt */
+    do {
+        old = __LDREXW(Value);
+    } while (__STREXW(old | Bits, Value));
+}
+
+static __INLINE uint32_t
+TM_SCHEDULER_INT_Take(volatile uint32_t* Value, uint32_t Bits) {
+    uint32_t old;
+
+    /* Clear bits and return old value of them, retry if value was changed by interrupt */
+    do {
+        old = __LDREXW(Value);
+    } while (__STREXW(old & ~Bits, Value));
+
+    return old & Bits;
+}
@@ -0,0 +1,302 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Cooperative run to completion scheduler with priorities and event posting from interrupts
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_SCHEDULER_H
+#define TM_SCHEDULER_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_SCHEDULER
+ * @brief    Cooperative run to completion scheduler with priorities and event posting from interrupts
+ * @{
+ *
+ * In while(1) loop with many update functions, each function waits for all others before it is called again.
+ * Scheduler calls task functions only when they have something to do and always calls task with the highest priority first.
+ *
+ * \par Tasks
+ *
+ * Task is a function which is called with events posted to it. It must return as soon as work is done (run to completion),
+ * it can't wait in a loop like in RTOS, because all tasks use the same stack.
+ *
+ * Each task has priority from 0 (lowest) to TM_SCHEDULER_PRIORITIES - 1 (highest).
+ * Events are bits in 32-bit value. Events posted to the same task before task is called are combined together.
+ *
+ *  - Tasks with priority lower than TM_SCHEDULER_PREEMPT_PRIORITY are called from main loop with @ref TM_SCHEDULER_Run.
+ *  - Tasks with priority TM_SCHEDULER_PREEMPT_PRIORITY or higher are called from PendSV interrupt.
+ *    PendSV has the lowest interrupt priority, so these tasks interrupt main loop tasks like SD card writes or display flushes,
+ *    but they are interrupted by all other interrupts.
+ *
+ * Tasks with the same priority don't interrupt each other.
+ *
+ * \par Posting events
+ *
+ * @ref TM_SCHEDULER_Post can be called from any interrupt or from task. It does not disable interrupts,
+ * events and ready flags are set with LDREX/STREX instructions.
+ *
+ * \par Periodic tasks
+ *
+ * Task can be called periodically with TM_DELAY custom timer, which posts TM_SCHEDULER_EVENT_TIMER event to task.
+ * Existing update functions, like TM_BUTTON_Update, are added with @ref TM_SCHEDULER_TaskInitUpdate:
+ *
+\code{.c}
+static TM_SCHEDULER_Task_t ButtonTask, GpsTask, UartTask;
+
+static void GpsUpdate(void* Param, uint32_t Events) {
+    TM_GPS_Update((TM_GPS_t *)Param);
+}
+
+static void UartReceive(void* Param, uint32_t Events) {
+    //Process received data
+}
+
+int main(void) {
+    SystemInit();
+    TM_DELAY_Init();
+    TM_SCHEDULER_Init();
+
+    //Buttons are checked every 10ms with priority 1
+    TM_SCHEDULER_TaskInitUpdate(&ButtonTask, TM_BUTTON_Update, 1, 10);
+
+    //GPS is checked every 5ms with priority 2
+    TM_SCHEDULER_TaskInit(&GpsTask, GpsUpdate, &GPS_Data, 2);
+    TM_SCHEDULER_TaskPeriodic(&GpsTask, 5);
+
+    //UART task with priority 4 is called from PendSV when interrupt posts an event
+    TM_SCHEDULER_TaskInit(&UartTask, UartReceive, NULL, 4);
+
+    //Call tasks forever, sleep when there is nothing to do
+    TM_SCHEDULER_Start();
+}
+
+//In USART interrupt
+TM_SCHEDULER_Post(&UartTask, 0x01);
+\endcode
+ *
+ * \par PendSV interrupt
+ *
+ * Library has PendSV_Handler function when TM_SCHEDULER_PREEMPT_PRIORITY is lower than TM_SCHEDULER_PRIORITIES.
+ * Remove PendSV_Handler from stm32f4xx_it.c file or set TM_SCHEDULER_PREEMPT_PRIORITY to TM_SCHEDULER_PRIORITIES
+ * when PendSV is used by something else, like RTOS. All tasks are then called from main loop.
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - TM DELAY
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "tm_stm32f4_delay.h"
+
+/**
+ * @defgroup TM_SCHEDULER_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Number of task priorities, maximal value is 32
+ */
+#ifndef TM_SCHEDULER_PRIORITIES
+#define TM_SCHEDULER_PRIORITIES          8
+#endif
+
+/**
+ * @brief  Tasks with this or higher priority are called from PendSV interrupt
+ * @note   Set to TM_SCHEDULER_PRIORITIES to call all tasks from main loop and not use PendSV
+ */
+#ifndef TM_SCHEDULER_PREEMPT_PRIORITY
+#define TM_SCHEDULER_PREEMPT_PRIORITY    4
+#endif
+
+/**
+ * @brief  Set to 1 to skip delay ticks with TM_DELAY tickless idle when there is no task to call
+ */
+#ifndef TM_SCHEDULER_TICKLESS
+#define TM_SCHEDULER_TICKLESS            0
+#endif
+
+/* Check settings */
+#if TM_SCHEDULER_PRIORITIES > 32
+#error "TM_SCHEDULER_PRIORITIES can be 32 or less"
+#endif
+#if TM_SCHEDULER_PREEMPT_PRIORITY > TM_SCHEDULER_PRIORITIES
+#error "TM_SCHEDULER_PREEMPT_PRIORITY can't be higher than TM_SCHEDULER_PRIORITIES"
+#endif
+
+/**
+ * @brief  Event posted by task timer, other bits are free for user events
+ */
+#define TM_SCHEDULER_EVENT_TIMER         0x80000000
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_SCHEDULER_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Task function
+ * @param  *Param: Parameter set on task initialization
+ * @param  Events: All events posted to task since last call
+ * @retval None
+ */
+typedef void (*TM_SCHEDULER_Func_t)(void* Param, uint32_t Events);
+
+/**
+ * @brief  Task structure
+ * @note   Structure must stay in memory while task is used, use static or global variable
+ */
+typedef struct _TM_SCHEDULER_Task_t {
+    TM_SCHEDULER_Func_t Func;                /*!< Task function */
+    void (*Update)(void);                    /*!< Update function without parameters, used when Func is NULL */
+    void* Param;                             /*!< Parameter for task function */
+    volatile uint32_t Events;                /*!< Events posted to task and not processed yet */
+    uint8_t Priority;                        /*!< Task priority, higher value means higher priority */
+    TM_DELAY_Timer_t Timer;                  /*!< Timer for periodic task */
+    struct _TM_SCHEDULER_Task_t* Next;       /*!< Next task with the same priority. Used private */
+} TM_SCHEDULER_Task_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_SCHEDULER_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes scheduler and sets PendSV to the lowest interrupt priority
+ * @note   Call @ref TM_DELAY_Init before if periodic tasks are used
+ * @param  None
+ * @retval None
+ */
+void TM_SCHEDULER_Init(void);
+
+/**
+ * @brief  Initializes task and adds it to scheduler
+ * @param  *Task: Pointer to @ref TM_SCHEDULER_Task_t structure
+ * @param  Func: Task function
+ * @param  *Param: Parameter passed to task function
+ * @param  Priority: Task priority, from 0 to TM_SCHEDULER_PRIORITIES - 1
+ * @retval Task added:
+ *            - 0: Priority is not valid
+ *            - > 0: Task added
+ */
+uint8_t TM_SCHEDULER_TaskInit(TM_SCHEDULER_Task_t* Task, TM_SCHEDULER_Func_t Func, void* Param, uint8_t Priority);
+
+/**
+ * @brief  Initializes periodic task for update function without parameters, like TM_BUTTON_Update
+ * @param  *Task: Pointer to @ref TM_SCHEDULER_Task_t structure
+ * @param  Update: Update function
+ * @param  Priority: Task priority, from 0 to TM_SCHEDULER_PRIORITIES - 1
+ * @param  Period: Period in milliseconds, 0 if task is called only when events are posted
+ * @retval Task added:
+ *            - 0: Priority is not valid
+ *            - > 0: Task added
+ */
+uint8_t TM_SCHEDULER_TaskInitUpdate(TM_SCHEDULER_Task_t* Task, void (*Update)(void), uint8_t Priority, uint32_t Period);
+
+/**
+ * @brief  Sets period for task
+ * @note   Task gets TM_SCHEDULER_EVENT_TIMER event from TM_DELAY custom timer
+ * @param  *Task: Pointer to @ref TM_SCHEDULER_Task_t structure
+ * @param  Period: Period in milliseconds, 0 to stop periodic calls
+ * @retval None
+ */
+void TM_SCHEDULER_TaskPeriodic(TM_SCHEDULER_Task_t* Task, uint32_t Period);
+
+/**
+ * @brief  Posts events to task
+ * @note   This function can be called from any interrupt or task
+ * @param  *Task: Pointer to @ref TM_SCHEDULER_Task_t structure
+ * @param  Events: Events to post, can't be 0
+ * @retval None
+ */
+void TM_SCHEDULER_Post(TM_SCHEDULER_Task_t* Task, uint32_t Events);
+
+/**
+ * @brief  Calls all ready tasks with priority lower than TM_SCHEDULER_PREEMPT_PRIORITY
+ * @note   Use this function in your own main loop, when @ref TM_SCHEDULER_Start is not used
+ * @param  None
+ * @retval Number of task calls
+ */
+uint32_t TM_SCHEDULER_Run(void);
+
+/**
+ * @brief  Calls ready tasks forever and sleeps when there is nothing to do
+ * @note   With TM_SCHEDULER_TICKLESS set to 1, delay ticks are skipped in sleep
+ * @param  None
+ * @retval None
+ */
+void TM_SCHEDULER_Start(void);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
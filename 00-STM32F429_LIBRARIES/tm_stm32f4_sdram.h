@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/05/library-14-working-with-sdram-on-stm32f429-discovery/
- * @version v1.3
+ * @version v1.4
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   External SDRAM for STM32F429-Discovery or STM324x9-EVAL boards
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_SDRAM_H
-#define TM_SDRAM_H 130
+#define TM_SDRAM_H 140
 /**
  * @addtogroup TM_STM32F4xx_Libraries
  * @{
@@ -89,11 +89,32 @@ PD15 <-> FMC_D1   | PE11 <-> FMC_D8    | PF11 <-> FC_NRAS   | PH11 <-> FMC_D19
                   | PE13 <-> FMC_D10   | PF13 <-> FMC_A7    |                    | PH14 <-> FMC_D22   | PI9  <-> FMC_D30
                   | PE14 <-> FMC_D11   | PF14 <-> FMC_A8    |                    | PH15 <-> FMC_D23   | PI10 <-> FMC_D31
                   | PE15 <-> FMC_D12   | PF15 <-> FMC_A9    |                    |                    |
+@endverbatim
+ *
+ * \par SDRAM memory map
+ *
+ * Libraries which use SDRAM take their memory from this map, so they do not overlap when used together.
+ * Offsets are from SDRAM_START_ADR, each can be changed in defines.h file:
+ *
+@verbatim
+Offset                Size                  Used by
+0x000000              SDRAM_LCD_SIZE        TM ILI9341 LTDC layers and frame buffers, TM ILI9341 shadow buffer (0x25800 bytes)
+SDRAM_OVERLAY_OFFSET  SDRAM_OVERLAY_SIZE    TM SPRITE overlay layer, 240 * 320 ARGB8888 pixels
+SDRAM_HEAP_OFFSET     to the end            TM HEAP SDRAM heap
+
+With default settings:
+0x000000 - 0x096000   LCD, 4 buffers of 240 * 320 * 2 bytes
+0x096000 - 0x0E1000   Sprite overlay
+0x0E1000 - 0x800000   Heap, about 7.1MB
 @endverbatim
  *
  * \par Changelog
  *
 @verbatim
+ Version 1.4
+  - October 16, 2026
+  - Added SDRAM memory map for LCD, sprite overlay and heap
+
  Version 1.3
   - March 19, 2015
   - Added support for STM324x9_EVAL board
@@ -203,6 +224,36 @@ PD15 <-> FMC_D1   | PE11 <-> FMC_D8    | PF11 <-> FC_NRAS   | PH11 <-> FMC_D19
 /* Timeout for SDRAM initialization */
 #define SDRAM_TIMEOUT                   ((uint32_t)0xFFFF)
 
+/**
+ * @brief  Size of SDRAM memory for LCD at SDRAM start
+ * @note   Each frame buffer is 240 * 320 * 2 = 0x25800 bytes. Layer 1, layer 2 and 2 more buffers for triple buffering are kept
+ *         by default, with ILI9341_FRAME_BUFFERS set in defines.h size is calculated from it
+ */
+#ifndef SDRAM_LCD_SIZE
+#if defined(ILI9341_USE_BUFFERING) && defined(ILI9341_FRAME_BUFFERS) && ILI9341_FRAME_BUFFERS > 3
+#define SDRAM_LCD_SIZE                  ((ILI9341_FRAME_BUFFERS + 1) * 0x25800)
+#else
+#define SDRAM_LCD_SIZE                  (4 * 0x25800)
+#endif
+#endif
+
+/**
+ * @brief  Offset and size of sprite overlay layer, right after LCD memory
+ */
+#ifndef SDRAM_OVERLAY_OFFSET
+#define SDRAM_OVERLAY_OFFSET            (SDRAM_LCD_SIZE)
+#endif
+#ifndef SDRAM_OVERLAY_SIZE
+#define SDRAM_OVERLAY_SIZE              (240 * 320 * 4)
+#endif
+
+/**
+ * @brief  Offset of SDRAM heap, heap goes from here to the end of SDRAM
+ */
+#ifndef SDRAM_HEAP_OFFSET
+#define SDRAM_HEAP_OFFSET               (SDRAM_OVERLAY_OFFSET + SDRAM_OVERLAY_SIZE)
+#endif
+
 /**
  * @}
  */
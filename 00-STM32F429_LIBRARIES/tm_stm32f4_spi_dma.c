@@ -131,6 +131,11 @@ TM_SPI_DMA_Transmit(SPI_TypeDef* SPIx, uint8_t* TX_Buffer, uint8_t* RX_Buffer, u
         return 0;
     }
 
+    /* DMA can't access CCM RAM */
+    if (TM_IS_CCM(TX_Buffer) || TM_IS_CCM(RX_Buffer)) {
+        return 0;
+    }
+
     /* Set dummy memory to default */
     Settings->Dummy16 = 0x00;
 
@@ -276,6 +281,46 @@ TM_SPI_DMA_SendHalfWord(SPI_TypeDef* SPIx, uint16_t value, uint16_t count) {
     return 1;
 }
 
+uint8_t
+TM_SPI_DMA_Send16(SPI_TypeDef* SPIx, uint16_t* TX_Buffer, uint16_t count) {
+    /* Get SPI settings */
+    TM_SPI_DMA_INT_t* Settings = TM_SPI_DMA_INT_GetSettings(SPIx);
+
+    /* Check if DMA available */
+    if (Settings->TX_Stream->NDTR || TX_Buffer == NULL || TM_IS_CCM(TX_Buffer)) {
+        return 0;
+    }
+
+    /* Set DMA peripheral address, number of half words and enable memory increase pointer */
+    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t) &SPIx->DR;
+    DMA_InitStruct.DMA_BufferSize = count;
+    DMA_InitStruct.DMA_Memory0BaseAddr = (uint32_t) TX_Buffer;
+    DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;
+
+    /* Configure TX DMA */
+    DMA_InitStruct.DMA_Channel = Settings->TX_Channel;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+
+    /* Set memory size */
+    DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+
+    /* Deinit first TX stream */
+    TM_DMA_ClearFlag(Settings->TX_Stream, DMA_FLAG_ALL);
+
+    /* Init TX stream */
+    DMA_Init(Settings->TX_Stream, &DMA_InitStruct);
+
+    /* Enable TX stream */
+    Settings->TX_Stream->CR |= DMA_SxCR_EN;
+
+    /* Enable SPI TX DMA */
+    SPIx->CR2 |= SPI_CR2_TXDMAEN;
+
+    /* Return OK */
+    return 1;
+}
+
 uint8_t
 TM_SPI_DMA_Working(SPI_TypeDef* SPIx) {
     /* Get SPI settings */
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/04/library-56-extend-spi-with-dma-for-stm32f4xx
- * @version v1.1.1
+ * @version v1.3
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   DMA functionality for TM SPI library
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_SPI_DMA_H
-#define TM_SPI_DMA_H 111
+#define TM_SPI_DMA_H 130
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -69,6 +69,14 @@ SPI6     | DMA2 | DMA Stream 5  | DMA Channel 1  | DMA Stream 6  | DMA Channel 0
  * \par Changelog
  *
 @verbatim
+ Version 1.3
+  - October 16, 2026
+  - Transmit functions return 0 for buffers in CCM RAM, because DMA can't access it
+
+ Version 1.2
+  - October 16, 2026
+  - Added TM_SPI_DMA_Send16() function for sending half word buffers
+
  Version 1.1.1
   - August 11, 2015
   - Fixed bug with default TX Stream value for SPI4
@@ -89,6 +97,7 @@ SPI6     | DMA2 | DMA Stream 5  | DMA Channel 1  | DMA Stream 6  | DMA Channel 0
  - defines.h
  - TM DMA
  - TM SPI
+ - attributes.h
  - stdlib.h
 @endverbatim
  */
@@ -97,6 +106,7 @@ SPI6     | DMA2 | DMA Stream 5  | DMA Channel 1  | DMA Stream 6  | DMA Channel 0
 #include "defines.h"
 #include "tm_stm32f4_dma.h"
 #include "tm_stm32f4_spi.h"
+#include "attributes.h"
 #include "stdlib.h"
 
 /**
@@ -218,7 +228,8 @@ void TM_SPI_DMA_Deinit(SPI_TypeDef* SPIx);
 
 /**
  * @brief  Transmits (exchanges) data over SPI with DMA
- * @note   Try not to use local variables pointers for DMA memory as TX and RX Buffers
+ * @note   Try not to use local variables pointers for DMA memory as TX and RX Buffers.
+ *         Buffers in CCM RAM are not allowed, DMA can't access this memory
  * @param  *SPIx: Pointer to SPIx where DMA transmission will happen
  * @param  *TX_Buffer: Pointer to TX_Buffer where DMA will take data to sent over SPI.
  *            Set this parameter to NULL, if you want to sent "0x00" and only receive data into *RX_Buffer pointer
@@ -279,6 +290,20 @@ uint8_t TM_SPI_DMA_SendByte(SPI_TypeDef* SPIx, uint8_t value, uint16_t count);
  */
 uint8_t TM_SPI_DMA_SendHalfWord(SPI_TypeDef* SPIx, uint16_t value, uint16_t count);
 
+/**
+ * @brief  Sends buffer of half words over SPI without receiving data back using DMA
+ * @note   SPI must be in 16-bit data mode before you call this function
+ * @note   Try not to use local variables pointers for DMA memory as TX Buffer. CCM RAM can not be used as source,
+ *         function returns 0 in this case
+ * @param  *SPIx: Pointer to SPIx where DMA transmission will happen
+ * @param  *TX_Buffer: Pointer to half word buffer where DMA will take data to sent over SPI
+ * @param  count: Number of half words to be sent over SPI with DMA
+ * @retval Sending started status:
+ *            - 0: DMA has not started with sending data
+ *            - > 0: DMA has started with sending data
+ */
+uint8_t TM_SPI_DMA_Send16(SPI_TypeDef* SPIx, uint16_t* TX_Buffer, uint16_t count);
+
 /**
  * @brief  Checks if SPI DMA is still sending/receiving data
  * @param  *SPIx: Pointer to SPIx where you want to enable DMA TX mode
@@ -0,0 +1,233 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_sprite.h"
+
+/**
+ * @brief  Overlay settings
+ * @note   Used private
+ */
+typedef struct {
+    uint16_t Width;  /*!< Overlay width, the same as layer 1 */
+    uint16_t Height; /*!< Overlay height, the same as layer 1 */
+    uint16_t HStart; /*!< First horizontal pixel of layer 1 window, including back porch */
+    uint16_t VStart; /*!< First vertical line of layer 1 window, including back porch */
+} TM_SPRITE_Overlay_t;
+
+static TM_SPRITE_Overlay_t Overlay;
+
+/* Overlay pixel address */
+#define SPRITE_PIXEL_ADDR(x, y)     ((uint32_t *)SPRITE_OVERLAY_ADDR + (uint32_t)(y) * Overlay.Width + (x))
+
+/* Private functions */
+static void TM_SPRITE_INT_Draw(TM_SPRITE_t* Sprite, int16_t x, int16_t y);
+static void TM_SPRITE_INT_Restore(TM_SPRITE_t* Sprite);
+
+uint8_t
+TM_SPRITE_Init(void) {
+    /* Layer 1 must be configured by LCD library */
+    if (!(LTDC_Layer1->CR & LTDC_LxCR_LEN)) {
+        return 0;
+    }
+
+    /* Overlay has the same window as layer 1 */
+    Overlay.HStart = LTDC_Layer1->WHPCR & LTDC_LxWHPCR_WHSTPOS;
+    Overlay.VStart = LTDC_Layer1->WVPCR & LTDC_LxWVPCR_WVSTPOS;
+    Overlay.Width = ((LTDC_Layer1->WHPCR & LTDC_LxWHPCR_WHSPPOS) >> 16) - Overlay.HStart + 1;
+    Overlay.Height = ((LTDC_Layer1->WVPCR & LTDC_LxWVPCR_WVSPPOS) >> 16) - Overlay.VStart + 1;
+
+    /* Clear overlay before it is shown */
+    TM_SPRITE_Clear();
+
+    /* Layer 2 is ARGB8888, blended with pixel alpha over layer 1 */
+    LTDC_Layer2->CR = 0;
+    LTDC_Layer2->WHPCR = LTDC_Layer1->WHPCR;
+    LTDC_Layer2->WVPCR = LTDC_Layer1->WVPCR;
+    LTDC_Layer2->PFCR = LTDC_Pixelformat_ARGB8888;
+    LTDC_Layer2->CACR = 255;
+    LTDC_Layer2->DCCR = SPRITE_TRANSPARENT;
+    LTDC_Layer2->BFCR = LTDC_BlendingFactor1_PAxCA | LTDC_BlendingFactor2_PAxCA;
+    LTDC_Layer2->CFBAR = SPRITE_OVERLAY_ADDR;
+    LTDC_Layer2->CFBLR = ((uint32_t)Overlay.Width * 4 << 16) | ((uint32_t)Overlay.Width * 4 + 3);
+    LTDC_Layer2->CFBLNR = Overlay.Height;
+    LTDC_Layer2->CR = LTDC_LxCR_LEN;
+
+    /* Reload configuration */
+    LTDC->SRCR = LTDC_SRCR_IMR;
+
+    /* Return OK */
+    return 1;
+}
+
+void
+TM_SPRITE_Clear(void) {
+    /* Fill overlay with transparent color */
+    DMA2D_WAIT;
+    DMA2D->CR = DMA2D_R2M;
+    DMA2D->OPFCCR = DMA2D_ARGB8888;
+    DMA2D->OCOLR = SPRITE_TRANSPARENT;
+    DMA2D->OMAR = SPRITE_OVERLAY_ADDR;
+    DMA2D->OOR = 0;
+    DMA2D->NLR = ((uint32_t)Overlay.Width << 16) | Overlay.Height;
+    DMA2D->CR |= DMA2D_CR_START;
+    DMA2D_WAIT;
+}
+
+uint32_t*
+TM_SPRITE_GetOverlay(void) {
+    return (uint32_t *)SPRITE_OVERLAY_ADDR;
+}
+
+void
+TM_SPRITE_Show(TM_SPRITE_t* Sprite, int16_t x, int16_t y) {
+    /* Already shown */
+    if (Sprite->Visible) {
+        TM_SPRITE_Move(Sprite, x, y);
+        return;
+    }
+
+    /* Save and draw */
+    TM_SPRITE_INT_Draw(Sprite, x, y);
+    Sprite->Visible = 1;
+}
+
+void
+TM_SPRITE_Hide(TM_SPRITE_t* Sprite) {
+    /* Not shown */
+    if (!Sprite->Visible) {
+        return;
+    }
+
+    /* Restore old content */
+    TM_SPRITE_INT_Restore(Sprite);
+    Sprite->Visible = 0;
+}
+
+void
+TM_SPRITE_Move(TM_SPRITE_t* Sprite, int16_t x, int16_t y) {
+    /* Not shown or position not changed */
+    if (!Sprite->Visible || (Sprite->X == x && Sprite->Y == y)) {
+        return;
+    }
+
+    /* Restore old rectangle and draw on new position */
+    TM_SPRITE_INT_Restore(Sprite);
+    TM_SPRITE_INT_Draw(Sprite, x, y);
+}
+
+void
+TM_SPRITE_SetOverlayPosition(int16_t x, int16_t y) {
+    int16_t x0, y0, x1, y1;
+
+    /* Visible part of overlay, in background coordinates */
+    x0 = x < 0 ? 0 : x;
+    y0 = y < 0 ? 0 : y;
+    x1 = x + Overlay.Width > Overlay.Width ? Overlay.Width : x + Overlay.Width;
+    y1 = y + Overlay.Height > Overlay.Height ? Overlay.Height : y + Overlay.Height;
+
+    /* Overlay is completely outside */
+    if (x0 >= x1 || y0 >= y1) {
+        LTDC_Layer2->CR &= ~LTDC_LxCR_LEN;
+        LTDC->SRCR = LTDC_SRCR_VBR;
+        return;
+    }
+
+    /* Window position and first visible overlay pixel */
+    LTDC_Layer2->WHPCR = (Overlay.HStart + x0) | ((uint32_t)(Overlay.HStart + x1 - 1) << 16);
+    LTDC_Layer2->WVPCR = (Overlay.VStart + y0) | ((uint32_t)(Overlay.VStart + y1 - 1) << 16);
+    LTDC_Layer2->CFBAR = (uint32_t)SPRITE_PIXEL_ADDR(x0 - x, y0 - y);
+    LTDC_Layer2->CFBLR = ((uint32_t)Overlay.Width * 4 << 16) | ((uint32_t)(x1 - x0) * 4 + 3);
+    LTDC_Layer2->CFBLNR = y1 - y0;
+    LTDC_Layer2->CR |= LTDC_LxCR_LEN;
+
+    /* Reload on vertical blanking */
+    LTDC->SRCR = LTDC_SRCR_VBR;
+}
+
+void
+TM_SPRITE_SetOverlayOpacity(uint8_t opacity) {
+    /* Set constant alpha */
+    LTDC_Layer2->CACR = opacity;
+
+    /* Reload on vertical blanking */
+    LTDC->SRCR = LTDC_SRCR_VBR;
+}
+
+void
+TM_SPRITE_WaitBlanking(void) {
+    /* Wait till vertical data enable is low */
+    while (LTDC->CDSR & LTDC_CDSR_VDES);
+}
+
+/* Private functions */
+static void
+TM_SPRITE_INT_Draw(TM_SPRITE_t* Sprite, int16_t x, int16_t y) {
+    int16_t x0, y0, x1, y1;
+    uint32_t* pDst;
+    const uint8_t* pSrc;
+
+    /* Save new position */
+    Sprite->X = x;
+    Sprite->Y = y;
+
+    /* Clip sprite to overlay */
+    x0 = x < 0 ? 0 : x;
+    y0 = y < 0 ? 0 : y;
+    x1 = x + Sprite->Width > Overlay.Width ? Overlay.Width : x + Sprite->Width;
+    y1 = y + Sprite->Height > Overlay.Height ? Overlay.Height : y + Sprite->Height;
+
+    /* Nothing is visible */
+    if (x0 >= x1 || y0 >= y1) {
+        Sprite->SaveWidth = 0;
+        return;
+    }
+
+    /* Save rectangle */
+    Sprite->SaveX = x0;
+    Sprite->SaveY = y0;
+    Sprite->SaveWidth = x1 - x0;
+    Sprite->SaveHeight = y1 - y0;
+
+    /* Save overlay content under sprite */
+    pDst = SPRITE_PIXEL_ADDR(x0, y0);
+    TM_DMA2DGRAPHIC_Convert(pDst, CM_ARGB8888, Sprite->SaveUnder, CM_ARGB8888, Sprite->SaveWidth, Sprite->SaveHeight, Overlay.Width - Sprite->SaveWidth, 0);
+
+    /* First visible image pixel, 4 bytes per pixel for ARGB8888, 2 bytes for 16-bit formats */
+    pSrc = (const uint8_t *)Sprite->Image + ((uint32_t)(y0 - y) * Sprite->Width + (x0 - x)) * (Sprite->Format == CM_ARGB8888 ? 4 : 2);
+
+    /* Blend sprite over overlay content */
+    TM_DMA2DGRAPHIC_Blend(
+        pSrc, Sprite->Format,
+        pDst, CM_ARGB8888,
+        pDst, CM_ARGB8888,
+        Sprite->SaveWidth, Sprite->SaveHeight,
+        Sprite->Width - Sprite->SaveWidth, Overlay.Width - Sprite->SaveWidth, Overlay.Width - Sprite->SaveWidth,
+        DMA2D_GRAPHIC_ALPHA_PIXEL
+    );
+}
+
+static void
+TM_SPRITE_INT_Restore(TM_SPRITE_t* Sprite) {
+    /* Sprite was outside overlay */
+    if (!Sprite->SaveWidth) {
+        return;
+    }
+
+    /* Copy saved content back */
+    TM_DMA2DGRAPHIC_Convert(Sprite->SaveUnder, CM_ARGB8888, SPRITE_PIXEL_ADDR(Sprite->SaveX, Sprite->SaveY), CM_ARGB8888, Sprite->SaveWidth, Sprite->SaveHeight, 0, Overlay.Width - Sprite->SaveWidth);
+}
@@ -0,0 +1,267 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Sprite compositor with 2 LTDC layers and DMA2D blending
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_SPRITE_H
+#define TM_SPRITE_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_SPRITE
+ * @brief    Sprite compositor with 2 LTDC layers and DMA2D blending
+ * @{
+ *
+ * Library uses LTDC layer 1 as static background and LTDC layer 2 as overlay for moving sprites,
+ * like cursors, markers or gauge needles. Background is drawn only once with LCD library,
+ * and LTDC hardware blends overlay over it on every frame.
+ *
+ * Overlay layer is in ARGB8888 format. Transparent pixels show background,
+ * so sprites with soft edges look correct over any background.
+ *
+ * \par How it works
+ *
+ * Before sprite is drawn to overlay, overlay content under sprite is saved to sprite's save-under buffer.
+ * When sprite moves, only old rectangle is restored from save-under buffer and sprite is blended
+ * with DMA2D to new position. Moving sprite costs 3 small DMA2D transfers instead of full screen redraw.
+ *
+ * If sprites overlap, hide them in reverse order than they were shown, otherwise save-under buffers restore wrong content.
+ *
+ * Complete overlay layer can also be moved with LTDC window registers, without any memory transfer.
+ * This is useful for cheap scrolling of overlay content.
+ *
+ * \par Usage
+ *
+@verbatim
+//Draw background with LCD library first, then init compositor
+TM_ILI9341_Init();
+TM_ILI9341_Fill(ILI9341_COLOR_BLUE);
+TM_SPRITE_Init();
+
+//Sprite with 32x32 ARGB8888 image and save-under buffer of the same size
+uint32_t CursorSave[32 * 32];
+TM_SPRITE_t Cursor = {CursorImage, CursorSave, CM_ARGB8888, 32, 32};
+
+TM_SPRITE_Show(&Cursor, 100, 100);
+while (1) {
+    TM_SPRITE_WaitBlanking();
+    TM_SPRITE_Move(&Cursor, x, y);
+}
+@endverbatim
+ *
+ * @note  Coordinates are in LTDC memory orientation, LCD library rotation is not used
+ * @note  Don't use layer 2 functions from LCD libraries when compositor is active
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - STM32F4xx LTDC
+ - STM32F4xx DMA2D
+ - defines.h
+ - TM SDRAM
+ - TM DMA2D GRAPHIC
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "stm32f4xx_ltdc.h"
+#include "stm32f4xx_dma2d.h"
+#include "defines.h"
+#include "tm_stm32f4_sdram.h"
+#include "tm_stm32f4_dma2d_graphic.h"
+
+/**
+ * @defgroup TM_SPRITE_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Overlay layer memory address
+ * @note   Width * Height * 4 bytes are used, by default it is placed between LCD framebuffers and SDRAM heap,
+ *         see SDRAM memory map in TM SDRAM library
+ */
+#ifndef SPRITE_OVERLAY_ADDR
+#define SPRITE_OVERLAY_ADDR         (SDRAM_START_ADR + SDRAM_OVERLAY_OFFSET)
+#endif
+
+/**
+ * @brief  Transparent overlay pixel in ARGB8888 format
+ */
+#define SPRITE_TRANSPARENT          0x00000000
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_SPRITE_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Sprite structure
+ * @note   Image, SaveUnder, Format, Width and Height are set by user, other members are used by library
+ */
+typedef struct {
+    const void* Image;   /*!< Pointer to sprite image, Width * Height pixels in Format pixel format */
+    uint32_t* SaveUnder; /*!< Pointer to save-under buffer for Width * Height ARGB8888 pixels. Must be in memory, reachable by DMA2D */
+    uint32_t Format;     /*!< Image pixel format with alpha: CM_ARGB8888, CM_ARGB1555 or CM_ARGB4444 */
+    uint16_t Width;      /*!< Sprite width in pixels */
+    uint16_t Height;     /*!< Sprite height in pixels */
+    int16_t X;           /*!< Current X position on overlay, can be outside overlay */
+    int16_t Y;           /*!< Current Y position on overlay, can be outside overlay */
+    uint8_t Visible;     /*!< Set to 1 when sprite is shown */
+    uint16_t SaveX;      /*!< X position of saved rectangle on overlay */
+    uint16_t SaveY;      /*!< Y position of saved rectangle on overlay */
+    uint16_t SaveWidth;  /*!< Width of saved rectangle, 0 when sprite is outside overlay */
+    uint16_t SaveHeight; /*!< Height of saved rectangle */
+} TM_SPRITE_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_SPRITE_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes LTDC layer 2 as transparent ARGB8888 overlay over layer 1
+ * @note   LCD library must configure LTDC before, overlay gets the same size and position as layer 1
+ * @param  None
+ * @retval Initialization status:
+ *           - 0: LTDC layer 1 is not enabled
+ *           - > 0: Compositor ready
+ */
+uint8_t TM_SPRITE_Init(void);
+
+/**
+ * @brief  Clears complete overlay to transparent color
+ * @note   Sprites are not shown anymore after this, but their Visible flag is not cleared
+ * @param  None
+ * @retval None
+ */
+void TM_SPRITE_Clear(void);
+
+/**
+ * @brief  Gets pointer to overlay memory for drawing static overlay content
+ * @note   Overlay is in ARGB8888 format, with width of LTDC layer 1
+ * @param  None
+ * @retval Pointer to overlay pixel 0,0
+ */
+uint32_t* TM_SPRITE_GetOverlay(void);
+
+/**
+ * @brief  Saves overlay content and draws sprite on new position
+ * @param  *Sprite: Pointer to @ref TM_SPRITE_t structure
+ * @param  x: X position of top left sprite pixel, can be negative
+ * @param  y: Y position of top left sprite pixel, can be negative
+ * @retval None
+ */
+void TM_SPRITE_Show(TM_SPRITE_t* Sprite, int16_t x, int16_t y);
+
+/**
+ * @brief  Restores overlay content under sprite
+ * @param  *Sprite: Pointer to @ref TM_SPRITE_t structure
+ * @retval None
+ */
+void TM_SPRITE_Hide(TM_SPRITE_t* Sprite);
+
+/**
+ * @brief  Moves visible sprite to new position
+ * @note   Only old sprite rectangle is restored and sprite is blended to new position
+ * @param  *Sprite: Pointer to @ref TM_SPRITE_t structure
+ * @param  x: New X position of top left sprite pixel, can be negative
+ * @param  y: New Y position of top left sprite pixel, can be negative
+ * @retval None
+ */
+void TM_SPRITE_Move(TM_SPRITE_t* Sprite, int16_t x, int16_t y);
+
+/**
+ * @brief  Moves complete overlay layer relative to background with LTDC window registers
+ * @note   Overlay memory is not changed. Parts of overlay outside LCD are not shown.
+ *         New position is used from next vertical blanking
+ * @param  x: Overlay X offset in pixels, can be negative
+ * @param  y: Overlay Y offset in pixels, can be negative
+ * @retval None
+ */
+void TM_SPRITE_SetOverlayPosition(int16_t x, int16_t y);
+
+/**
+ * @brief  Sets opacity of complete overlay layer
+ * @param  opacity: Opacity, 0 = overlay is not visible, 255 = pixel alpha values only
+ * @retval None
+ */
+void TM_SPRITE_SetOverlayOpacity(uint8_t opacity);
+
+/**
+ * @brief  Waits till LTDC is in vertical blanking period
+ * @note   Move sprites after this function to avoid flickering, when sprite is restored but not yet drawn on new position
+ * @param  None
+ * @retval None
+ */
+void TM_SPRITE_WaitBlanking(void);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -19,12 +19,25 @@
 #include "tm_stm32f4_ssd1306.h"
 
 /* Write command */
-#define SSD1306_WRITECOMMAND(command)      TM_I2C_Write(SSD1306_I2C, SSD1306_I2C_ADDR, 0x00, (command))
+#if SSD1306_USE_SPI
+#define SSD1306_WRITECOMMAND(command)      TM_SSD1306_INT_SPICommand(command)
+#else
+#define SSD1306_WRITECOMMAND(command)      TM_SSD1306_INT_I2CCommand(command)
+#endif
 /* Write data */
 #define SSD1306_WRITEDATA(data)            TM_I2C_Write(SSD1306_I2C, SSD1306_I2C_ADDR, 0x40, (data))
 /* Absolute value */
 #define ABS(x)   ((x) > 0 ? (x) : -(x))
 
+/* SPI pins */
+#define SSD1306_CS_LOW                     GPIO_ResetBits(SSD1306_CS_PORT, SSD1306_CS_PIN)
+#define SSD1306_CS_HIGH                    GPIO_SetBits(SSD1306_CS_PORT, SSD1306_CS_PIN)
+#define SSD1306_DC_LOW                     GPIO_ResetBits(SSD1306_DC_PORT, SSD1306_DC_PIN)
+#define SSD1306_DC_HIGH                    GPIO_SetBits(SSD1306_DC_PORT, SSD1306_DC_PIN)
+
+/* Number of 8 pixels high pages */
+#define SSD1306_PAGES                      (SSD1306_HEIGHT / 8)
+
 /* SSD1306 data buffer */
 static uint8_t SSD1306_Buffer[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
 
@@ -36,14 +49,74 @@ typedef struct {
     uint8_t Initialized;
 } SSD1306_t;
 
+/**
+ * @brief  Column range of one page which has to be sent to LCD
+ * @note   Used private
+ */
+typedef struct {
+    uint8_t X0; /*!< First changed column */
+    uint8_t X1; /*!< Last changed column, page is not changed when X0 > X1 */
+} SSD1306_Dirty_t;
+
+/**
+ * @brief  Asynchronous update state
+ * @note   Used private
+ */
+typedef struct {
+    SSD1306_Dirty_t Pages[SSD1306_PAGES]; /*!< Column ranges taken from dirty pages when update started */
+    uint8_t Cmd[6];                        /*!< Column and page address commands for current page */
+    uint8_t Page;                          /*!< Page which is currently sent */
+    uint8_t Data;                          /*!< 0 when commands are sent, 1 when page data are sent */
+    volatile uint8_t Working;              /*!< Set to 1 when update is in progress */
+} SSD1306_Update_t;
+
 /* Private variable */
 static SSD1306_t SSD1306;
+static SSD1306_Dirty_t SSD1306_Dirty[SSD1306_PAGES];
+#if SSD1306_USE_DMA
+static SSD1306_Update_t SSD1306_Update;
+#endif
+
+/* Private functions */
+static void TM_SSD1306_INT_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color);
+static void TM_SSD1306_INT_SetDirty(uint8_t x0, uint8_t x1, uint8_t page);
+static void TM_SSD1306_INT_SetAllDirty(void);
+static uint8_t TM_SSD1306_INT_SetWindowCmd(uint8_t* cmd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1);
+#if SSD1306_USE_SPI
+static void TM_SSD1306_INT_SPICommand(uint8_t command);
+#else
+static void TM_SSD1306_INT_I2CCommand(uint8_t command);
+#endif
+#if SSD1306_USE_DMA && !SSD1306_USE_SPI
+static uint8_t TM_SSD1306_INT_NextPage(void);
+#endif
+
+/* Device for scanline fill engine */
+static TM_SCANLINE_t SSD1306_Scanline = {TM_SSD1306_INT_Span, SSD1306_WIDTH, SSD1306_HEIGHT};
 
 uint8_t
 TM_SSD1306_Init(void) {
     /* Init delay */
     TM_DELAY_Init();
 
+#if SSD1306_USE_SPI
+    /* Init control pins */
+    TM_GPIO_Init(SSD1306_CS_PORT, SSD1306_CS_PIN, TM_GPIO_Mode_OUT, TM_GPIO_OType_PP, TM_GPIO_PuPd_NOPULL, TM_GPIO_Speed_Medium);
+    TM_GPIO_Init(SSD1306_DC_PORT, SSD1306_DC_PIN, TM_GPIO_Mode_OUT, TM_GPIO_OType_PP, TM_GPIO_PuPd_NOPULL, TM_GPIO_Speed_Medium);
+    TM_GPIO_Init(SSD1306_RST_PORT, SSD1306_RST_PIN, TM_GPIO_Mode_OUT, TM_GPIO_OType_PP, TM_GPIO_PuPd_UP, TM_GPIO_Speed_Low);
+    SSD1306_CS_HIGH;
+
+    /* Init SPI */
+    TM_SPI_Init(SSD1306_SPI, SSD1306_SPI_PINSPACK);
+#if SSD1306_USE_DMA
+    TM_SPI_DMA_Init(SSD1306_SPI);
+#endif
+
+    /* Reset LCD, it can't be detected on SPI */
+    GPIO_ResetBits(SSD1306_RST_PORT, SSD1306_RST_PIN);
+    Delayms(1);
+    GPIO_SetBits(SSD1306_RST_PORT, SSD1306_RST_PIN);
+#else
     /* Init I2C */
     TM_I2C_Init(SSD1306_I2C, SSD1306_I2C_PINSPACK, 400000);
 
@@ -53,13 +126,39 @@ TM_SSD1306_Init(void) {
         return 0;
     }
 
+#if SSD1306_USE_DMA
+    {
+        DMA_InitTypeDef DMA_InitStruct;
+        NVIC_InitTypeDef NVIC_InitStruct;
+
+        /* DMA stream for I2C TX, memory address and count are set for each transfer */
+        RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+        DMA_StructInit(&DMA_InitStruct);
+        DMA_InitStruct.DMA_Channel = SSD1306_DMA_CHANNEL;
+        DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t) &SSD1306_I2C->DR;
+        DMA_InitStruct.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+        DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;
+        DMA_InitStruct.DMA_Priority = DMA_Priority_Low;
+        DMA_DeInit(SSD1306_DMA_STREAM);
+        DMA_Init(SSD1306_DMA_STREAM, &DMA_InitStruct);
+
+        /* I2C events drive update from interrupt */
+        NVIC_InitStruct.NVIC_IRQChannel = SSD1306_I2C_IRQ;
+        NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = SSD1306_NVIC_PRIORITY;
+        NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+        NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+        NVIC_Init(&NVIC_InitStruct);
+    }
+#endif
+#endif
+
     /* A little delay */
     Delayms(100);
 
     /* Init LCD */
     SSD1306_WRITECOMMAND(0xAE); //display off
     SSD1306_WRITECOMMAND(0x20); //Set Memory Addressing Mode
-    SSD1306_WRITECOMMAND(0x10); //00,Horizontal Addressing Mode;01,Vertical Addressing Mode;10,Page Addressing Mode (RESET);11,Invalid
+    SSD1306_WRITECOMMAND(0x00); //00,Horizontal Addressing Mode;01,Vertical Addressing Mode;10,Page Addressing Mode (RESET);11,Invalid
     SSD1306_WRITECOMMAND(0xB0); //Set Page Start Address for Page Addressing Mode,0-7
     SSD1306_WRITECOMMAND(0xC8); //Set COM Output Scan Direction
     SSD1306_WRITECOMMAND(0x00); //---set low column address
@@ -105,16 +204,133 @@ TM_SSD1306_Init(void) {
 
 void
 TM_SSD1306_UpdateScreen(void) {
+    uint8_t cmd[6];
+    uint8_t m, n;
+
+    /* Wait for DMA update to finish */
+    while (TM_SSD1306_UpdateScreenWorking());
+
+    /* Send only changed columns of changed pages */
+    for (m = 0; m < SSD1306_PAGES; m++) {
+        if (SSD1306_Dirty[m].X0 > SSD1306_Dirty[m].X1) {
+            continue;
+        }
+
+        /* Set column and page window */
+        n = TM_SSD1306_INT_SetWindowCmd(cmd, SSD1306_Dirty[m].X0, SSD1306_Dirty[m].X1, m, m);
+
+#if SSD1306_USE_SPI
+        SSD1306_CS_LOW;
+        SSD1306_DC_LOW;
+        TM_SPI_WriteMulti(SSD1306_SPI, cmd, 6);
+        SSD1306_DC_HIGH;
+        TM_SPI_WriteMulti(SSD1306_SPI, &SSD1306_Buffer[SSD1306_WIDTH * m + SSD1306_Dirty[m].X0], n);
+        SSD1306_CS_HIGH;
+#else
+        TM_I2C_WriteMulti(SSD1306_I2C, SSD1306_I2C_ADDR, 0x00, cmd, 6);
+        TM_I2C_WriteMulti(SSD1306_I2C, SSD1306_I2C_ADDR, 0x40, &SSD1306_Buffer[SSD1306_WIDTH * m + SSD1306_Dirty[m].X0], n);
+#endif
+
+        /* Page is up to date */
+        SSD1306_Dirty[m].X0 = 0xFF;
+        SSD1306_Dirty[m].X1 = 0;
+    }
+}
+
+void
+TM_SSD1306_UpdateScreenFull(void) {
+    /* Mark all and update */
+    TM_SSD1306_INT_SetAllDirty();
+    TM_SSD1306_UpdateScreen();
+}
+
+#if SSD1306_USE_DMA
+uint8_t
+TM_SSD1306_UpdateScreenDMA(void) {
     uint8_t m;
+#if SSD1306_USE_SPI
+    uint8_t p0 = 0xFF, p1 = 0;
+#endif
 
-    for (m = 0; m < 8; m++) {
-        SSD1306_WRITECOMMAND(0xB0 + m);
-        SSD1306_WRITECOMMAND(0x00);
-        SSD1306_WRITECOMMAND(0x10);
+    /* Previous update is not finished yet */
+    if (TM_SSD1306_UpdateScreenWorking()) {
+        return 0;
+    }
 
-        /* Write multi data */
-        TM_I2C_WriteMulti(SSD1306_I2C, SSD1306_I2C_ADDR, 0x40, &SSD1306_Buffer[SSD1306_WIDTH * m], SSD1306_WIDTH);
+    /* Take dirty ranges, drawing functions can mark pages again while update is in progress */
+    for (m = 0; m < SSD1306_PAGES; m++) {
+        SSD1306_Update.Pages[m] = SSD1306_Dirty[m];
+        SSD1306_Dirty[m].X0 = 0xFF;
+        SSD1306_Dirty[m].X1 = 0;
+#if SSD1306_USE_SPI
+        if (SSD1306_Update.Pages[m].X0 <= SSD1306_Update.Pages[m].X1) {
+            if (p0 == 0xFF) {
+                p0 = m;
+            }
+            p1 = m;
+        }
+#endif
+    }
+
+#if SSD1306_USE_SPI
+    /* Nothing changed */
+    if (p0 == 0xFF) {
+        return 1;
+    }
+
+    /* Full width pages are continuous in buffer, so all changed pages are sent with one DMA transfer */
+    TM_SSD1306_INT_SetWindowCmd(SSD1306_Update.Cmd, 0, SSD1306_WIDTH - 1, p0, p1);
+    SSD1306_CS_LOW;
+    SSD1306_DC_LOW;
+    TM_SPI_WriteMulti(SSD1306_SPI, SSD1306_Update.Cmd, 6);
+    SSD1306_DC_HIGH;
+    SSD1306_Update.Working = 1;
+    TM_SPI_DMA_Transmit(SSD1306_SPI, &SSD1306_Buffer[SSD1306_WIDTH * p0], NULL, SSD1306_WIDTH * (p1 - p0 + 1));
+#else
+    /* Find first changed page */
+    SSD1306_Update.Page = 0xFF;
+    if (!TM_SSD1306_INT_NextPage()) {
+        return 1;
+    }
+
+    /* Start first transfer, next steps are done in I2C event interrupt */
+    SSD1306_Update.Working = 1;
+    SSD1306_I2C->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_DMAEN;
+    SSD1306_I2C->CR1 |= I2C_CR1_START;
+#endif
+
+    /* Update started */
+    return 1;
+}
+#endif
+
+uint8_t
+TM_SSD1306_UpdateScreenWorking(void) {
+#if SSD1306_USE_DMA
+    if (!SSD1306_Update.Working) {
+        return 0;
     }
+#if SSD1306_USE_SPI
+    /* Release LCD when DMA transfer is finished */
+    if (!TM_SPI_DMA_Working(SSD1306_SPI)) {
+        SSD1306_CS_HIGH;
+        SSD1306_Update.Working = 0;
+    }
+#else
+    /* LCD did not acknowledge, stop update */
+    if (SSD1306_I2C->SR1 & I2C_SR1_AF) {
+        SSD1306_I2C->CR2 &= ~(I2C_CR2_ITEVTEN | I2C_CR2_DMAEN);
+        SSD1306_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+        SSD1306_I2C->SR1 &= ~I2C_SR1_AF;
+        SSD1306_I2C->CR1 |= I2C_CR1_STOP;
+        SSD1306_Update.Working = 0;
+    }
+#endif
+    return SSD1306_Update.Working;
+#else
+    /* Update is always finished */
+    return 0;
+#endif
 }
 
 void
@@ -128,12 +344,18 @@ TM_SSD1306_ToggleInvert(void) {
     for (i = 0; i < sizeof(SSD1306_Buffer); i++) {
         SSD1306_Buffer[i] = ~SSD1306_Buffer[i];
     }
+
+    /* All pages changed */
+    TM_SSD1306_INT_SetAllDirty();
 }
 
 void
 TM_SSD1306_Fill(SSD1306_COLOR_t color) {
     /* Set memory */
     memset(SSD1306_Buffer, (color == SSD1306_COLOR_BLACK) ? 0x00 : 0xFF, sizeof(SSD1306_Buffer));
+
+    /* All pages changed */
+    TM_SSD1306_INT_SetAllDirty();
 }
 
 void
@@ -157,6 +379,9 @@ TM_SSD1306_DrawPixel(uint16_t x, uint16_t y, SSD1306_COLOR_t color) {
     } else {
         SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
     }
+
+    /* Column of page changed */
+    TM_SSD1306_INT_SetDirty(x, x, y / 8);
 }
 
 void
@@ -367,59 +592,8 @@ TM_SSD1306_DrawTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint
 
 void
 TM_SSD1306_DrawFilledTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color) {
-    int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0,
-            yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0,
-            curpixel = 0;
-
-    deltax = ABS(x2 - x1);
-    deltay = ABS(y2 - y1);
-    x = x1;
-    y = y1;
-
-    if (x2 >= x1) {
-        xinc1 = 1;
-        xinc2 = 1;
-    } else {
-        xinc1 = -1;
-        xinc2 = -1;
-    }
-
-    if (y2 >= y1) {
-        yinc1 = 1;
-        yinc2 = 1;
-    } else {
-        yinc1 = -1;
-        yinc2 = -1;
-    }
-
-    if (deltax >= deltay) {
-        xinc1 = 0;
-        yinc2 = 0;
-        den = deltax;
-        num = deltax / 2;
-        numadd = deltay;
-        numpixels = deltax;
-    } else {
-        xinc2 = 0;
-        yinc1 = 0;
-        den = deltay;
-        num = deltay / 2;
-        numadd = deltax;
-        numpixels = deltay;
-    }
-
-    for (curpixel = 0; curpixel <= numpixels; curpixel++) {
-        TM_SSD1306_DrawLine(x, y, x3, y3, color);
-
-        num += numadd;
-        if (num >= den) {
-            num -= den;
-            x += xinc1;
-            y += yinc1;
-        }
-        x += xinc2;
-        y += yinc2;
-    }
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillTriangle(&SSD1306_Scanline, x1, y1, x2, y2, x3, y3, color);
 }
 
 void
@@ -459,35 +633,169 @@ TM_SSD1306_DrawCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c) {
 
 void
 TM_SSD1306_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
+    /* Fill with scanline engine */
+    TM_SCANLINE_FillCircle(&SSD1306_Scanline, x0, y0, r, c);
+}
 
-    TM_SSD1306_DrawPixel(x0, y0 + r, c);
-    TM_SSD1306_DrawPixel(x0, y0 - r, c);
-    TM_SSD1306_DrawPixel(x0 + r, y0, c);
-    TM_SSD1306_DrawPixel(x0 - r, y0, c);
-    TM_SSD1306_DrawLine(x0 - r, y0, x0 + r, y0, c);
+TM_SCANLINE_t*
+TM_SSD1306_GetScanline(void) {
+    return &SSD1306_Scanline;
+}
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
+static void
+TM_SSD1306_INT_Span(int16_t x0, int16_t x1, int16_t y, uint32_t color) {
+    uint8_t* ptr = &SSD1306_Buffer[x0 + (y / 8) * SSD1306_WIDTH];
+    uint8_t mask = 1 << (y % 8);
+
+    /* Columns of page changed */
+    TM_SSD1306_INT_SetDirty(x0, x1, y / 8);
+
+    /* Check if pixels are inverted */
+    if (SSD1306.Inverted) {
+        color = !color;
+    }
+
+    /* Set the same bit in all columns of span */
+    if (color == SSD1306_COLOR_WHITE) {
+        for (; x0 <= x1; x0++) {
+            *ptr++ |= mask;
         }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
+    } else {
+        for (; x0 <= x1; x0++) {
+            *ptr++ &= ~mask;
+        }
+    }
+}
+
+static void
+TM_SSD1306_INT_SetDirty(uint8_t x0, uint8_t x1, uint8_t page) {
+    /* Extend column range of page */
+    if (x0 < SSD1306_Dirty[page].X0) {
+        SSD1306_Dirty[page].X0 = x0;
+    }
+    if (x1 > SSD1306_Dirty[page].X1) {
+        SSD1306_Dirty[page].X1 = x1;
+    }
+}
+
+static void
+TM_SSD1306_INT_SetAllDirty(void) {
+    uint8_t m;
+
+    /* All columns of all pages */
+    for (m = 0; m < SSD1306_PAGES; m++) {
+        SSD1306_Dirty[m].X0 = 0;
+        SSD1306_Dirty[m].X1 = SSD1306_WIDTH - 1;
+    }
+}
+
+static uint8_t
+TM_SSD1306_INT_SetWindowCmd(uint8_t* cmd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    /* Column and page address for horizontal addressing mode */
+    cmd[0] = 0x21;
+    cmd[1] = x0;
+    cmd[2] = x1;
+    cmd[3] = 0x22;
+    cmd[4] = p0;
+    cmd[5] = p1;
+
+    /* Return number of columns */
+    return x1 - x0 + 1;
+}
 
-        TM_SSD1306_DrawLine(x0 - x, y0 + y, x0 + x, y0 + y, c);
-        TM_SSD1306_DrawLine(x0 + x, y0 - y, x0 - x, y0 - y, c);
+#if SSD1306_USE_SPI
+static void
+TM_SSD1306_INT_SPICommand(uint8_t command) {
+    /* Wait for DMA update to finish */
+    while (TM_SSD1306_UpdateScreenWorking());
+
+    /* Send command */
+    SSD1306_CS_LOW;
+    SSD1306_DC_LOW;
+    TM_SPI_Send(SSD1306_SPI, command);
+    SSD1306_CS_HIGH;
+}
+#else
+static void
+TM_SSD1306_INT_I2CCommand(uint8_t command) {
+    /* Wait for DMA update to finish, I2C is used by update interrupt */
+    while (TM_SSD1306_UpdateScreenWorking());
+
+    /* Send command */
+    TM_I2C_Write(SSD1306_I2C, SSD1306_I2C_ADDR, 0x00, command);
+}
+#endif
+
+#if SSD1306_USE_DMA && !SSD1306_USE_SPI
+static uint8_t
+TM_SSD1306_INT_NextPage(void) {
+    /* Find next changed page */
+    while (++SSD1306_Update.Page < SSD1306_PAGES) {
+        if (SSD1306_Update.Pages[SSD1306_Update.Page].X0 <= SSD1306_Update.Pages[SSD1306_Update.Page].X1) {
+            /* Commands are sent first */
+            TM_SSD1306_INT_SetWindowCmd(
+                SSD1306_Update.Cmd,
+                SSD1306_Update.Pages[SSD1306_Update.Page].X0,
+                SSD1306_Update.Pages[SSD1306_Update.Page].X1,
+                SSD1306_Update.Page,
+                SSD1306_Update.Page
+            );
+            SSD1306_Update.Data = 0;
+            return 1;
+        }
+    }
 
-        TM_SSD1306_DrawLine(x0 + y, y0 + x, x0 - y, y0 + x, c);
-        TM_SSD1306_DrawLine(x0 + y, y0 - x, x0 - y, y0 - x, c);
+    /* No more pages */
+    return 0;
+}
+
+void
+SSD1306_I2C_IRQ_HANDLER(void) {
+    SSD1306_Dirty_t* Page;
+    uint16_t sr1 = SSD1306_I2C->SR1;
+
+    if (sr1 & I2C_SR1_SB) {
+        /* Start sent, send address for write */
+        SSD1306_I2C->DR = SSD1306_I2C_ADDR & ~I2C_OAR1_ADD0;
+    } else if (sr1 & I2C_SR1_ADDR) {
+        /* Clear ADDR flag with SR2 read */
+        (void)SSD1306_I2C->SR2;
+
+        /* Control byte is written here, commands or data are sent with DMA */
+        TM_DMA_ClearFlags(SSD1306_DMA_STREAM);
+        if (SSD1306_Update.Data) {
+            Page = &SSD1306_Update.Pages[SSD1306_Update.Page];
+            SSD1306_I2C->DR = 0x40;
+            SSD1306_DMA_STREAM->M0AR = (uint32_t)&SSD1306_Buffer[SSD1306_WIDTH * SSD1306_Update.Page + Page->X0];
+            SSD1306_DMA_STREAM->NDTR = Page->X1 - Page->X0 + 1;
+        } else {
+            SSD1306_I2C->DR = 0x00;
+            SSD1306_DMA_STREAM->M0AR = (uint32_t)SSD1306_Update.Cmd;
+            SSD1306_DMA_STREAM->NDTR = sizeof(SSD1306_Update.Cmd);
+        }
+        SSD1306_DMA_STREAM->CR |= DMA_SxCR_EN;
+    } else if (sr1 & I2C_SR1_BTF) {
+        /* DMA is still working or start is pending, BTF is cleared with next DMA write or start condition */
+        if (SSD1306_DMA_STREAM->NDTR || (SSD1306_I2C->CR1 & I2C_CR1_START)) {
+            return;
+        }
+        SSD1306_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+
+        /* Data after commands or next changed page, with repeated start */
+        if (!SSD1306_Update.Data) {
+            SSD1306_Update.Data = 1;
+            SSD1306_I2C->CR1 |= I2C_CR1_START;
+        } else if (TM_SSD1306_INT_NextPage()) {
+            SSD1306_I2C->CR1 |= I2C_CR1_START;
+        } else {
+            /* All pages sent */
+            SSD1306_I2C->CR1 |= I2C_CR1_STOP;
+            SSD1306_I2C->CR2 &= ~(I2C_CR2_ITEVTEN | I2C_CR2_DMAEN);
+            SSD1306_Update.Working = 0;
+        }
     }
 }
+#endif
 
 void
 SSD1306_ON(void) {
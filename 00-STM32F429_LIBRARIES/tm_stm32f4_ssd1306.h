@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/05/library-61-ssd1306-oled-i2c-lcd-for-stm32f4xx
- * @version v1.0
+ * @version v1.2
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   Library for 128x64 SSD1306 I2C LCD
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_SSD1306_H
-#define TM_SSD1306_H 100
+#define TM_SSD1306_H 120
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -77,11 +77,70 @@ SDA        |PC9          |Serial data line
 //Select custom width and height if your LCD differs in size
 #define SSD1306_WIDTH            128
 #define SSD1306_HEIGHT           64
+@endverbatim
+ *
+ * \par Partial updates
+ *
+ * Drawing functions mark changed columns of each 8 pixels high page.
+ * @ref TM_SSD1306_UpdateScreen() sends only changed column range of changed pages, so when only one digit
+ * on screen changes, only few bytes are sent instead of complete 1kB buffer.
+ * Use @ref TM_SSD1306_UpdateScreenFull() to send complete buffer, for example after LCD was reset.
+ *
+ * \par Update with DMA
+ *
+ * With DMA, @ref TM_SSD1306_UpdateScreenDMA() only starts update and returns immediately.
+ * On I2C, DMA sends commands and data of each changed page and I2C event interrupt starts next transfer.
+ * CPU is used only for few short interrupts per page.
+ * On SPI, all changed pages are sent with one DMA transfer.
+ *
+ * Drawing functions can be used while update is in progress, changes are sent with next update.
+ * Don't use the same I2C or SPI for other devices while @ref TM_SSD1306_UpdateScreenWorking() returns non-zero.
+ *
+@verbatim
+//Enable DMA in defines.h
+#define SSD1306_USE_DMA          1
+
+//DMA stream and I2C interrupt, defaults are for I2C3
+#define SSD1306_DMA_STREAM       DMA1_Stream4
+#define SSD1306_DMA_CHANNEL      DMA_Channel_3
+#define SSD1306_I2C_IRQ          I2C3_EV_IRQn
+#define SSD1306_I2C_IRQ_HANDLER  I2C3_EV_IRQHandler
+@endverbatim
+ *
+ * \par SPI LCD
+ *
+ * Some SSD1306 modules use 4-wire SPI instead of I2C. Enable it in defines.h:
+ *
+@verbatim
+#define SSD1306_USE_SPI          1
+
+//SPI and pins
+#define SSD1306_SPI              SPI1
+#define SSD1306_SPI_PINSPACK     TM_SPI_PinsPack_1
+#define SSD1306_CS_PORT          GPIOB
+#define SSD1306_CS_PIN           GPIO_Pin_7
+#define SSD1306_DC_PORT          GPIOB
+#define SSD1306_DC_PIN           GPIO_Pin_8
+#define SSD1306_RST_PORT         GPIOB
+#define SSD1306_RST_PIN          GPIO_Pin_9
 @endverbatim
  *
  * \par Changelog
  *
 @verbatim
+ Version 1.2
+  - October 16, 2026
+  - Drawing functions mark changed columns, only changed parts of LCD are updated
+  - LCD uses horizontal addressing mode with column and page window
+  - Added TM_SSD1306_UpdateScreenFull() function
+  - Added asynchronous update with DMA, TM_SSD1306_UpdateScreenDMA() function
+  - Added SPI interface, enabled with SSD1306_USE_SPI
+
+ Version 1.1
+  - October 16, 2026
+  - Filled circles and triangles are drawn with TM SCANLINE engine
+  - Added TM_SSD1306_GetScanline() function for other filled shapes
+
  Version 1.0
   - First release
 @endverbatim
@@ -93,8 +152,13 @@ SDA        |PC9          |Serial data line
  - STM32F4xx RCC
  - defines.h
  - TM I2C
+ - TM SPI, when SSD1306_USE_SPI is 1
+ - TM SPI DMA, when SSD1306_USE_SPI and SSD1306_USE_DMA are 1
+ - TM DMA, when SSD1306_USE_DMA is 1
+ - TM GPIO
  - TM FONTS
  - TM DELAY
+ - TM SCANLINE
  - string.h
  - stdlib.h
 @endverbatim
@@ -103,8 +167,10 @@ SDA        |PC9          |Serial data line
 #include "stm32f4xx.h"
 #include "defines.h"
 #include "tm_stm32f4_i2c.h"
+#include "tm_stm32f4_gpio.h"
 #include "tm_stm32f4_fonts.h"
 #include "tm_stm32f4_delay.h"
+#include "tm_stm32f4_scanline.h"
 
 #include "stdlib.h"
 #include "string.h"
@@ -115,6 +181,33 @@ SDA        |PC9          |Serial data line
  * @{
  */
 
+/**
+ * @brief  Set to 1 to use SPI instead of I2C
+ */
+#ifndef SSD1306_USE_SPI
+#define SSD1306_USE_SPI          0
+#endif
+
+/**
+ * @brief  Set to 1 to enable asynchronous update with DMA
+ * @note   With I2C, library uses I2C event interrupt handler
+ */
+#ifndef SSD1306_USE_DMA
+#define SSD1306_USE_DMA          0
+#endif
+
+#if SSD1306_USE_SPI
+#include "tm_stm32f4_spi.h"
+#if SSD1306_USE_DMA
+#include "tm_stm32f4_spi_dma.h"
+#endif
+#endif
+#if SSD1306_USE_DMA
+#include "tm_stm32f4_dma.h"
+#include "stm32f4xx_dma.h"
+#include "misc.h"
+#endif
+
 /* I2C settings */
 #ifndef SSD1306_I2C
 #define SSD1306_I2C              I2C3
@@ -128,6 +221,47 @@ SDA        |PC9          |Serial data line
 //#define SSD1306_I2C_ADDR       0x7A
 #endif
 
+/* DMA stream and channel for I2C TX */
+#ifndef SSD1306_DMA_STREAM
+#define SSD1306_DMA_STREAM       DMA1_Stream4
+#define SSD1306_DMA_CHANNEL      DMA_Channel_3
+#endif
+
+/* I2C event interrupt, used for update with DMA */
+#ifndef SSD1306_I2C_IRQ
+#define SSD1306_I2C_IRQ          I2C3_EV_IRQn
+#define SSD1306_I2C_IRQ_HANDLER  I2C3_EV_IRQHandler
+#endif
+
+/* I2C event interrupt priority */
+#ifndef SSD1306_NVIC_PRIORITY
+#define SSD1306_NVIC_PRIORITY    0x06
+#endif
+
+/* SPI settings */
+#ifndef SSD1306_SPI
+#define SSD1306_SPI              SPI1
+#define SSD1306_SPI_PINSPACK     TM_SPI_PinsPack_1
+#endif
+
+/* SPI chip select pin */
+#ifndef SSD1306_CS_PIN
+#define SSD1306_CS_PORT          GPIOB
+#define SSD1306_CS_PIN           GPIO_Pin_7
+#endif
+
+/* SPI data/command pin */
+#ifndef SSD1306_DC_PIN
+#define SSD1306_DC_PORT          GPIOB
+#define SSD1306_DC_PIN           GPIO_Pin_8
+#endif
+
+/* SPI reset pin */
+#ifndef SSD1306_RST_PIN
+#define SSD1306_RST_PORT         GPIOB
+#define SSD1306_RST_PIN          GPIO_Pin_9
+#endif
+
 /* SSD1306 settings */
 /* SSD1306 width in pixels */
 #ifndef SSD1306_WIDTH
@@ -178,11 +312,40 @@ uint8_t TM_SSD1306_Init(void);
 /**
  * @brief  Updates buffer from internal RAM to LCD
  * @note   This function must be called each time you do some changes to LCD, to update buffer from RAM to LCD
+ * @note   Only changed columns of changed pages are sent. Function waits for DMA update to finish first
  * @param  None
  * @retval None
  */
 void TM_SSD1306_UpdateScreen(void);
 
+/**
+ * @brief  Updates complete buffer from internal RAM to LCD
+ * @param  None
+ * @retval None
+ */
+void TM_SSD1306_UpdateScreenFull(void);
+
+#if SSD1306_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief  Starts update of changed parts of LCD with DMA and returns immediately
+ * @note   Available only when SSD1306_USE_DMA is 1
+ * @param  None
+ * @retval Update status:
+ *           - 0: Previous update is still in progress, nothing started
+ *           - > 0: Update started or there was nothing to update
+ */
+uint8_t TM_SSD1306_UpdateScreenDMA(void);
+#endif
+
+/**
+ * @brief  Checks if DMA update is in progress
+ * @param  None
+ * @retval Update status:
+ *           - 0: No update in progress
+ *           - > 0: Update in progress
+ */
+uint8_t TM_SSD1306_UpdateScreenWorking(void);
+
 /**
  * @brief  Toggles pixels invertion inside internal RAM
  * @note   @ref TM_SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
@@ -287,6 +450,20 @@ void TM_SSD1306_DrawFilledRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t
  */
 void TM_SSD1306_DrawTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color);
 
+/**
+ * @brief  Draws filled triangle to STM buffer
+ * @note   @ref TM_SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
+ * @param  x1: First coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y1: First coordinate Y location. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  x2: Second coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y2: Second coordinate Y location. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  x3: Third coordinate X location. Valid input is 0 to SSD1306_WIDTH - 1
+ * @param  y3: Third coordinate Y location. Valid input is 0 to SSD1306_HEIGHT - 1
+ * @param  c: Color to be used. This parameter can be a value of @ref SSD1306_COLOR_t enumeration
+ * @retval None
+ */
+void TM_SSD1306_DrawFilledTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, SSD1306_COLOR_t color);
+
 /**
  * @brief  Draws circle to STM buffer
  * @note   @ref TM_SSD1306_UpdateScreen() must be called after that in order to see updated LCD screen
@@ -309,6 +486,14 @@ void TM_SSD1306_DrawCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c)
  */
 void TM_SSD1306_DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, SSD1306_COLOR_t c);
 
+/**
+ * @brief  Gets device structure for TM SCANLINE engine, used for other filled shapes (polygons, ellipses, arcs)
+ * @note   @ref TM_SSD1306_UpdateScreen() must be called after drawing in order to see updated LCD screen
+ * @param  None
+ * @retval Pointer to @ref TM_SCANLINE_t device structure
+ */
+TM_SCANLINE_t* TM_SSD1306_GetScanline(void);
+
 /**
  * @}
  */
@@ -77,12 +77,55 @@
 #define STMPE811_TEMP_CTRL              0x60    //Temperature sensor setup
 #define STMPE811_TEMP_DATA              0x61    //Temperature data access port
 #define STMPE811_TEMP_TH                0x62    //Threshold for temperature controlled interrupt
+#define STMPE811_TSC_DATA_NON_INC       0xD7    //TSC_DATA without address auto increment, for FIFO burst read
+
+/* Interrupt bits in INT_EN and INT_STA registers */
+#define STMPE811_INT_TOUCH_DET          0x01    //Touch detected or released
+#define STMPE811_INT_FIFO_TH            0x02    //FIFO threshold reached
+#define STMPE811_INT_FIFO_OFLOW         0x04    //FIFO overflow
 
 /* Private functions */
 uint8_t TM_STMPE811_Read(uint8_t reg);
 uint16_t TM_STMPE811_ReadX(uint16_t x);
 uint16_t TM_STMPE811_ReadY(uint16_t y);
 
+#if STMPE811_USE_IRQ
+/**
+ * @brief  Touch state and filter, changed in interrupt
+ * @note   Used private
+ */
+typedef struct {
+    TM_STMPE811_Calibration_t Cal;        /*!< Calibration matrix */
+    int32_t Filter[2];                    /*!< IIR filter output for raw X and Y, 4 fractional bits */
+    uint16_t Hist[2][3];                  /*!< Last 3 raw samples for X and Y for median filter */
+    uint8_t HistPos;                      /*!< Position for next sample in history */
+    uint8_t Pressed;                      /*!< Set to 1 when touch is pressed and first sample was received */
+    uint8_t DownQueued;                   /*!< Set to 1 when down event is in queue and up event must follow */
+    volatile uint32_t Position;           /*!< Last X in low and Y in high 16 bits, written at once for main loop */
+    volatile uint8_t PositionValid;       /*!< Set to 1 when touch is pressed */
+    int16_t X;                            /*!< Last filtered X coordinate */
+    int16_t Y;                            /*!< Last filtered Y coordinate */
+    int16_t EventX;                       /*!< X coordinate of last event in queue */
+    int16_t EventY;                       /*!< Y coordinate of last event in queue */
+} TM_STMPE811_Touch_t;
+
+static TM_STMPE811_Touch_t Touch = {
+    /* Default matrix for Portrait 2 orientation, the same as polling mode: x = (3900 - raw_x) / 15, y = (raw_y - 360) / 11 */
+    {-65536 / 15, 0, 3900L * 65536 / 15, 0, 65536 / 11, -360L * 65536 / 11}
+};
+
+/* Event queue, written in interrupt and read in main loop */
+static TM_STMPE811_Event_t Events[STMPE811_EVENT_QUEUE_SIZE];
+static volatile uint8_t EventsIn, EventsOut;
+
+/* Burst read buffer, 4 bytes per sample */
+static uint8_t FifoBuffer[STMPE811_FIFO_BURST * 4];
+
+static void TM_STMPE811_INT_Sample(uint16_t x, uint16_t y);
+static void TM_STMPE811_INT_Release(void);
+static uint8_t TM_STMPE811_INT_PutEvent(TM_STMPE811_EventType_t type, uint8_t min_free);
+#endif
+
 TM_STMPE811_State_t
 TM_STMPE811_Init(void) {
     uint8_t bytes[2], mode;
@@ -166,18 +209,22 @@ TM_STMPE811_Init(void) {
     /* Clear all the status pending bits if any */
     TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_STA, 0xFF);
 
-    /* Enable global interrupts */
-    /*
-    mode = TM_I2C_Read(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_CTRL);
-    mode |= 0x01;
-    TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_CTRL, mode);
-    */
-    /* Enable touch interrupt */
-    /*
-    mode = TM_I2C_Read(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_EN);
-    mode |= 0x01;
-    TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_EN, mode);
-    */
+#if STMPE811_USE_IRQ
+    /* Generate interrupt after more samples, FIFO is read at once */
+    TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_FIFO_TH, STMPE811_FIFO_THRESHOLD);
+
+    /* Enable touch detect, FIFO threshold and FIFO overflow interrupts */
+    TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_EN, STMPE811_INT_TOUCH_DET | STMPE811_INT_FIFO_TH | STMPE811_INT_FIFO_OFLOW);
+
+    /* Attach INT pin to interrupt, pin is open drain and active low */
+    if (TM_EXTI_Attach(STMPE811_INT_PORT, STMPE811_INT_PIN, TM_EXTI_Trigger_Falling) != TM_EXTI_Result_Ok) {
+        return TM_STMPE811_State_Error;
+    }
+
+    /* Enable global interrupts, level interrupt, active low */
+    TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_CTRL, 0x01);
+#endif
+
     /* Wait for 2 ms delay */
     Delayms(2);
 
@@ -191,11 +238,44 @@ TM_STMPE811_Read(uint8_t reg) {
 
 TM_STMPE811_State_t
 TM_STMPE811_ReadTouch(TM_STMPE811_TouchData* structdata) {
+#if STMPE811_USE_IRQ
+    uint32_t position;
+    int16_t x, y;
+#else
     uint8_t val;
+#endif
 
     /* Save state */
     structdata->last_pressed = structdata->pressed;
 
+#if STMPE811_USE_IRQ
+    /* Not pressed */
+    if (!Touch.PositionValid) {
+        structdata->pressed = TM_STMPE811_State_Released;
+        return TM_STMPE811_State_Released;
+    }
+
+    /* Coordinates from interrupt are in Portrait 2 orientation */
+    position = Touch.Position;
+    x = (int16_t)(position & 0xFFFF);
+    y = (int16_t)(position >> 16);
+    x = x < 0 ? 0 : (x > 239 ? 239 : x);
+    y = y < 0 ? 0 : (y > 319 ? 319 : y);
+
+    if (structdata->orientation == TM_STMPE811_Orientation_Portrait_1) {
+        structdata->x = 239 - x;
+        structdata->y = 319 - y;
+    } else if (structdata->orientation == TM_STMPE811_Orientation_Portrait_2) {
+        structdata->x = x;
+        structdata->y = y;
+    } else if (structdata->orientation == TM_STMPE811_Orientation_Landscape_1) {
+        structdata->y = x;
+        structdata->x = 319 - y;
+    } else if (structdata->orientation == TM_STMPE811_Orientation_Landscape_2) {
+        structdata->y = 239 - x;
+        structdata->x = y;
+    }
+#else
     /* Read */
     val = TM_STMPE811_Read(STMPE811_TSC_CTRL);
     if ((val & 0x80) == 0) {
@@ -230,6 +310,7 @@ TM_STMPE811_ReadTouch(TM_STMPE811_TouchData* structdata) {
     //Reset Fifo
     TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_FIFO_STA, 0x01);
     TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_FIFO_STA, 0x00);
+#endif
 
     //Check for valid data
     if (structdata->orientation == TM_STMPE811_Orientation_Portrait_1 || structdata->orientation == TM_STMPE811_Orientation_Portrait_2) {
@@ -305,3 +386,212 @@ TM_STMPE811_ReadY(uint16_t y) {
 }
 
 
+
+#if STMPE811_USE_IRQ
+void
+TM_STMPE811_ProcessInterrupt(void) {
+    uint8_t status, count, n, i, loops = 4;
+    uint8_t* p;
+
+    /* Process while any interrupt is pending, INT pin goes high only when all are cleared */
+    while (loops-- && (status = TM_STMPE811_Read(STMPE811_INT_STA)) != 0) {
+        /* Read all samples from FIFO, each sample has 12-bit X, 12-bit Y and 8-bit Z */
+        count = TM_STMPE811_Read(STMPE811_FIFO_SIZE);
+        while (count) {
+            n = count > STMPE811_FIFO_BURST ? STMPE811_FIFO_BURST : count;
+            count -= n;
+
+            /* Burst read from data port without address increment */
+            TM_I2C_ReadMulti(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_TSC_DATA_NON_INC, FifoBuffer, n * 4);
+            for (i = 0, p = FifoBuffer; i < n; i++, p += 4) {
+                TM_STMPE811_INT_Sample(((uint16_t)p[0] << 4) | (p[1] >> 4), ((uint16_t)(p[1] & 0x0F) << 8) | p[2]);
+            }
+        }
+
+        /* Report last filtered position once per interrupt when changed */
+        if (Touch.Pressed && (Touch.X != Touch.EventX || Touch.Y != Touch.EventY)) {
+            TM_STMPE811_INT_PutEvent(TM_STMPE811_Event_Move, 2);
+        }
+
+        /* Samples were lost, start with empty FIFO */
+        if (status & STMPE811_INT_FIFO_OFLOW) {
+            TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_FIFO_STA, 0x01);
+            TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_FIFO_STA, 0x00);
+        }
+
+        /* Clear processed interrupts */
+        TM_I2C_Write(STMPE811_I2C, STMPE811_ADDRESS, STMPE811_INT_STA, status);
+
+        /* Touch released, all samples are already read */
+        if ((status & STMPE811_INT_TOUCH_DET) && !(TM_STMPE811_Read(STMPE811_TSC_CTRL) & 0x80)) {
+            TM_STMPE811_INT_Release();
+        }
+    }
+
+    /* INT is level interrupt and EXTI is edge triggered, pin stays low when new interrupt came meanwhile */
+    if (!TM_GPIO_GetInputPinValue(STMPE811_INT_PORT, STMPE811_INT_PIN)) {
+        /* Pend EXTI line again, handler will be called once more after return */
+        TM_EXTI_SoftwareInterrupt(STMPE811_INT_PIN);
+    }
+}
+
+uint8_t
+TM_STMPE811_GetEvent(TM_STMPE811_Event_t* Event) {
+    uint8_t out = EventsOut;
+
+    /* Queue empty */
+    if (out == EventsIn) {
+        return 0;
+    }
+
+    /* Copy event and free slot after copy */
+    *Event = Events[out & (STMPE811_EVENT_QUEUE_SIZE - 1)];
+    __DMB();
+    EventsOut = out + 1;
+
+    /* Return event */
+    return 1;
+}
+
+void
+TM_STMPE811_SetCalibration(const TM_STMPE811_Calibration_t* Calibration) {
+    /* Copy with interrupt disabled, so sample is not calculated with half of new matrix */
+    EXTI->IMR &= ~STMPE811_INT_PIN;
+    Touch.Cal = *Calibration;
+    EXTI->IMR |= STMPE811_INT_PIN;
+}
+
+uint8_t
+TM_STMPE811_Calibrate(const TM_STMPE811_Point_t* Lcd, const TM_STMPE811_Point_t* Raw, TM_STMPE811_Calibration_t* Calibration) {
+    int64_t div, x0, x1, x2, y0, y1, y2;
+    int64_t a, b, c, d, e, f;
+
+    x0 = Raw[0].x; x1 = Raw[1].x; x2 = Raw[2].x;
+    y0 = Raw[0].y; y1 = Raw[1].y; y2 = Raw[2].y;
+
+    /* Determinant, zero when points lie on the same line */
+    div = (x0 - x2) * (y1 - y2) - (x1 - x2) * (y0 - y2);
+    if (div == 0) {
+        return 0;
+    }
+
+    /* Solve for X */
+    a = (Lcd[0].x - Lcd[2].x) * (y1 - y2) - (Lcd[1].x - Lcd[2].x) * (y0 - y2);
+    b = (x0 - x2) * (Lcd[1].x - Lcd[2].x) - (Lcd[0].x - Lcd[2].x) * (x1 - x2);
+    c = y0 * (x2 * Lcd[1].x - x1 * Lcd[2].x) + y1 * (x0 * Lcd[2].x - x2 * Lcd[0].x) + y2 * (x1 * Lcd[0].x - x0 * Lcd[1].x);
+
+    /* Solve for Y */
+    d = (Lcd[0].y - Lcd[2].y) * (y1 - y2) - (Lcd[1].y - Lcd[2].y) * (y0 - y2);
+    e = (x0 - x2) * (Lcd[1].y - Lcd[2].y) - (Lcd[0].y - Lcd[2].y) * (x1 - x2);
+    f = y0 * (x2 * Lcd[1].y - x1 * Lcd[2].y) + y1 * (x0 * Lcd[2].y - x2 * Lcd[0].y) + y2 * (x1 * Lcd[0].y - x0 * Lcd[1].y);
+
+    /* Convert to 16.16 fixed point */
+    Calibration->A = (int32_t)(a * 65536 / div);
+    Calibration->B = (int32_t)(b * 65536 / div);
+    Calibration->C = (int32_t)(c * 65536 / div);
+    Calibration->D = (int32_t)(d * 65536 / div);
+    Calibration->E = (int32_t)(e * 65536 / div);
+    Calibration->F = (int32_t)(f * 65536 / div);
+
+    /* Matrix calculated */
+    return 1;
+}
+
+/* Private functions */
+static uint16_t
+TM_STMPE811_INT_Median(uint16_t a, uint16_t b, uint16_t c) {
+    if (a > b) {
+        uint16_t t = a; a = b; b = t;
+    }
+    /* a <= b, median is b limited to range [a, c] */
+    if (c < b) {
+        return c > a ? c : a;
+    }
+    return b;
+}
+
+static void
+TM_STMPE811_INT_Sample(uint16_t x, uint16_t y) {
+    uint16_t raw[2];
+    uint8_t i;
+    int32_t fx, fy;
+
+    raw[0] = x;
+    raw[1] = y;
+
+    for (i = 0; i < 2; i++) {
+        if (!Touch.Pressed) {
+            /* First sample of touch, fill history and filter with it */
+            Touch.Hist[i][0] = Touch.Hist[i][1] = Touch.Hist[i][2] = raw[i];
+            Touch.Filter[i] = (int32_t)raw[i] << 4;
+        } else {
+            /* Median of last 3 samples removes single spikes, IIR filter removes noise */
+            Touch.Hist[i][Touch.HistPos] = raw[i];
+            Touch.Filter[i] += (((int32_t)TM_STMPE811_INT_Median(Touch.Hist[i][0], Touch.Hist[i][1], Touch.Hist[i][2]) << 4) - Touch.Filter[i]) >> STMPE811_IIR_SHIFT;
+        }
+    }
+    if (++Touch.HistPos == 3) {
+        Touch.HistPos = 0;
+    }
+
+    /* Apply calibration, filter values have 4 fractional bits */
+    fx = Touch.Filter[0];
+    fy = Touch.Filter[1];
+    Touch.X = (int16_t)(((int64_t)Touch.Cal.A * fx + (int64_t)Touch.Cal.B * fy + ((int64_t)Touch.Cal.C << 4) + (1 << 19)) >> 20);
+    Touch.Y = (int16_t)(((int64_t)Touch.Cal.D * fx + (int64_t)Touch.Cal.E * fy + ((int64_t)Touch.Cal.F << 4) + (1 << 19)) >> 20);
+
+    /* Save position for main loop at once */
+    Touch.Position = (uint16_t)Touch.X | ((uint32_t)(uint16_t)Touch.Y << 16);
+
+    /* First sample after touch is detected */
+    if (!Touch.Pressed) {
+        Touch.Pressed = 1;
+        Touch.PositionValid = 1;
+        Touch.DownQueued = TM_STMPE811_INT_PutEvent(TM_STMPE811_Event_Down, 2);
+    }
+}
+
+static void
+TM_STMPE811_INT_Release(void) {
+    /* No sample was received */
+    if (!Touch.Pressed) {
+        return;
+    }
+
+    /* Release */
+    Touch.Pressed = 0;
+    Touch.PositionValid = 0;
+
+    /* Up event always has free slot, because down and move events leave one slot free */
+    if (Touch.DownQueued) {
+        TM_STMPE811_INT_PutEvent(TM_STMPE811_Event_Up, 1);
+        Touch.DownQueued = 0;
+    }
+}
+
+static uint8_t
+TM_STMPE811_INT_PutEvent(TM_STMPE811_EventType_t type, uint8_t min_free) {
+    uint8_t in = EventsIn;
+    TM_STMPE811_Event_t* e;
+
+    /* Not enough space, event is dropped */
+    if ((uint8_t)(STMPE811_EVENT_QUEUE_SIZE - (uint8_t)(in - EventsOut)) < min_free) {
+        return 0;
+    }
+
+    /* Fill event and publish it after it is written */
+    e = &Events[in & (STMPE811_EVENT_QUEUE_SIZE - 1)];
+    e->type = type;
+    e->x = Touch.X;
+    e->y = Touch.Y;
+    __DMB();
+    EventsIn = in + 1;
+
+    /* Save position of last event */
+    Touch.EventX = Touch.X;
+    Touch.EventY = Touch.Y;
+
+    /* Event stored */
+    return 1;
+}
+#endif
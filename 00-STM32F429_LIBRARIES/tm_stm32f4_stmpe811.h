@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/05/library-10-stmpe811-touch-screen-driver-for-stm32f429-discovery-board/
- * @version v1.2
+ * @version v1.3
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   STMPE811 Touch screen controller library
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_STMPE811_H
-#define TM_STMPE811_H  120
+#define TM_STMPE811_H  130
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -67,10 +67,76 @@ SDA        PC9         Data pin for I2C
 #define STMPE811_I2C             I2C3
 #define STMPE811_I2C_PINSPACK    TM_I2C_PinsPack_1
 @endverbatim
+ *
+ * \par Interrupt mode
+ *
+ * By default, @ref TM_STMPE811_ReadTouch reads coordinates over I2C on every call,
+ * so touch tracking is only as fast as your main loop.
+ *
+ * In interrupt mode, STMPE811 collects samples to its FIFO and sets INT pin (PA15 on STM32F429-Discovery)
+ * when FIFO threshold is reached or touch is detected/released.
+ * All samples are then read from FIFO in one I2C burst read inside interrupt,
+ * filtered with median of 3 and IIR low pass filter and converted to LCD coordinates with affine calibration matrix.
+ * Touch down, move and up events are stored to event queue, read them with @ref TM_STMPE811_GetEvent.
+ * @ref TM_STMPE811_ReadTouch still works, but it only returns last touch state and does not use I2C.
+ *
+ * Add this to defines.h file to enable interrupt mode:
+ *
+@verbatim
+//Enable interrupt mode
+#define STMPE811_USE_IRQ         1
+
+//Use custom INT pin
+#define STMPE811_INT_PORT        GPIOA
+#define STMPE811_INT_PIN         GPIO_PIN_15
+@endverbatim
+ *
+ * and call @ref TM_STMPE811_ProcessInterrupt from TM EXTI handler:
+ *
+@verbatim
+void TM_EXTI_Handler(uint16_t GPIO_Pin) {
+    if (GPIO_Pin == STMPE811_INT_PIN) {
+        TM_STMPE811_ProcessInterrupt();
+    }
+}
+
+//In main loop
+TM_STMPE811_Event_t Event;
+while (TM_STMPE811_GetEvent(&Event)) {
+    if (Event.type == TM_STMPE811_Event_Down) {
+        //Touch pressed on Event.x, Event.y
+    } else if (Event.type == TM_STMPE811_Event_Move) {
+        //Touch moved to Event.x, Event.y
+    } else {
+        //Touch released on Event.x, Event.y
+    }
+}
+@endverbatim
+ *
+ * @note Interrupt handler uses I2C, so do not use the same I2C for other devices from main loop in interrupt mode
+ *
+ * \par Calibration
+ *
+ * Event coordinates are calculated from raw ADC values with affine matrix:
+ *
+@verbatim
+x = (A * raw_x + B * raw_y + C) / 65536
+y = (D * raw_x + E * raw_y + F) / 65536
+@endverbatim
+ *
+ * Default matrix gives the same coordinates as @ref TM_STMPE811_Orientation_Portrait_2 orientation.
+ * To calibrate your screen, set identity matrix {65536, 0, 0, 0, 65536, 0} with @ref TM_STMPE811_SetCalibration,
+ * read raw coordinates when user touches 3 points on LCD, then calculate matrix with @ref TM_STMPE811_Calibrate.
+ * Matrix is precomputed, so conversion takes only a few multiplications per sample.
  *
  * \par Changelog
  *
 @verbatim
+ Version 1.3
+  - October 16, 2026
+  - Added interrupt mode with FIFO burst read, filtering, calibration matrix and event queue
+  - EXTI line is pended again when INT pin is still active after processing
+
  Version 1.0
   - First release
 
@@ -92,6 +158,7 @@ SDA        PC9         Data pin for I2C
  - defines.h
  - TM I2C
  - TM DELAY
+ - TM EXTI, when STMPE811_USE_IRQ is 1
 @endverbatim
  */
 
@@ -123,6 +190,56 @@ SDA        PC9         Data pin for I2C
 #define STMPE811_I2C_CLOCK              100000
 #endif
 
+/**
+ * @brief  Enables interrupt mode with event queue
+ */
+#ifndef STMPE811_USE_IRQ
+#define STMPE811_USE_IRQ                0
+#endif
+
+/**
+ * @brief  Default INT pin, on STM32F429-Discovery board
+ */
+#ifndef STMPE811_INT_PIN
+#define STMPE811_INT_PORT               GPIOA
+#define STMPE811_INT_PIN                GPIO_PIN_15
+#endif
+
+/**
+ * @brief  Number of samples in FIFO to generate interrupt
+ * @note   STMPE811 takes about 500 samples per second, so default value gives about 125 interrupts per second
+ */
+#ifndef STMPE811_FIFO_THRESHOLD
+#define STMPE811_FIFO_THRESHOLD         4
+#endif
+
+/**
+ * @brief  Maximal number of samples read in one I2C burst read
+ */
+#ifndef STMPE811_FIFO_BURST
+#define STMPE811_FIFO_BURST             16
+#endif
+
+/**
+ * @brief  IIR filter strength, new sample has weight 1 / 2^STMPE811_IIR_SHIFT
+ * @note   Set to 0 to disable IIR filter
+ */
+#ifndef STMPE811_IIR_SHIFT
+#define STMPE811_IIR_SHIFT              2
+#endif
+
+/**
+ * @brief  Number of events in event queue
+ * @note   Must be power of 2, maximal 128
+ */
+#ifndef STMPE811_EVENT_QUEUE_SIZE
+#define STMPE811_EVENT_QUEUE_SIZE       16
+#endif
+
+#if STMPE811_USE_IRQ
+#include "tm_stm32f4_exti.h"
+#endif
+
 /**
  * @}
  */
@@ -168,6 +285,44 @@ typedef struct {
 /* Backward compatibility */
 typedef TM_STMPE811_t TM_STMPE811_TouchData;
 
+/**
+ * @brief  Touch event type
+ */
+typedef enum {
+    TM_STMPE811_Event_Down, /*!< Touch pressed */
+    TM_STMPE811_Event_Move, /*!< Touch moved while pressed */
+    TM_STMPE811_Event_Up    /*!< Touch released, coordinates are the last valid position */
+} TM_STMPE811_EventType_t;
+
+/**
+ * @brief  Touch event from event queue
+ */
+typedef struct {
+    TM_STMPE811_EventType_t type; /*!< Event type */
+    int16_t x;                    /*!< X coordinate, calculated with calibration matrix */
+    int16_t y;                    /*!< Y coordinate, calculated with calibration matrix */
+} TM_STMPE811_Event_t;
+
+/**
+ * @brief  Point for calibration
+ */
+typedef struct {
+    int16_t x; /*!< X coordinate */
+    int16_t y; /*!< Y coordinate */
+} TM_STMPE811_Point_t;
+
+/**
+ * @brief  Affine calibration matrix, coefficients are in 16.16 fixed point format
+ */
+typedef struct {
+    int32_t A; /*!< Raw X coefficient for X */
+    int32_t B; /*!< Raw Y coefficient for X */
+    int32_t C; /*!< Offset for X */
+    int32_t D; /*!< Raw X coefficient for Y */
+    int32_t E; /*!< Raw Y coefficient for Y */
+    int32_t F; /*!< Offset for Y */
+} TM_STMPE811_Calibration_t;
+
 /**
  * @}
  */
@@ -187,6 +342,7 @@ TM_STMPE811_State_t TM_STMPE811_Init(void);
 
 /**
  * @brief  Reads touch coordinates
+ * @note   In interrupt mode, last filtered touch state is returned without I2C communication
  * @param  *structdata: Pointer to @ref TM_STMPE811_t to store data into
  * @retval Touch status:
  *            - TM_STMPE811_State_Pressed: Touch detected as pressed, coordinates valid
@@ -194,6 +350,52 @@ TM_STMPE811_State_t TM_STMPE811_Init(void);
  */
 TM_STMPE811_State_t TM_STMPE811_ReadTouch(TM_STMPE811_t* structdata);
 
+#if STMPE811_USE_IRQ || defined(__DOXYGEN__)
+
+/**
+ * @brief  Processes STMPE811 interrupt
+ * @note   Call this function from TM_EXTI_Handler when GPIO_Pin is STMPE811_INT_PIN
+ * @note   Function processes at most 4 interrupt rounds. If INT pin is still low after that,
+ *         EXTI line is pended by software so edge triggered EXTI does not miss level interrupt
+ * @note   Available only when STMPE811_USE_IRQ is 1
+ * @param  None
+ * @retval None
+ */
+void TM_STMPE811_ProcessInterrupt(void);
+
+/**
+ * @brief  Gets next touch event from event queue
+ * @note   Available only when STMPE811_USE_IRQ is 1
+ * @param  *Event: Pointer to @ref TM_STMPE811_Event_t structure to store event into
+ * @retval Event status:
+ *            - 0: Queue is empty
+ *            - > 0: Event stored to structure
+ */
+uint8_t TM_STMPE811_GetEvent(TM_STMPE811_Event_t* Event);
+
+/**
+ * @brief  Sets calibration matrix used for touch coordinates
+ * @note   Available only when STMPE811_USE_IRQ is 1
+ * @param  *Calibration: Pointer to @ref TM_STMPE811_Calibration_t matrix
+ * @retval None
+ */
+void TM_STMPE811_SetCalibration(const TM_STMPE811_Calibration_t* Calibration);
+
+/**
+ * @brief  Calculates calibration matrix from 3 points
+ * @note   Points should be far from each other and must not lie on the same line, like 2 corners and center of LCD
+ * @note   Available only when STMPE811_USE_IRQ is 1
+ * @param  *Lcd: Array of 3 points on LCD
+ * @param  *Raw: Array of 3 raw coordinates, read with identity calibration matrix when points on LCD were touched
+ * @param  *Calibration: Pointer to @ref TM_STMPE811_Calibration_t to store matrix into
+ * @retval Calculation status:
+ *            - 0: Points lie on the same line, matrix can't be calculated
+ *            - > 0: Matrix calculated
+ */
+uint8_t TM_STMPE811_Calibrate(const TM_STMPE811_Point_t* Lcd, const TM_STMPE811_Point_t* Raw, TM_STMPE811_Calibration_t* Calibration);
+
+#endif
+
 /**
  * @brief  Checks if touch data is inside specific rectangle coordinates
  * @param  sd: Pointer to @ref TM_STMPE811_t to get data from
@@ -18,29 +18,71 @@
  */
 #include "tm_stm32f4_string.h"
 
+/**
+ * @brief  Header before each string in arena
+ * @note   Used private
+ */
+typedef struct {
+    uint16_t Length; /*!< String length without 0, ENTRY_DELETED when string is not used. String position during compaction */
+    uint16_t Size;   /*!< Size of entry with header and 0 at the end, multiple of 4 bytes */
+} TM_STRING_Entry_t;
+
+/* Length value for deleted entries */
+#define ENTRY_DELETED               0xFFFF
+
+/* Entry macros */
+#define ENTRY_SIZE(len)             ((sizeof(TM_STRING_Entry_t) + (len) + 1 + 3) & ~3UL)
+#define ENTRY_GET(String, pos)      ((TM_STRING_Entry_t *)((String)->Arena + (String)->Offsets[(pos)]))
+#define ENTRY_STR(entry)            ((char *)(entry) + sizeof(TM_STRING_Entry_t))
+
+/* Private functions */
+static uint8_t TM_STRING_INT_Append(TM_STRING_t* String, const char* str, uint16_t len, uint32_t* offset);
+static uint8_t TM_STRING_INT_GrowOffsets(TM_STRING_t* String);
+static void TM_STRING_INT_CheckCompact(TM_STRING_t* String);
+#if TM_STRING_USE_HASH == 1
+static uint32_t TM_STRING_INT_HashCalc(const char* str, uint16_t len);
+static uint8_t TM_STRING_INT_HashResize(TM_STRING_t* String, uint32_t size);
+static void TM_STRING_INT_HashInsert(TM_STRING_t* String, uint16_t pos);
+static void TM_STRING_INT_HashRemove(TM_STRING_t* String, uint16_t pos);
+#endif
+
 TM_STRING_t*
-TM_STRING_Create(uint16_t size) {
+TM_STRING_Create(uint16_t count) {
     TM_STRING_t* String;
 
+    /* At least one string */
+    if (count == 0) {
+        count = 1;
+    }
+
     /* Allocate memory */
-    String = (TM_STRING_t*) LIB_ALLOC_FUNC(sizeof(TM_STRING_t));
+    String = (TM_STRING_t*) TM_STRING_ALLOC_FUNC(sizeof(TM_STRING_t));
 
     /* Check if allocated */
     if (String == NULL) {
         return NULL;
     }
+    memset(String, 0, sizeof(TM_STRING_t));
 
-    /* Allocate memory for number of counts */
-    String->Strings = (char**) LIB_ALLOC_FUNC(size * sizeof(char*));
+    /* Allocate locations of strings and arena */
+    String->Size = count;
+    String->Offsets = (uint32_t*) TM_STRING_ALLOC_FUNC(count * sizeof(uint32_t));
+    String->ArenaSize = count * ENTRY_SIZE(TM_STRING_AVERAGE_LENGTH);
+    String->Arena = (uint8_t*) TM_STRING_ALLOC_FUNC(String->ArenaSize);
 
     /* Check if allocated */
-    if (String->Strings == NULL) {
+    if (String->Offsets == NULL || String->Arena == NULL) {
+        TM_STRING_Free(String);
         return NULL;
     }
 
-    /* Set default settings */
-    String->Size = size;
-    String->Count = 0;
+#if TM_STRING_USE_HASH == 1
+    /* Hash index has at least 2 slots for each string */
+    if (!TM_STRING_INT_HashResize(String, 2 * count)) {
+        TM_STRING_Free(String);
+        return NULL;
+    }
+#endif
 
     /* Return result */
     return String;
@@ -48,73 +90,53 @@ TM_STRING_Create(uint16_t size) {
 
 uint16_t
 TM_STRING_AddString(TM_STRING_t* String, char* str) {
-    TM_STRING_t* ptr;
-    char** tmp1;
-    uint16_t i;
+    uint32_t len;
 
-    /* Check input pointer */
-    if (String == NULL) {
-        return 0;
+    /* Check input pointers */
+    if (String == NULL || str == NULL) {
+        return TM_STRING_ERROR;
     }
 
-    /* Check if memory available */
-    if (String->Count >= String->Size) {
-        /* Create new string with more memory */
-        ptr = TM_STRING_Create(String->Size + 1);
-        tmp1 = (char**) LIB_ALLOC_FUNC((String->Size + 1) * sizeof(char*));
-
-        /* Check if allocated */
-        if (ptr == NULL || tmp1 == NULL) {
-            return 0;
-        }
-
-        /* New string is allocated, copy old pointers to new */
-        /* Store old value */
-        for (i = 0; i < String->Size; i++) {
-            tmp1[i] = String->Strings[i];
-        }
-
-        /* Save new pointer location */
-        String->Strings = ptr->Strings;
-
-        /* Copy pointers from old to new */
-        for (i = 0; i < String->Size; i++) {
-            String->Strings[i] = tmp1[i];
-        }
-
-        /* Set new size */
-        String->Size = ptr->Size;
-
-        /* Set tmp old pointer to free */
-        ptr->Strings = tmp1;
-
-        /* Free tmp1 memory */
-        free(tmp1);
+    /* Check length and number of strings */
+    len = strlen(str);
+    if (len > TM_STRING_MAX_LENGTH || String->Count >= TM_STRING_ERROR) {
+        return TM_STRING_ERROR;
+    }
 
-        /* Free tmp structure */
-        TM_STRING_Free(ptr);
+    /* Array is full, make it 2 times bigger */
+    if (String->Count >= String->Size && !TM_STRING_INT_GrowOffsets(String)) {
+        return TM_STRING_ERROR;
     }
 
-    /* Allocate memory for string */
-    String->Strings[String->Count] = (char*) LIB_ALLOC_FUNC((strlen(str) + 1) * sizeof(char));
+#if TM_STRING_USE_HASH == 1
+    /* Keep hash index at most half full */
+    if (2 * (String->Count + 1) > String->HashSize && !TM_STRING_INT_HashResize(String, 2 * String->HashSize)) {
+        return TM_STRING_ERROR;
+    }
+#endif
 
-    /* Copy content to string */
-    strcpy(String->Strings[String->Count], str);
+    /* Copy string to the end of arena */
+    if (!TM_STRING_INT_Append(String, str, len, &String->Offsets[String->Count])) {
+        return TM_STRING_ERROR;
+    }
 
-    /* Increase count */
-    String->Count++;
+#if TM_STRING_USE_HASH == 1
+    /* Add to hash index */
+    TM_STRING_INT_HashInsert(String, String->Count);
+#endif
 
-    /* Return pointer */
-    return (String->Count - 1);
+    /* Increase count and return position */
+    return String->Count++;
 }
 
 TM_STRING_t*
 TM_STRING_ReplaceString(TM_STRING_t* String, uint16_t pos, char* str) {
-    char* tmp, *tmp1;
+    TM_STRING_Entry_t* entry;
+    uint32_t len, offset;
 
     /* Check input pointer */
-    if (String == NULL) {
-        return NULL;
+    if (String == NULL || str == NULL) {
+        return String;
     }
 
     /* Add string if necessary */
@@ -126,31 +148,38 @@ TM_STRING_ReplaceString(TM_STRING_t* String, uint16_t pos, char* str) {
         return String;
     }
 
-    /* Check size */
-    if (strlen(str) > strlen(String->Strings[pos])) {
-        /* Allocate new memory */
-        tmp = (char*) LIB_ALLOC_FUNC((strlen(str) + 1) * sizeof(char*));
-
-        /* Check if allocated */
-        if (tmp == NULL) {
-            return String;
-        }
-
-        /* Get current string pointer */
-        tmp1 = String->Strings[pos];
+    /* Check length */
+    len = strlen(str);
+    if (len > TM_STRING_MAX_LENGTH) {
+        return String;
+    }
 
-        /* Save new pointer */
-        String->Strings[pos] = tmp;
+#if TM_STRING_USE_HASH == 1
+    /* Remove old content from hash index */
+    TM_STRING_INT_HashRemove(String, pos);
+#endif
+
+    entry = ENTRY_GET(String, pos);
+    if (ENTRY_SIZE(len) <= entry->Size) {
+        /* New string fits to old memory, new string can be part of old one */
+        memmove(ENTRY_STR(entry), str, len);
+        ENTRY_STR(entry)[len] = 0;
+        entry->Length = len;
+    } else if (TM_STRING_INT_Append(String, str, len, &offset)) {
+        /* New string is at the end of arena, old memory is unused. Arena may have moved */
+        entry = ENTRY_GET(String, pos);
+        entry->Length = ENTRY_DELETED;
+        String->Unused += entry->Size;
+        String->Offsets[pos] = offset;
+    }
 
-        /* Copy string */
-        strcpy(String->Strings[pos], str);
+#if TM_STRING_USE_HASH == 1
+    /* Add new content to hash index */
+    TM_STRING_INT_HashInsert(String, pos);
+#endif
 
-        /* Free old pointer */
-        LIB_FREE_FUNC(tmp1);
-    } else {
-        /* Just replace in current memory */
-        strcpy(String->Strings[pos], str);
-    }
+    /* Remove unused memory if there is too much of it */
+    TM_STRING_INT_CheckCompact(String);
 
     /* Return pointer */
     return String;
@@ -158,8 +187,10 @@ TM_STRING_ReplaceString(TM_STRING_t* String, uint16_t pos, char* str) {
 
 TM_STRING_t*
 TM_STRING_DeleteString(TM_STRING_t* String, uint16_t pos) {
-    uint16_t i;
-    char* tmp;
+#if TM_STRING_USE_HASH == 1
+    uint32_t i;
+#endif
+    TM_STRING_Entry_t* entry;
 
     /* Check input pointer */
     if (String == NULL) {
@@ -171,20 +202,29 @@ TM_STRING_DeleteString(TM_STRING_t* String, uint16_t pos) {
         return String;
     }
 
-    /* Save pointer */
-    tmp = String->Strings[pos];
-
-    /* Copy pointers */
-    for (i = pos; i < (String->Count - 1); i++) {
-        /* Copy up */
-        String->Strings[i] = String->Strings[i + 1];
+#if TM_STRING_USE_HASH == 1
+    /* Remove from hash index, strings after it move one position up */
+    TM_STRING_INT_HashRemove(String, pos);
+    for (i = 0; i < String->HashSize; i++) {
+        if (String->Hash[i] > pos + 1) {
+            String->Hash[i]--;
+        }
     }
+#endif
+
+    /* Memory of string is unused now */
+    entry = ENTRY_GET(String, pos);
+    entry->Length = ENTRY_DELETED;
+    String->Unused += entry->Size;
+
+    /* Move locations up */
+    memmove(&String->Offsets[pos], &String->Offsets[pos + 1], (String->Count - pos - 1) * sizeof(uint32_t));
 
     /* Decrease count value */
     String->Count--;
 
-    /* Deallocate */
-    LIB_FREE_FUNC(tmp);
+    /* Remove unused memory if there is too much of it */
+    TM_STRING_INT_CheckCompact(String);
 
     /* Return pointer */
     return String;
@@ -200,13 +240,103 @@ TM_STRING_GetString(TM_STRING_t* String, uint16_t pos) {
     /* Check if memory available */
     if (String->Count > pos) {
         /* Return pointer to string */
-        return String->Strings[pos];
+        return ENTRY_STR(ENTRY_GET(String, pos));
     }
 
     /* Return NULL, no string available */
     return NULL;
 }
 
+uint16_t
+TM_STRING_GetLength(TM_STRING_t* String, uint16_t pos) {
+    /* Check input */
+    if (String == NULL || String->Count <= pos) {
+        return 0;
+    }
+
+    /* Length is saved in header */
+    return ENTRY_GET(String, pos)->Length;
+}
+
+uint16_t
+TM_STRING_Find(TM_STRING_t* String, const char* str) {
+    TM_STRING_Entry_t* entry;
+    uint32_t len, i;
+#if TM_STRING_USE_HASH == 1
+    uint16_t found = TM_STRING_ERROR;
+#endif
+
+    /* Check input pointers */
+    if (String == NULL || str == NULL) {
+        return TM_STRING_ERROR;
+    }
+    len = strlen(str);
+
+#if TM_STRING_USE_HASH == 1
+    /* Check all strings in chain, there can be more of the same strings */
+    for (i = TM_STRING_INT_HashCalc(str, len) & (String->HashSize - 1); String->Hash[i]; i = (i + 1) & (String->HashSize - 1)) {
+        entry = ENTRY_GET(String, String->Hash[i] - 1);
+        if (entry->Length == len && memcmp(ENTRY_STR(entry), str, len) == 0 && String->Hash[i] - 1 < found) {
+            found = String->Hash[i] - 1;
+        }
+    }
+    return found;
+#else
+    /* Compare content only for strings with the same length */
+    for (i = 0; i < String->Count; i++) {
+        entry = ENTRY_GET(String, i);
+        if (entry->Length == len && memcmp(ENTRY_STR(entry), str, len) == 0) {
+            return i;
+        }
+    }
+    return TM_STRING_ERROR;
+#endif
+}
+
+void
+TM_STRING_Compact(TM_STRING_t* String) {
+    TM_STRING_Entry_t* entry;
+    uint32_t i, src, dst, size;
+    uint16_t len;
+
+    /* Check input pointer */
+    if (String == NULL) {
+        return;
+    }
+
+    /* Save length to location array and position to header, so arena can be read in order of memory */
+    for (i = 0; i < String->Count; i++) {
+        entry = ENTRY_GET(String, i);
+        String->Offsets[i] = entry->Length;
+        entry->Length = i;
+    }
+
+    /* Move used strings to the start of arena */
+    for (src = 0, dst = 0; src < String->ArenaUsed; src += size) {
+        entry = (TM_STRING_Entry_t *)(String->Arena + src);
+        size = entry->Size;
+
+        /* Skip deleted strings */
+        if (entry->Length == ENTRY_DELETED) {
+            continue;
+        }
+
+        /* Restore length and location, remove free space at the end of entry */
+        i = entry->Length;
+        len = String->Offsets[i];
+        memmove(String->Arena + dst, entry, ENTRY_SIZE(len));
+        entry = (TM_STRING_Entry_t *)(String->Arena + dst);
+        entry->Length = len;
+        entry->Size = ENTRY_SIZE(len);
+        String->Offsets[i] = dst;
+        dst += entry->Size;
+    }
+
+    /* Arena has no unused memory now */
+    String->ArenaUsed = dst;
+    String->Unused = 0;
+}
+
 void
 TM_STRING_Free(TM_STRING_t* String) {
     /* Check input pointer */
@@ -214,29 +344,176 @@ TM_STRING_Free(TM_STRING_t* String) {
         return;
     }
 
-    /* Deallocate pointers */
-    LIB_FREE_FUNC(String->Strings);
+    /* Deallocate arena and arrays */
+    TM_STRING_FREE_FUNC(String->Arena);
+    TM_STRING_FREE_FUNC(String->Offsets);
+#if TM_STRING_USE_HASH == 1
+    TM_STRING_FREE_FUNC(String->Hash);
+#endif
 
     /* Deallocate structure */
-    LIB_FREE_FUNC(String);
+    TM_STRING_FREE_FUNC(String);
 }
 
 void
 TM_STRING_FreeAll(TM_STRING_t* String) {
-    uint16_t i;
+    /* All strings are in arena */
+    TM_STRING_Free(String);
+}
 
-    /* Check input pointer */
-    if (String == NULL) {
-        return;
+/* Private functions */
+static uint8_t
+TM_STRING_INT_Append(TM_STRING_t* String, const char* str, uint16_t len, uint32_t* offset) {
+    TM_STRING_Entry_t* entry;
+    uint8_t* arena = String->Arena;
+    uint32_t size = ENTRY_SIZE(len);
+    uint32_t arena_size = String->ArenaSize;
+
+    /* Arena is full, allocate 2 times bigger one */
+    if (String->ArenaUsed + size > arena_size) {
+        while (String->ArenaUsed + size > arena_size) {
+            arena_size *= 2;
+        }
+        arena = (uint8_t*) TM_STRING_ALLOC_FUNC(arena_size);
+        if (arena == NULL) {
+            return 0;
+        }
+        memcpy(arena, String->Arena, String->ArenaUsed);
+    }
+
+    /* Fill entry, string can be in old arena so it is freed after copy */
+    entry = (TM_STRING_Entry_t *)(arena + String->ArenaUsed);
+    entry->Length = len;
+    entry->Size = size;
+    memcpy(ENTRY_STR(entry), str, len);
+    ENTRY_STR(entry)[len] = 0;
+
+    /* Use new arena */
+    if (arena != String->Arena) {
+        TM_STRING_FREE_FUNC(String->Arena);
+        String->Arena = arena;
+        String->ArenaSize = arena_size;
+    }
+
+    /* Save location */
+    *offset = String->ArenaUsed;
+    String->ArenaUsed += size;
+
+    return 1;
+}
+
+static uint8_t
+TM_STRING_INT_GrowOffsets(TM_STRING_t* String) {
+    uint32_t* offsets;
+    uint32_t size;
+
+    /* Double size, positions are up to TM_STRING_ERROR - 1 */
+    size = 2 * String->Size;
+    if (size > TM_STRING_ERROR) {
+        size = TM_STRING_ERROR;
+    }
+
+    /* Allocate new array and copy locations */
+    offsets = (uint32_t*) TM_STRING_ALLOC_FUNC(size * sizeof(uint32_t));
+    if (offsets == NULL) {
+        return 0;
     }
+    memcpy(offsets, String->Offsets, String->Count * sizeof(uint32_t));
 
-    /* Deallocate all string locations */
+    /* Free old array */
+    TM_STRING_FREE_FUNC(String->Offsets);
+    String->Offsets = offsets;
+    String->Size = size;
+
+    return 1;
+}
+
+static void
+TM_STRING_INT_CheckCompact(TM_STRING_t* String) {
+    /* Compact when more than half of used arena is unused */
+    if (String->Unused > String->ArenaUsed / 2) {
+        TM_STRING_Compact(String);
+    }
+}
+
+#if TM_STRING_USE_HASH == 1
+static uint32_t
+TM_STRING_INT_HashCalc(const char* str, uint16_t len) {
+    uint32_t hash = 2166136261UL;
+
+    /* FNV-1a hash */
+    while (len--) {
+        hash = (hash ^ (uint8_t)*str++) * 16777619UL;
+    }
+
+    return hash;
+}
+
+static uint8_t
+TM_STRING_INT_HashResize(TM_STRING_t* String, uint32_t size) {
+    uint16_t* hash;
+    uint32_t i, hash_size = 8;
+
+    /* Number of slots is power of 2 */
+    while (hash_size < size) {
+        hash_size *= 2;
+    }
+
+    /* Allocate new index */
+    hash = (uint16_t*) TM_STRING_ALLOC_FUNC(hash_size * sizeof(uint16_t));
+    if (hash == NULL) {
+        return 0;
+    }
+    memset(hash, 0, hash_size * sizeof(uint16_t));
+
+    /* Use new index and add all strings again */
+    TM_STRING_FREE_FUNC(String->Hash);
+    String->Hash = hash;
+    String->HashSize = hash_size;
     for (i = 0; i < String->Count; i++) {
-        /* Deallocate pointer by pointer */
-        LIB_FREE_FUNC(String->Strings[i]);
+        TM_STRING_INT_HashInsert(String, i);
     }
 
-    /* Deallocate the rest */
-    TM_STRING_Free(String);
+    return 1;
+}
+
+static void
+TM_STRING_INT_HashInsert(TM_STRING_t* String, uint16_t pos) {
+    TM_STRING_Entry_t* entry = ENTRY_GET(String, pos);
+    uint32_t mask = String->HashSize - 1;
+    uint32_t i;
+
+    /* First empty slot from home slot */
+    i = TM_STRING_INT_HashCalc(ENTRY_STR(entry), entry->Length) & mask;
+    while (String->Hash[i]) {
+        i = (i + 1) & mask;
+    }
+    String->Hash[i] = pos + 1;
 }
 
+static void
+TM_STRING_INT_HashRemove(TM_STRING_t* String, uint16_t pos) {
+    TM_STRING_Entry_t* entry = ENTRY_GET(String, pos);
+    uint32_t mask = String->HashSize - 1;
+    uint32_t i, j, home;
+
+    /* Find slot with position */
+    i = TM_STRING_INT_HashCalc(ENTRY_STR(entry), entry->Length) & mask;
+    while (String->Hash[i] != pos + 1) {
+        i = (i + 1) & mask;
+    }
+
+    /* Move next strings from chain back to empty slot, so search does not stop before them */
+    for (j = (i + 1) & mask; String->Hash[j]; j = (j + 1) & mask) {
+        entry = ENTRY_GET(String, String->Hash[j] - 1);
+        home = TM_STRING_INT_HashCalc(ENTRY_STR(entry), entry->Length) & mask;
+
+        /* Empty slot is between home slot and current slot */
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            String->Hash[i] = String->Hash[j];
+            i = j;
+        }
+    }
+    String->Hash[i] = 0;
+}
+#endif
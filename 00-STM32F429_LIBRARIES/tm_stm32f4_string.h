@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/05/library-58-dynamic-strings-on-stm32f4xx
- * @version v1.1
+ * @version v2.0
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   String library for STM32F4xx devices
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_STRING_H
-#define TM_STRING_H 110
+#define TM_STRING_H 200
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -54,9 +54,49 @@ extern "C" {
  *
  * For other compilers, check it's manual.
  *
+ * \par Memory
+ *
+ * All strings of one table are saved one after another in one memory block (arena).
+ * Each string has small header with its length, so length is never calculated again.
+ * Table has array with location of each string in arena.
+ *
+ * When arena or array is full, new one with double size is allocated and data are copied,
+ * so adding n strings needs only about log2(n) allocations. Use count parameter in @ref TM_STRING_Create
+ * to allocate enough memory at start and there is no allocation later.
+ *
+ * Deleted strings and old strings which were replaced with longer ones leave unused space in arena.
+ * When more than half of used arena is unused, strings are moved together (compaction), without new memory.
+ *
+ * @note   Pointers from @ref TM_STRING_GetString are valid only till next add, replace or delete operation,
+ *         because strings can be moved in memory
+ *
+ * \par Search
+ *
+ * @ref TM_STRING_Find finds string by content. It compares lengths first, so only strings with the same length are compared.
+ * Set TM_STRING_USE_HASH to 1 in defines.h and table also has hash index, so search takes the same time for any number of strings.
+ * Index needs 4 bytes for each string.
+ *
  * \par Changelog
  *
 @verbatim
+ Version 2.0
+  - October 16, 2026
+  - Strings are saved to one arena with length before each string, instead of one malloc for each string
+  - Arrays grow to double size instead of one by one
+  - Added compaction of arena after delete and replace
+  - Added TM_STRING_Find, TM_STRING_GetLength and TM_STRING_Compact functions
+  - Added optional hash index for search, TM_STRING_USE_HASH
+  - TM_STRING_AddString returns TM_STRING_ERROR on error
+  - Fixed memory leak when TM_STRING_Create fails
+
+ Version 1.3
+  - October 16, 2026
+  - Added TM_STRING_ALLOC_FUNC and TM_STRING_FREE_FUNC defines to select memory for strings
+
+ Version 1.2
+  - October 16, 2026
+  - Fixed double free of pointers when string is added to full table
+
  Version 1.1
   - May 23, 2015
   - Added support for replacing string
@@ -96,6 +136,41 @@ extern "C" {
 #define LIB_FREE_FUNC     free
 #endif
 
+/**
+ * @brief  Memory functions for strings, LIB_ALLOC_FUNC and LIB_FREE_FUNC by default
+ * @note   Set them in defines.h to use other heap, for example with TM HEAP library
+ */
+#ifndef TM_STRING_ALLOC_FUNC
+#define TM_STRING_ALLOC_FUNC    LIB_ALLOC_FUNC
+#endif
+#ifndef TM_STRING_FREE_FUNC
+#define TM_STRING_FREE_FUNC     LIB_FREE_FUNC
+#endif
+
+/**
+ * @brief  Expected average string length, used for first arena size in @ref TM_STRING_Create
+ */
+#ifndef TM_STRING_AVERAGE_LENGTH
+#define TM_STRING_AVERAGE_LENGTH    12
+#endif
+
+/**
+ * @brief  Set to 1 to use hash index for @ref TM_STRING_Find
+ */
+#ifndef TM_STRING_USE_HASH
+#define TM_STRING_USE_HASH          0
+#endif
+
+/**
+ * @brief  Returned position when string can't be added or is not found
+ */
+#define TM_STRING_ERROR             0xFFFF
+
+/**
+ * @brief  Maximal string length
+ */
+#define TM_STRING_MAX_LENGTH        0xFFF0
+
 /**
  * @}
  */
@@ -110,9 +185,17 @@ extern "C" {
  * @brief  Main string structure
  */
 typedef struct {
-    char** Strings;    /*!< Pointer to pointers to strings */
-    uint32_t Count;    /*!< Number of string elementsz */
-    uint32_t Size;     /*!< Number of all allocated pointers for strings */
+    uint32_t* Offsets;  /*!< Location of each string in arena */
+    uint8_t* Arena;     /*!< Memory with strings, each has header with length */
+    uint32_t ArenaSize; /*!< Size of arena in bytes */
+    uint32_t ArenaUsed; /*!< Number of used bytes in arena, new strings are added after them */
+    uint32_t Unused;    /*!< Bytes in arena from deleted and replaced strings */
+    uint32_t Count;     /*!< Number of string elements */
+    uint32_t Size;      /*!< Number of strings which fit to Offsets array */
+#if TM_STRING_USE_HASH == 1
+    uint16_t* Hash;     /*!< Hash index, string position + 1 or 0 for empty slot */
+    uint32_t HashSize;  /*!< Number of slots in hash index, power of 2 */
+#endif
 } TM_STRING_t;
 
 /**
@@ -126,9 +209,9 @@ typedef struct {
  */
 
 /**
- * @brief  Creates and allocated string structure and memory for pointers for desired number of strings
- * @note   Function uses @ref malloc() to allocate main structure and all pointers depending on count variable,
- *            so make sure that you have enough HEAP memory reserved
+ * @brief  Creates string table and allocates memory for desired number of strings
+ * @note   Function uses TM_STRING_ALLOC_FUNC to allocate main structure, array of string locations
+ *            and arena for count strings of TM_STRING_AVERAGE_LENGTH characters
  * @param  count: Number of strings you will use. Set to 1, if you don't know how many of them will be used.
  *            It's recommended that you select the number which is greater or equal to count of all strings
  * @retval Pointer to allocated @ref TM_STRING_t structure or NULL of malloc() fails
@@ -137,18 +220,17 @@ TM_STRING_t* TM_STRING_Create(uint16_t count);
 
 /**
  * @brief  Adds new string to main string structure
- * @note   Function uses @ref malloc() to allocate memory for string where it will copy it.
- *            Memory size for allocation is string length + 1
+ * @note   String is copied to the end of arena. If there is no space, arena gets double size
  * @param  *String: Pointer to @ref TM_STRING_t structure
  * @param  *str: Pointer to string to be added to string
- * @retval String position in strings array
+ * @retval String position in strings array or TM_STRING_ERROR if memory is not available
  */
 uint16_t TM_STRING_AddString(TM_STRING_t* String, char* str);
 
 /**
  * @brief  Replaces already added string with new string
- * @note   If new string is larger than string before, new memory is allocated and old is free,
- *         but if new string length is smaller than old, only new string is copied to already allocateed memory
+ * @note   If new string fits to memory of old string, it is copied there.
+ *         Otherwise it is added to the end of arena and memory of old string is unused till compaction
  * @param  *String: Pointer to @ref TM_STRING_t structure
  * @param  pos: Position in array where to replace string
  * @param  *str: Pointer to new string which will be applied to memory
@@ -158,6 +240,7 @@ TM_STRING_t* TM_STRING_ReplaceString(TM_STRING_t* String, uint16_t pos, char* st
 
 /**
  * @brief  Deletes string from strings array
+ * @note   Strings after deleted one move one position up
  * @param  *String: Pointer to @ref TM_STRING_t structure
  * @param  pos: Position number in string array which string will be deleted.
  *            This number can be a value between 0 and number of strings - 1
@@ -167,6 +250,7 @@ TM_STRING_t* TM_STRING_DeleteString(TM_STRING_t* String, uint16_t pos);
 
 /**
  * @brief  Gets pointer to string at desired position
+ * @note   Pointer is valid till next add, replace or delete operation
  * @param  *String: Pointer to @ref TM_STRING_t structure
  * @param  pos: Position number in string array which string pointer will be returned.
  *            This number can be a value between 0 and number of strings - 1
@@ -175,8 +259,32 @@ TM_STRING_t* TM_STRING_DeleteString(TM_STRING_t* String, uint16_t pos);
 char* TM_STRING_GetString(TM_STRING_t* String, uint16_t pos);
 
 /**
- * @brief  Free all. It will free all strings, all pointers to strings and also main string structure
- * @note   Use @ref TM_STRING_DeleteString() to delete only one string if needed
+ * @brief  Gets length of string at desired position, without calculation
+ * @param  *String: Pointer to @ref TM_STRING_t structure
+ * @param  pos: Position number in string array
+ * @retval String length or 0 if string does not exist
+ */
+uint16_t TM_STRING_GetLength(TM_STRING_t* String, uint16_t pos);
+
+/**
+ * @brief  Finds first string with the same content
+ * @param  *String: Pointer to @ref TM_STRING_t structure
+ * @param  *str: String to find
+ * @retval Position of string or TM_STRING_ERROR if not found
+ */
+uint16_t TM_STRING_Find(TM_STRING_t* String, const char* str);
+
+/**
+ * @brief  Moves strings together and removes unused space in arena
+ * @note   Library calls it when more than half of used arena is unused. Call it after you delete many strings,
+ *         for example before table is used only for reading
+ * @param  *String: Pointer to @ref TM_STRING_t structure
+ * @retval None
+ */
+void TM_STRING_Compact(TM_STRING_t* String);
+
+/**
+ * @brief  Free all. It will free arena, array of string locations, hash index and main string structure
  * @param  *String: Pointer to @ref TM_STRING_t structure
  * @retval None
  */
@@ -191,10 +299,8 @@ void TM_STRING_FreeAll(TM_STRING_t* String);
 #define TM_STRING_GetCount(str)    ((str)->Count)
 
 /**
- * @brief  Free main structure and pointer to all pointers.
- * @note   This is not meant for public use unless you know what you are doing.
- *            It will deallocate structure, but all strings will stay untouched in heap memory!
- *            Use @ref TM_STRING_FreeAll() instead.
+ * @brief  Free main structure and all memory
+ * @note   All strings are in one arena now, so this function is the same as @ref TM_STRING_FreeAll()
  * @param  *String: Pointer to @ref TM_STRING_t structure
  */
 void TM_STRING_Free(TM_STRING_t* String);
@@ -0,0 +1,148 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2015
+ * |
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * |
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32f4_trace.h"
+#include "stdio.h"
+
+/* If trace is enabled */
+#if TM_TRACE_ENABLED == 1
+
+/* Mask of all ports used by library */
+#define TRACE_PORTS         ((1UL << TM_TRACE_PORT_TEXT) | (1UL << TM_TRACE_PORT_EVENT) | (((1UL << TM_TRACE_WATCHES) - 1) << TM_TRACE_PORT_WATCH))
+
+/* Key to unlock ITM registers */
+#define TRACE_ITM_UNLOCK    0xC5ACCE55
+
+/* Number of dropped records */
+volatile uint32_t TM_TRACE_Dropped = 0;
+
+void
+TM_TRACE_Init(uint32_t Baudrate) {
+    /* Enable trace and SWO pin */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DBGMCU->CR |= DBGMCU_CR_TRACE_IOEN;
+
+    /* Set SWO to UART protocol with baudrate, without formatter */
+    if (Baudrate) {
+        TPI->SPPR = 0x02;
+        TPI->ACPR = SystemCoreClock / Baudrate - 1;
+        TPI->FFCR = 0x100;
+    }
+
+    /* Enable ITM with timestamps in CPU cycles, sync packets and DWT packets */
+    ITM->LAR = TRACE_ITM_UNLOCK;
+    ITM->TCR = (1UL << ITM_TCR_TraceBusID_Pos) | ITM_TCR_DWTENA_Msk | ITM_TCR_SYNCENA_Msk | ITM_TCR_TSENA_Msk | ITM_TCR_ITMENA_Msk;
+
+    /* Enable our ports, ports used by debugger stay enabled */
+    ITM->TER |= TRACE_PORTS;
+
+    /* Sync packet every 2^24 cycles, needs cycle counter */
+    DWT->CTRL = (DWT->CTRL & ~DWT_CTRL_SYNCTAP_Msk) | (1UL << DWT_CTRL_SYNCTAP_Pos) | DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void
+TM_TRACE_Print(const char* str) {
+    uint32_t word;
+    uint8_t i;
+
+    /* Text ends with zero, last word has at least one zero byte */
+    do {
+        /* Pack 4 characters */
+        word = 0;
+        for (i = 0; i < 32 && *str; i += 8) {
+            word |= (uint32_t)(uint8_t)*str++ << i;
+        }
+
+        /* Drop rest of text when FIFO is full */
+        if (!ITM->PORT[TM_TRACE_PORT_TEXT].u32) {
+            TM_TRACE_Dropped++;
+            return;
+        }
+        ITM->PORT[TM_TRACE_PORT_TEXT].u32 = word;
+    } while (i == 32);
+}
+
+void
+TM_TRACE_Printf(const char* format, ...) {
+    char buffer[TM_TRACE_PRINTF_SIZE];
+    va_list args;
+
+    /* Format text */
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    /* Send it */
+    TM_TRACE_Print(buffer);
+}
+
+void
+TM_TRACE_ExceptionTrace(uint8_t Enable) {
+    if (Enable) {
+        DWT->CTRL |= DWT_CTRL_EXCTRCENA_Msk;
+    } else {
+        DWT->CTRL &= ~DWT_CTRL_EXCTRCENA_Msk;
+    }
+}
+
+void
+TM_TRACE_PCSampling(uint32_t Cycles) {
+    uint32_t ctrl, preset;
+
+    /* Disable sampling */
+    ctrl = DWT->CTRL & ~(DWT_CTRL_PCSAMPLENA_Msk | DWT_CTRL_CYCTAP_Msk | DWT_CTRL_POSTPRESET_Msk);
+    if (!Cycles) {
+        DWT->CTRL = ctrl;
+        return;
+    }
+
+    /* Counter counts 64 or 1024 cycles, up to 16 times */
+    if (Cycles <= 64 * 16) {
+        preset = Cycles / 64;
+    } else {
+        ctrl |= DWT_CTRL_CYCTAP_Msk;
+        preset = Cycles / 1024;
+    }
+    if (preset > 16) {
+        preset = 16;
+    } else if (!preset) {
+        preset = 1;
+    }
+
+    /* Enable sampling */
+    DWT->CTRL = ctrl | (preset - 1) << DWT_CTRL_POSTPRESET_Pos | DWT_CTRL_PCSAMPLENA_Msk | DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void
+TM_TRACE_DataTrace(uint8_t Comparator, volatile void* Address, uint8_t Size, TM_TRACE_Data_t Mode) {
+    /* COMP, MASK and FUNCTION registers repeat every 16 bytes */
+    volatile uint32_t* comp = &DWT->COMP0 + 4 * Comparator;
+
+    /* Disable comparator while it is changed */
+    comp[2] = 0;
+    if (Mode == TM_TRACE_Data_Disable) {
+        return;
+    }
+
+    /* Address and number of ignored address bits */
+    comp[0] = (uint32_t)Address;
+    comp[1] = Size == 4 ? 2 : (Size == 2 ? 1 : 0);
+    comp[2] = Mode;
+}
+
+#endif
@@ -0,0 +1,358 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Non-blocking ITM/SWO trace with text, event and watch channels
+ *
+@verbatim
+   ----------------------------------------------------------------------
+    Copyright (C) Tilen MAJERLE, 2015
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+   ----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef TM_TRACE_H
+#define TM_TRACE_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32F4xx_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_TRACE
+ * @brief    Non-blocking ITM/SWO trace with text, event and watch channels
+ * @{
+ *
+ * TM SWO library sends printf output character by character and waits when ITM FIFO is full,
+ * so debug output changes timing of your program. This library is made to be always on, also in release build.
+ *
+ * Each record is one 32-bit write to ITM stimulus port. When ITM FIFO is full, record is dropped
+ * and @ref TM_TRACE_Dropped counter is increased, library never waits.
+ * ITM adds timestamps to records, so host knows when each record was written.
+ *
+ * \par Channels
+ *
+ * Different records use different stimulus ports, so they don't mix:
+ *
+ *  - Text on port TM_TRACE_PORT_TEXT, 4 characters in each write, with @ref TM_TRACE_Print or @ref TM_TRACE_Printf
+ *  - Events on port TM_TRACE_PORT_EVENT, one write for each event:
+ *    - @ref TM_TRACE_Begin and @ref TM_TRACE_End mark start and end of some work, like FFT or LCD refresh
+ *    - @ref TM_TRACE_Event marks single moment with 24-bit argument
+ *  - Watches on ports TM_TRACE_PORT_WATCH to TM_TRACE_PORT_WATCH + TM_TRACE_WATCHES - 1,
+ *    @ref TM_TRACE_Watch sends 32-bit value of variable
+ *
+ * Event word has type in bits 31..30, event ID from 0 to 63 in bits 29..24 and argument in bits 23..0.
+ *
+\code{.c}
+#define EV_FFT      1
+
+TM_TRACE_Init(2000000);
+
+while (1) {
+    TM_TRACE_Begin(EV_FFT);
+    arm_cfft_radix4_f32(&S, Input);
+    TM_TRACE_End(EV_FFT);
+
+    TM_TRACE_Watch(0, MaxValue);
+    TM_TRACE_Printf("Max %d\n", MaxValue);
+}
+\endcode
+ *
+ * Text from interrupt and main loop at the same time can be mixed, because one text needs more writes.
+ * Events and watches are safe from everywhere.
+ *
+ * \par Hardware trace
+ *
+ * DWT unit can send trace packets by itself, without any code:
+ *
+ *  - @ref TM_TRACE_ExceptionTrace sends packet on each interrupt entry and exit
+ *  - @ref TM_TRACE_PCSampling sends program counter periodically, to see where CPU spends time
+ *  - @ref TM_TRACE_DataTrace sends value of variable each time it is read or written
+ *
+ * Hardware packets can fill SWO very fast, use fast SWO clock or only few of them at the same time.
+ *
+ * \par Host decoder
+ *
+ * host/trace_decode.c reads raw SWO capture, for example from OpenOCD with "tpiu config internal trace.bin uart off 168000000 2000000",
+ * and writes Chrome trace JSON file. Open it in https://ui.perfetto.dev or chrome://tracing to see timeline
+ * of events, interrupts, watches and text.
+ *
+ * \par Disable trace
+ *
+ * Set TM_TRACE_ENABLED to 0 in defines.h and all functions become empty defines.
+ *
+ * \par Changelog
+ *
+@verbatim
+ Version 1.0
+  - October 16, 2026
+  - First release
+@endverbatim
+ *
+ * \par Dependencies
+ *
+@verbatim
+ - STM32F4xx
+ - defines.h
+ - stdarg.h
+@endverbatim
+ */
+#include "stm32f4xx.h"
+#include "defines.h"
+#include "stdarg.h"
+
+/**
+ * @defgroup TM_TRACE_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Trace status, enabled by default
+ */
+#ifndef TM_TRACE_ENABLED
+#define TM_TRACE_ENABLED        1
+#endif
+
+/**
+ * @brief  Stimulus port for text, port 0 is used by TM SWO printf
+ */
+#ifndef TM_TRACE_PORT_TEXT
+#define TM_TRACE_PORT_TEXT      2
+#endif
+
+/**
+ * @brief  Stimulus port for events
+ */
+#ifndef TM_TRACE_PORT_EVENT
+#define TM_TRACE_PORT_EVENT     3
+#endif
+
+/**
+ * @brief  First stimulus port for watches
+ */
+#ifndef TM_TRACE_PORT_WATCH
+#define TM_TRACE_PORT_WATCH     8
+#endif
+
+/**
+ * @brief  Number of watches, each uses its own port
+ */
+#ifndef TM_TRACE_WATCHES
+#define TM_TRACE_WATCHES        8
+#endif
+
+/**
+ * @brief  Maximal length of text formatted with @ref TM_TRACE_Printf
+ */
+#ifndef TM_TRACE_PRINTF_SIZE
+#define TM_TRACE_PRINTF_SIZE    64
+#endif
+
+/* Check settings */
+#if TM_TRACE_PORT_WATCH + TM_TRACE_WATCHES > 32
+#error "Watch ports must be lower than 32"
+#endif
+
+/**
+ * @brief  Event types in bits 31..30 of event word
+ */
+#define TM_TRACE_EVENT_INSTANT  0x00 /*!< Single moment */
+#define TM_TRACE_EVENT_BEGIN    0x01 /*!< Start of work */
+#define TM_TRACE_EVENT_END      0x02 /*!< End of work */
+
+/**
+ * @brief  Creates event word
+ * @param  type: Event type
+ * @param  id: Event ID, from 0 to 63
+ * @param  arg: Argument, lower 24 bits are used
+ */
+#define TM_TRACE_EVENT(type, id, arg)   ((uint32_t)(type) << 30 | ((uint32_t)(id) & 0x3F) << 24 | ((uint32_t)(arg) & 0xFFFFFF))
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_TRACE_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  DWT data trace modes for @ref TM_TRACE_DataTrace
+ */
+typedef enum {
+    TM_TRACE_Data_Disable = 0x00,      /*!< Comparator is disabled */
+    TM_TRACE_Data_Value = 0x02,        /*!< Send value on read and write */
+    TM_TRACE_Data_PCValue = 0x03,      /*!< Send PC and value on read and write */
+    TM_TRACE_Data_ValueRead = 0x0C,    /*!< Send value on read */
+    TM_TRACE_Data_ValueWrite = 0x0D,   /*!< Send value on write */
+    TM_TRACE_Data_PCValueRead = 0x0E,  /*!< Send PC and value on read */
+    TM_TRACE_Data_PCValueWrite = 0x0F  /*!< Send PC and value on write */
+} TM_TRACE_Data_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_TRACE_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+#if TM_TRACE_ENABLED == 1
+
+/* Number of dropped records */
+extern volatile uint32_t TM_TRACE_Dropped;
+
+/**
+ * @brief  Initializes ITM with timestamps and enables trace ports
+ * @note   When debugger already configured SWO, use 0 for baudrate and only ITM is set
+ * @param  Baudrate: SWO baudrate, 0 to leave SWO clock and protocol as set by debugger
+ * @retval None
+ */
+void TM_TRACE_Init(uint32_t Baudrate);
+
+/**
+ * @brief  Writes one word to stimulus port, drops it when FIFO is full
+ * @note   Defined as static inline, it takes only a few cycles
+ * @param  Port: Stimulus port, from 0 to 31
+ * @param  Value: Value to write
+ * @retval None
+ */
+static __INLINE void TM_TRACE_Write(uint8_t Port, uint32_t Value) {
+    /* Port reads 1 when FIFO can take new data */
+    if (ITM->PORT[Port].u32) {
+        ITM->PORT[Port].u32 = Value;
+    } else {
+        TM_TRACE_Dropped++;
+    }
+}
+
+/**
+ * @brief  Sends start of work event
+ * @param  id: Event ID, from 0 to 63
+ * @retval None
+ */
+#define TM_TRACE_Begin(id)              TM_TRACE_Write(TM_TRACE_PORT_EVENT, TM_TRACE_EVENT(TM_TRACE_EVENT_BEGIN, id, 0))
+
+/**
+ * @brief  Sends end of work event
+ * @param  id: Event ID, from 0 to 63
+ * @retval None
+ */
+#define TM_TRACE_End(id)                TM_TRACE_Write(TM_TRACE_PORT_EVENT, TM_TRACE_EVENT(TM_TRACE_EVENT_END, id, 0))
+
+/**
+ * @brief  Sends single moment event
+ * @param  id: Event ID, from 0 to 63
+ * @param  arg: Argument, lower 24 bits are sent
+ * @retval None
+ */
+#define TM_TRACE_Event(id, arg)         TM_TRACE_Write(TM_TRACE_PORT_EVENT, TM_TRACE_EVENT(TM_TRACE_EVENT_INSTANT, id, arg))
+
+/**
+ * @brief  Sends value of watch
+ * @param  n: Watch number, from 0 to TM_TRACE_WATCHES - 1
+ * @param  value: 32-bit value
+ * @retval None
+ */
+#define TM_TRACE_Watch(n, value)        TM_TRACE_Write(TM_TRACE_PORT_WATCH + (n), (uint32_t)(value))
+
+/**
+ * @brief  Sends text to text port
+ * @note   Rest of text is dropped when FIFO gets full
+ * @param  *str: Text to send
+ * @retval None
+ */
+void TM_TRACE_Print(const char* str);
+
+/**
+ * @brief  Formats text like printf and sends it to text port
+ * @note   Text longer than TM_TRACE_PRINTF_SIZE - 1 characters is cut
+ * @param  *format: Format string, like for printf
+ * @retval None
+ */
+void TM_TRACE_Printf(const char* format, ...);
+
+/**
+ * @brief  Enables or disables exception trace packets on interrupt entry and exit
+ * @param  Enable: Set to 1 to enable or 0 to disable
+ * @retval None
+ */
+void TM_TRACE_ExceptionTrace(uint8_t Enable);
+
+/**
+ * @brief  Enables periodic PC sampling
+ * @param  Cycles: Sampling period in CPU cycles, from 64 to 16384, rounded down to 64 or 1024 multiple. 0 to disable
+ * @retval None
+ */
+void TM_TRACE_PCSampling(uint32_t Cycles);
+
+/**
+ * @brief  Sets DWT comparator to send variable value when it is accessed
+ * @param  Comparator: Comparator number, from 0 to 3
+ * @param  *Address: Address of variable
+ * @param  Size: Variable size in bytes, 1, 2 or 4
+ * @param  Mode: Data trace mode, member of @ref TM_TRACE_Data_t
+ * @retval None
+ */
+void TM_TRACE_DataTrace(uint8_t Comparator, volatile void* Address, uint8_t Size, TM_TRACE_Data_t Mode);
+
+#else
+/* Do nothing here, compiler will throw out these statements because they are empty */
+#define TM_TRACE_Init(Baudrate)
+#define TM_TRACE_Write(Port, Value)
+#define TM_TRACE_Begin(id)
+#define TM_TRACE_End(id)
+#define TM_TRACE_Event(id, arg)
+#define TM_TRACE_Watch(n, value)
+#define TM_TRACE_Print(str)
+#define TM_TRACE_Printf(format, ...)
+#define TM_TRACE_ExceptionTrace(Enable)
+#define TM_TRACE_PCSampling(Cycles)
+#define TM_TRACE_DataTrace(Comparator, Address, Size, Mode)
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -57,29 +57,30 @@ uint8_t TM_UART7_Buffer[TM_UART7_BUFFER_SIZE];
 uint8_t TM_UART8_Buffer[TM_UART8_BUFFER_SIZE];
 #endif
 
+/* Control structures are used in each RX interrupt, they are in CCM RAM. Buffers stay in SRAM */
 #ifdef USE_USART1
-TM_USART_t TM_USART1 = {TM_USART1_Buffer, TM_USART1_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_USART1 TM_CCM_DATA = {TM_USART1_Buffer, TM_USART1_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 #ifdef USE_USART2
-TM_USART_t TM_USART2 = {TM_USART2_Buffer, TM_USART2_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_USART2 TM_CCM_DATA = {TM_USART2_Buffer, TM_USART2_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 #ifdef USE_USART3
-TM_USART_t TM_USART3 = {TM_USART3_Buffer, TM_USART3_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_USART3 TM_CCM_DATA = {TM_USART3_Buffer, TM_USART3_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 #ifdef USE_UART4
-TM_USART_t TM_UART4 = {TM_UART4_Buffer, TM_UART4_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_UART4 TM_CCM_DATA = {TM_UART4_Buffer, TM_UART4_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 #ifdef USE_UART5
-TM_USART_t TM_UART5 = {TM_UART5_Buffer, TM_UART5_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_UART5 TM_CCM_DATA = {TM_UART5_Buffer, TM_UART5_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 #ifdef USE_USART6
-TM_USART_t TM_USART6 = {TM_USART6_Buffer, TM_USART6_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_USART6 TM_CCM_DATA = {TM_USART6_Buffer, TM_USART6_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 #ifdef USE_UART7
-TM_USART_t TM_UART7 = {TM_UART7_Buffer, TM_UART7_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_UART7 TM_CCM_DATA = {TM_UART7_Buffer, TM_UART7_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 #ifdef USE_UART8
-TM_USART_t TM_UART8 = {TM_UART8_Buffer, TM_UART8_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
+TM_USART_t TM_UART8 TM_CCM_DATA = {TM_UART8_Buffer, TM_UART8_BUFFER_SIZE, 0, 0, 0, 0, USART_STRING_DELIMITER};
 #endif
 
 /* Private functions */
@@ -291,6 +292,12 @@ TM_USART_ClearBuffer(USART_TypeDef* USARTx) {
     u->Out = 0;
 }
 
+void
+TM_USART_InsertToBuffer(USART_TypeDef* USARTx, uint8_t c) {
+    /* Add to buffer like in interrupt */
+    TM_USART_INT_InsertToBuffer(TM_USART_INT_GetUsart(USARTx), c);
+}
+
 void
 TM_USART_SetCustomStringEndCharacter(USART_TypeDef* USARTx, uint8_t Character) {
     /* Get USART structure */
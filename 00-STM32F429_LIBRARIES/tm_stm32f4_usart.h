@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2014/04/library-04-connect-stm32f429-discovery-to-computer-with-usart/
- * @version v2.5
+ * @version v2.7
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   USART Library for STM32F4 with receive interrupt
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_USART_H
-#define TM_USART_H 250
+#define TM_USART_H 270
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -144,6 +144,14 @@ UART8        |PE1    PE0     |-      -       |-      -
  * \par Changelog
  *
 @verbatim
+ Version 2.7
+   - October 16, 2026
+   - Buffer control structures are placed to CCM RAM when TM_CCM_ENABLED is 1
+
+ Version 2.6
+   - October 16, 2026
+   - Added TM_USART_InsertToBuffer() function to put data to receive buffer without USART
+
  Version 2.5
    - April 15, 2015
    - Added support for custom character for string delimiter
@@ -584,6 +592,15 @@ uint8_t TM_USART_BufferFull(USART_TypeDef* USARTx);
  */
 void TM_USART_ClearBuffer(USART_TypeDef* USARTx);
 
+/**
+ * @brief  Inserts character to internal USART buffer, like it was received
+ * @note   Use it for data from other sources, like USB, to use the same parsers, or in tests and benchmarks
+ * @param  *USARTx: Pointer to USARTx peripheral you will use
+ * @param  c: Character to insert. It is dropped if buffer is full
+ * @retval None
+ */
+void TM_USART_InsertToBuffer(USART_TypeDef* USARTx, uint8_t c);
+
 /**
  * @brief  Sets custom character for @ref TM_USART_Gets() function to detect when string ends
  * @param  *USARTx: Pointer to USARTx peripheral you will use
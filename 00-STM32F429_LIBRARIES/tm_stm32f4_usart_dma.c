@@ -129,6 +129,11 @@ TM_USART_DMA_Send(USART_TypeDef* USARTx, uint8_t* DataArray, uint16_t count) {
         return 0;
     }
 
+    /* DMA can't read CCM RAM */
+    if (TM_IS_CCM(DataArray)) {
+        return 0;
+    }
+
     /* Set DMA options */
     DMA_InitStruct.DMA_Channel = Settings->DMA_Channel;
     DMA_InitStruct.DMA_BufferSize = count;
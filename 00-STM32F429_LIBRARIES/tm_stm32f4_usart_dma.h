@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/04/library-55-extend-usart-with-tx-dma
- * @version v1.2.3
+ * @version v1.4
  * @ide     Keil uVision
  * @license GNU GPL v3
  * @brief   DMA TX functionality for TM USART library
@@ -28,7 +28,7 @@
 @endverbatim
  */
 #ifndef TM_USART_DMA_H
-#define TM_USART_DMA_H 123
+#define TM_USART_DMA_H 140
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -78,6 +78,10 @@ UART8      | DMA1 | DMA Stream 0 | DMA Channel 5
  * \par Changelog
  *
 @verbatim
+ Version 1.4
+  - October 16, 2026
+  - TM_USART_DMA_Send() returns 0 for data in CCM RAM, because DMA can't read it
+
  Version 1.3
   - TM_USART_DMA_Working() function now returns > 0 also when USART works, not only when DMA works.
      Requires updated USART library
@@ -105,6 +109,7 @@ UART8      | DMA1 | DMA Stream 0 | DMA Channel 5
  - defines.h
  - TM USART
  - TM DMA
+ - attributes.h
  - string.h
 @endverbatim
  */
@@ -114,6 +119,7 @@ UART8      | DMA1 | DMA Stream 0 | DMA Channel 5
 #include "defines.h"
 #include "tm_stm32f4_dma.h"
 #include "tm_stm32f4_usart.h"
+#include "attributes.h"
 #include "string.h"
 
 /* Check USART library version */
@@ -246,7 +252,8 @@ DMA_Stream_TypeDef* TM_USART_DMA_GetStream(USART_TypeDef* USARTx);
 
 /**
  * @brief  Puts string to USART port with DMA
- * @note   Try not to use local variables pointers for DMA memory as parameter *str
+ * @note   Try not to use local variables pointers for DMA memory as parameter *str.
+ *         Strings in CCM RAM are not sent, DMA can't read this memory
  * @param  *USARTx: Pointer to USARTx peripheral you will use
  * @param  *str: Pointer to string to send over USART with DMA
  * @retval Sending started status:
@@ -257,7 +264,8 @@ uint8_t TM_USART_DMA_Puts(USART_TypeDef* USARTx, char* str);
 
 /**
  * @brief  Sends data over USART with DMA TX functionality
- * @note   Try not to use local variables pointers for DMA memory as parameter *str
+ * @note   Try not to use local variables pointers for DMA memory as parameter *str.
+ *         Data in CCM RAM are not sent, DMA can't read this memory
  * @param  *USARTx: Pointer to USARTx to use for send
  * @param  *DataArray: Pointer to array of data to be sent over USART
  * @param  count: Number of data bytes to be sent over USART with DMA
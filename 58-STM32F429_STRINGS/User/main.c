@@ -36,31 +36,42 @@ int main(void) {
 	
 	/* Create string with 10 predefined locations for strings */
 	String = TM_STRING_Create(10);
+	if (String == NULL) {
+		/* Not enough memory */
+		printf("String create failed\n");
+		while (1);
+	}
 	
 	/* Add string to memory, allocated memory will be set depending on string length */
-	TM_STRING_AddString(String, "First string");
+	if (TM_STRING_AddString(String, "First string") == TM_STRING_ERROR) {
+		printf("String add failed\n");
+	}
 	
 	/* Add another string to memory, allocated memory will be set depending on string length */
-	TM_STRING_AddString(String, "Second string");
+	if (TM_STRING_AddString(String, "Second string") == TM_STRING_ERROR) {
+		printf("String add failed\n");
+	}
 	
 	/* Send strings over USART */
-	for (i = 0; i < String->Count; i++) {
-		/* Print string to user */
-		printf("%s\n", String->Strings[i]);
+	for (i = 0; i < TM_STRING_GetCount(String); i++) {
+		/* Print string to user, pointer is used only before next change of strings */
+		printf("%s\n", TM_STRING_GetString(String, i));
 	}
 	
-	/* Add some strings */
+	/* Add some strings, strings can move in memory, so old pointers are not valid anymore */
 	TM_STRING_AddString(String, "Third string");
 	strposition = TM_STRING_AddString(String, "Forth string");
 	TM_STRING_AddString(String, "Fifth string");
 	
-	/* Modify string number 4 */
-	TM_STRING_ReplaceString(String, strposition, "Updated string");
+	/* Modify string number 4, if it was added */
+	if (strposition != TM_STRING_ERROR) {
+		TM_STRING_ReplaceString(String, strposition, "Updated string");
+	}
 	
-	/* Send strings over USART */
-	for (i = 0; i < String->Count; i++) {
+	/* Send strings over USART, get pointers again after changes */
+	for (i = 0; i < TM_STRING_GetCount(String); i++) {
 		/* Print string to user */
-		printf("%s\n", String->Strings[i]);
+		printf("%s\n", TM_STRING_GetString(String, i));
 	}
 	
 	/* Delete string on position 1 = "Second string" */
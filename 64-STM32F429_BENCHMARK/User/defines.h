@@ -0,0 +1,42 @@
+/**
+ *  Defines for your entire project at one place
+ * 
+ *	@author 	Tilen MAJERLE
+ *	@email		tilen@majerle.eu
+ *	@website	http://stm32f4-discovery.net
+ *	@version 	v1.0
+ *	@ide		Keil uVision 5
+ *	@license	GNU GPL v3
+ *	
+ * |----------------------------------------------------------------------
+ * | Copyright (C) Tilen MAJERLE, 2014
+ * | 
+ * | This program is free software: you can redistribute it and/or modify
+ * | it under the terms of the GNU General Public License as published by
+ * | the Free Software Foundation, either version 3 of the License, or
+ * | any later version.
+ * |  
+ * | This program is distributed in the hope that it will be useful,
+ * | but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * | GNU General Public License for more details.
+ * | 
+ * | You should have received a copy of the GNU General Public License
+ * | along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * |----------------------------------------------------------------------
+ */
+#ifndef TM_DEFINES_H
+#define TM_DEFINES_H
+
+/* Put your global defines for all libraries here used in your project */
+
+/* Use SDRAM with FATFS, FatFs suite uses it as RAM disk */
+#define FATFS_USE_SDRAM          1
+
+/* Buffer and GPS suites put up to 1kB to USART1 receive buffer */
+#define TM_USART1_BUFFER_SIZE    1024
+
+/* GPS data comes from benchmark, USART1 is already used for results */
+#define GPS_USART_INIT(baudrate)
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ *	Keil project for TM BENCH micro benchmark suites
+ *
+ *	Before you start, select your target, on the right of the "Load" button
+ *
+ *	@author		Tilen MAJERLE
+ *	@email		tilen@majerle.eu
+ *	@website	http://stm32f4-discovery.net
+ *	@ide		Keil uVision 5
+ *	@conf		PLL parameters are set in "Options for Target" -> "C/C++" -> "Defines"
+ *	@packs		STM32F4xx Keil packs version 2.4.0 or greater required
+ *	@stdperiph	STM32F4xx Standard peripheral drivers version 1.5.0 or greater required
+ *
+ *	Notes:
+ *		- Add all files from 00-STM32F429_LIBRARIES/bench folder to project
+ *		- Add ARM_MATH_CM4 and __FPU_PRESENT=1 defines and CMSIS DSP library for FFT suite
+ *		- Results are sent as CSV text on USART1, PA9 pin, 921600 bauds
+ *		- Same suites can run on PC with "make bench-run" in 00-STM32F429_LIBRARIES/host folder
+ */
+/* Include core modules */
+#include "stm32f4xx.h"
+/* Include my libraries here */
+#include "defines.h"
+#include "tm_stm32f4_delay.h"
+#include "tm_stm32f4_disco.h"
+#include "tm_stm32f4_usart.h"
+#include "tm_stm32f4_bench.h"
+#include "bench_suites.h"
+
+/* Output function for benchmark results */
+void Output(const char* str) {
+	TM_USART_Puts(USART1, (char *)str);
+}
+
+int main(void) {
+	/* Initialize system */
+	SystemInit();
+	
+	/* Initialize delay */
+	TM_DELAY_Init();
+	
+	/* Initialize leds on board */
+	TM_DISCO_LedInit();
+	
+	/* Initialize USART1 for results, TX on PA9 */
+	TM_USART_Init(USART1, TM_USART_PinsPack_1, 921600);
+	
+	/* Measure overhead and run all suites */
+	TM_DISCO_LedOn(LED_RED);
+	TM_BENCH_Init();
+	TM_BENCH_Run(BENCH_Suites, BENCH_SuitesCount, NULL, Output);
+	
+	/* Done, turn on GREEN led */
+	TM_DISCO_LedOff(LED_RED);
+	TM_DISCO_LedOn(LED_GREEN);
+	
+	/* Main loop */
+	while (1) {
+		
+	}
+}